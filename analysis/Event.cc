@@ -26,6 +26,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventHistograms.hh"
 #include "BDSOutputROOTEventInfo.hh"
 #include "BDSOutputROOTEventLoss.hh"
+#include "BDSOutputROOTEventLossBinned.hh"
 #include "BDSOutputROOTEventLossWorld.hh"
 #include "BDSOutputROOTEventTrajectory.hh"
 #include "BDSOutputROOTEventSampler.hh"
@@ -70,6 +71,7 @@ Event::~Event()
   delete ElossTunnel;
   delete ElossWorld;
   delete ElossWorldExit;
+  delete ElossBinned;
   delete PrimaryFirstHit;
   delete PrimaryLastHit;
   delete TunnelHit;
@@ -102,6 +104,7 @@ void Event::CommonCtor()
   ElossWorld         = new BDSOutputROOTEventLossWorld();
   ElossWorldContents = new BDSOutputROOTEventLossWorld();
   ElossWorldExit     = new BDSOutputROOTEventLossWorld();
+  ElossBinned        = new BDSOutputROOTEventLossBinned();
   PrimaryFirstHit    = new BDSOutputROOTEventLoss();
   PrimaryLastHit     = new BDSOutputROOTEventLoss();
   TunnelHit          = new BDSOutputROOTEventLoss();
@@ -248,6 +251,7 @@ void Event::SetBranchAddress(TTree* t,
           bToTurnOn.emplace_back("ElossWorld");
           bToTurnOn.emplace_back("ElossWorldContents");
           bToTurnOn.emplace_back("ElossWorldExit");
+          bToTurnOn.emplace_back("ElossBinned");
           // add all collimators but ensure not duplicate from user supplied branch names
           if (collimatorNamesIn)
             {
@@ -309,6 +313,8 @@ void Event::SetBranchAddress(TTree* t,
         {addressSetResult = t->SetBranchAddress("ApertureImpacts.", &ApertureImpacts);}
       else if (name == "Eloss")
         {addressSetResult = t->SetBranchAddress("Eloss.",           &Eloss);}
+      else if (name == "ElossBinned")
+        {addressSetResult = t->SetBranchAddress("ElossBinned.",     &ElossBinned);}
       else if (name == "ElossVacuum")
         {addressSetResult = t->SetBranchAddress("ElossVacuum.",     &ElossVacuum);}
       else if (name == "ElossTunnel")
@@ -354,6 +360,7 @@ void Event::SetBranchAddress(TTree* t,
       std::cout << "Event::SetBranchAddress> ElossWorld.         " << ElossWorld         << std::endl;
       std::cout << "Event::SetBranchAddress> ElossWorldContents. " << ElossWorldContents << std::endl;
       std::cout << "Event::SetBranchAddress> ElossWorldExit.     " << ElossWorldExit     << std::endl;
+      std::cout << "Event::SetBranchAddress> ElossBinned.        " << ElossBinned        << std::endl;
       std::cout << "Event::SetBranchAddress> PrimaryFirstHit.    " << PrimaryFirstHit    << std::endl;
       std::cout << "Event::SetBranchAddress> PrimaryLastHit.     " << PrimaryLastHit     << std::endl;
       std::cout << "Event::SetBranchAddress> TunnelHit.          " << TunnelHit          << std::endl;
@@ -503,6 +510,7 @@ void Event::Fill(Event* other)
   ElossWorld->Fill(other->ElossWorld);
   ElossWorldContents->Fill(other->ElossWorldContents);
   ElossWorldExit->Fill(other->ElossWorldExit);
+  ElossBinned->Fill(other->ElossBinned);
   PrimaryFirstHit->Fill(other->PrimaryFirstHit);
   PrimaryLastHit->Fill(other->PrimaryLastHit);
   TunnelHit->Fill(other->TunnelHit);
@@ -535,6 +543,7 @@ void Event::Flush()
   ElossWorld->Flush();
   ElossWorldContents->Flush();
   ElossWorldExit->Flush();
+  ElossBinned->Flush();
   PrimaryFirstHit->Flush();
   PrimaryLastHit->Flush();
   TunnelHit->Flush();
@@ -35,6 +35,7 @@ class BDSOutputROOTEventCoords;
 class BDSOutputROOTEventHistograms;
 class BDSOutputROOTEventInfo;
 class BDSOutputROOTEventLoss;
+class BDSOutputROOTEventLossBinned;
 class BDSOutputROOTEventLossWorld;
 class BDSOutputROOTEventSamplerC;
 class BDSOutputROOTEventSamplerS;
@@ -68,6 +69,7 @@ public:
   BDSOutputROOTEventLossWorld*       GetLossWorld()        {return ElossWorld;}
   BDSOutputROOTEventLossWorld*       GetLossWorldContents(){return ElossWorldContents;}
   BDSOutputROOTEventLossWorld*       GetLossWorldExit()    {return ElossWorldExit;}
+  BDSOutputROOTEventLossBinned*      GetLossBinned()       {return ElossBinned;}
   BDSOutputROOTEventLoss*            GetPrimaryFirstHit()  {return PrimaryFirstHit;}
   BDSOutputROOTEventLoss*            GetPrimaryLastHit()   {return PrimaryLastHit;}
   BDSOutputROOTEventLoss*            GetTunnelHit()        {return TunnelHit;}
@@ -132,6 +134,7 @@ public:
   BDSOutputROOTEventLossWorld*  ElossWorld;
   BDSOutputROOTEventLossWorld*  ElossWorldContents;
   BDSOutputROOTEventLossWorld*  ElossWorldExit;
+  BDSOutputROOTEventLossBinned* ElossBinned;
   BDSOutputROOTEventLoss*       PrimaryFirstHit;
   BDSOutputROOTEventLoss*       PrimaryLastHit;
   BDSOutputROOTEventLoss*       TunnelHit;
@@ -67,9 +67,9 @@ if (Geant4_FOUND)
       string(REGEX REPLACE "\n$" "" _TMP2 "${_TMP2}")
       set(Geant4_LIBRARY_DIR ${_TMP2}/lib)
 
-      # We don't support multithreading for now
+      # multithreading is optional at run time with the nThreads option
       if ("${Geant4_DEFINITIONS}" MATCHES "G4MULTITHREADED")
-	    message(FATAL_ERROR "Currently Geant4 builds with multithreading are not supported at the moment! Please build Geant4 with multithreading off. Exiting")
+	    message(STATUS "Geant4 built with multithreading - option nThreads can be used to process events in parallel")
       endif()
       
       if($ENV{VERBOSE})
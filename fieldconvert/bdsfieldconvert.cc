@@ -0,0 +1,131 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray1DCoords.hh"
+#include "BDSArray2DCoords.hh"
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSException.hh"
+#include "BDSFieldFormat.hh"
+#include "BDSFieldLoaderBDSIM.hh"
+#include "BDSFieldLoaderBinary.hh"
+#include "BDSFieldLoaderPoisson.hh"
+
+#include "globals.hh" // geant4 types / globals
+#include "G4String.hh"
+
+#include <exception>
+#include <fstream>
+#include <string>
+
+#ifdef USE_GZSTREAM
+#include "src-external/gzstream/gzstream.h"
+#endif
+
+namespace
+{
+  void Usage()
+  {
+    G4cout << "Convert an ASCII field map to the BDSIM binary field map format." << G4endl;
+    G4cout << "Usage: bdsfieldconvert <format> <inputfile> <outputfile>" << G4endl;
+    G4cout << "  format : bdsim1d, bdsim2d, bdsim3d, bdsim4d, poisson2d, poisson2dquad, poisson2ddipole" << G4endl;
+    G4cout << "The output file is then used with the equivalent 'bdsimNdbin' format. Poisson maps" << G4endl;
+    G4cout << "are written as is and may still be loaded with the poisson formats to apply" << G4endl;
+    G4cout << "their reflections." << G4endl;
+  }
+
+  template <class T>
+  BDSArray4DCoords* LoadASCII(const BDSFieldFormat& format,
+                              const G4String&       fileName)
+  {
+    BDSArray4DCoords* result = nullptr;
+    switch (format.underlying())
+      {
+      case BDSFieldFormat::bdsim1d:
+        {BDSFieldLoaderBDSIM<T> loader; result = loader.Load1D(fileName); break;}
+      case BDSFieldFormat::bdsim2d:
+        {BDSFieldLoaderBDSIM<T> loader; result = loader.Load2D(fileName); break;}
+      case BDSFieldFormat::bdsim3d:
+        {BDSFieldLoaderBDSIM<T> loader; result = loader.Load3D(fileName); break;}
+      case BDSFieldFormat::bdsim4d:
+        {BDSFieldLoaderBDSIM<T> loader; result = loader.Load4D(fileName); break;}
+      case BDSFieldFormat::poisson2d:
+      case BDSFieldFormat::poisson2dquad:
+      case BDSFieldFormat::poisson2ddipole:
+        {BDSFieldLoaderPoisson<T> loader; result = loader.LoadMag2D(fileName); break;}
+      default:
+        {throw BDSException("bdsfieldconvert", "format \"" + format.ToString() + "\" cannot be converted");}
+      }
+    return result;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  /// Print header & program information
+  G4cout<<"bdsfieldconvert : version @BDSIM_VERSION@"<<G4endl;
+  G4cout<<"                  (C) 2001-@CURRENT_YEAR@ Royal Holloway University London"<<G4endl;
+  G4cout<<"                  http://www.pp.rhul.ac.uk/bdsim"<<G4endl;
+  G4cout<<G4endl;
+
+  if (argc != 4)
+    {
+      Usage();
+      return 1;
+    }
+
+  G4String formatName = G4String(argv[1]);
+  G4String inputFile  = G4String(argv[2]);
+  G4String outputFile = G4String(argv[3]);
+
+  try
+    {
+      BDSFieldFormat format = BDS::DetermineFieldFormat(formatName);
+      if (BDS::FieldFormatIsBinary(format))
+        {throw BDSException("bdsfieldconvert", "input format is already binary");}
+      if (BDSFieldLoaderBinary::IsBinaryFile(inputFile))
+        {throw BDSException("bdsfieldconvert", "input file is already in the binary format");}
+
+      BDSArray4DCoords* array = nullptr;
+      if (inputFile.rfind("gz") != std::string::npos)
+        {
+#ifdef USE_GZSTREAM
+          array = LoadASCII<igzstream>(format, inputFile);
+#else
+          throw BDSException("bdsfieldconvert", "Compressed file loading - but BDSIM not compiled with ZLIB.");
+#endif
+        }
+      else
+        {array = LoadASCII<std::ifstream>(format, inputFile);}
+
+      BDSFieldLoaderBinary::Write(array, BDS::NDimensionsOfFieldFormat(format), outputFile);
+      delete array;
+    }
+  catch (BDSException& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+  catch (std::exception& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSACTIONINITIALIZATION_H
+#define BDSACTIONINITIALIZATION_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4VUserActionInitialization.hh"
+
+#include <vector>
+
+class BDSBunch;
+class BDSDetectorConstruction;
+class BDSOutput;
+class BDSOutputEventQueue;
+class BDSParticleDefinition;
+
+namespace GMAD
+{
+  class Beam;
+}
+
+/**
+ * @brief Construct the user actions for each thread.
+ *
+ * In a sequential run, Build() is called once and uses the bunch given here.
+ * In a multi-threaded run, BuildForMaster() constructs the run action for the
+ * master that writes the output and Build() is called on each worker thread.
+ * Each worker gets its own bunch distribution, built from the same beam definition,
+ * as the distributions keep state. Events from all workers are written to the one
+ * output through the output queue.
+ */
+
+class BDSActionInitialization: public G4VUserActionInitialization
+{
+public:
+  BDSActionInitialization(BDSOutput*                   outputIn,
+                          BDSBunch*                    bunchIn,
+                          const GMAD::Beam&            beamIn,
+                          const BDSParticleDefinition* designParticleIn,
+                          const BDSDetectorConstruction* detectorIn,
+                          BDSOutputEventQueue*         outputQueueIn = nullptr);
+  virtual ~BDSActionInitialization();
+
+  /// Construct the run action of the master for a multi-threaded run.
+  virtual void BuildForMaster() const;
+
+  /// Construct all the user actions for the (worker) thread.
+  virtual void Build() const;
+
+private:
+  BDSActionInitialization() = delete;
+
+  BDSOutput* output;                        ///< Not owned by this class.
+  BDSBunch*  bunch;                         ///< Bunch of the master. Not owned by this class.
+  const GMAD::Beam& beam;
+  const BDSParticleDefinition* designParticle;
+  const BDSDetectorConstruction* detector;
+  BDSOutputEventQueue* outputQueue;         ///< Optional writer of the workers' events. Not owned.
+  mutable std::vector<BDSBunch*> workerBunches; ///< Bunches of the worker threads (owned).
+};
+
+#endif
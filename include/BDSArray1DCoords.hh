@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+#include <memory>
 #include <ostream>
 
 class BDSExtent;
@@ -43,7 +44,9 @@ public:
   BDSArray1DCoords(G4int            nX,
                    G4double         xMinIn,
                    G4double         xMaxIn,
-                   BDSDimensionType dimensionIn = BDSDimensionType::x);
+                   BDSDimensionType dimensionIn = BDSDimensionType::x,
+                   BDSFieldValue*        externalData      = nullptr,
+                   std::shared_ptr<void> externalDataOwner = nullptr);
   virtual ~BDSArray1DCoords(){;}
   
   /// Extract 2 points lying around coordinate x.
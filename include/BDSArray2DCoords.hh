@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+#include <memory>
 #include <ostream>
 
 class BDSExtent;
@@ -45,7 +46,9 @@ public:
 		   G4double xMinIn, G4double xMaxIn,
 		   G4double yMinIn, G4double yMaxIn,
 		   BDSDimensionType xDimensionIn = BDSDimensionType::x,
-		   BDSDimensionType yDimensionIn = BDSDimensionType::y);
+		   BDSDimensionType yDimensionIn = BDSDimensionType::y,
+		   BDSFieldValue*        externalData      = nullptr,
+		   std::shared_ptr<void> externalDataOwner = nullptr);
   virtual ~BDSArray2DCoords(){;}
   
   /// Extract 2x2 points lying around coordinate x.
@@ -23,6 +23,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+#include <memory>
 #include <ostream>
 
 /**
@@ -47,7 +48,9 @@ public:
 		   G4double zMinIn, G4double zMaxIn,
 		   BDSDimensionType xDimensionIn = BDSDimensionType::x,
 		   BDSDimensionType yDimensionIn = BDSDimensionType::y,
-		   BDSDimensionType zDimensionIn = BDSDimensionType::z);
+		   BDSDimensionType zDimensionIn = BDSDimensionType::z,
+		   BDSFieldValue*        externalData      = nullptr,
+		   std::shared_ptr<void> externalDataOwner = nullptr);
   virtual ~BDSArray3DCoords(){;}
   
   /// Extract 2x2x2 points lying around coordinate x.
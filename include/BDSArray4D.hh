@@ -19,9 +19,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSARRAY4D_H
 #define BDSARRAY4D_H
 
+#include "BDSArrayStorageType.hh"
 #include "BDSFieldValue.hh"
 #include "BDSFourVector.hh"
+#include "BDSThreeVector.hh"
 
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -43,6 +47,21 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  * https://isocpp.org/wiki/faq/operator-overloading#matrix-subscript-op
  * 
  * The size cannot be changed after construction.
+ *
+ * Optionally, the data may be provided externally (e.g. a memory-mapped
+ * file) rather than being allocated and owned by this class. In this case
+ * an owner object is held (shared) that keeps the memory valid for the
+ * lifetime of this array and any copies of it.
+ *
+ * Once filled, the data may be converted to a reduced precision storage type
+ * (see BDSArrayStorageType) to reduce memory usage. The values are then converted
+ * back to BDSFieldValue on access and can no longer be set.
+ *
+ * The data may also be rearranged into bricks of 4x4x4 (x,y,z) values that are
+ * each contiguous in memory (bricks ordered x fastest, then y, z and t). A cubic
+ * interpolation then touches only a few bricks rather than 16 widely separated rows,
+ * which greatly reduces cache misses for large arrays. Each dimension is padded to a
+ * multiple of 4. The layout is internal and all access is by index as normal.
  * 
  * @author Laurie Nevay
  */
@@ -56,6 +75,17 @@ public:
   /// At construction the size of the array must be known as this implementation
   /// does not allow the size to be changed afterwards.
   BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn);
+  /// Use externally provided memory for the data. The memory must hold at least
+  /// nX*nY*nZ*nT values in the same order as this class. The owner is held for the
+  /// lifetime of this array and is responsible for releasing the memory - it may be
+  /// nullptr if the lifetime is guaranteed elsewhere. If externalData is nullptr,
+  /// the memory is allocated as normal.
+  BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+             BDSFieldValue*        externalData,
+             std::shared_ptr<void> externalDataOwner);
+  /// Copy constructor - data is copied if owned, but shared if external.
+  BDSArray4D(const BDSArray4D& other);
+  BDSArray4D& operator=(const BDSArray4D&) = delete;
   virtual ~BDSArray4D(){;}
 
   /// @{ Access the number of elements in a given dimension.
@@ -79,6 +109,9 @@ public:
   /// Accessor only as returns const reference to data. By being named
   /// this can be used explicitly to ensure const access - recommended main
   /// main interface.
+  /// Reduced precision data is converted on access into a value per thread, as the
+  /// array may be shared between threads. The reference is therefore only valid until
+  /// the next call on the same thread - copy the value to keep it.
   virtual const BDSFieldValue& GetConst(G4int x,
 					G4int y = 0,
 					G4int z = 0,
@@ -94,6 +127,53 @@ public:
   const BDSFieldValue& operator()(const BDSFourVector<G4int>& pos) const
   {return operator()(pos.x(), pos.y(), pos.z(), pos.t());}
 
+  /// Whether the data is held in externally provided memory rather than owned.
+  inline G4bool ExternalData() const {return data && ownedData.empty();}
+
+  /// Total number of field values held.
+  inline std::size_t Size() const {return (std::size_t)nX * nY * nZ * nT;}
+
+  /// Direct (const) access to the contiguous underlying data for writing out. nullptr if
+  /// the storage type isn't standard.
+  inline const BDSFieldValue* Data() const {return data;}
+
+  /// Convert the data to a different storage type. This can only be done once from the
+  /// standard type and any external memory is released. The values may not be set afterwards.
+  void ConvertStorage(BDSArrayStorageType storageTypeIn);
+
+  /// Accessor for how the data is stored.
+  inline BDSArrayStorageType StorageType() const {return storageType;}
+
+  /// Size in bytes of the stored data (excluding any external memory).
+  std::size_t MemoryUsage() const;
+
+  /// Rearrange the data into bricks. Must be done before any storage type conversion
+  /// and any external memory is released.
+  void ConvertToBricked();
+
+  /// Whether the data is stored in bricks.
+  inline G4bool Bricked() const {return bricked;}
+
+  /// Ratio of the number of values stored when bricked (with padding) to the number
+  /// of values in the array. Used to judge whether bricking is worthwhile.
+  G4double BrickedPaddingRatio() const;
+
+  /// Number of values in each dimension of a brick.
+  static const G4int brickSize = 4;
+
+  /// @{ Contribution of the index in each dimension to the position in Data() for the
+  /// current layout. The position of (x,y,z,t) is the sum of these. Allows interpolators
+  /// to compute the offsets of a stencil once per dimension and read the data directly.
+  inline std::size_t OffsetX(G4int x) const
+  {return bricked ? ((std::size_t)(x >> 2) << 6) + (x & 3) : (std::size_t)x;}
+  inline std::size_t OffsetY(G4int y) const
+  {return bricked ? ((std::size_t)(y >> 2)*nBX << 6) + ((y & 3) << 2) : (std::size_t)y*nX;}
+  inline std::size_t OffsetZ(G4int z) const
+  {return bricked ? ((std::size_t)(z >> 2)*nBY*nBX << 6) + ((z & 3) << 4) : (std::size_t)z*nY*nX;}
+  inline std::size_t OffsetT(G4int t) const
+  {return bricked ? ((std::size_t)t*nBZ*nBY*nBX << 6) : (std::size_t)t*nZ*nY*nX;}
+  /// @}
+
   /// Return whether the indices are valid and lie within the array boundaries or not.
   virtual G4bool Outside(G4int x,
 			 G4int y,
@@ -127,8 +207,42 @@ protected:
   BDSFieldValue defaultValue;
   
 private:
-  /// A 1D array representing all the data.
-  std::vector<BDSFieldValue> data;
+  /// Position in the stored data of a given set of (valid) indices for the current layout.
+  inline std::size_t StorageIndex(G4int x, G4int y, G4int z, G4int t) const
+  {return OffsetX(x) + OffsetY(y) + OffsetZ(z) + OffsetT(t);}
+
+  /// Number of values held in the storage including any padding for bricks.
+  std::size_t StoredSize() const;
+
+  /// @{ Layout of the data and number of bricks in each dimension.
+  G4bool bricked;
+  G4int  nBX;
+  G4int  nBY;
+  G4int  nBZ;
+  /// @}
+
+  /// Storage for the data when owned by this class. Empty if external memory is used.
+  std::vector<BDSFieldValue> ownedData;
+
+  /// Holder to keep any external memory valid. nullptr if the data is owned (or
+  /// if the lifetime of the external memory is guaranteed elsewhere).
+  std::shared_ptr<void> externalOwner;
+
+  /// Pointer to the start of the data - either ownedData or external memory. nullptr
+  /// if a reduced precision storage type is used.
+  BDSFieldValue* data;
+
+  /// How the data is stored.
+  BDSArrayStorageType storageType;
+
+  /// Single precision storage. Empty unless used.
+  std::vector<BDSThreeVector<G4float> > floatData;
+
+  /// 16-bit fixed point storage with 3 components for each value. Empty unless used.
+  std::vector<std::int16_t> fixedData;
+
+  /// Value of one unit in the fixed point storage.
+  FIELDTYPET fixedScale;
 };
 
 #endif
@@ -26,6 +26,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 
 #include <array>
+#include <memory>
 #include <ostream>
 
 class BDSExtent;
@@ -54,7 +55,8 @@ public:
   
   /// Constructor similar to BDSArray4D but with spatial limits in each dimension.
   /// The distance between the UNIFORMLY spaced data in spatial coordinates is
-  /// calculated using the extents and the number of entries.
+  /// calculated using the extents and the number of entries. Optionally, externally
+  /// provided memory may be used for the data - see BDSArray4D.
   BDSArray4DCoords(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
 		   G4double xMinIn, G4double xMaxIn,
 		   G4double yMinIn, G4double yMaxIn,
@@ -63,7 +65,9 @@ public:
                    BDSDimensionType xDimensionIn = BDSDimensionType::x,
                    BDSDimensionType yDimensionIn = BDSDimensionType::y,
                    BDSDimensionType zDimensionIn = BDSDimensionType::z,
-                   BDSDimensionType tDimensionIn = BDSDimensionType::t);
+                   BDSDimensionType tDimensionIn = BDSDimensionType::t,
+                   BDSFieldValue*        externalData      = nullptr,
+                   std::shared_ptr<void> externalDataOwner = nullptr);
 
   virtual ~BDSArray4DCoords(){;} 
 
@@ -0,0 +1,48 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSARRAYSTORAGETYPE_H
+#define BDSARRAYSTORAGETYPE_H
+
+#include "BDSTypeSafeEnum.hh"
+
+#include "G4String.hh"
+
+/**
+ * @brief Type definition for how field map array values are stored in memory.
+ *
+ * standard is the precision BDSIM is compiled with (BDSFieldValue). float32 is
+ * single precision and int16 is 16-bit fixed point scaled to the maximum absolute
+ * value in the array.
+ */
+
+struct arraystoragetypes_def
+{
+  enum type {standard, float32, int16};
+};
+
+typedef BDSTypeSafeEnum<arraystoragetypes_def,int> BDSArrayStorageType;
+
+namespace BDS
+{
+  /// Function to determine the enum type of the array storage type (case-insensitive).
+  /// An empty string gives the standard type.
+  BDSArrayStorageType DetermineArrayStorageType(G4String arrayStorageType);
+}
+
+#endif
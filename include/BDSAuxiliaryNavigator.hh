@@ -30,6 +30,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 class BDSStep;
 class G4Step;
 class G4VPhysicalVolume;
+class G4VSolid;
 
 /**
  * @brief Extra G4Navigator to get coordinate transforms.
@@ -57,6 +58,14 @@ class G4VPhysicalVolume;
  * use is one for the real world and one for the read out geometry / world
  * for curvilinear coordinates.  All functions have an optional last argument
  * to select which navigator is required - the default is the curvilinear one.
+ *
+ * Each instance (e.g. each integrator or global field wrapper, which typically belong
+ * to one beamline element) keeps the transforms of the last volume it found in each
+ * world. If a subsequent point is inside that volume (and the volume has no daughters)
+ * the navigator is not used. At element edges the navigator is used as normal.
+ *
+ * The navigators are per thread and are created on first use in each thread. The
+ * world volumes they navigate are shared as the geometry is.
  * 
  * @author Laurie Nevay
  */
@@ -68,16 +77,13 @@ public:
   ~BDSAuxiliaryNavigator();
 
   /// Setup the navigator w.r.t. to a world volume - typically real world.
-  static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
-  {auxNavigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn;}
+  static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn);
 
   /// Setup the navigator w.r.t. to the read out world / geometry to provide
   /// curvilinear coordinates.
-  static void AttachWorldVolumeToNavigatorCL(G4VPhysicalVolume* curvilinearWorldPVIn)
-  {auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn); curvilinearWorldPV = curvilinearWorldPVIn;}
+  static void AttachWorldVolumeToNavigatorCL(G4VPhysicalVolume* curvilinearWorldPVIn);
 
-  static void RegisterCurvilinearBridgeWorld(G4VPhysicalVolume* curvilinearBridgeWorldPVIn)
-  {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn); curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn;}
+  static void RegisterCurvilinearBridgeWorld(G4VPhysicalVolume* curvilinearBridgeWorldPVIn);
 
   static void ResetNavigatorStates();
 
@@ -223,22 +229,39 @@ protected:
   mutable G4AffineTransform globalToLocalCL;
   mutable G4AffineTransform localToGlobalCL;
   mutable G4bool            bridgeVolumeWasUsed;
+
+  /// Transforms and extent of the last volume found in one world.
+  struct VolumeCache
+  {
+    G4VPhysicalVolume* volume = nullptr;
+    const G4VSolid*    solid  = nullptr;
+    G4ThreeVector      extentMin;
+    G4ThreeVector      extentMax;
+    G4AffineTransform  globalToLocal;
+    G4AffineTransform  localToGlobal;
+  };
+  mutable VolumeCache cacheMass; ///< Last volume in the mass world.
+  mutable VolumeCache cacheCL;   ///< Last volume in the curvilinear world.
   
   /// Navigator object for safe navigation in the real (mass) world without
   /// affecting tracking of the particle.
-  static G4Navigator* auxNavigator;
+  static G4ThreadLocal G4Navigator* auxNavigator;
 
   /// Navigator object for curvilinear world that contains simple cylinders
   /// for each element whose local coordinates represent the curvilinear coordinate
   /// system.
-  static G4Navigator* auxNavigatorCL;
+  static G4ThreadLocal G4Navigator* auxNavigatorCL;
 
   /// Navigator object for bridge world. This contains bridging volumes for the
   /// gaps in the curvilinear world. It therefore acts as a fall back if we find
   /// the world volume when we know we really shouldn't.
-  static G4Navigator* auxNavigatorCLB;
+  static G4ThreadLocal G4Navigator* auxNavigatorCLB;
 
 private:
+  /// Create this thread's navigators if they don't exist and set the world volumes
+  /// that are already known.
+  static void InitialiseNavigators();
+
   /// Utility function to select appropriate navigator
   G4Navigator* Navigator(G4bool curvilinear) const;
 
@@ -265,10 +288,22 @@ private:
   void InitialiseTransform(const G4ThreeVector& globalPosition,
                            const G4ThreeVector& globalMomentum,
                            const G4double       stepLength);
+
+  /// If the point is strictly inside the cached volume, set the transforms of the
+  /// world from the cache and return true.
+  G4bool UseCache(const VolumeCache&   cache,
+                  const G4ThreeVector& globalPoint,
+                  G4bool               curvilinear) const;
+
+  /// Store the volume just found and the current transforms for the world. Volumes
+  /// with daughters are not cached.
+  void FillCache(VolumeCache&       cache,
+                 G4VPhysicalVolume* volume,
+                 G4bool             curvilinear) const;
   
   /// Counter to keep track of when the last instance of the class is deleted
   /// and therefore when the navigators can be safely deleted without affecting
-  static G4int numberOfInstances;
+  static G4ThreadLocal G4int numberOfInstances;
   
   /// @{ Cache of world PV to test if we're getting the wrong volume for the transform.
   static G4VPhysicalVolume* worldPV;
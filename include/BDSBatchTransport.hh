@@ -0,0 +1,142 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBATCHTRANSPORT_H
+#define BDSBATCHTRANSPORT_H
+
+#include "globals.hh" // geant4 types / globals
+
+#include <vector>
+
+class BDSBeamline;
+class BDSBeamlineElement;
+class BDSParticleDefinition;
+
+/**
+ * @brief Transport many particles at once through a beam line with linear
+ * and thin-lens element maps to find which ones approach an aperture.
+ *
+ * This is used to screen primaries before they are simulated. The coordinates
+ * are stored as a structure of arrays (Batch) so that each element is applied
+ * to all particles in a simple loop. Each particle that comes within the aperture
+ * margin of an aperture (of the beam pipe or a collimator) anywhere along the beam
+ * line is marked. These are the ones that should be simulated in Geant4.
+ *
+ * Drifts, quadrupoles, sextupoles, octupoles, decapoles, sector bends (without
+ * tilt), dipole fringes and rectangular, elliptical and jaw collimators are used.
+ * Any other element with a length (or a kicker with a finite kick) is treated as
+ * opaque and all particles that reach it are marked. Transport stops there.
+ * The teleporter and terminator of a circular machine are ignored.
+ *
+ * The aperture is checked at the ends of each element and each slice of long
+ * magnets. The margin should cover the error from the approximate maps.
+ */
+
+class BDSBatchTransport
+{
+public:
+  /// Particle coordinates in the curvilinear frame as a structure of arrays.
+  struct Batch
+  {
+    std::vector<G4double> x;
+    std::vector<G4double> xp;
+    std::vector<G4double> y;
+    std::vector<G4double> yp;
+    std::vector<G4double> qOverP;  ///< Charge over momentum relative to the design particle.
+    std::vector<char>     reachedAperture;
+
+    void Resize(std::size_t n);
+  };
+
+  BDSBatchTransport(const BDSBeamline*           beamline,
+		    const BDSParticleDefinition* designParticle,
+		    G4double                     apertureMarginIn);
+  ~BDSBatchTransport(){;}
+
+  /// Transport all particles of the batch through the beam line and set reachedAperture
+  /// for each one that comes within the margin of an aperture.
+  void Transport(Batch& batch) const;
+
+  /// Number of beam line elements that are transported before any opaque one.
+  inline G4int NElementsTransported() const {return nElementsTransported;}
+
+  /// Name of the first element that can't be transported. Empty if there isn't one.
+  inline const G4String& FirstOpaqueElementName() const {return firstOpaqueElementName;}
+
+private:
+  /// Private default constructor to force use of supplied constructor.
+  BDSBatchTransport() = delete;
+
+  enum class MapType {drift, quadrupole, multipole, sbend, fringe, opaque};
+  enum class ApertureType {none, circular, elliptical, rectangular, rectellipse, opaque};
+
+  /// All the information needed for one beam line element.
+  struct Element
+  {
+    MapType      map           = MapType::drift;
+    G4double     length        = 0;
+    G4int        nSlices       = 1;
+    G4double     rigidityScale = 1;  ///< Design rigidity of this element relative to the design particle.
+    G4double     k1            = 0;  ///< Quadrupole strength (also in a bend).
+    G4int        order         = 0;  ///< Order of a multipole (2 = sextupole).
+    G4double     kn            = 0;  ///< Multipole strength divided by order factorial.
+    G4double     h             = 0;  ///< Curvature of a bend or of the bend for a fringe.
+    G4double     tanE          = 0;  ///< tan(e) of the pole face of a fringe.
+    G4double     tanEPsi       = 0;  ///< tan(e - psi) of the pole face of a fringe.
+    G4bool       misaligned    = false;
+    G4double     dx            = 0;
+    G4double     dy            = 0;
+    G4double     cosTilt       = 1;
+    G4double     sinTilt       = 0;
+    ApertureType aperture      = ApertureType::none;
+    G4double     a1            = 0;  ///< Half widths or radius less the margin.
+    G4double     a2            = 0;
+    G4double     a3            = 0;
+    G4double     a4            = 0;
+  };
+
+  /// Prepare the map and aperture for one beam line element.
+  Element BuildElement(const BDSBeamlineElement* element,
+		       G4double                  designMomentum) const;
+
+  /// Set the aperture from the beam pipe of an element (or opaque if there isn't one).
+  void SetBeamPipeAperture(const BDSBeamlineElement* element,
+			   Element&                  e) const;
+
+  /// Apply the map of an element for a length to all particles.
+  void Advance(const Element& e,
+	       G4double       length,
+	       Batch&         batch) const;
+
+  /// Mark all particles outside the aperture of the element.
+  void CheckAperture(const Element& e,
+		     Batch&         batch) const;
+
+  /// Move into or out of a misaligned element's frame.
+  void Misalign(const Element& e,
+		Batch&         batch,
+		G4bool         toElement) const;
+
+  G4double apertureMargin;
+  G4double maximumSliceLength;
+  std::vector<Element> elements;
+  G4int    nElementsTransported;
+  G4String firstOpaqueElementName;
+};
+
+#endif
@@ -0,0 +1,88 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBESSELTABLE_H
+#define BDSBESSELTABLE_H
+
+#include "G4Types.hh"
+
+#include <vector>
+
+/**
+ * @brief Tabulated Bessel functions J0 and J1 over a bounded range.
+ *
+ * The values and derivatives of J0 and J1 are calculated once on a regular
+ * grid from 0 to xMax. Evaluation uses cubic Hermite interpolation between
+ * the nodes, which with the default number of points agrees with the exact
+ * functions to better than 1e-12. Arguments outside [0, xMax] are clamped.
+ */
+
+class BDSBesselTable
+{
+public:
+  BDSBesselTable() = delete;
+  explicit BDSBesselTable(G4double xMaxIn,
+			  G4int    nIntervalsIn = 1024);
+  ~BDSBesselTable(){;}
+
+  /// Evaluate J0(x) and J1(x) together.
+  inline void J0J1(G4double x,
+		   G4double& j0,
+		   G4double& j1) const;
+
+  inline G4double XMax() const {return xMax;}
+
+private:
+  G4double xMax;
+  G4int    nIntervals;
+  G4double h;    ///< Spacing between nodes.
+  G4double invH; ///< 1/h cached.
+
+  /// Per node: J0, h*J0', J1, h*J1' interleaved so one lookup touches one cache line.
+  std::vector<G4double> data;
+};
+
+inline void BDSBesselTable::J0J1(G4double x,
+				 G4double& j0,
+				 G4double& j1) const
+{
+  if (x < 0)
+    {x = 0;}
+  else if (x > xMax)
+    {x = xMax;}
+  G4double u = x * invH;
+  G4int i = (G4int)u;
+  if (i >= nIntervals)
+    {i = nIntervals - 1;}
+  G4double t = u - (G4double)i;
+
+  // cubic Hermite basis functions
+  G4double t2  = t*t;
+  G4double t3  = t2*t;
+  G4double h00 = 2*t3 - 3*t2 + 1;
+  G4double h10 = t3 - 2*t2 + t;
+  G4double h01 = -2*t3 + 3*t2;
+  G4double h11 = t3 - t2;
+
+  const G4double* a = &data[4*i];
+  const G4double* b = a + 4;
+  j0 = h00*a[0] + h10*a[1] + h01*b[0] + h11*b[1];
+  j1 = h00*a[2] + h10*a[3] + h01*b[2] + h11*b[3];
+}
+
+#endif
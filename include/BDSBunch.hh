@@ -108,6 +108,9 @@ public:
   /// Access whether there's a finite S offset and therefore we're using a CL transform.
   G4bool UseCurvilinearTransform() const {return useCurvilinear;}
 
+  /// Access whether the time of each event depends on its bunch index.
+  G4bool UseBunchTiming() const {return useBunchTiming;}
+
   /// When recreating events, it's possible that setting the seed state may not
   /// be sufficient for the bunch to get the right distribution. This is true when
   /// the bunch coordinates are based on an external source of data i.e. user bunch
@@ -54,6 +54,8 @@ public:
 
   inline G4double GetJawTiltLeft() const {return jawTiltLeft;}
   inline G4double GetJawTiltRight() const {return jawTiltRight;}
+  inline G4double XSizeLeft()  const {return xSizeLeft;}
+  inline G4double XSizeRight() const {return xSizeRight;}
 
 protected:
   /// Check and update parameters before construction. Called at the start of Build() as
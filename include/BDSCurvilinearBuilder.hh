@@ -21,6 +21,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh"
 
+#include <map>
+
 class BDSBeamline;
 class BDSCurvilinearFactory;
 class BDSSimpleComponent;
@@ -47,6 +49,14 @@ public:
   /// Build bridging volumes to join the curvilinear ones
   BDSBeamline* BuildCurvilinearBridgeBeamLine(BDSBeamline const* const beamline);
 
+  /// Find the element of a curvilinear beam line from BuildCurvilinearBeamLine1To1() made
+  /// for each element of the beam line it was built from. They are matched in order by S
+  /// position, so any extra sections at either end are skipped. Elements without one
+  /// aren't included.
+  static std::map<const BDSBeamlineElement*, const BDSBeamlineElement*>
+  MatchElements1To1(const BDSBeamline* beamline,
+		    const BDSBeamline* curvilinearBeamline);
+
 private:
   BDSCurvilinearBuilder(const BDSCurvilinearBuilder&) = delete;
   BDSCurvilinearBuilder& operator=(const BDSCurvilinearBuilder&) = delete;
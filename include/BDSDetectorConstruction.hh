@@ -213,6 +213,11 @@ private:
   /// Place beam line, tunnel beam line, end pieces and placements in world.
   void ComponentPlacement(G4VPhysicalVolume* worldPV);
 
+  /// Register the placements of each element of a placed mass world beam line with the
+  /// curvilinear frame of that element, so the s coordinate of a volume can be found from
+  /// a touchable without navigating the curvilinear world.
+  void RegisterCurvilinearFrames(const BDSBeamlineSet& beamlineSet) const;
+
   /// Detect whether the first element has an angled face such that it might overlap
   /// with a previous element.  Only used in case of a circular machine.
   G4bool UnsuitableFirstElement(std::list<GMAD::Element>::const_iterator element);
@@ -240,6 +245,18 @@ private:
   /// Construct scoring meshes.
   void ConstructScoringMeshes();
 
+  /// On a worker thread, replace the sensitive detectors attached on the master with this
+  /// thread's ones of the same name. Throws if there isn't one.
+  void AttachWorkerSensitiveDetectors();
+
+  /// Make a region of all the accelerator vacuum volumes without daughters that
+  /// aren't already in a user region for the fast vacuum transport model.
+  void BuildFastVacuumTransportRegion();
+
+  /// Attach the fast vacuum transport model to its region. As the fields are
+  /// per thread, this is done in ConstructSDandField.
+  void ConstructFastVacuumTransport(const std::vector<BDSFieldObjects*>& fields);
+
   /// Print out the sensitivity of every single volume so far constructed in the world.
   void VerboseSensitivity() const;
   /// Recursive function to print out each sensitive detector name.
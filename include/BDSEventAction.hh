@@ -28,12 +28,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <bitset>
 #include <ctime>
+#include <list>
 #include <map>
 #include <string>
 #include <vector>
 
+class BDSAuxiliaryNavigator;
 class BDSEventInfo;
 class BDSOutput;
+class BDSOutputEventQueue;
+class BDSOutputEventRecord;
 class BDSTrajectoriesToStore;
 class BDSTrajectory;
 class BDSTrajectoryPrimary;
@@ -64,6 +68,22 @@ public:
 
   /// Interface for tracking action to increment the number of  tracks in each event.
   void IncrementNTracks() {nTracks++;}
+
+  /// Evaluate the trajectory filters that can be decided when a track starts - i.e. primary,
+  /// secondary, energy threshold, particle and depth in the tree.
+  std::bitset<BDS::NTrajectoryFilters> TrajectoryStartFilters(G4bool          primary,
+                                                              G4double        kineticEnergy,
+                                                              const G4String& particleName,
+                                                              G4int           pdgID,
+                                                              G4int           depth) const;
+
+  /// Whether a track that matches these start filters could still be stored by its
+  /// own filters (including those only decided later on such as samplers) and
+  /// therefore requires a full trajectory.
+  G4bool TrajectoryMayBeStored(const std::bitset<BDS::NTrajectoryFilters>& startFilters) const;
+
+  /// Whether trajectories are connected back to the primary.
+  G4bool TrajectoryConnect() const {return trajConnect;}
   
   /// Append this trajectory to vector of primaries we keep to avoid sifting at the end of event.
   void RegisterPrimaryTrajectory(const BDSTrajectoryPrimary* trajectoryIn);
@@ -73,6 +93,18 @@ public:
   /// has already been constructed.
   inline void SetPrintModulo(G4int printModuloIn) {printModulo = printModuloIn;}
 
+  /// Hand events to this queue to be written by its writer thread rather than filling
+  /// the output directly. Used in a multi-threaded run.
+  inline void SetOutputQueue(BDSOutputEventQueue* outputQueueIn) {outputQueue = outputQueueIn;}
+
+  /// Release the events of any records that have been written and reuse the records.
+  /// Optionally wait until all the records of this thread have been written.
+  void ReleaseWrittenRecords(G4bool waitForAll = false);
+
+  /// Set the number added to the event index stored in the output, e.g. the index of the
+  /// first event of a job so the events of all jobs have unique indices when combined.
+  static void SetEventIndexOffset(G4int offsetIn) {eventIndexOffset = offsetIn;}
+
 protected:
   /// Sift through all trajectories (if any) and mark for storage.
   BDSTrajectoriesToStore* IdentifyTrajectoriesForStorage(const G4Event* evt,
@@ -82,6 +114,10 @@ protected:
 							 const std::vector<BDSHitsCollectionSampler*>& allSamplerHits,
 							 G4int nChar = 50) const;
 
+  /// Find the beam line index of the volume at each point that will be stored of each
+  /// trajectory to be stored. Done here rather than in the output as it needs the geometry.
+  void FillTrajectoryModelIndices(BDSTrajectoriesToStore* trajectories);
+
   /// Recursively (using this function) mark each parent trajectory as true - to be stored,
   /// and also flag the bitset for 'connect' as true.
   void ConnectTrajectory(std::map<BDSTrajectory*, bool>& interestingTraj,
@@ -96,6 +132,8 @@ private:
   G4bool storeTrajectory;    ///< Cache of whether to store trajectories or not.
   G4bool storeTrajectoryAll; ///< Store all trajectories irrespective of filters.
   G4bool storeTrajectorySecondary;
+  G4int  storeTrajectoryStepPoints;
+  G4bool storeTrajectoryStepPointLast;
   G4int  printModulo;
 
   G4int samplerCollID_plane;      ///< Collection ID for plane sampler hits.
@@ -103,6 +141,8 @@ private:
   G4int samplerCollID_sphere;     ///< Collection ID for spherical sampler hits.
   G4int eCounterID;               ///< Collection ID for general energy deposition hits.
   G4int eCounterFullID;           ///< Collection ID for general energy deposition full hits.
+  G4int eCounterBinnedID;         ///< Collection ID for binned general energy deposition (-1 if not used).
+  G4int eCounterFullBinnedID;     ///< Collection ID for binned general energy deposition full (-1 if not used).
   G4int eCounterVacuumID;         ///< Collection ID for the vacuum energy deposition hits.
   G4int eCounterTunnelID;         ///< Collection ID for the tunnel energy deposition hits.
   G4int eCounterWorldID;          ///< Collection ID for the world energy deposition hits.
@@ -158,6 +198,19 @@ private:
   /// leading to more than one temporary object per final one trajectory. Therefore
   /// we can't end up with degenerate ones here.
   std::map<G4int, const BDSTrajectoryPrimary*> primaryTrajectoriesCache;// Cache of primary trajectories as constructed
+
+  /// Get a record from the pool or a new one if none are free.
+  BDSOutputEventRecord* NextRecord();
+
+  /// Navigator for the model index of trajectory points. Made on first use as this
+  /// must be on the thread processing events once the geometry is built.
+  BDSAuxiliaryNavigator* auxNavigator;
+
+  BDSOutputEventQueue* outputQueue;                ///< Not owned. Only used in a multi-threaded run.
+
+  static G4int eventIndexOffset;
+  std::list<BDSOutputEventRecord*> recordsInFlight; ///< Published but not yet released (owned).
+  std::vector<BDSOutputEventRecord*> recordPool;    ///< Records ready for reuse (owned).
 };
 
 #endif
@@ -59,6 +59,8 @@ public:
   inline void SetPrimaryAbsorbedInCollimator(G4bool absorbed) {info->primaryAbsorbedInCollimator = absorbed;}
   inline void SetNTracks(long long int nTracks)         {info->nTracks = nTracks;}
   inline void SetBunchIndex(int bunchIndexIn)           {info->bunchIndex = bunchIndexIn;}
+  inline void SetNPrimariesScreened(long long int nIn)  {info->nPrimariesScreened = nIn;}
+  inline void SetEnergyKilled(G4double energyKilledIn)  {info->energyKilled = (double)energyKilledIn;}
   /// @}
 
   /// Accessor.
@@ -0,0 +1,111 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFASTVACUUMTRANSPORTMODEL_H
+#define BDSFASTVACUUMTRANSPORTMODEL_H
+
+#include "globals.hh" // geant4 types / globals
+#include "G4ThreeVector.hh"
+#include "G4VFastSimulationModel.hh"
+
+#include <map>
+#include <vector>
+
+class BDSFieldObjects;
+class G4FastStep;
+class G4FastTrack;
+class G4FieldManager;
+class G4ParticleDefinition;
+class G4Region;
+class G4Track;
+class G4VPhysicalVolume;
+class G4VSolid;
+
+/**
+ * @brief Transport paraxial primaries through a whole vacuum volume in one step.
+ *
+ * A Geant4 fast simulation model for a region made of the accelerator vacuum
+ * volumes. When a charged primary is in one of these volumes and is paraxial
+ * with respect to it, the model tracks it to the end of the volume using the
+ * BDSIM integrator of the field there, or a straight line if there is no field.
+ * The path is checked against the vacuum solid along the way. If the particle
+ * would leave through the side of the volume (i.e. hit the beam pipe), the model
+ * is not applied and Geant4 tracks the particle as usual.
+ *
+ * Only purely magnetic fields that are not modulated and use a BDSIM integrator
+ * are used. Any other field in a volume of the region means the model is not
+ * applied there.
+ */
+
+class BDSFastVacuumTransportModel: public G4VFastSimulationModel
+{
+public:
+  BDSFastVacuumTransportModel(const G4String& name,
+			      G4Region*       envelope,
+			      const std::vector<BDSFieldObjects*>& fields);
+  virtual ~BDSFastVacuumTransportModel(){;}
+
+  /// Whether a field can be used with this model.
+  static G4bool SuitableField(const BDSFieldObjects* field);
+
+  /// Only for charged particles.
+  virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+
+  /// Check the track is a paraxial primary and try to transport it to the end of
+  /// the volume. The result is kept for DoIt.
+  virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+
+  /// Move the primary to the end of the volume as calculated in ModelTrigger.
+  virtual void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+
+private:
+  /// Private default constructor to force use of supplied constructor.
+  BDSFastVacuumTransportModel() = delete;
+
+  /// Track the primary to the end of the envelope with the field in it. Returns
+  /// false if it would leave through the side or can't be tracked with this model.
+  G4bool Propagate(const G4FastTrack& fastTrack);
+
+  /// Whether a point on the surface of the solid is on an end face rather than the side.
+  static G4bool OnEndFace(const G4VSolid* solid, const G4ThreeVector& localPoint);
+
+  /// Field objects of each suitable field manager for this thread.
+  std::map<const G4FieldManager*, const BDSFieldObjects*> fieldObjects;
+
+  /// Whether there is a global field that applies to volumes without a field manager.
+  G4bool globalField;
+
+  G4double paraxialLimit;  ///< Cache of backup stepper momentum limit.
+  G4double minimumStep;    ///< Shortest step before the model gives up.
+  G4int    maximumNSteps;  ///< Most integrator steps to use in one volume.
+
+  /// @{ Result of the last successful Propagate in global coordinates.
+  G4ThreeVector finalPosition;
+  G4ThreeVector finalMomentumDirection;
+  G4double      pathLength;
+  /// @}
+
+  /// @{ The last track and volume the model wasn't applied to. As the model
+  /// is asked again at every step in the volume, this avoids repeating it.
+  const G4Track*           rejectedTrack;
+  G4int                    rejectedTrackID;
+  const G4VPhysicalVolume* rejectedVolume;
+  /// @}
+};
+
+#endif
@@ -76,12 +76,19 @@ public:
                                     const BDSMagnetStrength* magnetStrengthForScaling = nullptr,
 				    const G4String&          scalingKey               = "none");
 
+  /// Build all registered fields and attach them to their volumes. Fields with an
+  /// equivalent info (see BDSFieldInfo::IsEquivalent) share one set of field objects
+  /// (field, equation of motion, integrator, chord finder and field manager). Only
+  /// the unique ones are returned.
   std::vector<BDSFieldObjects*> CreateAndAttachAll();
 
 private:
   /// Private default constructor to enforce singleton pattern.
   BDSFieldBuilder();
 
+  /// Whether the field objects for this info may be shared with other identical infos.
+  static G4bool CanShare(const BDSFieldInfo* info);
+
   /// Singleton instance.
   static BDSFieldBuilder* instance;
   
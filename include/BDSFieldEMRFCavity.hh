@@ -26,12 +26,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <utility>
 
+class BDSBesselTable;
 class BDSCavityInfo;
 class BDSMagnetStrength;
 
 /**
  * @brief Pill box cavity electromagnetic field.
  *
+ * The Bessel functions are evaluated with TMath by default or optionally from a
+ * table shared by all instances (tabulatedBessel), which is much faster and agrees
+ * to better than 1e-12.
+ *
  * @author Stuart Walker
  */
 
@@ -39,13 +44,15 @@ class BDSFieldEMRFCavity: public BDSFieldEM
 {
 public:
   BDSFieldEMRFCavity() = delete;
-  explicit BDSFieldEMRFCavity(BDSMagnetStrength const* strength);
+  explicit BDSFieldEMRFCavity(BDSMagnetStrength const* strength,
+                              G4bool tabulatedBessel = false);
   
   BDSFieldEMRFCavity(G4double eFieldAmplitude,
                      G4double frequency,
                      G4double phaseOffset,
                      G4double cavityRadius,
-                     G4double synchronousTIn);
+                     G4double synchronousTIn,
+                     G4bool   tabulatedBessel = false);
   
   virtual ~BDSFieldEMRFCavity(){;}
 
@@ -62,6 +69,9 @@ public:
                                     G4double beta);
   
 private:
+  /// Table of J0 and J1 from 0 to j0FirstZero shared by all instances.
+  static const BDSBesselTable* BesselTable();
+
   G4double eFieldMax;    ///< Maximum field in V/m.
   G4double phase;        ///< Phase offset of the oscillator.
   G4double cavityRadius; ///< Radius at maximum extent of cavity.
@@ -71,6 +81,7 @@ private:
   static const G4double Z0; ///< Impedance of free space.
   const G4double normalisedCavityRadius; ///< Pre-calculated normalised calculated radius w.r.t. bessel first 0.
   const G4double angularFrequency; ///< Angular frequency calculated from frequency - cached to avoid repeated calculation.
+  const BDSBesselTable* besselTable; ///< Optional table to use instead of TMath. Not owned.
 };
 
 #endif
@@ -34,6 +34,7 @@ namespace GMAD
   class Modulator;
 }
 
+class BDSArray2DCoords;
 class BDSFieldE;
 class BDSFieldInfo;
 class BDSFieldMag;
@@ -161,6 +162,11 @@ private:
   
   /// Return the parameter "outerScaling" from strength st, but default to 1
   G4double GetOuterScaling(const BDSMagnetStrength* st) const;
+
+  /// Wrap a yoke field in a BDSFieldMagMultipoleOuterGridded using a grid that is
+  /// shared between all yoke fields with the same parameters. Takes ownership of field.
+  BDSFieldMag* CreateYokeFieldInterpolated(const BDSFieldInfo& info,
+                                           BDSFieldMag*        field);
   
   /// Create the necessary modulator.
   BDSModulator* CreateModulator(const BDSModulatorInfo* modulatorRecipe,
@@ -193,11 +199,14 @@ private:
   std::map<G4String, BDSFieldInfo*> parserDefinitions;
   std::map<G4String, BDSModulatorInfo*> parserModulatorDefinitions;
 
+  /// Sampled yoke field grids keyed by the parameters of the yoke field. Owned by this class.
+  std::map<G4String, BDSArray2DCoords*> yokeFieldGrids;
+
   /// Cache of design particle for fields.
   static const BDSParticleDefinition* designParticle;
 
-  /// Cache of primary generator action.
-  static BDSPrimaryGeneratorAction* primaryGeneratorAction;
+  /// Cache of primary generator action of this thread.
+  static G4ThreadLocal BDSPrimaryGeneratorAction* primaryGeneratorAction;
   
   G4bool useOldMultipoleOuterFields;
 };
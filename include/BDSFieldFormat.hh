@@ -34,7 +34,8 @@ struct fieldformats_def
     {
       none,
       bdsim1d, bdsim2d, bdsim3d, bdsim4d,
-      poisson2d, poisson2dquad, poisson2ddipole
+      poisson2d, poisson2dquad, poisson2ddipole,
+      bdsim1dbin, bdsim2dbin, bdsim3dbin, bdsim4dbin
     };
 };
 
@@ -47,6 +48,9 @@ namespace BDS
 
   /// Report the number of dimensions for that format.
   G4int NDimensionsOfFieldFormat(const BDSFieldFormat& ff);
+
+  /// Whether the format is one of the BDSIM binary formats.
+  G4bool FieldFormatIsBinary(const BDSFieldFormat& ff);
 }
 
 #endif
@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDINFO_H
 
 #include "BDSArrayReflectionType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSFieldFormat.hh"
 #include "BDSFieldType.hh"
 #include "BDSIntegratorType.hh"
@@ -29,6 +30,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Transform3D.hh"
 #include "G4ThreeVector.hh"
 
+#include <cstddef>
 #include <ostream>
 
 class BDSMagnetStrength;
@@ -126,9 +128,12 @@ public:
   inline G4bool              UsePlacementWorldTransform() const {return usePlacementWorldTransform;}
   inline const BDSArrayReflectionTypeSet& MagneticArrayReflectionType() const {return magneticArrayReflectionTypeSet;}
   inline const BDSArrayReflectionTypeSet& ElectricArrayReflectionType() const {return electricArrayReflectionTypeSet;}
+  inline BDSArrayStorageType MagneticArrayStorageType() const {return magneticArrayStorageType;}
+  inline BDSArrayStorageType ElectricArrayStorageType() const {return electricArrayStorageType;}
   inline BDSModulatorInfo*   ModulatorInfo()            const {return modulatorInfo;}
   inline G4bool IgnoreUpdateOfMaximumStepSize() const {return ignoreUpdateOfMaximumStepSize;}
   inline G4bool              IsThin()                   const {return isThin;}
+  inline G4double            YokeExtent()               const {return yokeExtent;}
   /// @}
 
   G4double SynchronousT() const;
@@ -144,6 +149,8 @@ public:
   inline void SetMagneticInterpolatorType(BDSInterpolatorType typeIn) {magneticInterpolatorType = typeIn;}
   inline void SetMagneticArrayReflectionType(const BDSArrayReflectionTypeSet& typeIn) {magneticArrayReflectionTypeSet = typeIn;}
   inline void SetElectricArrayReflectionType(const BDSArrayReflectionTypeSet& typeIn) {electricArrayReflectionTypeSet = typeIn;}
+  inline void SetMagneticArrayStorageType(BDSArrayStorageType typeIn) {magneticArrayStorageType = typeIn;}
+  inline void SetElectricArrayStorageType(BDSArrayStorageType typeIn) {electricArrayStorageType = typeIn;}
   inline void SetBScaling(G4double bScalingIn) {bScaling  = bScalingIn;}
   inline void SetAutoScale(G4bool autoScaleIn) {autoScale = autoScaleIn;}
   inline void SetScalingRadius(G4double poleTipRadiusIn) {poleTipRadius = poleTipRadiusIn;}
@@ -155,6 +162,7 @@ public:
   inline void SetUsePlacementWorldTransform(G4bool use) {usePlacementWorldTransform = use;}
   inline void SetModulatorInfo(BDSModulatorInfo* modulatorInfoIn) {modulatorInfo = modulatorInfoIn;}
   inline void SetIgnoreUpdateOfMaximumStepSize(G4bool ignoreUpdateOfMaximumStepSizeIn) {ignoreUpdateOfMaximumStepSize = ignoreUpdateOfMaximumStepSizeIn;}
+  inline void SetYokeExtent(G4double yokeExtentIn) {yokeExtent = yokeExtentIn;}
 
   /// *= for BScaling.
   inline void CompoundBScaling(G4double extraBScalingIn) {bScaling *= extraBScalingIn;}
@@ -181,6 +189,14 @@ public:
   /// Turn on or off transform caching.
   inline void CacheTransforms(G4bool cacheTransformsIn) {cacheTransforms = cacheTransformsIn;}
 
+  /// Hash of every parameter that affects the field and integrator built from this
+  /// info. The name, user limits and scaling strength (for autoscaling) are not included.
+  std::size_t Hash() const;
+
+  /// Whether the field and integrator built from this info would be identical to that
+  /// built from another. The name and user limits may differ.
+  G4bool IsEquivalent(const BDSFieldInfo& other) const;
+
   /// output stream
   friend std::ostream& operator<< (std::ostream &out, BDSFieldInfo const &info);
 
@@ -200,10 +216,12 @@ private:
   BDSFieldFormat           magneticFieldFormat;
   BDSInterpolatorType      magneticInterpolatorType;
   BDSArrayReflectionTypeSet magneticArrayReflectionTypeSet;
+  BDSArrayStorageType      magneticArrayStorageType;
   G4String                 electricFieldFilePath;
   BDSFieldFormat           electricFieldFormat;
   BDSInterpolatorType      electricInterpolatorType;
   BDSArrayReflectionTypeSet electricArrayReflectionTypeSet;
+  BDSArrayStorageType      electricArrayStorageType;
   G4bool                   cacheTransforms;
   G4double                 eScaling;
   G4double                 bScaling;
@@ -221,6 +239,7 @@ private:
   BDSModulatorInfo*        modulatorInfo;
   G4bool                   ignoreUpdateOfMaximumStepSize; ///< To be used when enforcing a larger maximum step size value.
   G4bool                   isThin;
+  G4double                 yokeExtent; ///< Largest transverse extent of the magnet a yoke field is for (0 if unknown).
 
   /// Transform from curvilinear frame to this field - ie beam line bit only.
   G4Transform3D*           transformBeamline;
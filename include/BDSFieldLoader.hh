@@ -20,11 +20,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDLOADER_H
 
 #include "BDSArrayReflectionType.hh"
+#include "BDSArrayStorageType.hh"
+#include "BDSFieldFormat.hh"
 #include "BDSInterpolatorType.hh"
 #include "G4String.hh"
 #include "G4Transform3D.hh"
 
 #include <array>
+#include <cstddef>
 #include <set>
 
 class BDSArray1DCoords;
@@ -92,19 +95,46 @@ private:
   static void EFilePathOK(const BDSFieldInfo& info);
   /// @}
 
+  /// Throw an exception if a binary format is specified but the file isn't one.
+  static void BinaryFileOK(const G4String& filePath, const BDSFieldFormat& format);
+
   /// @{ Return the cached array if there is one - may return nullptr.
-  BDSArray1DCoords* Get1DCached(const G4String& filePath);
-  BDSArray2DCoords* Get2DCached(const G4String& filePath);
-  BDSArray3DCoords* Get3DCached(const G4String& filePath);
-  BDSArray4DCoords* Get4DCached(const G4String& filePath);
+  BDSArray1DCoords* Get1DCached(const G4String& key);
+  BDSArray2DCoords* Get2DCached(const G4String& key);
+  BDSArray3DCoords* Get3DCached(const G4String& key);
+  BDSArray4DCoords* Get4DCached(const G4String& key);
   /// @}
 
-  /// @{ Utility function to use the right templated loader class (gz or normal).
-  BDSArray2DCoords* LoadPoissonMag2D(const G4String& filePath);
-  BDSArray1DCoords* LoadBDSIM1D(const G4String& filePath);
-  BDSArray2DCoords* LoadBDSIM2D(const G4String& filePath);
-  BDSArray3DCoords* LoadBDSIM3D(const G4String& filePath);
-  BDSArray4DCoords* LoadBDSIM4D(const G4String& filePath);
+  /// Load an array from file or, if the fieldMapSharedMemory option is on, use
+  /// BDSFieldLoaderSharedMemory to attach to or publish the array in shared memory.
+  /// The array is then converted to the requested storage type.
+  BDSArray4DCoords* LoadArray(const G4String&     filePath,
+                              G4int               nDimensions,
+                              BDSArrayStorageType storage,
+                              G4bool              poisson = false) const;
+
+  /// Use the binary loader if the file is in the BDSIM binary format or the
+  /// BDSIM (or Poisson) format loader otherwise.
+  static BDSArray4DCoords* LoadArrayFromFile(const G4String& filePath,
+                                             G4int           nDimensions,
+                                             G4bool          poisson);
+
+  /// Use the templated loader class for the stream type (gz or normal).
+  template <class T>
+  static BDSArray4DCoords* LoadArrayFromStream(const G4String& filePath,
+                                               G4int           nDimensions,
+                                               G4bool          poisson);
+
+  /// Key for the cache of arrays as the same file may be stored in different ways.
+  static G4String CacheKey(const G4String& filePath,
+                           BDSArrayStorageType storage);
+
+  /// @{ Load an array of each type, reusing a cached one if available.
+  BDSArray2DCoords* LoadPoissonMag2D(const G4String& filePath, BDSArrayStorageType storage);
+  BDSArray1DCoords* LoadBDSIM1D(const G4String& filePath, BDSArrayStorageType storage);
+  BDSArray2DCoords* LoadBDSIM2D(const G4String& filePath, BDSArrayStorageType storage);
+  BDSArray3DCoords* LoadBDSIM3D(const G4String& filePath, BDSArrayStorageType storage);
+  BDSArray4DCoords* LoadBDSIM4D(const G4String& filePath, BDSArrayStorageType storage);
   /// @}
 
   /// Create the appropriate array operators (index and value) and assign to the pointers
@@ -150,40 +180,49 @@ private:
   BDSInterpolator4D* CreateInterpolator4D(BDSArray4DCoords*   array,
   					  BDSInterpolatorType interpolatorType) const;
 
+  /// Whether a cubic interpolation coefficient table of this size in bytes is within
+  /// the limit of the option fieldMapCubicTableMaxSize. Warns if not.
+  G4bool CubicTableFits(std::size_t tableSize) const;
+
   /// Load a 1D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM1DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-					const BDSArrayReflectionTypeSet* reflection = nullptr);
+					const BDSArrayReflectionTypeSet* reflection = nullptr,
+					BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 2D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM2DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 3D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM3DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 4D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM4DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 2D poisson superfish B field map.
   BDSFieldMagInterpolated* LoadPoissonSuperFishB(const G4String&      filePath,
 						 BDSInterpolatorType  interpolatorType,
 						 const G4Transform3D& transform,
 						 G4double             bScaling,
-                                                 const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                 const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                 BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Similar to LoadPoissonSuperFishB() but the data below y = x is reflected
   /// and the data relfected from one quadrant to all four at the array level.
@@ -191,7 +230,8 @@ private:
 						     BDSInterpolatorType  interpolatorType,
 						     const G4Transform3D& transform,
 						     G4double             bScaling,
-                                                     const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                     const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                     BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Similar to LoadPoissonSuperFishB() but with appropriate reflections for
   /// a map for the positive quadrant reflected to all quadrants.
@@ -199,35 +239,40 @@ private:
 						       BDSInterpolatorType  interpolatorType,
 						       const G4Transform3D& transform,
 						       G4double             bScaling,
-                                                       const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                       const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                       BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 1D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM1DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 2D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM2DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSArrayStorageType              storage = BDSArrayStorageType::standard);
   
   /// Load a 3D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM3DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSArrayStorageType              storage = BDSArrayStorageType::standard);
 
   /// Load a 4D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM4DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSArrayStorageType              storage = BDSArrayStorageType::standard);
 
   /// Load a 1D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM1DEM(const G4String&      eFilePath,
@@ -238,7 +283,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSArrayStorageType              eStorage = BDSArrayStorageType::standard,
+                                        BDSArrayStorageType              bStorage = BDSArrayStorageType::standard);
 
   /// Load a 2D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM2DEM(const G4String&      eFilePath,
@@ -249,7 +296,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSArrayStorageType              eStorage = BDSArrayStorageType::standard,
+                                        BDSArrayStorageType              bStorage = BDSArrayStorageType::standard);
   
   /// Load a 3D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM3DEM(const G4String&      eFilePath,
@@ -260,7 +309,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSArrayStorageType              eStorage = BDSArrayStorageType::standard,
+                                        BDSArrayStorageType              bStorage = BDSArrayStorageType::standard);
 
   /// Load a 4D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM4DEM(const G4String&      eFilePath,
@@ -271,7 +322,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSArrayStorageType              eStorage = BDSArrayStorageType::standard,
+                                        BDSArrayStorageType              bStorage = BDSArrayStorageType::standard);
 
   /// @{ Map of cached field map array.
   std::map<G4String, BDSArray1DCoords*> arrays1d;
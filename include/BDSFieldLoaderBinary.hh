@@ -0,0 +1,118 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDLOADERBINARY_H
+#define BDSFIELDLOADERBINARY_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+class BDSArray1DCoords;
+class BDSArray2DCoords;
+class BDSArray3DCoords;
+class BDSArray4DCoords;
+
+/**
+ * @brief Loader and writer for BDSIM binary format field maps.
+ *
+ * The binary format is a fixed size header followed by the raw array of
+ * field values in the same order as BDSArray4D (x varies fastest). The
+ * spatial coordinates in the header are stored in Geant4 units (mm, ns)
+ * and the field values without units exactly as in the equivalent ASCII
+ * file, so the same scaling is applied afterwards.
+ *
+ * If the precision of the stored values matches that of BDSFieldValue,
+ * the file is memory-mapped and the array uses the mapped memory directly
+ * without any parsing or copying. Otherwise, the values are read and converted.
+ *
+ * Files are written with the bdsfieldconvert utility.
+ */
+
+class BDSFieldLoaderBinary
+{
+public:
+  BDSFieldLoaderBinary();
+  ~BDSFieldLoaderBinary();
+
+  BDSArray4DCoords* Load4D(const G4String& fileName); ///< Load a 4D array.
+  BDSArray3DCoords* Load3D(const G4String& fileName); ///< Load a 3D array.
+  BDSArray2DCoords* Load2D(const G4String& fileName); ///< Load a 2D array.
+  BDSArray1DCoords* Load1D(const G4String& fileName); ///< Load a 1D array.
+
+  /// General loader for any number of dimensions.
+  BDSArray4DCoords* Load(const G4String& fileName,
+                         G4int           nDimensions) const;
+
+  /// Whether the file starts with the binary format identifier. Does not throw.
+  static G4bool IsBinaryFile(const G4String& fileName);
+
+  /// Load an array from an already open file descriptor that may be a regular file or a
+  /// shared memory object. The memory is always mapped read only. If readOnly, it is also
+  /// mapped shared so it may be used by other processes. The descriptor may be closed afterwards. The name is only
+  /// used for feedback.
+  BDSArray4DCoords* LoadFromDescriptor(int             fileDescriptor,
+                                       const G4String& name,
+                                       G4int           nDimensions,
+                                       G4bool          readOnly) const;
+
+  /// Write an array to file in the binary format. nDimensions is the number of
+  /// dimensions the array represents (1-4).
+  static void Write(const BDSArray4DCoords* array,
+                    G4int                   nDimensions,
+                    const G4String&         fileName);
+
+  /// Size in bytes of the binary representation of an array including the header.
+  static std::size_t SizeInBytes(const BDSArray4DCoords* array);
+
+  /// Write the binary representation of an array into a buffer in memory that must
+  /// be at least SizeInBytes() long. The header is written last.
+  static void Serialise(const BDSArray4DCoords* array,
+                        G4int                   nDimensions,
+                        char*                   buffer);
+
+  /// Fixed size header at the start of each file.
+  struct Header
+  {
+    char          identifier[8];
+    std::uint32_t version;
+    std::uint32_t endianCheck;
+    std::uint32_t nDimensions;
+    std::uint32_t componentSize; ///< Size in bytes of one component of a field value.
+    std::int32_t  n[4];          ///< Number of points in each array dimension.
+    std::int32_t  dimensions[4]; ///< BDSDimensionType of each array dimension.
+    double        min[4];
+    double        max[4];
+    std::uint64_t nValues;
+    std::uint64_t dataOffset;    ///< Offset in bytes of the data from the start of the file.
+  };
+
+private:
+  /// Prepare the header for an array. Throws if invalid.
+  static Header MakeHeader(const BDSArray4DCoords* array,
+                           G4int                   nDimensions);
+
+  /// Read and check the header of an open file. Throws if invalid.
+  static void ReadHeader(int             fileDescriptor,
+                         const G4String& fileName,
+                         Header&         header);
+};
+
+#endif
@@ -0,0 +1,82 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDLOADERSHAREDMEMORY_H
+#define BDSFIELDLOADERSHAREDMEMORY_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstdint>
+#include <functional>
+
+class BDSArray4DCoords;
+
+/**
+ * @brief Share loaded field map arrays between processes on the same machine.
+ *
+ * Each loaded array is stored in a POSIX shared memory object in the BDSIM binary
+ * field map format (see BDSFieldLoaderBinary). The object is named from a hash of
+ * the canonical file path, the file contents, the number of dimensions and the
+ * precision of BDSFieldValue, so a modified file will never match an older object.
+ *
+ * The first process to request a map creates the object and holds an exclusive lock
+ * on it while it loads the file with the supplied function. Other processes wait for
+ * this lock, then map the same memory read only. If anything about the shared memory
+ * fails, the map is loaded privately as normal with a warning.
+ *
+ * Shared memory objects persist after the processes finish so that subsequent jobs
+ * can also reuse them. They can be removed at any time (e.g. /dev/shm/bdsimfm-*)
+ * without affecting processes that are already attached.
+ */
+
+class BDSFieldLoaderSharedMemory
+{
+public:
+  typedef std::function<BDSArray4DCoords*()> LoadFunction;
+
+  /// Return the array for the file either attached from shared memory or loaded
+  /// with loadFunction and then published in shared memory.
+  static BDSArray4DCoords* Load(const G4String& filePath,
+                                G4int           nDimensions,
+                                const LoadFunction& loadFunction);
+
+  /// Name of the shared memory object for a given file and number of dimensions.
+  static G4String ObjectName(const G4String& filePath,
+                             G4int           nDimensions);
+
+private:
+  /// Private default constructor as only static methods.
+  BDSFieldLoaderSharedMemory() = delete;
+
+  /// FNV-1a hash of a file's contents. Throws if the file can't be read.
+  static std::uint64_t ContentHash(const G4String& filePath);
+
+  /// Create and fill the shared memory object. Returns false if any system call fails.
+  /// The array is not deleted.
+  static G4bool Publish(int                     fileDescriptor,
+                        const BDSArray4DCoords* array,
+                        G4int                   nDimensions);
+
+  /// Attach to an existing, complete shared memory object. Returns nullptr if it
+  /// isn't ready or is invalid.
+  static BDSArray4DCoords* Attach(const G4String& objectName,
+                                  G4int           nDimensions);
+};
+
+#endif
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Transform3D.hh"
 
 class BDSModulator;
+class BDSMultipolePolynomial;
 
 /**
  * @brief Interface for static magnetic fields that may or may not be local.
@@ -54,6 +55,11 @@ public:
   /// Each derived class should override this if needs be. Used to warn about
   /// time modulation with a time-varying field.
   virtual G4bool TimeVarying() const {return false;}
+
+  /// If the (local) field is a pure 2D multipole field that can be expressed as
+  /// By + iBx = P(x + iy), set the polynomial and return true. This allows the field to be
+  /// evaluated or manipulated (e.g. rotated) more efficiently. Default is false.
+  virtual G4bool TransversePolynomial(BDSMultipolePolynomial& /*polynomial*/) const {return false;}
   
   /// Implement interface to this class's GetField to fulfill G4MagneticField
   /// inheritance and allow a BDSFieldMag instance to be passed around in the field
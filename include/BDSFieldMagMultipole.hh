@@ -20,10 +20,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDMAGMULTIPOLE_H
 
 #include "BDSFieldMag.hh"
+#include "BDSMultipolePolynomial.hh"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4ThreeVector.hh"
 
+#include <cstddef>
 #include <vector>
 
 class BDSMagnetStrength;
@@ -48,6 +50,17 @@ public:
   virtual G4ThreeVector GetField(const G4ThreeVector &position,
 				 const G4double       t = 0) const;
 
+  /// Batch access to the transverse field (Bz is always 0) for nPoints points at once.
+  /// The results are identical to GetField but this is more efficient for many points.
+  void GetFieldBatch(std::size_t     nPoints,
+                     const G4double* x,
+                     const G4double* y,
+                     G4double*       bx,
+                     G4double*       by) const;
+
+  /// The field as a polynomial in the complex transverse position.
+  virtual G4bool TransversePolynomial(BDSMultipolePolynomial& polynomial) const;
+
 private:
   /// Private default constructor to force use of supplied constructor.
   BDSFieldMagMultipole();
@@ -65,6 +78,9 @@ private:
 
   /// Skew field components = kns * brho
   std::vector<G4double> skewComponents;
+
+  /// Combined normal and skew components as a polynomial in x + iy.
+  BDSMultipolePolynomial polynomial;
 };
 
 #endif 
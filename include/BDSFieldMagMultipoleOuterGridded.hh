@@ -0,0 +1,79 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDMAGMULTIPOLEOUTERGRIDDED_H
+#define BDSFIELDMAGMULTIPOLEOUTERGRIDDED_H
+
+#include "BDSFieldMag.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include <atomic>
+
+class BDSArray2DCoords;
+class BDSInterpolator2D;
+
+/**
+ * @brief A transverse yoke field served from a precomputed 2D grid.
+ *
+ * The yoke field parameterisations (BDSFieldMagMultipoleOuter and variants) sum
+ * the contribution of every infinite wire current source for each query. This
+ * class instead linearly interpolates a grid of the same field sampled once with
+ * SampleField(). Outside the grid the analytical field is used and a warning is
+ * printed the first time this happens for each field.
+ *
+ * Owns the analytical field. Does not own the grid so that it can be shared
+ * between identical magnets.
+ */
+
+class BDSFieldMagMultipoleOuterGridded: public BDSFieldMag
+{
+public:
+  BDSFieldMagMultipoleOuterGridded() = delete;
+  BDSFieldMagMultipoleOuterGridded(BDSFieldMag*      analyticalFieldIn,
+				   BDSArray2DCoords* gridIn);
+  virtual ~BDSFieldMagMultipoleOuterGridded();
+
+  /// Access the field value. Only x and y are used.
+  virtual G4ThreeVector GetField(const G4ThreeVector& position,
+				 const G4double       t = 0) const;
+
+  /// Sample the (local) field on a square grid of nPoints x nPoints centred on
+  /// the origin with a full width of 2*halfWidth. Returned array is owned by the caller.
+  static BDSArray2DCoords* SampleField(const BDSFieldMag* field,
+				       G4double           halfWidth,
+				       G4int              nPoints);
+
+private:
+  BDSFieldMag*       analyticalField; ///< Field used outside the grid.
+  BDSInterpolator2D* interpolator;    ///< Interpolator on the shared grid.
+
+  /// Whether the use of the analytical field outside the grid has been reported.
+  /// Atomic as the field may be shared between threads.
+  mutable std::atomic<G4bool> warnedOutside;
+
+  /// @{ Limits of the grid to decide whether to interpolate.
+  G4double xMin;
+  G4double xMax;
+  G4double yMin;
+  G4double yMax;
+  /// @}
+};
+
+#endif
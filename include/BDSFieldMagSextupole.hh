@@ -44,6 +44,9 @@ public:
   /// Access the field value.
   virtual G4ThreeVector GetField(const G4ThreeVector &position,
 				 const G4double       t = 0) const;
+
+  /// The field as a polynomial in the complex transverse position.
+  virtual G4bool TransversePolynomial(BDSMultipolePolynomial& polynomial) const;
   
 private:
   /// Private default constructor to avoid usage.
@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDSKEW_H
 
 #include "BDSFieldMag.hh"
+#include "BDSMultipolePolynomial.hh"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4RotationMatrix.hh"
@@ -33,6 +34,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  * This is intended to implement skew fields but any arbritary rotation can
  * be applied, although this should be considered carefully.
  * 
+ * If the wrapped field is a pure multipole field (see BDSFieldMag::TransversePolynomial),
+ * the rotation is applied to its polynomial coefficients once at construction and the
+ * field is evaluated directly without any rotation of the coordinates or field vector.
+ *
  * This class does not own the field it wraps.
  *
  * @author Laurie Nevay
@@ -49,6 +54,9 @@ public:
   /// Get the field - local coordinates, and rotated.
   virtual G4ThreeVector GetField(const G4ThreeVector &position,
 				 const G4double       t = 0) const;
+
+  /// The rotated polynomial if the wrapped field has one.
+  virtual G4bool TransversePolynomial(BDSMultipolePolynomial& polynomialOut) const;
   
 private:
   /// Private default constructor to force use of supplied ones.
@@ -63,6 +71,12 @@ private:
 
   /// The opposite rotation matrix used to transform the resultant field vector.
   G4RotationMatrix* antiRotation;
+
+  /// Whether the rotated polynomial is used rather than the wrapped field.
+  G4bool usePolynomial;
+
+  /// Rotated version of the wrapped field's polynomial if it has one.
+  BDSMultipolePolynomial polynomial;
 };
 
 #endif
@@ -105,6 +105,12 @@ public:
   void AttachToVolume(const std::vector<G4LogicalVolume*>& volumes,
 		      G4bool penetrateToDaughterVolumes = true) const;
 
+  /// Attach to logical volumes but with the user limits from another (equivalent) field
+  /// info. Used when one set of field objects is shared between identical fields.
+  void AttachToVolume(const std::vector<G4LogicalVolume*>& volumes,
+		      G4bool              penetrateToDaughterVolumes,
+		      const BDSFieldInfo* userLimitsInfo) const;
+
   /// Attach user limits to a volume and optionally recurse to daughters.
   /// Note this will override any existing G4UserLimits on the volume or
   /// daughters. We rely on BDSFieldInfo::defaultUL coming from BDSGlobalConstants
@@ -124,6 +124,8 @@ public:
   inline G4int    Seed()                   const {return G4int   (options.seed);}
   inline G4bool   SeedSet()                const {return G4bool  (options.HasBeenSet("seed"));}
   inline G4String RandomEngine()           const {return G4String(options.randomEngine);}
+  inline G4int    NThreads()               const {return G4int   (options.nThreads);}
+  inline G4int    NJobs()                  const {return G4int   (options.nJobs);}
   inline G4bool   Recreate()               const {return G4bool  (options.recreate);}
   inline G4String RecreateFileName()       const {return G4String(options.recreateFileName);}
   inline G4int    StartFromEvent()         const {return G4int   (options.startFromEvent);}
@@ -209,6 +211,8 @@ public:
   inline G4double MinimumEpsilonStepThin()   const {return G4double(options.minimumEpsilonStepThin);}
   inline G4double MaximumEpsilonStepThin()   const {return G4double(options.maximumEpsilonStepThin);}
   inline G4String FieldModulator()           const {return G4String(options.fieldModulator);}
+  inline G4bool   ModulatorsTabulated()      const {return G4bool  (options.modulatorsTabulated);}
+  inline G4int    ModulatorsTabulatedNPoints() const {return G4int (options.modulatorsTabulatedNPoints);}
   inline G4double MaxTime()                  const {return G4double(options.maximumTrackingTime)*CLHEP::s;}
   inline G4double MaxStepLength()            const {return G4double(options.maximumStepLength)*CLHEP::m;}
   inline G4double MaxTrackLength()           const {return G4double(options.maximumTrackLength)*CLHEP::m;}
@@ -242,6 +246,8 @@ public:
   inline G4double CollimatorHitsMinimumKE()  const {return G4double(options.collimatorHitsMinimumKE*CLHEP::GeV);}
   inline G4bool   StoreELoss()               const {return G4bool  (options.storeEloss);}
   inline G4bool   StoreELossHistograms()     const {return G4bool  (options.storeElossHistograms);}
+  inline G4bool   StoreELossBinned()         const {return G4bool  (options.storeElossBinned);}
+  inline G4bool   StoreELossBinnedParticleClass() const {return G4bool (options.storeElossBinnedParticleClass);}
   inline G4bool   StoreELossVacuum()         const {return G4bool  (options.storeElossVacuum);}
   inline G4bool   StoreELossVacuumHistograms()const{return G4bool  (options.storeElossVacuumHistograms);}
   inline G4bool   StoreELossTunnel()         const {return G4bool  (options.storeElossTunnel);}
@@ -320,9 +326,12 @@ public:
   inline G4bool   YokeFields()               const {return G4bool  (options.yokeFields);}
   inline G4bool   YokeFieldsMatchLHCGeometry()const{return G4bool  (options.yokeFieldsMatchLHCGeometry);}
   inline G4bool   UseOldMultipoleOuterFields()const{return G4bool  (options.useOldMultipoleOuterFields);}
+  inline G4bool   YokeFieldsInterpolated()   const {return G4bool  (options.yokeFieldsInterpolated);}
+  inline G4int    YokeFieldsInterpolatedNPoints() const {return G4int (options.yokeFieldsInterpolatedNPoints);}
   inline G4double ScalingFieldOuter()        const {return G4double(options.scalingFieldOuter);}
   inline G4bool   IntegrateKineticEnergyAlongBeamline()const {return G4bool  (options.integrateKineticEnergyAlongBeamline);}
   inline G4String CavityFieldType()          const {return G4String(options.cavityFieldType);}
+  inline G4bool   CavityFieldTabulatedBessel() const {return G4bool (options.cavityFieldTabulatedBessel);}
   inline G4bool   TurnOnOpticalAbsorption()  const {return G4bool  (options.turnOnOpticalAbsorption);}
   inline G4bool   TurnOnRayleighScattering() const {return G4bool  (options.turnOnRayleighScattering);}
   inline G4bool   TurnOnMieScattering()      const {return G4bool  (options.turnOnMieScattering);}
@@ -330,6 +339,8 @@ public:
   inline G4int    NumberOfEventsPerNtuple()  const {return G4int   (options.numberOfEventsPerNtuple);}
   inline G4bool   IncludeFringeFields()      const {return G4bool  (options.includeFringeFields);}
   inline G4bool   IncludeFringeFieldsCavities() const {return G4bool  (options.includeFringeFieldsCavities);}
+  inline G4bool   FieldMapSharedMemory()     const {return G4bool  (options.fieldMapSharedMemory);}
+  inline G4double FieldMapCubicTableMaxSize() const {return G4double(options.fieldMapCubicTableMaxSize);}
   inline G4int    NSegmentsPerCircle()       const {return G4int   (options.nSegmentsPerCircle);}
   inline G4double ThinElementLength()        const {return G4double(options.thinElementLength*CLHEP::m);}
   inline G4bool   HStyle()                   const {return G4bool  (options.hStyle);}
@@ -355,7 +366,16 @@ public:
   inline G4bool   TeleporterFullTransform()  const {return G4bool  (options.teleporterFullTransform);}
   inline G4double DEThresholdForScattering() const {return G4double(options.dEThresholdForScattering)*CLHEP::GeV;}
   inline G4String PTCOneTurnMapFileName()    const {return G4String (options.ptcOneTurnMapFileName);}
+  inline G4bool   OneTurnMapFromModel()      const {return G4bool  (options.oneTurnMapFromModel);}
+  inline G4int    OneTurnMapFromModelOrder() const {return G4int   (options.oneTurnMapFromModelOrder);}
+  inline G4double OneTurnMapFromModelMaxOffset() const {return G4double(options.oneTurnMapFromModelMaxOffset)*CLHEP::m;}
+  inline G4double OneTurnMapFromModelMaxAngle()  const {return G4double(options.oneTurnMapFromModelMaxAngle)*CLHEP::rad;}
+  inline G4double OneTurnMapFromModelMaxDeltaP() const {return G4double(options.oneTurnMapFromModelMaxDeltaP);}
   inline G4double BackupStepperMomLimit()    const {return G4double(options.backupStepperMomLimit)*CLHEP::rad;}
+  inline G4bool   FastVacuumTransport()      const {return G4bool  (options.fastVacuumTransport);}
+  inline G4bool   ScreenPrimaries()          const {return G4bool  (options.screenPrimaries);}
+  inline G4int    ScreenPrimariesBatchSize() const {return G4int   (options.screenPrimariesBatchSize);}
+  inline G4double ScreenPrimariesApertureMargin() const {return G4double(options.screenPrimariesApertureMargin)*CLHEP::m;}
 
   /// @{ options that require some implementation.
   G4bool StoreTrajectoryTransportationSteps() const;
@@ -439,8 +459,8 @@ private:
   G4UserLimits* defaultUserLimitsTunnel;
   std::set<G4int> particlesToExcludeFromCutsAsSet;
   
-  /// Turn Control
-  G4int turnsTaken;
+  /// Turn Control - per thread as each thread tracks its own event.
+  static G4ThreadLocal G4int turnsTaken;
 
   BDSOutputType        outputType;         ///< Output type enum for output format to be used.
   BDSIntegratorSetType integratorSet;      ///< Integrator type enum for integrator set to be used.
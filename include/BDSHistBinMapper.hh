@@ -60,6 +60,9 @@ public:
   inline G4double NBinsJ() const {return nBinsJ;}
   inline G4double NBinsK() const {return nBinsK;}
   inline G4double NBinsL() const {return nBinsL;}
+
+  /// Total number of global indices (including the energy under and overflow bins).
+  inline G4int NBinsTotal() const {return nBinsI * nBinsJ * nBinsK * nBinsL;}
   
 #ifdef USE_BOOST
   inline boost_histogram_axes_variant GetEnergyAxis() const {return energyAxis;}
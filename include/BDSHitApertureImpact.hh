@@ -77,7 +77,7 @@ public:
 };
 
 typedef G4THitsCollection<BDSHitApertureImpact> BDSHitsCollectionApertureImpacts;
-extern G4Allocator<BDSHitApertureImpact> BDSAllocatorApertureImpacts;
+extern G4ThreadLocal G4Allocator<BDSHitApertureImpact> BDSAllocatorApertureImpacts;
 
 inline void* BDSHitApertureImpact::operator new(size_t)
 {
@@ -65,7 +65,7 @@ public:
 };
 
 typedef G4THitsCollection<BDSHitCollimator> BDSHitsCollectionCollimator;
-extern G4Allocator<BDSHitCollimator> BDSAllocatorCollimator;
+extern G4ThreadLocal G4Allocator<BDSHitCollimator> BDSAllocatorCollimator;
 
 inline void* BDSHitCollimator::operator new(size_t)
 {
@@ -107,7 +107,7 @@ private:
 };
 
 typedef G4THitsCollection<BDSHitEnergyDeposition> BDSHitsCollectionEnergyDeposition;
-extern G4Allocator<BDSHitEnergyDeposition> BDSAllocatorEnergyDeposition;
+extern G4ThreadLocal G4Allocator<BDSHitEnergyDeposition> BDSAllocatorEnergyDeposition;
 
 inline void* BDSHitEnergyDeposition::operator new(size_t)
 {
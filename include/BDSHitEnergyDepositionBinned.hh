@@ -0,0 +1,80 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSHITENERGYDEPOSITIONBINNED_H
+#define BDSHITENERGYDEPOSITIONBINNED_H
+
+#include "globals.hh"
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+
+/**
+ * @brief Energy deposition summed over one event for one bin of S, beam line
+ * element and optionally turn and particle class.
+ *
+ * One of these is made the first time energy is deposited in a bin in an event
+ * and all following deposits in the same bin are added to it.
+ */
+
+class BDSHitEnergyDepositionBinned: public G4VHit
+{
+public:
+  BDSHitEnergyDepositionBinned(G4int sBinIn,
+			       G4int beamlineIndexIn,
+			       G4int turnIn,
+			       G4int particleClassIn);
+  /// Note this should not be inline when we use a G4Allocator.
+  virtual ~BDSHitEnergyDepositionBinned();
+
+  inline void* operator new(size_t) ;
+  inline void operator delete(void *aHit);
+
+  /// Add a weighted energy deposit to this bin.
+  inline void Add(G4double energyWeightedIn) {energyWeighted += energyWeightedIn;}
+
+  /// Classify a particle by its PDG ID: 0 photons, 1 electrons and positrons,
+  /// 2 neutrons, 3 other hadrons and ions, 4 anything else.
+  static G4int ParticleClass(G4int pdgID);
+
+  G4int    sBin;           ///< Index of the S bin from the start of the beam line.
+  G4int    beamlineIndex;  ///< Index of the beam line element.
+  G4int    turn;           ///< Turn number or -1 if not binned by turn.
+  G4int    particleClass;  ///< Particle class or -1 if not binned by particle class.
+  G4double energyWeighted; ///< Sum of the weighted energy deposited.
+
+private:
+  BDSHitEnergyDepositionBinned() = delete;
+};
+
+typedef G4THitsCollection<BDSHitEnergyDepositionBinned> BDSHitsCollectionEnergyDepositionBinned;
+extern G4ThreadLocal G4Allocator<BDSHitEnergyDepositionBinned> BDSAllocatorEnergyDepositionBinned;
+
+inline void* BDSHitEnergyDepositionBinned::operator new(size_t)
+{
+  void* aHit;
+  aHit=(void*) BDSAllocatorEnergyDepositionBinned.MallocSingle();
+  return aHit;
+}
+
+inline void BDSHitEnergyDepositionBinned::operator delete(void *aHit)
+{
+  BDSAllocatorEnergyDepositionBinned.FreeSingle((BDSHitEnergyDepositionBinned*) aHit);
+}
+
+#endif
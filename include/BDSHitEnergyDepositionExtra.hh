@@ -90,7 +90,7 @@ private:
 };
 
 typedef G4THitsCollection<BDSHitEnergyDepositionExtra> BDSHitsCollectionEnergyDepositionExtra;
-extern G4Allocator<BDSHitEnergyDepositionExtra> BDSAllocatorEnergyDepositionExtra;
+extern G4ThreadLocal G4Allocator<BDSHitEnergyDepositionExtra> BDSAllocatorEnergyDepositionExtra;
 
 inline void* BDSHitEnergyDepositionExtra::operator new(size_t)
 {
@@ -72,7 +72,7 @@ private:
 };
 
 typedef G4THitsCollection<BDSHitSampler> BDSHitsCollectionSampler;
-extern G4Allocator<BDSHitSampler> BDSAllocatorSampler;
+extern G4ThreadLocal G4Allocator<BDSHitSampler> BDSAllocatorSampler;
 
 inline void* BDSHitSampler::operator new(size_t)
 {
@@ -75,7 +75,7 @@ public:
 };
 
 typedef G4THitsCollection<BDSHitSamplerCylinder> BDSHitsCollectionSamplerCylinder;
-extern G4Allocator<BDSHitSamplerCylinder> BDSAllocatorSamplerCylinder;
+extern G4ThreadLocal G4Allocator<BDSHitSamplerCylinder> BDSAllocatorSamplerCylinder;
 
 inline void* BDSHitSamplerCylinder::operator new(size_t)
 {
@@ -65,7 +65,7 @@ public:
 };
 
 typedef G4THitsCollection<BDSHitSamplerLink> BDSHitsCollectionSamplerLink;
-extern G4Allocator<BDSHitSamplerLink> BDSAllocatorSamplerLink;
+extern G4ThreadLocal G4Allocator<BDSHitSamplerLink> BDSAllocatorSamplerLink;
 
 inline void* BDSHitSamplerLink::operator new(size_t)
 {
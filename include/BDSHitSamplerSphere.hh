@@ -75,7 +75,7 @@ public:
 };
 
 typedef G4THitsCollection<BDSHitSamplerSphere> BDSHitsCollectionSamplerSphere;
-extern G4Allocator<BDSHitSamplerSphere> BDSAllocatorSamplerSphere;
+extern G4ThreadLocal G4Allocator<BDSHitSamplerSphere> BDSAllocatorSamplerSphere;
 
 inline void* BDSHitSamplerSphere::operator new(size_t)
 {
@@ -32,7 +32,7 @@ class BDSTrajectoryPrimary;
 
 class BDSHitThinThing; // forward declaration to allow typedef required for static function
 typedef G4THitsCollection<BDSHitThinThing> BDSHitsCollectionThinThing;
-extern G4Allocator<BDSHitThinThing> BDSAllocatorThinThing;
+extern G4ThreadLocal G4Allocator<BDSHitThinThing> BDSAllocatorThinThing;
 
 /**
  * @brief A hit if a particle lost energy in a thin object.
@@ -25,12 +25,17 @@ class BDSComponentFactoryUser;
 class BDSDetectorConstruction;
 class BDSGlobalConstants;
 class BDSOutput;
+class BDSOutputEventQueue;
 class BDSParser;
-class BDSRunManager;
+class G4RunManager;
 class G4VModularPhysicsList;
 
 #include "G4String.hh"
 
+#include <vector>
+
+#include <sys/types.h>
+
 /** 
  * @brief Interface class to use BDSIM.
  *
@@ -90,6 +95,29 @@ public:
 private:
   /// The main function where everything is constructed.
   int Initialise();
+
+  /// Throw an exception for any feature that prevents the events being split between
+  /// threads or jobs, prefixing the message with baseMessage.
+  void CheckEventsCanBeSplit(const BDSGlobalConstants* globals,
+                             const G4String&           baseMessage) const;
+
+  /// Throw an exception for any feature that can't be used with more than one thread.
+  void CheckMultiThreadingSupported(const BDSGlobalConstants* globals) const;
+
+  /// Throw an exception for any feature that can't be used with more than one job.
+  void CheckJobsSupported(const BDSGlobalConstants* globals) const;
+
+  /// Split the events between nJobs processes forked from this fully initialised one,
+  /// each with a seed offset by its job index and its own output file. The output of
+  /// all jobs is combined at the end.
+  void RunJobs(G4int nToGenerate);
+
+  /// Combine the output of the jobs with bdsimCombine and remove the job files if successful.
+  void CombineJobOutput(const G4String&              combinedFileName,
+                        const std::vector<G4String>& jobFileNames) const;
+
+  /// Wait for a child process to finish. Returns whether it finished successfully.
+  static G4bool WaitForProcess(pid_t pid);
   
   bool   ignoreSIGINT;         ///< For cmake testing.
   bool   usualPrintOut;        ///< Whether to allow the usual cout output.
@@ -102,7 +130,8 @@ private:
   BDSParser*     parser;
   BDSOutput*     bdsOutput;
   BDSBunch*      bdsBunch;
-  BDSRunManager* runManager;
+  G4RunManager*  runManager;
+  BDSOutputEventQueue* outputQueue;               ///< Only in a multi-threaded run.
   BDSComponentFactoryUser* userComponentFactory; ///< Optional user registered component factory.
   G4VModularPhysicsList* userPhysicsList;        ///< Optional user registered physics list.
   BDSDetectorConstruction* realWorld;
@@ -69,7 +69,7 @@ public:
   /// This static variable is updated by BDSFieldManager that marks each
   /// track as primary or not here. This variable is used throughout our
   /// integrators for magnetic fields which inherit this class.
-  static G4bool currentTrackIsPrimary;
+  static G4ThreadLocal G4bool currentTrackIsPrimary;
 
 protected:
   /// Convert final local position and direction to global frame. Allow
@@ -20,10 +20,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSINTEGRATORMULTIPOLETHIN_H
 
 #include "BDSIntegratorMag.hh"
+#include "BDSMultipolePolynomial.hh"
 
 #include "globals.hh"
-#include <list>
-#include <vector>
 
 class G4Mag_EqRhs;
 class BDSMagnetStrength;
@@ -66,18 +65,14 @@ private:
   /// Private default constructor to enforce use of supplied constructor
   BDSIntegratorMultipoleThin() = delete;
 
-  /// Calculate the factorial of n.
-  G4int Factorial(G4int n);
-
   /// Magnetic rigidity for momentum scaling
   G4double brho;
 
   /// Dipole component
   G4double b0l;
-  /// @{ Higher order components
-  std::list<double>  bnl;
-  std::list<double>  bsl;
-  std::vector<G4int> nfact;
+  /// @{ Higher order components as polynomials in x + iy including the factorials.
+  BDSMultipolePolynomial normalKick;
+  BDSMultipolePolynomial skewKick;
   /// @}
 };
 
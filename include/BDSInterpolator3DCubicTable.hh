@@ -0,0 +1,93 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSINTERPOLATOR3DCUBICTABLE_H
+#define BDSINTERPOLATOR3DCUBICTABLE_H
+
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3D.hh"
+
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <vector>
+
+class BDSArray3DCoords;
+
+/** 
+ * @brief Cubic interpolation over 3d array using precomputed polynomial coefficients.
+ *
+ * The same result as BDSInterpolator3DCubic (to within the field precision), but the
+ * 64 coefficients of the tricubic polynomial of every cell are calculated when
+ * constructed. Each query is then a single contiguous read of one cell's coefficients
+ * and the evaluation of the polynomial. This uses 64 times the memory of the field
+ * map (in the field precision) and so is intended for modest size maps that are
+ * queried very many times.
+ *
+ * This can only be used with a plain BDSArray3DCoords (i.e. not reflected) - see Suitable().
+ * Any storage type may be used as the coefficients are stored separately.
+ * 
+ * Does not own array - so multiple interpolators could be used on same data.
+ */
+
+class BDSInterpolator3DCubicTable: public BDSInterpolator3D
+{
+public:
+  explicit BDSInterpolator3DCubicTable(BDSArray3DCoords* arrayIn);
+  virtual ~BDSInterpolator3DCubicTable();
+
+  /// Whether an array can be interpolated with this class.
+  static G4bool Suitable(const BDSArray3DCoords* arrayIn);
+
+  /// Size in bytes of the coefficient table that would be built for an array.
+  static std::size_t MemoryRequired(const BDSArray3DCoords* arrayIn);
+
+  /// Size in bytes of the coefficient table.
+  inline std::size_t MemoryUsage() const {return coefficients.size() * sizeof(BDSFieldValue);}
+
+protected:
+  virtual BDSFieldValue GetInterpolatedValueT(G4double x, G4double y, G4double z) const;
+
+private:
+  /// Private default constructor to force use of provided one.
+  BDSInterpolator3DCubicTable() = delete;
+
+  /// Number of coefficients for each cell.
+  static const G4int nCoefficients = 64;
+
+  /// Calculate the coefficients for every cell from the array.
+  void BuildCoefficients();
+
+  /// @{ Cached array parameters.
+  G4int    nX;
+  G4int    nY;
+  G4int    nZ;
+  G4double xMin;
+  G4double yMin;
+  G4double zMin;
+  G4double xStepInv;
+  G4double yStepInv;
+  G4double zStepInv;
+  /// @}
+
+  /// Coefficients of x^p y^q z^r at [cell*64 + p*16 + q*4 + r] where the cell index
+  /// is the array index of the first point of the cell (x fastest).
+  std::vector<BDSFieldValue> coefficients;
+};
+
+#endif
@@ -0,0 +1,79 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSINTERPOLATOR3DDIRECT_H
+#define BDSINTERPOLATOR3DDIRECT_H
+
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3D.hh"
+
+#include "G4Types.hh"
+
+class BDSArray3DCoords;
+
+/** 
+ * @brief Interpolation over a 3D array reading the array memory directly.
+ *
+ * Equivalent to BDSInterpolator3DLinear (N = 2) and BDSInterpolator3DCubic (N = 4),
+ * but instead of extracting a copy of the local points through the virtual array
+ * interface, the stencil is summed directly from the array data with weights calculated
+ * once per dimension. The three components of the field are summed together in SIMD
+ * registers. Points whose stencil extends beyond the array use the normal (virtual)
+ * interface so the boundary behaviour is identical.
+ *
+ * This can only be used with a plain BDSArray3DCoords in the standard storage type
+ * (i.e. not reflected or reduced precision) - see Suitable().
+ * 
+ * Does not own array - so multiple interpolators could be used on same data.
+ */
+
+template<G4int N>
+class BDSInterpolator3DDirect: public BDSInterpolator3D
+{
+public:
+  explicit BDSInterpolator3DDirect(BDSArray3DCoords* arrayIn);
+  virtual ~BDSInterpolator3DDirect(){;}
+
+  /// Whether an array can be interpolated with this class.
+  static G4bool Suitable(const BDSArray3DCoords* arrayIn);
+
+protected:
+  virtual BDSFieldValue GetInterpolatedValueT(G4double x, G4double y, G4double z) const;
+
+private:
+  /// Private default constructor to force use of provided one.
+  BDSInterpolator3DDirect() = delete;
+
+  /// Interpolation through the array interface for points near the edge.
+  BDSFieldValue GetInterpolatedValueEdge(G4double x, G4double y, G4double z) const;
+
+  /// @{ Cached array parameters.
+  const BDSFieldValue* data;
+  G4int    nX;
+  G4int    nY;
+  G4int    nZ;
+  G4double xMin;
+  G4double yMin;
+  G4double zMin;
+  G4double xStepInv;
+  G4double yStepInv;
+  G4double zStepInv;
+  /// @}
+};
+
+#endif
@@ -247,6 +247,105 @@ namespace BDS
     v *= factor;
     return v;
   }
+
+  /// Weights of the N points around a normalised coordinate 'x' on the interval [0,1]
+  /// for interpolation as a sum of weighted values. N = 2 is linear and N = 4 is
+  /// cubic (identical to Linear1D and Cubic1D). The weights only depend on the
+  /// coordinate so they can be calculated once per dimension for a whole stencil.
+  template<G4int N>
+  void InterpolationWeights(G4double x, G4double (&w)[N]);
+
+  template<>
+  inline void InterpolationWeights<2>(G4double x, G4double (&w)[2])
+  {
+    w[0] = 1. - x;
+    w[1] = x;
+  }
+
+  template<>
+  inline void InterpolationWeights<4>(G4double x, G4double (&w)[4])
+  {
+    G4double x2 = x*x;
+    G4double x3 = x2*x;
+    w[0] = 0.5*(-x + 2.*x2 - x3);
+    w[1] = 1. + 0.5*(-5.*x2 + 3.*x3);
+    w[2] = 0.5*(x + 4.*x2 - 3.*x3);
+    w[3] = 0.5*(x3 - x2);
+  }
+
+  /// Coefficients c of the polynomial c[0] + c[1]x + c[2]x^2 + c[3]x^3 that is identical
+  /// to Cubic1D for the points p. In multiple dimensions this can be applied along each
+  /// dimension in turn to give the coefficients of the full polynomial.
+  template<class T>
+  void Cubic1DCoefficients(const T p[4],
+                           T       c[4])
+  {
+    c[0] = p[1];
+    c[1] = 0.5*(p[2] - p[0]);
+    c[2] = p[0] - 2.5*p[1] + 2.*p[2] - 0.5*p[3];
+    c[3] = 0.5*(p[3] - p[0]) + 1.5*(p[1] - p[2]);
+  }
+
+  /// Convert the values of a cubic stencil in nDimensions (4^nDimensions values flattened
+  /// with the last dimension fastest as in the 'p' of CubicND) in place to the coefficients
+  /// of the polynomial that is identical to CubicND. The coefficient of x^a y^b ... is then
+  /// at the same position as the value of point [a][b]...
+  template<class T>
+  void CubicCoefficients(T* v,
+                         G4int nDimensions)
+  {
+    G4int n = 1 << (2*nDimensions);
+    T in[4];
+    T out[4];
+    for (G4int stride = 1; stride < n; stride *= 4)
+      {
+        for (G4int base = 0; base < n; base++)
+          {
+            if ((base / stride) % 4 != 0)
+              {continue;} // not the first point along this dimension
+            for (G4int i = 0; i < 4; i++)
+              {in[i] = v[base + i*stride];}
+            BDS::Cubic1DCoefficients(in, out);
+            for (G4int i = 0; i < 4; i++)
+              {v[base + i*stride] = out[i];}
+          }
+      }
+  }
+
+  /// Powers 0 to 3 of a normalised coordinate for evaluating cubic polynomial coefficients.
+  inline void CubicPowers(G4double x, G4double (&xp)[4])
+  {
+    xp[0] = 1.;
+    xp[1] = x;
+    xp[2] = x*x;
+    xp[3] = xp[2]*x;
+  }
+
+#if defined(__GNUC__) || defined(__clang__)
+  /// The three components of a field value (plus one unused) held together so that
+  /// weighted sums of field values are done in SIMD registers.
+  typedef G4double FieldLanes __attribute__((vector_size(4*sizeof(G4double))));
+#else
+  /// Plain fallback for compilers without vector extensions.
+  struct FieldLanes
+  {
+    G4double v[4];
+    G4double  operator[](G4int i) const {return v[i];}
+  };
+#endif
+
+  /// Add a weighted field value to a sum held as FieldLanes.
+  inline void AccumulateWeighted(FieldLanes& sum, G4double weight, const BDSFieldValue& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    FieldLanes v = {value.x(), value.y(), value.z(), 0};
+    sum += weight * v;
+#else
+    sum.v[0] += weight * value.x();
+    sum.v[1] += weight * value.y();
+    sum.v[2] += weight * value.z();
+#endif
+  }
 }
 
 #endif
@@ -34,7 +34,7 @@ class G4Step;
 class G4Track;
 
 // flag initiated in BDSEventAction
-extern G4bool FireLaserCompton;
+extern G4ThreadLocal G4bool FireLaserCompton;
 
 /**
  * @brief Laser compton scattering process to achieve a laserwire.
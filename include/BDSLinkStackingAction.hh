@@ -47,7 +47,7 @@ public:
   /// the even won't conserve energy with the stopSecondaries on.
   virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
 
-  static G4double kineticEnergyKilled;
+  static G4ThreadLocal G4double kineticEnergyKilled;
 
 private:
   G4bool killNeutrinos;     ///< Local copy of whether to kill neutrinos for tracking efficiency.
@@ -0,0 +1,67 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSMTRUNMANAGER_H
+#define BDSMTRUNMANAGER_H
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+
+class BDSExceptionHandler;
+class BDSOutputEventQueue;
+
+/**
+ * @brief Wrapper from G4MTRunManager for processing events on several threads.
+ *
+ * Equivalent to BDSRunManager for a multi-threaded run. The master constructs the
+ * geometry and writes the output and the workers process events. Only available if
+ * Geant4 is built with multithreading.
+ *
+ * The workers take one event at a time (an event modulo of 1) rather than the default
+ * blocks of about sqrt(nEvents/nThreads) events. The events are written in order
+ * through a ring of a few events per thread, so a worker far ahead in its block
+ * would wait for the others and the run would effectively be sequential.
+ */
+
+class BDSMTRunManager: public G4MTRunManager
+{
+public:
+  BDSMTRunManager();
+  virtual ~BDSMTRunManager();
+
+  /// Run G4MTRunManager::Initialize() and carry out any field queries. The
+  /// world extent is given to each worker's primary generator action when built.
+  virtual void Initialize();
+
+  /// Run G4MTRunManager::AbortRun(), but give some print out feedback for the user.
+  /// The output queue stops accepting events so the workers don't wait for ones that
+  /// won't be simulated.
+  virtual void AbortRun(G4bool softAbort = false);
+
+  /// Set the queue the workers' events are written through. Not owned. The workers
+  /// are given BDSWorkerRunManagers so an abort on any of them also abandons it.
+  void SetOutputQueue(BDSOutputEventQueue* outputQueueIn);
+
+protected:
+  BDSExceptionHandler* exceptionHandler;
+  BDSOutputEventQueue* outputQueue;
+};
+
+#endif
+#endif
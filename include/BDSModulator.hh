@@ -22,6 +22,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <vector>
+
 /**
  * @brief Base class for a modulator.
  * 
@@ -29,6 +31,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  *
  * Turn number can also be used and should be accessed through BDSGlobalConstants
  * in the derived class that would wish to use this (static) variable.
+ *
+ * Fields should use CachedFactor(). If a derived class only depends on T, the
+ * last factor is reused when queried again at the same T (as happens for every
+ * query within one step) and, if it is periodic, a table of one period may be
+ * built and interpolated instead of calling Factor(). A derived class that uses
+ * the event index or turn number must not return true from OnlyVariesWithTime().
  * 
  * @author Fabian Metzger
  */
@@ -52,9 +60,36 @@ public:
   
   /// Must return the smallest spatial
   virtual G4double RecommendedMaxStepLength() const = 0;
+
+  /// Whether the factor depends only on T and so may be cached and tabulated.
+  virtual G4bool OnlyVariesWithTime() const {return false;}
+
+  /// Period in T of the factor if it is periodic, else 0.
+  virtual G4double Period() const {return 0;}
+
+  /// Return the factor reusing the last one if T is unchanged or interpolating the
+  /// periodic table if built. Falls back to Factor() for spatially varying modulators.
+  G4double CachedFactor(const G4ThreeVector& xyz,
+                        G4double T) const;
+
+  /// Sample one period of Factor() at nPoints to be interpolated (cubic) in
+  /// CachedFactor(). Does nothing if not periodic or not only a function of T.
+  void BuildPeriodicTable(G4int nPoints);
   
 protected:
-  static G4int eventIndex;
+  static G4ThreadLocal G4int eventIndex;
+
+private:
+  /// Cubic Lagrange interpolation of the periodic table.
+  G4double InterpolateTable(G4double T) const;
+
+  mutable G4bool   cacheValid  = false;
+  mutable G4double cachedT     = 0;
+  mutable G4double cachedFactor = 0;
+
+  std::vector<G4double> table;
+  G4double tablePeriod = 0;
+  G4double tableStep   = 0;
 };
 
 #endif
@@ -50,6 +50,11 @@ public:
   /// Return the wavelength / 20 of the oscillator.
   virtual G4double RecommendedMaxStepLength() const;
 
+  virtual G4bool OnlyVariesWithTime() const {return true;}
+
+  /// Return 1 / frequency or 0 if the frequency is 0.
+  virtual G4double Period() const;
+
 private:
   G4double angularFrequency;
   G4double phase;
@@ -49,6 +49,8 @@ public:
   /// Return difference in T0, T1 / 20.
   virtual G4double RecommendedMaxStepLength() const;
 
+  virtual G4bool OnlyVariesWithTime() const {return true;}
+
 private:
   G4double T0;
   G4double T1;
@@ -0,0 +1,94 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSMULTIPOLEPOLYNOMIAL_H
+#define BDSMULTIPOLEPOLYNOMIAL_H
+
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Polynomial in the complex transverse position z = x + iy.
+ *
+ * P(z) = sum_n c_n z^n for n = 1 to N with complex coefficients c_n. Any 2D multipole
+ * field (or kick) can be expressed this way, e.g. By + iBx = P(z). The coefficients
+ * are prepared once (including any factorials and units) and the polynomial is evaluated
+ * with Horner's method, i.e. only multiplications and additions - no powers or
+ * trigonometric functions. Both single point and batch evaluation are provided. The batch
+ * version is written so that the compiler can vectorise over the points.
+ */
+
+class BDSMultipolePolynomial
+{
+public:
+  /// Empty polynomial that always evaluates to zero.
+  BDSMultipolePolynomial();
+  /// Coefficients of z^1 to z^N (i.e. element 0 is the coefficient of z).
+  explicit BDSMultipolePolynomial(const std::vector<G4complex>& coefficients);
+  ~BDSMultipolePolynomial(){;}
+
+  /// Set coefficient of z^n (n >= 1), extending the polynomial as required.
+  void SetCoefficient(G4int n, G4complex value);
+
+  /// Rotate the field represented by the polynomial (in the form By + iBx = P(z)) by angle
+  /// (rad) about the z axis - the same as BDSFieldMagSkew. The coefficient of z^n is
+  /// multiplied by exp(i(n+1)angle).
+  void RotateField(G4double angle);
+
+  /// Highest power with a non-zero coefficient.
+  inline G4int Order() const {return (G4int)real.size();}
+
+  /// Whether all coefficients are zero.
+  inline G4bool Empty() const {return real.empty();}
+
+  /// Evaluate at a single point.
+  inline void Evaluate(G4double x, G4double y, G4double& resultReal, G4double& resultImag) const
+  {
+    G4double pr = 0;
+    G4double pi = 0;
+    for (G4int n = (G4int)real.size() - 1; n >= 0; n--)
+      {// p = p*z + c
+        G4double t = pr*x - pi*y + real[n];
+        pi = pr*y + pi*x + imag[n];
+        pr = t;
+      }
+    // lowest power is z^1
+    resultReal = pr*x - pi*y;
+    resultImag = pr*y + pi*x;
+  }
+
+  /// Evaluate at nPoints points.
+  void Evaluate(std::size_t     nPoints,
+                const G4double* x,
+                const G4double* y,
+                G4double*       resultReal,
+                G4double*       resultImag) const;
+
+private:
+  /// Remove trailing zero coefficients.
+  void Trim();
+
+  /// @{ Coefficients of z^(i+1) split into separate arrays for vectorisation.
+  std::vector<G4double> real;
+  std::vector<G4double> imag;
+  /// @}
+};
+
+#endif
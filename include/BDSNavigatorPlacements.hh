@@ -27,6 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <utility>
 
 class G4VPhysicalVolume;
+class G4VSolid;
 
 /**
  * @brief Extra G4Navigator to get coordinate transforms for placement world.
@@ -42,6 +43,13 @@ class G4VPhysicalVolume;
  * in the geometry.
  *
  * See InitialiseTransform() documentation for why we have mutable variables.
+ *
+ * The transform of the last volume found is cached (shared by all instances as the
+ * navigator is). If that volume has no daughters and a subsequent point is still
+ * inside it, the cached transform is used without navigating. A bounding box check
+ * rejects most points outside the volume before the solid itself is asked.
+ *
+ * The navigator and the cache are per thread.
  * 
  * @author Laurie Nevay
  */
@@ -53,9 +61,9 @@ public:
   ~BDSNavigatorPlacements();
 
   /// Setup the navigator w.r.t. to a world volume - typically real world.
-  static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
-  {navigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn;}
+  static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn);
 
+  /// Reset the navigator and invalidate the cached volume.
   static void ResetNavigatorStates();
   
   /// Locate the point and setup transforms. If the point is not in a volume that's
@@ -85,9 +93,12 @@ protected:
   
   /// Navigator object for safe navigation in the real (mass) world without
   /// affecting tracking of the particle.
-  static G4Navigator* navigator;
+  static G4ThreadLocal G4Navigator* navigator;
 
 private:
+  /// Create this thread's navigator if it doesn't exist.
+  static void InitialiseNavigator();
+
   /// @{ Utility function to select appropriate transform.
   inline const G4AffineTransform& GlobalToLocal() const {return globalToLocal;}
   inline const G4AffineTransform& LocalToGlobal() const {return localToGlobal;}
@@ -100,13 +111,29 @@ private:
   /// implement and have to keep const. This function doesn't change the
   /// const pointer but does change the contents of what it points to.
   G4bool InitialiseTransform(const G4ThreeVector& globalPosition) const;
+
+  /// Fill the cache from the volume just located by the navigator.
+  static void CacheVolume(G4VPhysicalVolume* volume);
+
+  /// Whether a point is inside the cached volume. If so, the local position is set.
+  static G4bool InsideCachedVolume(const G4ThreeVector& globalPosition,
+                                   G4ThreeVector&       localPosition);
   
   /// Counter to keep track of when the last instance of the class is deleted
   /// and therefore when the navigators can be safely deleted without affecting
-  static G4int numberOfInstances;
+  static G4ThreadLocal G4int numberOfInstances;
   
   /// Cache of world PV to test if we're getting the wrong volume for the transform.
   static G4VPhysicalVolume* worldPV;
+
+  /// @{ Cache of the last placement volume without daughters that was located.
+  static G4ThreadLocal G4bool            cacheValid;
+  static G4ThreadLocal G4VSolid*         cachedSolid;
+  static G4ThreadLocal G4ThreeVector     cachedExtentMin;
+  static G4ThreadLocal G4ThreeVector     cachedExtentMax;
+  static G4ThreadLocal G4AffineTransform cachedGlobalToLocal;
+  static G4ThreadLocal G4AffineTransform cachedLocalToGlobal;
+  /// @}
 };
 
 
@@ -0,0 +1,46 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSONETURNMAPGENERATOR_H
+#define BDSONETURNMAPGENERATOR_H
+
+#include "BDSPTCOneTurnMap.hh"
+
+#include "globals.hh" // geant4 types / globals
+
+#include <array>
+
+class BDSBeamline;
+class BDSParticleDefinition;
+
+namespace BDS
+{
+  /// Generate a one turn map of the given order for a circular beam line by
+  /// tracking a set of probe particles through it with BDSBatchTransport and
+  /// fitting a polynomial to the result. The map is in the same (PTC) coordinates
+  /// as one loaded from a file. The probes fill a box of the given half widths in
+  /// x, px, y, py and deltaP (m, rad, fractional) and the map is marked as valid only
+  /// inside it. An exception is thrown if the beam line has an element that can't be
+  /// transported. The user owns the result.
+  BDSPTCOneTurnMap* GenerateOneTurnMap(const BDSBeamline*           beamline,
+				       const BDSParticleDefinition* designParticle,
+				       G4int                        order,
+				       const std::array<G4double, BDSPTCOneTurnMap::nVariables>& halfWidth);
+}
+
+#endif
@@ -52,10 +52,12 @@ class BDSHitSamplerLink;
 typedef G4THitsCollection<BDSHitSamplerLink> BDSHitsCollectionSamplerLink;
 class BDSTrajectory;
 class BDSTrajectoryPointHit;
+class BDSHitEnergyDepositionBinned;
+typedef G4THitsCollection<BDSHitEnergyDepositionBinned> BDSHitsCollectionEnergyDepositionBinned;
 class BDSHitEnergyDepositionGlobal;
 typedef G4THitsCollection<BDSHitEnergyDepositionGlobal> BDSHitsCollectionEnergyDepositionGlobal;
 class BDSTrajectoriesToStore;
-template <class T> class G4THitsMap;
+class G4VHitsCollection;
 
 class G4PrimaryVertex;
 
@@ -129,6 +131,8 @@ public:
                  const BDSHitsCollectionSamplerLink*            samplerHitsLink,
                  const BDSHitsCollectionEnergyDeposition*       energyLoss,
                  const BDSHitsCollectionEnergyDeposition*       energyLossFull,
+                 const BDSHitsCollectionEnergyDepositionBinned* energyLossBinned,
+                 const BDSHitsCollectionEnergyDepositionBinned* energyLossFullBinned,
                  const BDSHitsCollectionEnergyDeposition*       energyLossVacuum,
                  const BDSHitsCollectionEnergyDeposition*       energyLossTunnel,
                  const BDSHitsCollectionEnergyDepositionGlobal* energyLossWorld,
@@ -139,7 +143,7 @@ public:
                  const BDSTrajectoriesToStore*                  trajectories,
                  const BDSHitsCollectionCollimator*             collimatorHits,
                  const BDSHitsCollectionApertureImpacts*        apertureImpactHits,
-                 const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap,
+                 const std::map<G4String, G4VHitsCollection*>& scorerHitsMap,
                  const G4int                                    turnsTaken);
 
   /// Close a file and open a new one.
@@ -159,15 +163,20 @@ public:
   /// Feedback for protected names.
   static void PrintProtectedNames(std::ostream& out);
 
-protected:
   /// Get the next file name based on the base file name and the accrued number of files.
   G4String GetNextFileName();
 
+  /// Use a different base file name from now on and overwrite any existing file of that
+  /// name. Used by each forked job so the parent knows which files to combine.
+  void SetBaseFileNameOverwrite(const G4String& baseFileNameIn);
+
+protected:
   /// Whether to create the collimator structures in the output or not.
   inline G4bool CreateCollimatorOutputStructures() const {return createCollimatorOutputStructures;}
 
   /// @{ Options for dynamic bits of output.
   G4bool storeELoss;
+  G4bool storeELossBinned;
   G4bool storeELossTunnel;
   G4bool storeELossVacuum;
   G4bool storeELossWorld; // for both world and world exit
@@ -246,6 +255,11 @@ private:
   void FillEnergyLoss(const BDSHitsCollectionEnergyDeposition* loss,
                       const LossType type);
 
+  /// Fill the binned energy deposition. The bins of both collections are merged and
+  /// the energy deposition histograms are filled from them.
+  void FillEnergyLossBinned(const BDSHitsCollectionEnergyDepositionBinned* loss,
+                            const BDSHitsCollectionEnergyDepositionBinned* lossFull);
+
   /// Fill a collection of energy hits in global coordinates into the appropriate output structure.
   void FillEnergyLoss(const BDSHitsCollectionEnergyDepositionGlobal* loss,
                       const LossType type);
@@ -266,15 +280,16 @@ private:
   /// Fill aperture impact hits.
   void FillApertureImpacts(const BDSHitsCollectionApertureImpacts* hits);
 
-  /// Fill a map of scorer hits into the output.
-  void FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap);
+  /// Fill a map of scorer hits into the output. Each hits collection is either a
+  /// G4THitsMap<G4double> (Geant4 scorers) or a BDSScorerHitsMap (BDSIM scorers).
+  void FillScorerHits(const std::map<G4String, G4VHitsCollection*>& scorerHitsMap);
 
   /// Fill an individual scorer hits map into a particular output histogram.
   void FillScorerHitsIndividual(const G4String& hsitogramDefName,
-                                const G4THitsMap<G4double>* hitMap);
+                                const G4VHitsCollection* hitMap);
 
   void FillScorerHitsIndividualBLM(const G4String& histogramDefName,
-                                   const G4THitsMap<G4double>* hitMap);
+                                   const G4VHitsCollection* hitMap);
 
   /// Fill run level summary information. This also updates the header information for
   /// writing at the end of a file.
@@ -291,8 +306,9 @@ private:
                             const G4String& destinationName,
                             const std::vector<G4int>& indices);
   
-  const G4String baseFileName;  ///< Base file name.
+  G4String       baseFileName;  ///< Base file name.
   const G4String fileExtension; ///< File extension to add to each file.
+  G4bool         overwriteFiles; ///< Overwrite existing files regardless of the usual policy.
   G4int numberEventPerFile; ///< Number of events stored per file.
   G4int outputFileNumber;   ///< Number of output file.
 
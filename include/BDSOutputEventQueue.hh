@@ -0,0 +1,100 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSOUTPUTEVENTQUEUE_H
+#define BDSOUTPUTEVENTQUEUE_H
+
+#include "globals.hh"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class BDSOutput;
+class BDSOutputEventRecord;
+
+/**
+ * @brief Write events from several worker threads to one output in event index order.
+ *
+ * Workers publish a filled BDSOutputEventRecord and carry on with the next event. A
+ * dedicated writer thread fills the output structures and writes them (including
+ * compression) to the file in event index order. The queue is a fixed ring of slots
+ * indexed by event index modulo the capacity. An event may only be published once the
+ * event 'capacity' before it has been written, which bounds the number of events held
+ * in memory and makes each slot used by only one event at a time. The slots and indices
+ * are atomics so neither the workers nor the writer take a lock.
+ *
+ * Start() and Finish() are called by the master at the beginning and end of each run.
+ */
+
+class BDSOutputEventQueue
+{
+public:
+  BDSOutputEventQueue(BDSOutput* outputIn,
+                      G4int      capacityIn,
+                      G4int      eventsPerFileIn);
+  ~BDSOutputEventQueue();
+
+  /// Start the writer thread for a new run. Event indices start from 0.
+  void Start();
+
+  /// Wait for all the published events to be written and stop the writer thread.
+  /// Only to be called once no more events will be published. Any events missing
+  /// from the sequence are skipped.
+  void Finish();
+
+  /// Refuse any further events, e.g. for an aborted run. The events already published
+  /// are still written.
+  void Abandon();
+
+  /// Hand a filled record to the writer. Waits while the slot is still in use by an
+  /// earlier event. Returns false if the queue was abandoned, in which case the record
+  /// will not be written.
+  G4bool Publish(BDSOutputEventRecord* record);
+
+  /// Wait a little longer each time this is called with the same counter - spin
+  /// briefly then sleep so a waiting thread doesn't take a core from the workers.
+  static void Backoff(G4int& nTries);
+
+private:
+  BDSOutputEventQueue() = delete;
+  BDSOutputEventQueue(const BDSOutputEventQueue&) = delete;
+  BDSOutputEventQueue& operator=(const BDSOutputEventQueue&) = delete;
+
+  /// Body of the writer thread.
+  void WriterLoop();
+
+  /// Write all published records in index order regardless of any gaps. Returns
+  /// whether any were written.
+  G4bool WriteRemaining();
+
+  /// Fill the output from one record and optionally start a new file.
+  void Write(BDSOutputEventRecord* record);
+
+  BDSOutput*  output;        ///< Not owned.
+  const G4int capacity;
+  const G4int eventsPerFile;
+
+  std::vector<std::atomic<BDSOutputEventRecord*> > slots;
+  std::atomic<G4int>  nextIndex;  ///< Index of the next event to write. Only changed by the writer.
+  std::atomic<G4bool> finishing;
+  std::atomic<G4bool> abandoned;
+  std::thread writer;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSOUTPUTEVENTRECORD_H
+#define BDSOUTPUTEVENTRECORD_H
+
+#include "globals.hh"
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+// forward declarations
+template <class T> class G4THitsCollection;
+class BDSHitApertureImpact;
+typedef G4THitsCollection<BDSHitApertureImpact> BDSHitsCollectionApertureImpacts;
+class BDSHitCollimator;
+typedef G4THitsCollection<BDSHitCollimator> BDSHitsCollectionCollimator;
+class BDSHitEnergyDeposition;
+typedef G4THitsCollection<BDSHitEnergyDeposition> BDSHitsCollectionEnergyDeposition;
+class BDSHitEnergyDepositionBinned;
+typedef G4THitsCollection<BDSHitEnergyDepositionBinned> BDSHitsCollectionEnergyDepositionBinned;
+class BDSHitEnergyDepositionGlobal;
+typedef G4THitsCollection<BDSHitEnergyDepositionGlobal> BDSHitsCollectionEnergyDepositionGlobal;
+class BDSHitSampler;
+typedef G4THitsCollection<BDSHitSampler> BDSHitsCollectionSampler;
+class BDSHitSamplerCylinder;
+typedef G4THitsCollection<BDSHitSamplerCylinder> BDSHitsCollectionSamplerCylinder;
+class BDSHitSamplerSphere;
+typedef G4THitsCollection<BDSHitSamplerSphere> BDSHitsCollectionSamplerSphere;
+class BDSEventInfo;
+class BDSTrajectoriesToStore;
+class BDSTrajectoryPointHit;
+class G4VHitsCollection;
+class G4Event;
+class G4PrimaryVertex;
+
+/**
+ * @brief Everything needed to fill the output for one event.
+ *
+ * The hits and trajectories belong to the G4Event, which is kept alive until the record
+ * has been written. The primary hits and losses and the trajectories to store are owned
+ * by the record and deleted in Clear(). A record is filled by a worker thread, written
+ * by the output writer thread and then cleared and reused by the same worker.
+ */
+
+class BDSOutputEventRecord
+{
+public:
+  BDSOutputEventRecord();
+  ~BDSOutputEventRecord();
+
+  /// Delete the owned objects, release the event and reset all pointers. The
+  /// capacity of the vectors is kept for the next event.
+  void Clear();
+
+  G4int                                           index;
+  const G4Event*                                  event;
+  const BDSEventInfo*                             info;
+  const G4PrimaryVertex*                          vertex;
+  std::vector<BDSHitsCollectionSampler*>          samplerHitsPlane;
+  std::vector<BDSHitsCollectionSamplerCylinder*>  samplerHitsCylinder;
+  std::vector<BDSHitsCollectionSamplerSphere*>    samplerHitsSphere;
+  const BDSHitsCollectionEnergyDeposition*        energyLoss;
+  const BDSHitsCollectionEnergyDeposition*        energyLossFull;
+  const BDSHitsCollectionEnergyDepositionBinned*  energyLossBinned;
+  const BDSHitsCollectionEnergyDepositionBinned*  energyLossFullBinned;
+  const BDSHitsCollectionEnergyDeposition*        energyLossVacuum;
+  const BDSHitsCollectionEnergyDeposition*        energyLossTunnel;
+  const BDSHitsCollectionEnergyDepositionGlobal*  energyLossWorld;
+  const BDSHitsCollectionEnergyDepositionGlobal*  energyLossWorldContents;
+  const BDSHitsCollectionEnergyDepositionGlobal*  worldExitHits;
+  std::vector<const BDSTrajectoryPointHit*>       primaryHits;   ///< Owned.
+  std::vector<const BDSTrajectoryPointHit*>       primaryLosses; ///< Owned.
+  BDSTrajectoriesToStore*                         trajectories;  ///< Owned.
+  const BDSHitsCollectionCollimator*              collimatorHits;
+  const BDSHitsCollectionApertureImpacts*         apertureImpactHits;
+  std::map<G4String, G4VHitsCollection*>          scorerHits;
+  G4int                                           turnsTaken;
+
+  /// Set by the writer thread once the record has been written to the output.
+  std::atomic<G4bool> written;
+
+private:
+  BDSOutputEventRecord(const BDSOutputEventRecord&) = delete;
+  BDSOutputEventRecord& operator=(const BDSOutputEventRecord&) = delete;
+};
+
+#endif
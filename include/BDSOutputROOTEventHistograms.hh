@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSOUTPUTROOTEVENTHISTOGRAMS_H
 #define BDSOUTPUTROOTEVENTHISTOGRAMS_H
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -106,13 +107,28 @@ public:
                 G4int    e,
                 G4double value);
   
+  /// Add a value to a bin by (ROOT!!) global bin index. Equivalent to accumulating a
+  /// histogram with only this bin set, but without visiting every other bin.
+  void Add3DHistogramBinContent(G4int    histoId,
+				G4int    globalBinID,
+				G4double value);
+
+  void Add4DHistogramBinContent(G4int    histoId,
+				G4int    x,
+				G4int    y,
+				G4int    z,
+				G4int    e,
+				G4double value);
+  
   /// Add the values from one supplied 3D histogram to another. Uses TH3-Add().
   void AccumulateHistogram3D(G4int histoId,
 			     TH3D* otherHistogram);
   void AccumulateHistogram4D(G4int histoId,
                              BDSBH4DBase* otherHistogram);
 #endif
-  /// Flush the contents.
+  /// Flush the contents. 3D and 4D histograms that have only had bins set with
+  /// Set3DHistogramBinContent or Set4DHistogramBinContent since the last flush
+  /// have only those bins reset rather than every bin.
   virtual void Flush();
   
   /// Copy (using the TH->Clone) method from another instance.
@@ -133,11 +149,28 @@ public:
   /// @}
 
 private:
+  /// Record that a histogram has been modified other than by setting bins so it
+  /// must be fully reset on the next flush.
+  void MarkModified3D(int histoId);
+  void MarkModified4D(int histoId);
+
+  /// Forget the bins set so all histograms are fully reset on the next flush.
+  void ClearBinsSet();
+
   std::vector<TH1D*> histograms1D;
   std::vector<TH2D*> histograms2D;
   std::vector<TH3D*> histograms3D;
   std::vector<BDSBH4DBase*> histograms4D;
 
+  /// @{ Bins set in each histogram since the last flush (not written out).
+  std::vector<std::vector<int> > binsSet3D;                 //!
+  std::vector<std::vector<std::array<int,4> > > binsSet4D;  //!
+  /// @}
+  /// @{ Whether each histogram has only been modified by setting bins since the last flush.
+  std::vector<bool> onlyBinsSet3D; //!
+  std::vector<bool> onlyBinsSet4D; //!
+  /// @}
+
   ClassDef(BDSOutputROOTEventHistograms,4);
 };
 
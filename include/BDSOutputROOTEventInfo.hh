@@ -58,6 +58,7 @@ public:
   int    nCollimatorsInteracted;        ///< Number of collimators primary interacted with.
   long long int nTracks;                ///< Number of tracks in the event.
   int    bunchIndex;                    ///< Bunch index for this event.
+  long long int nPrimariesScreened;     ///< Number of primaries screened out before this event.
   
   BDSOutputROOTEventInfo();
 
@@ -67,7 +68,7 @@ public:
   /// Fill from another instance.
   void Fill(const BDSOutputROOTEventInfo* other);
   
-  ClassDef(BDSOutputROOTEventInfo, 7);
+  ClassDef(BDSOutputROOTEventInfo, 8);
 };
 
 #endif
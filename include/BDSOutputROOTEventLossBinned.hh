@@ -0,0 +1,61 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSOUTPUTROOTEVENTLOSSBINNED_H
+#define BDSOUTPUTROOTEVENTLOSSBINNED_H
+
+#include "TObject.h"
+
+#include <vector>
+
+/**
+ * @brief Energy deposition per event summed into bins of S for each beam line element.
+ *
+ * There is one entry for each combination of S bin, beam line element and optionally
+ * turn and particle class with any energy deposited in the event. The turn and particle
+ * class are only filled if the energy deposition is binned by them.
+ */
+
+class BDSOutputROOTEventLossBinned: public TObject
+{
+public:
+  BDSOutputROOTEventLossBinned();
+  virtual ~BDSOutputROOTEventLossBinned();
+
+  int                n = 0;     ///< Number of entries.
+  std::vector<float> S;         ///< Centre of the S bin in m.
+  std::vector<int>   modelID;   ///< Geometry model index.
+  std::vector<int>   turn;      ///< Turn number.
+  std::vector<int>   partClass; ///< Particle class: 0 photon, 1 e+-, 2 neutron, 3 other hadron or ion, 4 other.
+  std::vector<float> energy;    ///< Sum of the weighted energy deposited in GeV.
+
+  /// Add one bin. Negative turn and particle class values aren't stored.
+  void Fill(float sIn,
+	    int   modelIDIn,
+	    int   turnIn,
+	    int   partClassIn,
+	    float energyIn);
+  
+  /// Fill from another instance.
+  void Fill(const BDSOutputROOTEventLossBinned* other);
+  virtual void Flush();
+
+  ClassDef(BDSOutputROOTEventLossBinned,1);
+};
+
+#endif
@@ -41,8 +41,6 @@ namespace BDS
 }
 #endif
 
-class BDSAuxiliaryNavigator;
-
 #if 0
 0  fNotDefined,
   1  fTransportation,
@@ -155,15 +153,14 @@ public:
 
   /// Fill an trajectory point with index 'i' into the IndividualTrajectory struct
   /// (basic C++ / ROOT types) from Geant4 types from 'traj' trajectory for 1 track.
+  /// modelIndices are the beam line indices of the points of the trajectory.
   void FillIndividualTrajectory(IndividualTrajectory& itj,
 				BDSTrajectory*        traj,
 				int                   i,
+				const std::vector<int>& modelIndices,
 				const std::map<G4Material*, short int>& materialToID) const;
 #endif
 
-  /// Required to find beamline index careful including in streamer.
-  BDSAuxiliaryNavigator* auxNavigator; //! add comment to avoid warning (no need to make persistent, see issue #191)
-  
   virtual void Flush();
   void FlushLocal(); ///< Non-virtual version for initialising members.
   void Fill(const BDSOutputROOTEventTrajectory* other);
@@ -38,6 +38,7 @@ class BDSOutputROOTEventHeader;
 class BDSOutputROOTEventHistograms;
 class BDSOutputROOTEventInfo;
 class BDSOutputROOTEventLoss;
+class BDSOutputROOTEventLossBinned;
 class BDSOutputROOTEventLossWorld;
 class BDSOutputROOTEventModel;
 class BDSOutputROOTEventOptions;
@@ -168,6 +169,7 @@ protected:
   BDSOutputROOTEventLossWorld*  eLossWorld;         ///< World energy deposition.
   BDSOutputROOTEventLossWorld*  eLossWorldExit;     ///< World exit hits.
   BDSOutputROOTEventLossWorld*  eLossWorldContents; ///< Externally supplied world contents hits.
+  BDSOutputROOTEventLossBinned* eLossBinned;        ///< Energy deposition summed in bins.
   BDSOutputROOTEventAperture*   apertureImpacts;    ///< Impacts on the aperture.
   BDSOutputROOTEventTrajectory* traj;               ///< Trajectories.
   BDSOutputROOTEventHistograms* evtHistos;          ///< Event level histograms.
@@ -19,14 +19,24 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSPSCELLFLUX4D_H
 #define BDSPSCELLFLUX4D_H
 #include "BDSBH4DTypeDefs.hh"
+#include "BDSScorerHitsMap.hh"
 
 #include "G4PSCellFlux3D.hh"
 #include "G4String.hh"
 #include "G4Types.hh"
 
+#include <memory>
+#include <vector>
+
 class BDSHistBinMapper;
+class G4HCofThisEvent;
+class G4Step;
+class G4TouchableHistory;
 
 /** @brief Primitive scorer for cell flux in a 4D mesh.
+ *
+ * The cell flux is calculated as in G4PSCellFlux3D but the values are stored in
+ * a BDSScorerHitsMap rather than a G4THitsMap.
  *
  * @author Eliott Ramoisiaux
  */
@@ -46,11 +56,25 @@ public:
 		  G4int depi = 2, G4int depj = 1, G4int depk = 0);
   
   virtual ~BDSPSCellFlux4D() override {;}
+
+  void   Initialize(G4HCofThisEvent* HCE) override;
+  void   EndOfEvent(G4HCofThisEvent* HCE) override;
+  void   clear() override;
+  void   PrintAll() override;
+
+  /// Whether to multiply the cell flux by the track weight. Hides the base class
+  /// function as the base class flag is private.
+  void Weighted(G4bool flag = true);
   
 protected:
+  G4bool ProcessHits(G4Step* aStep, G4TouchableHistory*) override;
   G4int GetIndex(G4Step* aStep) override;
   
 private:
+  G4int             HCID4D;   ///< Collection ID.
+  BDSScorerHitsMap* evtMap4D; ///< Hits map.
+  std::vector<std::unique_ptr<BDSScorerHitsMap::Buffer> > buffers; ///< Storage reused between events.
+  G4bool            weighted;
   G4int fDepthi;
   G4int fDepthj;
   G4int fDepthk;
@@ -19,10 +19,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSPSCELLFLUXSCALED3D_H
 #define BDSPSCELLFLUXSCALED3D_H
 
+#include "BDSScorerHitsMap.hh"
+
 #include "globals.hh"
-#include "G4THitsMap.hh"
 #include "G4VPrimitiveScorer.hh"
 
+#include <map>
+#include <memory>
+#include <vector>
+
 class BDSHistBinMapper;
 class G4PhysicsVector;
 
@@ -34,7 +39,8 @@ class G4PhysicsVector;
  * default is none and just a factor of 1.
  *
  * The implementation also differs from G4PSCellFlux3D as we cache the volume
- * to avoid repeated calculation.
+ * to avoid repeated calculation and the values are stored in a BDSScorerHitsMap
+ * rather than a G4THitsMap.
  * 
  * @author Robin Tesse
  */
@@ -65,6 +71,7 @@ public:
   void   Initialize(G4HCofThisEvent* HCE) override;
   void   EndOfEvent(G4HCofThisEvent* HCE) override;
   void   clear() override;
+  void   PrintAll() override;
   G4bool ProcessHits(G4Step* aStep, G4TouchableHistory*) override;
   G4int  GetIndex(G4Step* aStep) override;
   
@@ -76,7 +83,8 @@ private:
   void DefineUnitAndCategory() const;
 
   G4int                 HCID3D;   ///< Collection ID.
-  G4THitsMap<G4double>* evtMap3D; ///< Hits map.
+  BDSScorerHitsMap*     evtMap3D; ///< Hits map.
+  std::vector<std::unique_ptr<BDSScorerHitsMap::Buffer> > buffers; ///< Storage reused between events.
   
   /// @{ Depth in replica to look for each dimension.
   G4int fDepthi;
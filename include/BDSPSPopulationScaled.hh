@@ -18,13 +18,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSPSPOPULATIONSCALED_H
 #define BDSPSPOPULATIONSCALED_H
+#include "BDSScorerHitsMap.hh"
+
 #include "G4String.hh"
-#include "G4THitsMap.hh"
 #include "G4TrackLogger.hh"
 #include "G4Types.hh"
 #include "G4VPrimitiveScorer.hh"
 
 #include <map>
+#include <memory>
 #include <vector>
 
 class G4PhysicsVector;
@@ -74,7 +76,8 @@ public:
   
 private:
   G4int HCID;
-  G4THitsMap<G4double>* EvtMap;
+  BDSScorerHitsMap* EvtMap;
+  std::vector<std::unique_ptr<BDSScorerHitsMap::Buffer> > buffers; ///< Storage reused between events.
   
   std::map<G4int, G4TrackLogger>  fCellTrackLogger;
   std::map< G4int, std::map<G4int, G4PhysicsVector*> > conversionFactors;
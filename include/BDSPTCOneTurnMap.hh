@@ -24,8 +24,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // Geant4 typedefs
 #include "G4Track.hh"
 
-#include <vector>
+#include <array>
 #include <set>
+#include <vector>
 
 class BDSParticleDefinition;
 
@@ -34,6 +35,11 @@ class BDSParticleDefinition;
  *
  * This class uses PTC units internally for calculating the result of the map.
  *
+ * The terms of all five outputs are merged at load time into one list of
+ * unique monomials, each with a coefficient per output. To evaluate the map,
+ * each power of each variable is calculated once by multiplication and all
+ * outputs are accumulated together.
+ *
  * @author Stuart Walker.
  */
 
@@ -55,10 +61,23 @@ public:
   BDSPTCOneTurnMap(BDSPTCOneTurnMap &&other) noexcept = default; ///< Move constructor. 
   virtual ~BDSPTCOneTurnMap() {;}                                ///< Destructor.
 
+  /// Number of variables (and outputs) of the map.
+  static const G4int nVariables = 5;
+
   /// Main constructor with path to maptable file.
   BDSPTCOneTurnMap(const G4String& maptableFile,
 		   const BDSParticleDefinition* designParticle);
 
+  /// Constructor with the terms of each output (in the order x, px, y, py, deltaP)
+  /// already prepared, e.g. from BDS::GenerateOneTurnMap.
+  BDSPTCOneTurnMap(const std::array<std::vector<PTCMapTerm>, nVariables>& terms,
+		   const BDSParticleDefinition* designParticle);
+
+  /// Set the half widths in x, px, y, py and deltaP (PTC units) of the box the map is
+  /// valid in, e.g. the one it was fitted over. A warning is printed the first time the
+  /// map is applied to coordinates outside it. By default there is no limit.
+  void SetValidRange(const std::array<G4double, nVariables>& halfWidthsIn);
+
   /// Decides whether or not this should be applied. Can add more
   G4bool ShouldApplyToPrimary(G4double momentum, G4int turnstaken);
 
@@ -79,13 +98,30 @@ public:
 		   G4double& pz,
 		   G4int turnstaken);
 
+  /// Apply the map once to n particles in PTC coordinates. Each array is updated in place.
+  void Evaluate(std::size_t n,
+		G4double*   x,
+		G4double*   px,
+		G4double*   y,
+		G4double*   py,
+		G4double*   deltaP) const;
+
 private:
-  G4double Evaluate(std::vector<PTCMapTerm>& terms,
-		    G4double x,
-		    G4double px,
-            G4double y,
-		    G4double py,
-		    G4double deltaP) const;
+  /// A unique product of powers of the variables and its coefficient in each output.
+  struct Monomial
+  {
+    std::array<G4int, nVariables>    powers;
+    std::array<G4double, nVariables> coefficients;
+  };
+
+  /// Merge the terms of each output (in the order x, px, y, py, deltaP) into monomials.
+  void Compile(const std::array<std::vector<PTCMapTerm>, nVariables>& terms);
+
+  /// Apply the map to one set of coordinates (x, px, y, py, deltaP) in place.
+  void Evaluate(std::array<G4double, nVariables>& coords);
+
+  /// Warn once if the coordinates are outside the range set by SetValidRange.
+  void CheckInValidRange(const std::array<G4double, nVariables>& coords);
 
   G4double initialPrimaryMomentum;
   G4bool   beamOffsetS0;
@@ -101,11 +137,15 @@ private:
   G4double pyLastTurn;
   G4double deltaPLastTurn;
 
-  std::vector<PTCMapTerm> xTerms;
-  std::vector<PTCMapTerm> yTerms;
-  std::vector<PTCMapTerm> pxTerms;
-  std::vector<PTCMapTerm> pyTerms;
-  std::vector<PTCMapTerm> deltaPTerms;
+  std::vector<Monomial> monomials;
+  std::array<G4int, nVariables> maxPowers;   ///< Highest power of each variable in any monomial.
+  std::array<G4int, nVariables> powerOffsets;///< Start of each variable in the power table.
+  G4int powerTableSize;
+  std::vector<G4double> powerTable;          ///< Scratch space for single particle evaluation.
+
+  G4bool hasValidRange;
+  std::array<G4double, nVariables> validHalfWidths;
+  G4bool warnedOutsideValidRange;
 };
 
 #endif
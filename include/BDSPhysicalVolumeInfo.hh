@@ -19,7 +19,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSPHYSICALVOLUMEINFO_H
 #define BDSPHYSICALVOLUMEINFO_H
 
+#include "G4RotationMatrix.hh"
 #include "G4String.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh" // geant4 types / globals
 
 class BDSBeamline;
@@ -74,6 +76,18 @@ public:
   inline BDSBeamline* GetBeamlineMassWorld() const {return beamlineMassWorld;}
   inline G4int        GetBeamlineMassWorldIndex() const {return beamlineMassWorldIndex;}
   /// @}
+
+  /// Set the curvilinear frame of the beam line element this volume belongs to, i.e. the
+  /// reference rotation and position at the middle of the element.
+  void SetCurvilinearFrame(const G4RotationMatrix& rotation,
+			   const G4ThreeVector&    position);
+
+  /// Whether the curvilinear frame has been set.
+  inline G4bool HasCurvilinearFrame() const {return hasCurvilinearFrame;}
+
+  /// Transform a global point into the curvilinear frame. Only valid if it's been set.
+  inline G4ThreeVector GlobalToCurvilinear(const G4ThreeVector& globalPosition) const
+  {return curvilinearRotationInverse * (globalPosition - curvilinearOrigin);}
   
 private:
   BDSPhysicalVolumeInfo();
@@ -88,6 +102,12 @@ private:
   BDSBeamline* beamlineMassWorld;
   /// Corresponding mass world beam line index - also may be the same as beamlineIndex.
   G4int        beamlineMassWorldIndex;
+
+  /// @{ Curvilinear frame of the beam line element.
+  G4bool           hasCurvilinearFrame;
+  G4RotationMatrix curvilinearRotationInverse;
+  G4ThreeVector    curvilinearOrigin;
+  /// @}
 };
 
 
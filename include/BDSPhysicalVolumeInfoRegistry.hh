@@ -24,8 +24,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <iterator>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 class G4VPhysicalVolume;
+class G4VTouchable;
 class BDSBeamlineElement;
 class BDSPhysicalVolumeInfo;
 
@@ -49,6 +51,11 @@ typedef std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*>::const_iterator BDS
  * volumes of a component will lead to polluting the main register with many more
  * volumes. This can be revisited and simplified if we force / require that every
  * element has a read out volume.
+ *
+ * A third register holds info for the placements of the mass world beam line elements
+ * in the world volume along with the curvilinear frame of each element. Any volume
+ * inside an element can be identified from its touchable with one look up and without
+ * navigating the curvilinear world.
  * 
  * @author Laurie Nevay
  */
@@ -86,6 +93,16 @@ public:
   BDSPhysicalVolumeInfo* GetInfo(G4VPhysicalVolume* logicalVolume,
 				 G4bool             isTunnel = false);
 
+  /// Register info, which must have its curvilinear frame set, for the physical volumes
+  /// placed in the world volume for a mass world beam line element.
+  void RegisterMassWorldInfo(const std::set<G4VPhysicalVolume*>& physicalVolumes,
+			     BDSPhysicalVolumeInfo* info);
+
+  /// Get the info of the mass world beam line element a touchable is inside of from the
+  /// volume at the level below the world in its history. Returns nullptr if that volume
+  /// isn't registered, e.g. for volumes that aren't part of a beam line element.
+  const BDSPhysicalVolumeInfo* GetInfo(const G4VTouchable* touchable) const;
+
   /// Register a pointer to exclude from the search. If the registry is queried with
   /// one of these pointers, it immediately returns a nullptr without complaint. This
   /// registers the pointer to (hopefully small) member vector that is queried before
@@ -132,6 +149,7 @@ private:
   std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> readOutRegister;
   std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> backupRegister;
   std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> tunnelRegister;
+  std::unordered_map<const G4VPhysicalVolume*, const BDSPhysicalVolumeInfo*> massWorldRegister;
   std::set<G4VPhysicalVolume*> excludedVolumes;
   
   std::set<BDSPhysicalVolumeInfo*> pvInfosForDeletion;
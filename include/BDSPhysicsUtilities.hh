@@ -116,6 +116,11 @@ namespace BDS
   /// Build muon splitting biasing and wrap the various processes in the physics list.
   void BuildMuonBiasing(G4VModularPhysicsList* physicsList);
 
+  /// If the fastVacuumTransport option is on, register fast simulation for the beam
+  /// particle so BDSFastVacuumTransportModel can be used.
+  void BuildFastVacuumTransport(G4VModularPhysicsList*       physicsList,
+				const BDSParticleDefinition* beamParticle);
+
 #if G4VERSION_NUMBER > 1039
   /// Build the physics required for channelling to work correctly.
   G4VModularPhysicsList* ChannellingPhysicsComplete(G4bool useEMD  = false,
@@ -20,12 +20,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSPRIMARYGENERATORACTION_H
 
 #include "BDSExtent.hh"
+#include "BDSParticleCoordsFullGlobal.hh"
 
 #include "globals.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+#include <deque>
+
+class BDSBatchTransport;
 class BDSBunch;
 class BDSOutputLoader;
+class BDSParticleDefinition;
 class BDSPrimaryGeneratorFile;
 class BDSPTCOneTurnMap;
 class G4Event;
@@ -59,10 +64,30 @@ public:
   /// Register a PTC map instance used in the teleporter which this
   /// class will set initial (first turn) primary coordinates for.
   void RegisterPTCOneTurnMap(BDSPTCOneTurnMap* otmIn) {oneTurnMap = otmIn;}
+
+  /// Set the design particle the beam line is built for. Required for screening primaries.
+  inline void SetDesignParticle(const BDSParticleDefinition* designParticleIn) {designParticle = designParticleIn;}
   
 private:
   /// For a file-based event generator there are a few checks we have to do - put in a function to keep tidy.
   void GeneratePrimariesFromFile(G4Event* anEvent);
+
+  /// A primary that should be simulated as it was predicted to approach an aperture.
+  struct ScreenedPrimary
+  {
+    G4String seedStateBefore;  ///< Seed state before the coordinates were generated.
+    long     eventSeed;        ///< Seed for the random numbers used to simulate it.
+    BDSParticleCoordsFullGlobal coords;
+    long long int nScreenedBefore; ///< Number of primaries screened out since the previous one.
+  };
+
+  /// Generate and screen batches of primaries until at least one is to be simulated. Returns
+  /// false if none could be found.
+  G4bool FillScreenedPrimaries();
+
+  /// Draw a seed from the current engine for the random numbers used to simulate an event
+  /// whose coordinates have just been generated when screening primaries.
+  static long DrawEventSeed();
   
   G4ParticleGun* particleGun;     ///< Geant4 particle gun that creates single particles.
   BDSBunch* bunch;                ///< BDSIM particle generator.
@@ -85,6 +110,16 @@ private:
   BDSPTCOneTurnMap* oneTurnMap;
 
   BDSPrimaryGeneratorFile* generatorFromFile;
+
+  /// @{ Screening of primaries by batched linear transport.
+  G4bool   screenPrimaries;
+  G4bool   reseedEachEvent;   ///< Simulate each event with a seed drawn after its coordinates.
+  G4int    screenBatchSize;
+  const BDSParticleDefinition* designParticle;
+  BDSBatchTransport* batchTransport;
+  std::deque<ScreenedPrimary> screenedPrimaries;
+  long long int nScreenedSinceLast;
+  /// @}
 };
 
 #endif
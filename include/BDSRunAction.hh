@@ -30,6 +30,7 @@ class BDSBunch;
 class BDSEventAction;
 class BDSEventInfo;
 class BDSOutput;
+class BDSOutputEventQueue;
 class G4Run;
 
 /**
@@ -38,6 +39,9 @@ class G4Run;
  * Unlike the regular Geant4 run action we call a beginning of run
  * action on the bunch distribution (when we know the number of events
  * to run).
+ *
+ * In a multi-threaded run, only the master's instance opens, fills and closes
+ * the output. It has no event action.
  */
 
 class BDSRunAction: public G4UserRunAction
@@ -53,8 +57,16 @@ public:
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
 
+  /// Set the queue the workers' events are written through. The master starts and
+  /// finishes it with each run.
+  inline void SetOutputQueue(BDSOutputEventQueue* outputQueueIn) {outputQueue = outputQueueIn;}
+
 private:
   BDSRunAction() = delete;
+
+  /// Start the run information and open and fill the output file with the
+  /// run independent information. Only done by the master.
+  void BeginOfRunOutput(const G4Run* aRun);
   
   /// Iterate over all particles and print out all process names for each. This
   /// is private as using at the wrong time will result in Geant4 crashing.
@@ -80,6 +92,7 @@ private:
   BDSEventAction* eventAction;    ///< Event action for updating information at start of run.
   G4String        trajectorySamplerID; ///< Copy of option.
   unsigned long long int nEventsRequested; ///< Cache of ngenerate.
+  BDSOutputEventQueue* outputQueue; ///< Only in a multi-threaded run. Not owned.
 };
 
 #endif
@@ -20,8 +20,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSSDENERGYDEPOSITION_H
 
 #include "BDSHitEnergyDeposition.hh"
+#include "BDSHitEnergyDepositionBinned.hh"
 #include "BDSSensitiveDetector.hh"
 
+#include <cstddef>
+#include <unordered_map>
+
 class BDSAuxiliaryNavigator;
 
 class G4HCofThisEvent;
@@ -36,6 +40,11 @@ class G4Track;
  * a change in energy. This assigns the energy deposition to a point randomly (uniformly)
  * along the step.  It also uses a BDSAuxiliaryNavigator instance to use transforms from
  * the curvilinear parallel world for curvilinear coordinates.
+ *
+ * Optionally, the energy deposited can also be summed in each event into bins of S
+ * (of width elossHistoBinWidth), beam line element and optionally turn and particle
+ * class in a second hits collection with one hit per bin. If storeSteps is false, this
+ * is done instead of making a hit for every step.
  */
 
 class BDSSDEnergyDeposition: public BDSSensitiveDetector
@@ -43,7 +52,9 @@ class BDSSDEnergyDeposition: public BDSSensitiveDetector
 public:
   BDSSDEnergyDeposition(const G4String& name,
 			G4bool          storeExtrasIn,
-			G4bool          killedParticleMassAddedToElossIn = false);
+			G4bool          killedParticleMassAddedToElossIn = false,
+			G4bool          storeBinnedIn = false,
+			G4bool          storeStepsIn  = true);
   virtual ~BDSSDEnergyDeposition();
   
   /// assignment and copy constructor not implemented nor used
@@ -68,14 +79,64 @@ public:
 
   /// Provide access to last hit.
   virtual G4VHit* last() const;
+
+  /// Name of the collection of binned hits.
+  inline G4String BinnedCollectionName() const {return colNameBinned;}
   
 private:
+  /// Add a deposit to the binned hit for its bin, making the hit if it's the
+  /// first deposit in that bin in this event.
+  void AddToBin(G4double energyWeighted,
+		G4double sHit,
+		G4int    beamlineIndex,
+		G4int    turnsTaken,
+		G4int    pdgID);
+
+  /// Key of a bin for the binned hits.
+  struct BinKey
+  {
+    G4int sBin;
+    G4int beamlineIndex;
+    G4int turn;
+    G4int particleClass;
+    inline G4bool operator==(const BinKey& other) const
+    {
+      return sBin == other.sBin && beamlineIndex == other.beamlineIndex &&
+	turn == other.turn && particleClass == other.particleClass;
+    }
+  };
+
+  /// Hash of a bin key.
+  struct BinKeyHash
+  {
+    inline std::size_t operator()(const BinKey& k) const
+    {
+      std::size_t h = std::hash<G4int>()(k.sBin);
+      h = h * 1000003u ^ std::hash<G4int>()(k.beamlineIndex);
+      h = h * 1000003u ^ std::hash<G4int>()(k.turn);
+      return h * 1000003u ^ std::hash<G4int>()(k.particleClass);
+    }
+  };
+
   G4bool   storeExtras;     ///< Whether to store extra information.
   G4bool   killedParticleMassAddedToEloss; ///< In the case of a G4Track being deposited
   G4String colName;         ///< Collection name.
   BDSHitsCollectionEnergyDeposition* hits;
   G4int    HCIDe;
 
+  G4bool   storeBinned;      ///< Whether to sum the energy deposited into bins.
+  G4bool   storeSteps;       ///< Whether to make a hit for each step.
+  G4bool   binTurn;          ///< Whether to bin by turn.
+  G4bool   binParticleClass; ///< Whether to bin by particle class.
+  G4double binWidth;         ///< Width of the S bins.
+  G4double binOrigin;        ///< S at the start of the first bin.
+  G4String colNameBinned;    ///< Binned collection name.
+  BDSHitsCollectionEnergyDepositionBinned* binnedHits;
+  G4int    HCIDBinned;
+
+  /// Binned hit for each bin with any energy deposited in this event.
+  std::unordered_map<BinKey, BDSHitEnergyDepositionBinned*, BinKeyHash> binnedHitsMap;
+
   /// Navigator for checking points in read out geometry
   BDSAuxiliaryNavigator* auxNavigator;
 };
@@ -60,6 +60,10 @@ class G4VSDFilter;
  * Each sensitive detector class
  * need only be instantiated once and attached to the relevant
  * volume. This instantiates all necessary SDs and holds them.
+ *
+ * There is one instance per thread as sensitive detectors accumulate
+ * the hits of the event being processed. Each worker thread swaps the
+ * SDs attached on the master for its own (matched by name).
  * 
  * @author Laurie Nevay
  */
@@ -195,7 +199,7 @@ private:
   /// Private default constructor for singleton.
   BDSSDManager();
  
-  static BDSSDManager* instance;
+  static G4ThreadLocal BDSSDManager* instance;
 
   /// @{ SD instance.
   BDSSDSampler*                samplerPlane;
@@ -250,6 +254,8 @@ private:
   G4bool   storeApertureImpactsIons;
   G4double apertureImpactsMinimumKE;
   G4bool   generateELossHits;
+  G4bool   generateELossBinnedHits;
+  G4bool   generateELossStepHits;
   G4bool   generateELossVacuumHits;
   G4bool   generateELossTunnelHits;
   G4bool   generateELossWorldContents;
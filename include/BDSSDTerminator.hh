@@ -38,7 +38,7 @@ public:
   virtual void   EndOfEvent (G4HCofThisEvent* HCE);
 
   /// Externally accessible counter for event number. Set in BeginOfEventAction.
-  static G4int eventNumber;
+  static G4ThreadLocal G4int eventNumber;
 
 private:
   G4int moduloEvents; ///< Cache of print turn number on these events.
@@ -0,0 +1,132 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSCORERHITSMAP_H
+#define BDSSCORERHITSMAP_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4VHitsCollection.hh"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class G4VHit;
+
+/**
+ * @brief Hits collection of one value per scorer cell stored in a flat array.
+ * 
+ * This replaces G4THitsMap<G4double> for BDSIM primitive scorers where the number of
+ * cells is known (e.g. from BDSHistBinMapper). Adding to a cell is an array access
+ * rather than a std::map lookup and a heap allocated value per cell. The indices of the
+ * cells with something added are recorded in order so the output only visits those.
+ *
+ * The collection doesn't own its storage. Each scorer keeps its Buffers for the whole
+ * run and wraps a free one in a new collection for each event (Geant4 deletes the
+ * collection with the event). A Buffer is zeroed once when it's allocated and only the
+ * cells that were added to are reset when it's reused, so the cost per event doesn't
+ * scale with the size of the mesh. A Buffer stays in use until the collection wrapping
+ * it is deleted, so an event kept for later writing doesn't have its values overwritten
+ * by the next event - another Buffer is allocated instead.
+ *
+ * If an index beyond the size is added, the storage is enlarged, so a size of 0 may be
+ * given if the number of cells isn't known. Negative indices are ignored.
+ */
+
+class BDSScorerHitsMap: public G4VHitsCollection
+{
+public:
+  /// Storage of the cells owned by a scorer and reused between events.
+  class Buffer
+  {
+  public:
+    explicit Buffer(G4int sizeIn);
+
+    /// Reset only the cells that have had a value added.
+    void Clear();
+
+    std::vector<G4double> values;  ///< Value per cell.
+    std::vector<char>     touched; ///< Whether each cell has had a value added.
+    std::vector<G4int>    indices; ///< Cells with a value in the order first added to.
+    G4bool inUse;                  ///< Whether a collection currently wraps this buffer.
+  };
+
+  /// Return a Buffer from buffers that isn't in use, cleared, or allocate a new
+  /// one of sizeIn cells if they're all in use.
+  static Buffer* FreeBuffer(std::vector<std::unique_ptr<Buffer> >& buffers,
+			    G4int sizeIn = 0);
+
+  /// The buffer is not owned and is marked in use until this collection is deleted.
+  BDSScorerHitsMap(const G4String& detectorName,
+		   const G4String& collectionName,
+		   Buffer*         bufferIn);
+  virtual ~BDSScorerHitsMap() override;
+
+  /// @{ Copying not implemented.
+  BDSScorerHitsMap(const BDSScorerHitsMap&) = delete;
+  BDSScorerHitsMap& operator=(const BDSScorerHitsMap&) = delete;
+  /// @}
+
+  /// Add a value to a cell.
+  inline void Add(G4int index, G4double value);
+
+  /// Value of a cell - 0 if nothing has been added to it.
+  inline G4double At(G4int index) const;
+
+  /// Indices of cells that have had a value added in the order they were first added to.
+  inline const std::vector<G4int>& Indices() const {return buffer->indices;}
+
+  /// Reset only the cells that have had a value added.
+  void Clear() {buffer->Clear();}
+
+  /// Number of cells with a value.
+  virtual std::size_t GetSize() const override {return buffer->indices.size();}
+
+  /// There are no G4VHit objects in this collection.
+  virtual G4VHit* GetHit(std::size_t) const override {return nullptr;}
+
+  virtual void PrintAllHits() override;
+
+private:
+  /// Enlarge the storage so that it includes index.
+  void Enlarge(G4int index);
+
+  Buffer* buffer; ///< Storage - we don't own this.
+};
+
+inline void BDSScorerHitsMap::Add(G4int index, G4double value)
+{
+  if (index < 0)
+    {return;}
+  if (index >= (G4int)buffer->values.size())
+    {Enlarge(index);}
+  if (!buffer->touched[index])
+    {
+      buffer->touched[index] = 1;
+      buffer->indices.push_back(index);
+    }
+  buffer->values[index] += value;
+}
+
+inline G4double BDSScorerHitsMap::At(G4int index) const
+{
+  return index >= 0 && index < (G4int)buffer->values.size() ? buffer->values[index] : 0;
+}
+
+#endif
@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 #include "G4UserTrackingAction.hh"
 
+#include <unordered_map>
+
 class BDSEventAction;
 class G4Track;
 
@@ -45,7 +47,10 @@ public:
   
   virtual ~BDSTrackingAction(){;}
 
-  /// Used to decide whether or not to store trajectories.
+  /// Used to decide whether or not to store trajectories. In batch mode, the trajectory
+  /// filters that can be decided at the start of a track are applied here so no trajectory
+  /// is built for a track that would be discarded. If required to connect other trajectories,
+  /// a skeleton trajectory is built instead.
   virtual void PreUserTrackingAction(const G4Track* track);
 
   /// Detect whether track is a primary and if so whether it ended in a collimator.
@@ -65,6 +70,11 @@ private:
   /// Cache of event action to communicate whether a primary stopped in a collimator or not.
   BDSEventAction* eventAction;
 
+  /// Depth in the tree of each track started in the current event. Tracks are always
+  /// started after their parent, so the depth is known without any trajectory.
+  std::unordered_map<G4int, G4int> trackDepths;
+  G4int trackDepthsEventIndex; ///< Event index the track depths are for.
+
   G4int  verboseSteppingEventStart;
   G4int  verboseSteppingEventStop;
   G4bool verboseSteppingPrimaryOnly;
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <bitset>
 #include <map>
 #include <utility>
+#include <vector>
 
 class BDSTrajectory;
 
@@ -46,6 +47,11 @@ public:
   
   std::map<BDSTrajectory*, bool> trajectories;
   std::map<BDSTrajectory*, std::bitset<BDS::NTrajectoryFilters> > filtersMatched;
+
+  /// Beam line index of the volume at each point of each stored trajectory (-1 if none
+  /// or the point isn't stored). Found by the thread that tracked the event as this needs
+  /// geometry navigation, which the output writer thread can't do.
+  std::map<BDSTrajectory*, std::vector<int> > modelIndices;
 };
 
 #endif
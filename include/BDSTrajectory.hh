@@ -46,7 +46,8 @@ public:
   BDSTrajectory() = delete;
   BDSTrajectory(const G4Track* aTrack,
 		G4bool         interactiveIn,
-		const BDS::TrajectoryOptions& storageOptionsIn);
+		const BDS::TrajectoryOptions& storageOptionsIn,
+		G4bool         skeletonIn = false);
   /// copy constructor is not needed
   BDSTrajectory(BDSTrajectory &) = delete;
 
@@ -57,7 +58,8 @@ public:
   inline int operator == (const BDSTrajectory& right) const {return (this==&right);}
 
   /// Append a step point to this trajectory. This is required for the trajectory
-  /// points to show up in the visualisation correctly.
+  /// points to show up in the visualisation correctly. If a skeleton, only steps
+  /// that create secondaries and the last step of the track are kept.
   virtual void AppendStep(const G4Step* aStep);
 
   /// Append a step point. Use a pre-made BDSTrajectoryPoint to save creating
@@ -81,6 +83,10 @@ public:
   /// Method to identify which one is a primary. Overridden in derived class.
   virtual G4bool IsPrimary() const {return false;}
 
+  /// Whether this trajectory only keeps the points required to connect its
+  /// secondaries to it. Such a trajectory is only stored to connect others.
+  inline G4bool IsSkeleton() const {return skeleton;}
+
   /// The index of the trajectory assigned in the output from the reduced set of
   /// indices. This is why it will not be the same as the track ID.
   inline void  SetTrajIndex(G4int trajIndexIn)                 {trajIndex = trajIndexIn;}
@@ -95,7 +101,7 @@ public:
   inline void  SetParentStepIndex(G4int parentStepIndexIn)     {parentStepIndex = parentStepIndexIn;}
   inline G4int GetParentStepIndex()                      const {return parentStepIndex;}
   
-  /// Depth in the tree. Will be filled later once all trajectories are created and sorted.
+  /// Depth in the tree. Set by the tracking action when the track starts.
   inline G4int GetDepth() const {return depth;}
   inline void SetDepth(G4int depthIn) {depth = depthIn;}
 
@@ -126,6 +132,7 @@ protected:
   G4int          parentIndex;
   G4int          parentStepIndex;
   G4int          depth;
+  G4bool         skeleton;
 
   /// Container of all points. This is really a vector so all memory is dynamically
   /// allocated and there's no need to make this dynamically allocated itself a la
@@ -133,7 +140,7 @@ protected:
   BDSTrajectoryPointsContainer* fpBDSPointsContainer;
 };
 
-extern G4Allocator<BDSTrajectory> bdsTrajectoryAllocator;
+extern G4ThreadLocal G4Allocator<BDSTrajectory> bdsTrajectoryAllocator;
 
 inline void* BDSTrajectory::operator new(size_t)
 {
@@ -197,11 +197,11 @@ private:
   G4Material*   material;         ///< Material point for pre-step point
 
   /// An auxiliary navigator to get curvilinear coordinates. Lots of points, but only
-  /// need one navigator so make it static.
-  static BDSAuxiliaryNavigator* auxNavigator;
+  /// need one navigator (per thread) so make it static.
+  static G4ThreadLocal BDSAuxiliaryNavigator* auxNavigator;
 };
 
-extern G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
+extern G4ThreadLocal G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
 
 inline void* BDSTrajectoryPoint::operator new(size_t)
 {
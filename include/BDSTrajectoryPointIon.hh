@@ -53,7 +53,7 @@ private:
   BDSTrajectoryPointIon() = delete;
 };
 
-extern G4Allocator<BDSTrajectoryPointIon> BDSAllocatorTrajectoryPointIon;
+extern G4ThreadLocal G4Allocator<BDSTrajectoryPointIon> BDSAllocatorTrajectoryPointIon;
 
 inline void* BDSTrajectoryPointIon::operator new(size_t)
 {
@@ -53,7 +53,7 @@ private:
   BDSTrajectoryPointLink() = delete;
 };
 
-extern G4Allocator<BDSTrajectoryPointLink> BDSAllocatorTrajectoryPointLink;
+extern G4ThreadLocal G4Allocator<BDSTrajectoryPointLink> BDSAllocatorTrajectoryPointLink;
 
 inline void* BDSTrajectoryPointLink::operator new(size_t)
 {
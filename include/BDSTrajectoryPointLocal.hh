@@ -49,7 +49,7 @@ private:
   BDSTrajectoryPointLocal() = delete;
 };
 
-extern G4Allocator<BDSTrajectoryPointLocal> BDSAllocatorTrajectoryPointLocal;
+extern G4ThreadLocal G4Allocator<BDSTrajectoryPointLocal> BDSAllocatorTrajectoryPointLocal;
 
 inline void* BDSTrajectoryPointLocal::operator new(size_t)
 {
@@ -88,7 +88,7 @@ public:
 
   /// Whether this primary has scattered on this turn.  It should be
   /// reset at the end of each turn. This is static so it can be done externally.
-  static G4bool hasScatteredThisTurn;
+  static G4ThreadLocal G4bool hasScatteredThisTurn;
 
 protected:
   BDSTrajectoryPoint* firstHit;  ///< Point owned by this class for the first scattering point.
@@ -100,7 +100,7 @@ private:
   BDSTrajectoryPrimary() = delete; ///< No default constructor required.
 };
 
-extern G4Allocator<BDSTrajectoryPrimary> bdsTrajectoryPrimaryAllocator;
+extern G4ThreadLocal G4Allocator<BDSTrajectoryPrimary> bdsTrajectoryPrimaryAllocator;
 
 inline void* BDSTrajectoryPrimary::operator new(size_t)
 {
@@ -0,0 +1,53 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSWORKERRUNMANAGER_H
+#define BDSWORKERRUNMANAGER_H
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4WorkerRunManager.hh"
+
+class BDSOutputEventQueue;
+
+/**
+ * @brief Run manager of each worker thread in a multi-threaded run.
+ *
+ * The only difference to G4WorkerRunManager is that aborting the run on a worker
+ * (e.g. a distribution that can't generate any more events) also abandons the output
+ * queue. Otherwise the events allocated to the worker never arrive and the writer,
+ * the other workers and the master all wait for them.
+ */
+
+class BDSWorkerRunManager: public G4WorkerRunManager
+{
+public:
+  explicit BDSWorkerRunManager(BDSOutputEventQueue* outputQueueIn);
+  virtual ~BDSWorkerRunManager(){;}
+
+  /// Abandon the output queue then run G4WorkerRunManager::AbortRun().
+  virtual void AbortRun(G4bool softAbort = false);
+
+private:
+  BDSWorkerRunManager() = delete;
+  
+  BDSOutputEventQueue* outputQueue; ///< Not owned.
+};
+
+#endif
+#endif
@@ -0,0 +1,48 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSWORKERTHREADINITIALIZATION_H
+#define BDSWORKERTHREADINITIALIZATION_H
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4UserWorkerThreadInitialization.hh"
+
+class BDSOutputEventQueue;
+class G4WorkerRunManager;
+
+/**
+ * @brief Construct a BDSWorkerRunManager for each worker thread.
+ */
+
+class BDSWorkerThreadInitialization: public G4UserWorkerThreadInitialization
+{
+public:
+  explicit BDSWorkerThreadInitialization(BDSOutputEventQueue* outputQueueIn);
+  virtual ~BDSWorkerThreadInitialization(){;}
+
+  virtual G4WorkerRunManager* CreateWorkerRunManager() const;
+
+private:
+  BDSWorkerThreadInitialization() = delete;
+  
+  BDSOutputEventQueue* outputQueue; ///< Not owned.
+};
+
+#endif
+#endif
@@ -66,7 +66,7 @@ public:
                                           const G4Step& step);
   
   /// Counter for understanding occurence.
-  static G4int nCallsThisEvent;
+  static G4ThreadLocal G4int nCallsThisEvent;
   
 private:
   G4int splittingFactor;
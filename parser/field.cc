@@ -58,6 +58,8 @@ void Field::clear()
   electricSubField = "";
   magneticReflection = "";
   electricReflection = "";
+  magneticStorage = "";
+  electricStorage = "";
   fieldParameters = "";
 }
 
@@ -93,6 +95,8 @@ void Field::PublishMembers()
   publish("electricSubField",     &Field::electricSubField);
   publish("magneticReflection",   &Field::magneticReflection);
   publish("electricReflection",   &Field::electricReflection);
+  publish("magneticStorage",      &Field::magneticStorage);
+  publish("electricStorage",      &Field::electricStorage);
   publish("fieldParameters",      &Field::fieldParameters);
 }
 
@@ -121,5 +125,7 @@ void Field::print()const
             << "magneticSubField "     << magneticSubField     << std::endl
             << "magneticReflection "   << magneticReflection   << std::endl
             << "electricReflection "   << electricReflection   << std::endl
+            << "magneticStorage "      << magneticStorage      << std::endl
+            << "electricStorage "      << electricStorage      << std::endl
             << "fieldParameters "      << fieldParameters      << std::endl;
 }
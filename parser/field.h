@@ -80,6 +80,11 @@ namespace GMAD
 
     std::string magneticReflection;
     std::string electricReflection;
+
+    /// @{ How to store the field map values in memory.
+    std::string magneticStorage;
+    std::string electricStorage;
+    /// @}
     
     std::string fieldParameters;
     
@@ -207,6 +207,8 @@ void Options::PublishMembers()
   publish("useASCIISeedState",     &Options::useASCIISeedState);
   publish("seedStateFileName",     &Options::seedStateFileName);
   publish("ngenerate",             &Options::nGenerate);
+  publish("nThreads",              &Options::nThreads);
+  publish("nJobs",                 &Options::nJobs);
   publish("generatePrimariesOnly", &Options::generatePrimariesOnly);
   publish("exportGeometry",        &Options::exportGeometry);
   publish("exportType",            &Options::exportType);
@@ -260,11 +262,16 @@ void Options::PublishMembers()
   publish("includeIronMagFields", &Options::yokeFields); // for backwards compatibility
   publish("yokeFieldsMatchLHCGeometry", &Options::yokeFieldsMatchLHCGeometry);
   publish("useOldMultipoleOuterFields", &Options::useOldMultipoleOuterFields);
+  publish("yokeFieldsInterpolated",     &Options::yokeFieldsInterpolated);
+  publish("yokeFieldsInterpolatedNPoints", &Options::yokeFieldsInterpolatedNPoints);
   publish("scalingFieldOuter",    &Options::scalingFieldOuter);
   publish("integrateKineticEnergyAlongBeamline", &Options::integrateKineticEnergyAlongBeamline);
   publish("cavityFieldType",      &Options::cavityFieldType);
+  publish("cavityFieldTabulatedBessel", &Options::cavityFieldTabulatedBessel);
   publish("includeFringeFields",  &Options::includeFringeFields);
   publish("includeFringeFieldsCavities", &Options::includeFringeFieldsCavities);
+  publish("fieldMapSharedMemory", &Options::fieldMapSharedMemory);
+  publish("fieldMapCubicTableMaxSize", &Options::fieldMapCubicTableMaxSize);
   publish("beampipeRadius",       &Options::aper1);
   publish("beampipeThickness",    &Options::beampipeThickness);
   publish("apertureType",         &Options::apertureType);
@@ -367,6 +374,8 @@ void Options::PublishMembers()
   // options which influence tracking
   publish("integratorSet",            &Options::integratorSet);
   publish("fieldModulator",           &Options::fieldModulator);
+  publish("modulatorsTabulated",      &Options::modulatorsTabulated);
+  publish("modulatorsTabulatedNPoints", &Options::modulatorsTabulatedNPoints);
   publish("lengthSafety",             &Options::lengthSafety);
   publish("lengthSafetyLarge",        &Options::lengthSafetyLarge);
   publish("maximumTrackingTime",      &Options::maximumTrackingTime);
@@ -390,6 +399,10 @@ void Options::PublishMembers()
   publish("teleporterFullTransform",  &Options::teleporterFullTransform);
   publish("dEThresholdForScattering", &Options::dEThresholdForScattering);
   publish("backupStepperMomLimit",    &Options::backupStepperMomLimit);
+  publish("fastVacuumTransport",      &Options::fastVacuumTransport);
+  publish("screenPrimaries",          &Options::screenPrimaries);
+  publish("screenPrimariesBatchSize", &Options::screenPrimariesBatchSize);
+  publish("screenPrimariesApertureMargin", &Options::screenPrimariesApertureMargin);
 
   // hit generation
   publish("sensitiveOuter",              &Options::sensitiveOuter);
@@ -421,6 +434,10 @@ void Options::PublishMembers()
   publish("storeELoss",                     &Options::storeEloss);
   publish("storeElossHistograms",           &Options::storeElossHistograms);
   publish("storeELossHistograms",           &Options::storeElossHistograms);
+  publish("storeElossBinned",               &Options::storeElossBinned);
+  publish("storeELossBinned",               &Options::storeElossBinned);
+  publish("storeElossBinnedParticleClass",  &Options::storeElossBinnedParticleClass);
+  publish("storeELossBinnedParticleClass",  &Options::storeElossBinnedParticleClass);
   publish("storeElossVacuum",               &Options::storeElossVacuum);
   publish("storeELossVacuum",               &Options::storeElossVacuum);
   publish("storeElossVacuumHistograms",     &Options::storeElossVacuumHistograms);
@@ -510,6 +527,11 @@ void Options::PublishMembers()
   // circular options
   publish("nturns",                   &Options::nturns);
   publish("ptcOneTurnMapFileName",    &Options::ptcOneTurnMapFileName);
+  publish("oneTurnMapFromModel",      &Options::oneTurnMapFromModel);
+  publish("oneTurnMapFromModelOrder", &Options::oneTurnMapFromModelOrder);
+  publish("oneTurnMapFromModelMaxOffset", &Options::oneTurnMapFromModelMaxOffset);
+  publish("oneTurnMapFromModelMaxAngle",  &Options::oneTurnMapFromModelMaxAngle);
+  publish("oneTurnMapFromModelMaxDeltaP", &Options::oneTurnMapFromModelMaxDeltaP);
 
   publish("printModuloFraction",      &Options::printFractionEvents); // alternative name
   publish("printFractionEvents",      &Options::printFractionEvents);
@@ -72,6 +72,8 @@ OptionsBase::OptionsBase()
   seed                  = -1;
   randomEngine          = "hepjames";
   nGenerate             = 1;
+  nThreads              = 1;
+  nJobs                 = 1;
   recreate              = false;
   recreateFileName      = "";
   startFromEvent        = 0;
@@ -140,14 +142,19 @@ OptionsBase::OptionsBase()
   dontSplitSBends      = false;
   includeFringeFields  = true;
   includeFringeFieldsCavities = true;
+  fieldMapSharedMemory = false;
+  fieldMapCubicTableMaxSize = 1024;
 
   yokeFields           = true;
   yokeFieldsMatchLHCGeometry = true;
   useOldMultipoleOuterFields = false;
+  yokeFieldsInterpolated     = false;
+  yokeFieldsInterpolatedNPoints = 201;
   scalingFieldOuter    = 1.0;
   integrateKineticEnergyAlongBeamline = true;
   
   cavityFieldType = "constantinz";
+  cavityFieldTabulatedBessel = false;
   
   // beam pipe / aperture
   beampipeThickness    = 0.0025;
@@ -243,6 +250,8 @@ OptionsBase::OptionsBase()
   // tracking options
   integratorSet            = "bdsimmatrix";
   fieldModulator           = "";
+  modulatorsTabulated      = false;
+  modulatorsTabulatedNPoints = 1000;
   lengthSafety             = 1e-9;   // be very careful adjusting this as it affects all the geometry
   lengthSafetyLarge        = 1e-6;   // be very careful adjusting this as it affects all the geometry
   maximumTrackingTime      = -1;      // s, nonsensical - used for testing
@@ -256,6 +265,10 @@ OptionsBase::OptionsBase()
   teleporterFullTransform  = true;
   dEThresholdForScattering = 1e-11; // GeV
   backupStepperMomLimit    = 0.1;   // fraction of unit momentum
+  fastVacuumTransport      = false;
+  screenPrimaries          = false;
+  screenPrimariesBatchSize = 4096;
+  screenPrimariesApertureMargin = 1e-3; // m
 
   // default value in Geant4, old value 0 - error must be greater than this
   minimumEpsilonStep       = 1e-12;   // used to be 1e-25 but since v11.1 this has to be greater than double precision
@@ -291,6 +304,8 @@ OptionsBase::OptionsBase()
   collimatorHitsMinimumKE    = 0;
   storeEloss                 = true;
   storeElossHistograms       = true;
+  storeElossBinned           = false;
+  storeElossBinnedParticleClass = false;
   storeElossVacuum           = false;
   storeElossVacuumHistograms = false;
   storeElossTunnel           = false;
@@ -359,6 +374,11 @@ OptionsBase::OptionsBase()
   // circular options
   nturns                   = 1;
   ptcOneTurnMapFileName    = "";
+  oneTurnMapFromModel      = false;
+  oneTurnMapFromModelOrder = 3;
+  oneTurnMapFromModelMaxOffset = 5e-3; // m
+  oneTurnMapFromModelMaxAngle  = 5e-4; // rad
+  oneTurnMapFromModelMaxDeltaP = 0.05;
 
   printFractionEvents   = 0.1;
   printFractionTurns    = 0.2;
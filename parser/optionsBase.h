@@ -92,6 +92,8 @@ namespace GMAD
     int  seed;                     ///< The seed value for the random number generator
     std::string randomEngine;      ///< Name of random engine to use.
     int  nGenerate;                ///< The number of primary events to simulate
+    int  nThreads;                 ///< Number of threads to process events with.
+    int  nJobs;                    ///< Number of forked processes to split the events between.
     bool recreate;                 ///< Whether to recreate from a file or not.
     std::string recreateFileName;  ///< The file path to recreate a run from.
     int  startFromEvent;           ///< Event to start from when recreating.
@@ -173,14 +175,22 @@ namespace GMAD
     bool      yokeFields;
     bool      yokeFieldsMatchLHCGeometry;
     bool      useOldMultipoleOuterFields;
+    bool      yokeFieldsInterpolated;
+    int       yokeFieldsInterpolatedNPoints;
     double    scalingFieldOuter;
     bool      integrateKineticEnergyAlongBeamline;
     
     std::string cavityFieldType;
+    bool        cavityFieldTabulatedBessel;
 
     bool        includeFringeFields;
     bool        includeFringeFieldsCavities;
 
+    /// share loaded field maps between processes on the same machine
+    bool        fieldMapSharedMemory;
+    /// largest coefficient table in MB for the cubictable interpolator
+    double      fieldMapCubicTableMaxSize;
+
     ///@{ default beampipe parameters
     double      beampipeThickness;
     std::string apertureType;
@@ -283,6 +293,8 @@ namespace GMAD
     // tracking related parameters
     std::string integratorSet;
     std::string fieldModulator;
+    bool     modulatorsTabulated;
+    int      modulatorsTabulatedNPoints;
     double   lengthSafety;
     double   lengthSafetyLarge;
     double   maximumTrackingTime; ///< Maximum tracking time per track [s].
@@ -305,6 +317,10 @@ namespace GMAD
     bool     teleporterFullTransform;     ///< Whether to use the new Transform3D method for the teleporter.
     double   dEThresholdForScattering;
     double   backupStepperMomLimit;    ///< Fractional momentum limit for reverting to backup steppers.
+    bool     fastVacuumTransport;      ///< Transport paraxial primaries through whole vacuum volumes.
+    bool     screenPrimaries;          ///< Only simulate primaries predicted to approach an aperture.
+    int      screenPrimariesBatchSize;
+    double   screenPrimariesApertureMargin;
 
     // hit generation - only two parts that go in the same collection / branch
     bool      sensitiveOuter;
@@ -329,6 +345,8 @@ namespace GMAD
     double      collimatorHitsMinimumKE;
     bool        storeEloss;
     bool        storeElossHistograms;
+    bool        storeElossBinned;
+    bool        storeElossBinnedParticleClass;
     bool        storeElossVacuum;
     bool        storeElossVacuumHistograms;
     bool        storeElossTunnel;
@@ -399,6 +417,11 @@ namespace GMAD
     // circular options
     int         nturns;
     std::string ptcOneTurnMapFileName;
+    bool        oneTurnMapFromModel;      ///< Generate a one turn map by tracking through the model.
+    int         oneTurnMapFromModelOrder;
+    double      oneTurnMapFromModelMaxOffset;  ///< Half width in x and y the generated map is fitted over.
+    double      oneTurnMapFromModelMaxAngle;   ///< Half width in px and py the generated map is fitted over.
+    double      oneTurnMapFromModelMaxDeltaP;  ///< Half width in momentum the generated map is fitted over.
 
     double   printFractionEvents;
     double   printFractionTurns;
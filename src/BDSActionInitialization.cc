@@ -0,0 +1,144 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSActionInitialization.hh"
+#include "BDSBunch.hh"
+#include "BDSBunchFactory.hh"
+#include "BDSDetectorConstruction.hh"
+#include "BDSEventAction.hh"
+#include "BDSFieldFactory.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSPrimaryGeneratorAction.hh"
+#include "BDSRunAction.hh"
+#include "BDSStackingAction.hh"
+#include "BDSSteppingAction.hh"
+#include "BDSTrackingAction.hh"
+#include "BDSUtilities.hh"
+
+#include "parser/beam.h"
+
+#include "G4AutoLock.hh"
+#include "G4EventManager.hh"
+#include "G4Threading.hh"
+#include "G4TrackingManager.hh"
+
+namespace
+{
+  /// Guard the list of worker bunches as the workers are built at the same time.
+  G4Mutex workerBunchMutex = G4MUTEX_INITIALIZER;
+}
+
+BDSActionInitialization::BDSActionInitialization(BDSOutput*                   outputIn,
+                                                 BDSBunch*                    bunchIn,
+                                                 const GMAD::Beam&            beamIn,
+                                                 const BDSParticleDefinition* designParticleIn,
+                                                 const BDSDetectorConstruction* detectorIn,
+                                                 BDSOutputEventQueue*         outputQueueIn):
+  output(outputIn),
+  bunch(bunchIn),
+  beam(beamIn),
+  designParticle(designParticleIn),
+  detector(detectorIn),
+  outputQueue(outputQueueIn)
+{;}
+
+BDSActionInitialization::~BDSActionInitialization()
+{
+  for (auto b : workerBunches)
+    {delete b;}
+}
+
+void BDSActionInitialization::BuildForMaster() const
+{
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  BDSRunAction* runAction = new BDSRunAction(output,
+                                             bunch,
+                                             bunch->ParticleDefinition()->IsAnIon(),
+                                             nullptr,
+                                             globals->StoreTrajectorySamplerID());
+  runAction->SetOutputQueue(outputQueue);
+  SetUserAction(runAction);
+}
+
+void BDSActionInitialization::Build() const
+{
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  G4bool isWorker = G4Threading::IsWorkerThread();
+  
+  BDSBunch* threadBunch = bunch;
+  if (isWorker)
+    {
+      // the random engine of this thread is already set up so the distribution uses it
+      threadBunch = BDSBunchFactory::CreateBunch(bunch->ParticleDefinition(),
+                                                 beam,
+                                                 globals->BeamlineTransform(),
+                                                 globals->BeamlineS(),
+                                                 globals->GeneratePrimariesOnly());
+      G4AutoLock lock(&workerBunchMutex);
+      workerBunches.push_back(threadBunch);
+    }
+  
+  BDSEventAction* eventAction = new BDSEventAction(output);
+  if (isWorker)
+    {eventAction->SetOutputQueue(outputQueue);}
+  SetUserAction(eventAction);
+  
+  SetUserAction(new BDSRunAction(output,
+                                 threadBunch,
+                                 threadBunch->ParticleDefinition()->IsAnIon(),
+                                 eventAction,
+                                 globals->StoreTrajectorySamplerID()));
+  
+  // Only add stepping action if it is actually used, so do check here (for performance reasons)
+  G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
+  G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
+                                                          globals->VerboseSteppingEventContinueFor());
+  if (globals->VerboseSteppingBDSIM())
+    {
+      SetUserAction(new BDSSteppingAction(true,
+                                          verboseSteppingEventStart,
+                                          verboseSteppingEventStop));
+    }
+  
+  SetUserAction(new BDSTrackingAction(globals->Batch(),
+                                      globals->StoreTrajectory(),
+                                      globals->StoreTrajectoryOptions(),
+                                      eventAction,
+                                      verboseSteppingEventStart,
+                                      verboseSteppingEventStop,
+                                      globals->VerboseSteppingPrimaryOnly(),
+                                      globals->VerboseSteppingLevel()));
+
+  SetUserAction(new BDSStackingAction(globals));
+  
+  auto primaryGeneratorAction = new BDSPrimaryGeneratorAction(threadBunch, beam, globals->Batch());
+  primaryGeneratorAction->SetDesignParticle(designParticle);
+  // possibly updated after the primary generator as loaded a beam file
+  eventAction->SetPrintModulo(BDSGlobalConstants::Instance()->PrintModuloEvents());
+  SetUserAction(primaryGeneratorAction);
+  // per thread - the teleporter of this thread registers its one turn map with it
+  BDSFieldFactory::SetPrimaryGeneratorAction(primaryGeneratorAction);
+
+  if (isWorker)
+    {
+      // the geometry is already constructed by the master
+      primaryGeneratorAction->SetWorldExtent(detector->WorldExtent());
+      G4EventManager::GetEventManager()->SetVerboseLevel(globals->VerboseEventLevel());
+      G4EventManager::GetEventManager()->GetTrackingManager()->SetVerboseLevel(globals->VerboseTrackingLevel());
+    }
+}
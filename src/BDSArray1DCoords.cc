@@ -23,19 +23,26 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <array>
 #include <cmath>
+#include <memory>
 #include <ostream>
 #include <limits>
 #include <set>
+#include <utility>
 #include <vector>
 
 BDSArray1DCoords::BDSArray1DCoords(G4int            nXIn,
 				   G4double         xMinIn,
 				   G4double         xMaxIn,
-				   BDSDimensionType dimensionIn):
+				   BDSDimensionType dimensionIn,
+				   BDSFieldValue*        externalData,
+				   std::shared_ptr<void> externalDataOwner):
   BDSArray2DCoords(nXIn,1,
 		   xMinIn,xMaxIn,
 		   0,   1,
-		   dimensionIn)
+		   dimensionIn,
+		   BDSDimensionType::y,
+		   externalData,
+		   std::move(externalDataOwner))
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
@@ -22,8 +22,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <array>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "globals.hh"
@@ -32,13 +34,18 @@ BDSArray2DCoords::BDSArray2DCoords(G4int nXIn, G4int nYIn,
 				   G4double xMinIn, G4double xMaxIn,
 				   G4double yMinIn, G4double yMaxIn,
 				   BDSDimensionType xDimensionIn,
-				   BDSDimensionType yDimensionIn):
+				   BDSDimensionType yDimensionIn,
+				   BDSFieldValue*        externalData,
+				   std::shared_ptr<void> externalDataOwner):
   BDSArray3DCoords(nXIn,nYIn,1,
 		   xMinIn,xMaxIn,
 		   yMinIn,yMaxIn,
 		   0,   1,
 		   xDimensionIn,
-		   yDimensionIn)
+		   yDimensionIn,
+		   BDSDimensionType::z,
+		   externalData,
+		   std::move(externalDataOwner))
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
@@ -19,8 +19,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSArray3DCoords.hh"
 
 #include <cmath>
+#include <memory>
 #include <ostream>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "globals.hh"
@@ -31,7 +33,9 @@ BDSArray3DCoords::BDSArray3DCoords(G4int nXIn, G4int nYIn, G4int nZIn,
 				   G4double zMinIn, G4double zMaxIn,
 				   BDSDimensionType xDimensionIn,
 				   BDSDimensionType yDimensionIn,
-				   BDSDimensionType zDimensionIn):
+				   BDSDimensionType zDimensionIn,
+				   BDSFieldValue*        externalData,
+				   std::shared_ptr<void> externalDataOwner):
   BDSArray4DCoords(nXIn,nYIn,nZIn,1,
 		   xMinIn,xMaxIn,
 		   yMinIn,yMaxIn,
@@ -39,7 +43,10 @@ BDSArray3DCoords::BDSArray3DCoords(G4int nXIn, G4int nYIn, G4int nZIn,
 		   0,   1,
 		   xDimensionIn,
 		   yDimensionIn,
-		   zDimensionIn)
+		   zDimensionIn,
+		   BDSDimensionType::t,
+		   externalData,
+		   std::move(externalDataOwner))
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
@@ -17,30 +17,188 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSArray4D.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSFieldValue.hh"
 
 #include "globals.hh" // geant4 types / globals
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+  /// Reduced precision data must be converted on access, but GetConst returns by
+  /// reference. The array may be shared between worker threads, so each thread
+  /// converts into its own value. A pointer as G4ThreadLocal may require a trivial type.
+  G4ThreadLocal BDSFieldValue* decodedValue = nullptr;
+}
+
 
 BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn):
+  BDSArray4D(nXIn, nYIn, nZIn, nTIn, nullptr, nullptr)
+{;}
+
+BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+                       BDSFieldValue*        externalData,
+                       std::shared_ptr<void> externalDataOwner):
   nX(nXIn), nY(nYIn), nZ(nZIn), nT(nTIn),
   defaultValue(BDSFieldValue()),
-  data(std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn))
+  externalOwner(nullptr),
+  data(nullptr),
+  bricked(false),
+  nBX(0),
+  nBY(0),
+  nBZ(0),
+  storageType(BDSArrayStorageType::standard),
+  fixedScale(0)
+{
+  if (externalData)
+    {
+      externalOwner = std::move(externalDataOwner);
+      data = externalData;
+    }
+  else
+    {
+      ownedData = std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn);
+      data = ownedData.data();
+    }
+}
+
+BDSArray4D::BDSArray4D(const BDSArray4D& other):
+  nX(other.nX), nY(other.nY), nZ(other.nZ), nT(other.nT),
+  defaultValue(other.defaultValue),
+  ownedData(other.ownedData),
+  externalOwner(other.externalOwner),
+  data(other.ExternalData() ? other.data : (ownedData.empty() ? nullptr : ownedData.data())),
+  bricked(other.bricked),
+  nBX(other.nBX),
+  nBY(other.nBY),
+  nBZ(other.nBZ),
+  storageType(other.storageType),
+  floatData(other.floatData),
+  fixedData(other.fixedData),
+  fixedScale(other.fixedScale)
 {;}
 
+void BDSArray4D::ConvertStorage(BDSArrayStorageType storageTypeIn)
+{
+  if (storageTypeIn == storageType)
+    {return;}
+  if (storageType != BDSArrayStorageType::standard)
+    {throw BDSException(__METHOD_NAME__, "array storage type can only be converted once");}
+
+  std::size_t n = StoredSize();
+  switch (storageTypeIn.underlying())
+    {
+    case BDSArrayStorageType::float32:
+      {
+        floatData.reserve(n);
+        for (std::size_t i = 0; i < n; i++)
+          {floatData.emplace_back((G4float)data[i].x(), (G4float)data[i].y(), (G4float)data[i].z());}
+        break;
+      }
+    case BDSArrayStorageType::int16:
+      {// a single scale for all components so the direction of each vector is preserved
+        FIELDTYPET maxAbs = 0;
+        for (std::size_t i = 0; i < n; i++)
+          {maxAbs = std::max({maxAbs, std::abs(data[i].x()), std::abs(data[i].y()), std::abs(data[i].z())});}
+        const FIELDTYPET maxInt = (FIELDTYPET)std::numeric_limits<std::int16_t>::max();
+        fixedScale = maxAbs > 0 ? maxAbs / maxInt : (FIELDTYPET)1;
+        fixedData.reserve(3*n);
+        for (std::size_t i = 0; i < n; i++)
+          {
+            fixedData.push_back((std::int16_t)std::lround(data[i].x() / fixedScale));
+            fixedData.push_back((std::int16_t)std::lround(data[i].y() / fixedScale));
+            fixedData.push_back((std::int16_t)std::lround(data[i].z() / fixedScale));
+          }
+        break;
+      }
+    default:
+      {break;}
+    }
+  storageType = storageTypeIn;
+  // release the full precision data
+  std::vector<BDSFieldValue>().swap(ownedData);
+  externalOwner = nullptr;
+  data = nullptr;
+}
+
+void BDSArray4D::ConvertToBricked()
+{
+  if (bricked)
+    {return;}
+  if (storageType != BDSArrayStorageType::standard)
+    {throw BDSException(__METHOD_NAME__, "array must be bricked before the storage type is converted");}
+
+  G4int nBXNew = (nX + brickSize - 1) / brickSize;
+  G4int nBYNew = (nY + brickSize - 1) / brickSize;
+  G4int nBZNew = (nZ + brickSize - 1) / brickSize;
+  std::size_t nBricks = (std::size_t)nT * nBZNew * nBYNew * nBXNew;
+  std::vector<BDSFieldValue> brickedData(nBricks * brickSize * brickSize * brickSize);
+
+  // fill the new storage using the index calculation for the bricked layout
+  const BDSFieldValue* linearData = data;
+  bricked = true;
+  nBX = nBXNew;
+  nBY = nBYNew;
+  nBZ = nBZNew;
+  std::size_t linearIndex = 0;
+  for (G4int t = 0; t < nT; t++)
+    {
+      for (G4int z = 0; z < nZ; z++)
+        {
+          for (G4int y = 0; y < nY; y++)
+            {
+              for (G4int x = 0; x < nX; x++)
+                {brickedData[StorageIndex(x,y,z,t)] = linearData[linearIndex++];}
+            }
+        }
+    }
+  ownedData.swap(brickedData);
+  std::vector<BDSFieldValue>().swap(brickedData);
+  externalOwner = nullptr;
+  data = ownedData.data();
+}
+
+G4double BDSArray4D::BrickedPaddingRatio() const
+{
+  auto padded = [](G4int n){return (G4double)(((n + brickSize - 1) / brickSize) * brickSize);};
+  return padded(nX) * padded(nY) * padded(nZ) / ((G4double)nX * nY * nZ);
+}
+
+std::size_t BDSArray4D::StoredSize() const
+{
+  if (bricked)
+    {return (std::size_t)nT * nBZ * nBY * nBX * brickSize * brickSize * brickSize;}
+  else
+    {return Size();}
+}
+
+std::size_t BDSArray4D::MemoryUsage() const
+{
+  return ownedData.size() * sizeof(BDSFieldValue)
+    + floatData.size() * sizeof(BDSThreeVector<G4float>)
+    + fixedData.size() * sizeof(std::int16_t);
+}
+
 BDSFieldValue& BDSArray4D::operator()(G4int x,
 				      G4int y,
 				      G4int z,
 				      G4int t)
 {
   OutsideWarn(x,y,z,t); // keep as a warning as can't assign to invalid index
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  if (!data)
+    {throw BDSException(__METHOD_NAME__, "values cannot be set once the array storage type has been converted");}
+  return data[StorageIndex(x,y,z,t)];
 }
 
 const BDSFieldValue& BDSArray4D::GetConst(G4int x,
@@ -50,7 +208,23 @@ const BDSFieldValue& BDSArray4D::GetConst(G4int x,
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  std::size_t index = StorageIndex(x,y,z,t);
+  if (storageType == BDSArrayStorageType::standard)
+    {return data[index];}
+  
+  if (!decodedValue)
+    {decodedValue = new BDSFieldValue();}
+  if (storageType == BDSArrayStorageType::float32)
+    {
+      const BDSThreeVector<G4float>& v = floatData[index];
+      *decodedValue = BDSFieldValue((FIELDTYPET)v.x(), (FIELDTYPET)v.y(), (FIELDTYPET)v.z());
+    }
+  else
+    {
+      const std::int16_t* v = &fixedData[3*index];
+      *decodedValue = BDSFieldValue(v[0]*fixedScale, v[1]*fixedScale, v[2]*fixedScale);
+    }
+  return *decodedValue;
 }
   
 const BDSFieldValue& BDSArray4D::operator()(G4int x,
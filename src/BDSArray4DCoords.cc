@@ -28,8 +28,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 
 #include "globals.hh"
 
@@ -41,8 +43,10 @@ BDSArray4DCoords::BDSArray4DCoords(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTI
                                    BDSDimensionType xDimensionIn,
                                    BDSDimensionType yDimensionIn,
                                    BDSDimensionType zDimensionIn,
-                                   BDSDimensionType tDimensionIn):
-  BDSArray4D(nXIn,nYIn,nZIn,nTIn),
+                                   BDSDimensionType tDimensionIn,
+                                   BDSFieldValue*        externalData,
+                                   std::shared_ptr<void> externalDataOwner):
+  BDSArray4D(nXIn,nYIn,nZIn,nTIn,externalData,std::move(externalDataOwner)),
   xMin(xMinIn), xMax(xMaxIn),
   yMin(yMinIn), yMax(yMaxIn),
   zMin(zMinIn), zMax(zMaxIn),
@@ -0,0 +1,65 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArrayStorageType.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <map>
+#include <string>
+
+// dictionary for BDSArrayStorageType
+template<>
+std::map<BDSArrayStorageType, std::string>* BDSArrayStorageType::dictionary =
+  new std::map<BDSArrayStorageType, std::string> ({
+  {BDSArrayStorageType::standard, "standard"},
+  {BDSArrayStorageType::float32,  "float"},
+  {BDSArrayStorageType::int16,    "int16"}
+});
+
+BDSArrayStorageType BDS::DetermineArrayStorageType(G4String arrayStorageType)
+{
+  if (arrayStorageType.empty())
+    {return BDSArrayStorageType::standard;}
+  
+  std::map<G4String, BDSArrayStorageType> types;
+  types["standard"] = BDSArrayStorageType::standard;
+  types["float"]    = BDSArrayStorageType::float32;
+  types["int16"]    = BDSArrayStorageType::int16;
+
+  arrayStorageType = BDS::LowerCase(arrayStorageType);
+
+  auto result = types.find(arrayStorageType);
+  if (result == types.end())
+    {// it's not a valid key
+      G4String msg = "\"" + arrayStorageType + "\" is not a valid array storage type\n";
+      msg += "Available array storage types are:\n";
+      for (const auto& it : types)
+        {msg += "\"" + it.first + "\"\n";}
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+  
+#ifdef BDSDEBUG
+  G4cout << __METHOD_NAME__ << " determined array storage type to be " << result->second << G4endl;
+#endif
+  return result->second;
+}
@@ -21,16 +21,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSStep.hh"
 #include "BDSUtilities.hh"
 
+#include "G4LogicalVolume.hh"
 #include "G4Navigator.hh"
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 #include "G4StepStatus.hh"
 #include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
 
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigator             = new G4Navigator();
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCL           = new G4Navigator();
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCLB          = new G4Navigator();
-G4int              BDSAuxiliaryNavigator::numberOfInstances        = 0;
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigator      = nullptr;
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigatorCL    = nullptr;
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigatorCLB   = nullptr;
+G4ThreadLocal G4int        BDSAuxiliaryNavigator::numberOfInstances = 0;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::worldPV                  = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearWorldPV       = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearBridgeWorldPV = nullptr;
@@ -43,6 +46,7 @@ BDSAuxiliaryNavigator::BDSAuxiliaryNavigator():
   bridgeVolumeWasUsed(false),
   volumeMargin(0.1*CLHEP::mm)
 {
+  InitialiseNavigators();
   numberOfInstances++;
 }
 
@@ -58,8 +62,52 @@ BDSAuxiliaryNavigator::~BDSAuxiliaryNavigator()
   numberOfInstances--;
 }
 
+void BDSAuxiliaryNavigator::InitialiseNavigators()
+{
+  if (!auxNavigator)
+    {
+      auxNavigator = new G4Navigator();
+      if (worldPV)
+        {auxNavigator->SetWorldVolume(worldPV);}
+    }
+  if (!auxNavigatorCL)
+    {
+      auxNavigatorCL = new G4Navigator();
+      if (curvilinearWorldPV)
+        {auxNavigatorCL->SetWorldVolume(curvilinearWorldPV);}
+    }
+  if (!auxNavigatorCLB)
+    {
+      auxNavigatorCLB = new G4Navigator();
+      if (curvilinearBridgeWorldPV)
+        {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPV);}
+    }
+}
+
+void BDSAuxiliaryNavigator::AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
+{
+  worldPV = worldPVIn;
+  InitialiseNavigators();
+  auxNavigator->SetWorldVolume(worldPVIn);
+}
+
+void BDSAuxiliaryNavigator::AttachWorldVolumeToNavigatorCL(G4VPhysicalVolume* curvilinearWorldPVIn)
+{
+  curvilinearWorldPV = curvilinearWorldPVIn;
+  InitialiseNavigators();
+  auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn);
+}
+
+void BDSAuxiliaryNavigator::RegisterCurvilinearBridgeWorld(G4VPhysicalVolume* curvilinearBridgeWorldPVIn)
+{
+  curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn;
+  InitialiseNavigators();
+  auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn);
+}
+
 void BDSAuxiliaryNavigator::ResetNavigatorStates()
 {
+  InitialiseNavigators();
   auxNavigator->ResetStackAndState();
   auxNavigatorCL->ResetStackAndState();
   auxNavigatorCLB->ResetStackAndState();
@@ -198,17 +246,25 @@ BDSStep BDSAuxiliaryNavigator::ConvertToLocal(const G4ThreeVector& globalPositio
   else if (stepLength > 0) // must be a shorter length, obey it
     {point += globalDirUnit * (stepLength * 0.5);}
   // else pass: point = globalPosition
-  
-  auto selectedVol = LocateGlobalPointAndSetup(point,
-                                               &globalDirection,
-                                               true,  // relative search
-                                               false, // don't ignore direction, ie use it
-                                               useCurvilinear);
+
+  // if still inside the last volume we found, the navigator isn't required
+  VolumeCache& cache = useCurvilinear ? cacheCL : cacheMass;
+  G4VPhysicalVolume* selectedVol = nullptr;
+  if (UseCache(cache, point, useCurvilinear))
+    {selectedVol = cache.volume;}
+  else
+    {
+      selectedVol = LocateGlobalPointAndSetup(point,
+                                              &globalDirection,
+                                              true,  // relative search
+                                              false, // don't ignore direction, ie use it
+                                              useCurvilinear);
 #ifdef BDSDEBUGNAV
-  G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
+      G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
 #endif
-  
-  useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      FillCache(cache, selectedVol, useCurvilinear);
+    }
   const G4AffineTransform& aff = GlobalToLocal(useCurvilinear);
   G4ThreeVector localPos = aff.TransformPoint(globalPosition);
   G4ThreeVector localDir = aff.TransformAxis(globalDirection);
@@ -492,12 +548,70 @@ void BDSAuxiliaryNavigator::InitialiseTransform(const G4bool massWorld,
 
 void BDSAuxiliaryNavigator::InitialiseTransform(const G4ThreeVector& globalPosition) const
 {
-  auxNavigator->LocateGlobalPointAndSetup(globalPosition);
-  auxNavigatorCL->LocateGlobalPointAndSetup(globalPosition);
-  globalToLocal = auxNavigator->GetGlobalToLocalTransform();
-  localToGlobal = auxNavigator->GetLocalToGlobalTransform();
-  globalToLocalCL = auxNavigatorCL->GetGlobalToLocalTransform();
-  localToGlobalCL = auxNavigatorCL->GetLocalToGlobalTransform();
+  if (!UseCache(cacheMass, globalPosition, false))
+    {
+      G4VPhysicalVolume* massVolume = auxNavigator->LocateGlobalPointAndSetup(globalPosition);
+      globalToLocal = auxNavigator->GetGlobalToLocalTransform();
+      localToGlobal = auxNavigator->GetLocalToGlobalTransform();
+      FillCache(cacheMass, massVolume, false);
+    }
+  if (!UseCache(cacheCL, globalPosition, true))
+    {
+      G4VPhysicalVolume* clVolume = auxNavigatorCL->LocateGlobalPointAndSetup(globalPosition);
+      bridgeVolumeWasUsed = false;
+      globalToLocalCL = auxNavigatorCL->GetGlobalToLocalTransform();
+      localToGlobalCL = auxNavigatorCL->GetLocalToGlobalTransform();
+      FillCache(cacheCL, clVolume, true);
+    }
+}
+
+G4bool BDSAuxiliaryNavigator::UseCache(const VolumeCache&   cache,
+                                       const G4ThreeVector& globalPoint,
+                                       G4bool               curvilinear) const
+{
+  if (!cache.solid)
+    {return false;}
+  G4ThreeVector localPoint = cache.globalToLocal.TransformPoint(globalPoint);
+  if (localPoint.x() < cache.extentMin.x() || localPoint.x() > cache.extentMax.x() ||
+      localPoint.y() < cache.extentMin.y() || localPoint.y() > cache.extentMax.y() ||
+      localPoint.z() < cache.extentMin.z() || localPoint.z() > cache.extentMax.z())
+    {return false;}
+  // points on a surface are left to the navigator as the direction matters there
+  if (cache.solid->Inside(localPoint) != kInside)
+    {return false;}
+  if (curvilinear)
+    {
+      globalToLocalCL     = cache.globalToLocal;
+      localToGlobalCL     = cache.localToGlobal;
+      bridgeVolumeWasUsed = false;
+    }
+  else
+    {
+      globalToLocal = cache.globalToLocal;
+      localToGlobal = cache.localToGlobal;
+    }
+  return true;
+}
+
+void BDSAuxiliaryNavigator::FillCache(VolumeCache&       cache,
+                                      G4VPhysicalVolume* volume,
+                                      G4bool             curvilinear) const
+{
+  cache.solid = nullptr; // invalid until filled
+  // world volumes (including the bridge world) aren't cached as they have daughters and the
+  // bridge volumes are only used where the curvilinear volumes have gaps
+  if (!volume || volume == worldPV || volume == curvilinearWorldPV || volume == curvilinearBridgeWorldPV)
+    {return;}
+  if (curvilinear && bridgeVolumeWasUsed)
+    {return;}
+  G4LogicalVolume* lv = volume->GetLogicalVolume();
+  if (lv->GetNoDaughters() > 0)
+    {return;}
+  cache.volume = volume;
+  cache.solid  = lv->GetSolid();
+  cache.solid->BoundingLimits(cache.extentMin, cache.extentMax);
+  cache.globalToLocal = GlobalToLocal(curvilinear);
+  cache.localToGlobal = LocalToGlobal(curvilinear);
 }
 
 void BDSAuxiliaryNavigator::InitialiseTransform(const G4ThreeVector &globalPosition,
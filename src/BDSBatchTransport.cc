@@ -0,0 +1,514 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAcceleratorComponent.hh"
+#include "BDSBatchTransport.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
+#include "BDSBeamPipeInfo.hh"
+#include "BDSBeamPipeType.hh"
+#include "BDSCollimator.hh"
+#include "BDSCollimatorElliptical.hh"
+#include "BDSCollimatorJaw.hh"
+#include "BDSCollimatorRectangular.hh"
+#include "BDSDrift.hh"
+#include "BDSExtent.hh"
+#include "BDSIntegratorDipoleFringe.hh"
+#include "BDSMagnet.hh"
+#include "BDSMagnetStrength.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSTiltOffset.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh" // geant4 types / globals
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /// Apply a linear focusing map of strength K (u'' = -K u) for length L to u and up.
+  inline void Focus(G4double K, G4double L, G4double& u, G4double& up)
+  {
+    if (K > 1e-20)
+      {
+	G4double w  = std::sqrt(K);
+	G4double c  = std::cos(w*L);
+	G4double s  = std::sin(w*L);
+	G4double u1 = c*u + (s/w)*up;
+	up = -w*s*u + c*up;
+	u  = u1;
+      }
+    else if (K < -1e-20)
+      {
+	G4double w  = std::sqrt(-K);
+	G4double c  = std::cosh(w*L);
+	G4double s  = std::sinh(w*L);
+	G4double u1 = c*u + (s/w)*up;
+	up = w*s*u + c*up;
+	u  = u1;
+      }
+    else
+      {u += L*up;}
+  }
+}
+
+void BDSBatchTransport::Batch::Resize(std::size_t n)
+{
+  x.resize(n);
+  xp.resize(n);
+  y.resize(n);
+  yp.resize(n);
+  qOverP.resize(n);
+  reachedAperture.resize(n);
+}
+
+BDSBatchTransport::BDSBatchTransport(const BDSBeamline*           beamline,
+				     const BDSParticleDefinition* designParticle,
+				     G4double                     apertureMarginIn):
+  apertureMargin(apertureMarginIn),
+  maximumSliceLength(0.5*CLHEP::m),
+  nElementsTransported(0)
+{
+  G4double designMomentum = designParticle->Momentum();
+  for (const auto element : *beamline)
+    {
+      Element e = BuildElement(element, designMomentum);
+      elements.push_back(e);
+      if (e.map == MapType::opaque)
+	{
+	  firstOpaqueElementName = element->GetName();
+	  break; // everything reaching this is marked so nothing beyond it matters
+	}
+      nElementsTransported++;
+    }
+}
+
+BDSBatchTransport::Element BDSBatchTransport::BuildElement(const BDSBeamlineElement* element,
+							   G4double                  designMomentum) const
+{
+  Element e;
+  e.length = element->GetArcLength();
+  G4double elementMomentum = element->GetStartMomentum();
+  if (BDS::IsFinite(elementMomentum) && BDS::IsFinite(designMomentum))
+    {e.rigidityScale = elementMomentum / designMomentum;}
+
+  const BDSTiltOffset* to = element->GetTiltOffset();
+  if (to)
+    {
+      e.dx      = to->GetXOffset();
+      e.dy      = to->GetYOffset();
+      e.cosTilt = std::cos(to->GetTilt());
+      e.sinTilt = std::sin(to->GetTilt());
+      e.misaligned = BDS::IsFinite(e.dx) || BDS::IsFinite(e.dy) || BDS::IsFinite(to->GetTilt());
+    }
+
+  const BDSAcceleratorComponent* component = element->GetAcceleratorComponent();
+  const G4String type = component->GetType();
+  if (type == "teleporter" || type == "terminator")
+    {// these only close a circular machine and have no optical effect
+      e.length = 0;
+      return e;
+    }
+  if (dynamic_cast<const BDSDrift*>(component))
+    {
+      SetBeamPipeAperture(element, e);
+      return e;
+    }
+
+  if (const auto collimator = dynamic_cast<const BDSCollimator*>(component))
+    {
+      G4double xAper = std::min(collimator->XApertureIn(), collimator->XApertureOut());
+      G4double yAper = std::min(collimator->YApertureIn(), collimator->YApertureOut());
+      if (const auto jaw = dynamic_cast<const BDSCollimatorJaw*>(component))
+	{// only the jaws in x limit the aperture - use the narrower of the two half gaps
+	  G4double leftHalfGap  = BDS::IsFinite(jaw->XSizeLeft())  ? jaw->XSizeLeft()  : xAper;
+	  G4double rightHalfGap = BDS::IsFinite(jaw->XSizeRight()) ? jaw->XSizeRight() : xAper;
+	  xAper = std::min(leftHalfGap, rightHalfGap);
+	  G4double maxTilt = std::max(std::abs(jaw->GetJawTiltLeft()), std::abs(jaw->GetJawTiltRight()));
+	  xAper -= 0.5 * e.length * std::tan(maxTilt);
+	  e.aperture = ApertureType::rectangular;
+	  e.a1 = xAper - apertureMargin;
+	  e.a2 = std::numeric_limits<G4double>::max();
+	}
+      else if (dynamic_cast<const BDSCollimatorRectangular*>(component))
+	{
+	  e.aperture = ApertureType::rectangular;
+	  e.a1 = xAper - apertureMargin;
+	  e.a2 = yAper - apertureMargin;
+	}
+      else if (dynamic_cast<const BDSCollimatorElliptical*>(component))
+	{
+	  e.aperture = ApertureType::elliptical;
+	  e.a1 = xAper - apertureMargin;
+	  e.a2 = yAper - apertureMargin;
+	}
+      else
+	{e.map = MapType::opaque;}
+      if (e.a1 <= 0 || e.a2 <= 0) // closed
+	{e.aperture = ApertureType::opaque;}
+      return e;
+    }
+
+  const auto magnet = dynamic_cast<const BDSMagnet*>(component);
+  const BDSMagnetStrength* st = magnet ? magnet->MagnetStrength() : nullptr;
+  if (!st)
+    {
+      if (!BDS::IsFinite(e.length)) // nothing to transport through
+	{return e;}
+      e.map = MapType::opaque;
+      return e;
+    }
+
+  SetBeamPipeAperture(element, e);
+  if (type == "quadrupole")
+    {
+      e.map = MapType::quadrupole;
+      e.k1  = (*st)["k1"] / CLHEP::m2;
+    }
+  else if (type == "sextupole" || type == "octupole" || type == "decapole")
+    {
+      e.map   = MapType::multipole;
+      e.order = type == "sextupole" ? 2 : (type == "octupole" ? 3 : 4);
+      G4String key = "k" + std::to_string(e.order);
+      G4double nFactorial = e.order == 2 ? 2 : (e.order == 3 ? 6 : 24);
+      e.kn = (*st)[key] / (std::pow(CLHEP::m, e.order + 1) * nFactorial);
+    }
+  else if (type == "sbend")
+    {
+      G4double scaling = (*st)["scaling"];
+      if (!BDS::IsFinite(e.length) || BDS::IsFinite(element->GetTilt()) || (BDS::IsFinite(scaling) && scaling != 1))
+	{e.map = MapType::opaque;}
+      else
+	{
+	  e.map = MapType::sbend;
+	  e.h   = component->GetAngle() / e.length;
+	  e.k1  = (*st)["k1"] / CLHEP::m2;
+	}
+    }
+  else if (type == "dipolefringe")
+    {
+      G4double bendLength = (*st)["length"];
+      if (!BDS::IsFinite(bendLength) || BDS::IsFinite(element->GetTilt()))
+	{e.map = MapType::opaque;}
+      else
+	{
+	  G4bool isEntrance = BDS::IsFinite((*st)["isentrance"]);
+	  G4double poleFace = isEntrance ? (*st)["e1"] : (*st)["e2"];
+	  e.map     = MapType::fringe;
+	  e.h       = (*st)["angle"] / bendLength;
+	  e.tanE    = std::tan(poleFace);
+	  e.tanEPsi = std::tan(poleFace - e.h * BDS::FringeFieldCorrection(st, isEntrance));
+	}
+    }
+  else if ((type == "hkicker" || type == "vkicker")
+	   && !BDS::IsFinite((*st)["hkick"]) && !BDS::IsFinite((*st)["vkick"]))
+    {e.map = MapType::drift;} // unpowered corrector
+  else
+    {e.map = MapType::opaque;}
+
+  if (e.map == MapType::quadrupole || e.map == MapType::multipole || e.map == MapType::sbend)
+    {e.nSlices = std::max(1, (G4int)std::ceil(e.length / maximumSliceLength));}
+  return e;
+}
+
+void BDSBatchTransport::SetBeamPipeAperture(const BDSBeamlineElement* element,
+					    Element&                  e) const
+{
+  const BDSBeamPipeInfo* bp = element->GetBeamPipeInfo();
+  if (!bp)
+    {
+      e.aperture = ApertureType::opaque;
+      return;
+    }
+  G4double m = apertureMargin;
+  switch (bp->beamPipeType.underlying())
+    {
+    case BDSBeamPipeType::circular:
+    case BDSBeamPipeType::circularvacuum:
+      {
+	e.aperture = ApertureType::circular;
+	e.a1 = bp->aper1 - m;
+	break;
+      }
+    case BDSBeamPipeType::elliptical:
+      {
+	e.aperture = ApertureType::elliptical;
+	e.a1 = bp->aper1 - m;
+	e.a2 = bp->aper2 - m;
+	break;
+      }
+    case BDSBeamPipeType::rectangular:
+      {
+	e.aperture = ApertureType::rectangular;
+	e.a1 = bp->aper1 - m;
+	e.a2 = bp->aper2 - m;
+	break;
+      }
+    case BDSBeamPipeType::rectellipse:
+      {
+	e.aperture = ApertureType::rectellipse;
+	e.a1 = bp->aper1 - m;
+	e.a2 = bp->aper2 - m;
+	e.a3 = bp->aper3 - m;
+	e.a4 = bp->aper4 - m;
+	break;
+      }
+    case BDSBeamPipeType::lhc:
+    case BDSBeamPipeType::lhcdetailed:
+      {// rectangle and circle
+	e.aperture = ApertureType::rectellipse;
+	e.a1 = bp->aper1 - m;
+	e.a2 = bp->aper2 - m;
+	e.a3 = bp->aper3 - m;
+	e.a4 = bp->aper3 - m;
+	break;
+      }
+    case BDSBeamPipeType::racetrack:
+    case BDSBeamPipeType::octagonal:
+    case BDSBeamPipeType::clicpcl:
+    case BDSBeamPipeType::rhombus:
+      {// a circle that fits inside any of these shapes
+	BDSExtent ext = bp->ExtentInner();
+	e.aperture = ApertureType::circular;
+	e.a1 = std::min(ext.XPos(), ext.YPos()) / std::sqrt(2.0) - m;
+	break;
+      }
+    default:
+      {e.aperture = ApertureType::opaque; break;}
+    }
+  if (e.a1 <= 0 || (e.aperture != ApertureType::circular && e.a2 <= 0))
+    {e.aperture = ApertureType::opaque;}
+}
+
+void BDSBatchTransport::Transport(Batch& batch) const
+{
+  std::size_t n = batch.x.size();
+  std::fill(batch.reachedAperture.begin(), batch.reachedAperture.begin() + n, 0);
+  for (const auto& e : elements)
+    {
+      if (e.map == MapType::opaque)
+	{
+	  std::fill(batch.reachedAperture.begin(), batch.reachedAperture.begin() + n, 1);
+	  return;
+	}
+      if (e.misaligned)
+	{Misalign(e, batch, true);}
+      CheckAperture(e, batch);
+      G4double sliceLength = e.length / (G4double)e.nSlices;
+      for (G4int i = 0; i < e.nSlices; i++)
+	{
+	  Advance(e, sliceLength, batch);
+	  CheckAperture(e, batch);
+	}
+      if (e.misaligned)
+	{Misalign(e, batch, false);}
+    }
+}
+
+void BDSBatchTransport::Advance(const Element& e,
+				G4double       L,
+				Batch&         batch) const
+{
+  const std::size_t n = batch.x.size();
+  G4double* x  = batch.x.data();
+  G4double* xp = batch.xp.data();
+  G4double* y  = batch.y.data();
+  G4double* yp = batch.yp.data();
+  const G4double* qOverP = batch.qOverP.data();
+
+  switch (e.map)
+    {
+    case MapType::drift:
+      {
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    x[i] += L*xp[i];
+	    y[i] += L*yp[i];
+	  }
+	break;
+      }
+    case MapType::quadrupole:
+      {
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double K = e.k1 * qOverP[i] * e.rigidityScale;
+	    Focus(K,  L, x[i], xp[i]);
+	    Focus(-K, L, y[i], yp[i]);
+	  }
+	break;
+      }
+    case MapType::multipole:
+      {// drift - kick - drift with the kick (x+iy)^n
+	G4double halfL = 0.5*L;
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double xm = x[i] + halfL*xp[i];
+	    G4double ym = y[i] + halfL*yp[i];
+	    G4double re = xm;
+	    G4double im = ym;
+	    for (G4int k = 1; k < e.order; k++)
+	      {
+		G4double reNew = re*xm - im*ym;
+		im = re*ym + im*xm;
+		re = reNew;
+	      }
+	    G4double c = e.kn * qOverP[i] * e.rigidityScale * L;
+	    xp[i] -= c*re;
+	    yp[i] += c*im;
+	    x[i] = xm + halfL*xp[i];
+	    y[i] = ym + halfL*yp[i];
+	  }
+	break;
+      }
+    case MapType::sbend:
+      {// x'' = -K x + D with the dispersive term D = h - k0 for this particle's rigidity
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double invR = qOverP[i] * e.rigidityScale;
+	    G4double k0   = e.h * invR;
+	    G4double k1   = e.k1 * invR;
+	    G4double K    = e.h*k0 + k1;
+	    G4double D    = e.h - k0;
+	    if (std::abs(K) > 1e-20)
+	      {
+		G4double xFixed = D / K;
+		G4double u = x[i] - xFixed;
+		Focus(K, L, u, xp[i]);
+		x[i] = u + xFixed;
+	      }
+	    else
+	      {
+		x[i]  += L*xp[i] + 0.5*D*L*L;
+		xp[i] += D*L;
+	      }
+	    Focus(-k1, L, y[i], yp[i]);
+	  }
+	break;
+      }
+    case MapType::fringe:
+      {
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double hEff = e.h * qOverP[i] * e.rigidityScale;
+	    xp[i] += hEff * e.tanE * x[i];
+	    yp[i] -= hEff * e.tanEPsi * y[i];
+	    x[i]  += L*xp[i];
+	    y[i]  += L*yp[i];
+	  }
+	break;
+      }
+    default:
+      {break;}
+    }
+}
+
+void BDSBatchTransport::CheckAperture(const Element& e,
+				      Batch&         batch) const
+{
+  const std::size_t n = batch.x.size();
+  const G4double* x = batch.x.data();
+  const G4double* y = batch.y.data();
+  char* reached = batch.reachedAperture.data();
+
+  switch (e.aperture)
+    {
+    case ApertureType::circular:
+      {
+	G4double r2 = e.a1*e.a1;
+	for (std::size_t i = 0; i < n; i++)
+	  {reached[i] |= (x[i]*x[i] + y[i]*y[i]) >= r2;}
+	break;
+      }
+    case ApertureType::elliptical:
+      {
+	G4double ia = 1.0 / e.a1;
+	G4double ib = 1.0 / e.a2;
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double u = x[i]*ia;
+	    G4double v = y[i]*ib;
+	    reached[i] |= (u*u + v*v) >= 1.0;
+	  }
+	break;
+      }
+    case ApertureType::rectangular:
+      {
+	for (std::size_t i = 0; i < n; i++)
+	  {reached[i] |= std::abs(x[i]) >= e.a1 || std::abs(y[i]) >= e.a2;}
+	break;
+      }
+    case ApertureType::rectellipse:
+      {
+	G4double ia = 1.0 / e.a3;
+	G4double ib = 1.0 / e.a4;
+	for (std::size_t i = 0; i < n; i++)
+	  {
+	    G4double u = x[i]*ia;
+	    G4double v = y[i]*ib;
+	    reached[i] |= std::abs(x[i]) >= e.a1 || std::abs(y[i]) >= e.a2 || (u*u + v*v) >= 1.0;
+	  }
+	break;
+      }
+    case ApertureType::opaque:
+      {
+	std::fill(reached, reached + n, 1);
+	break;
+      }
+    default:
+      {break;}
+    }
+}
+
+void BDSBatchTransport::Misalign(const Element& e,
+				 Batch&         batch,
+				 G4bool         toElement) const
+{
+  const std::size_t n = batch.x.size();
+  G4double* x  = batch.x.data();
+  G4double* xp = batch.xp.data();
+  G4double* y  = batch.y.data();
+  G4double* yp = batch.yp.data();
+  G4double c = e.cosTilt;
+  G4double s = toElement ? -e.sinTilt : e.sinTilt;
+  G4double dx = toElement ? -e.dx : 0;
+  G4double dy = toElement ? -e.dy : 0;
+  for (std::size_t i = 0; i < n; i++)
+    {// offset then rotate going in, rotate then offset coming out
+      G4double xi = x[i] + dx;
+      G4double yi = y[i] + dy;
+      x[i]  = c*xi - s*yi;
+      y[i]  = s*xi + c*yi;
+      G4double xpi = xp[i];
+      xp[i] = c*xpi - s*yp[i];
+      yp[i] = s*xpi + c*yp[i];
+    }
+  if (!toElement)
+    {
+      for (std::size_t i = 0; i < n; i++)
+	{
+	  x[i] += e.dx;
+	  y[i] += e.dy;
+	}
+    }
+}
@@ -0,0 +1,54 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBesselTable.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+
+#include "G4Types.hh"
+
+#include "TMath.h"
+
+#include <vector>
+
+BDSBesselTable::BDSBesselTable(G4double xMaxIn,
+			       G4int    nIntervalsIn):
+  xMax(xMaxIn),
+  nIntervals(nIntervalsIn),
+  h(0),
+  invH(0)
+{
+  if (nIntervals < 1 || !(xMax > 0))
+    {throw BDSException(__METHOD_NAME__, "invalid range or number of points for Bessel table");}
+  h    = xMax / (G4double)nIntervals;
+  invH = 1.0 / h;
+
+  data.resize(4*(nIntervals+1));
+  for (G4int i = 0; i <= nIntervals; i++)
+    {
+      G4double x  = (G4double)i * h;
+      G4double j0 = TMath::BesselJ0(x);
+      G4double j1 = TMath::BesselJ1(x);
+      // J0' = -J1 and J1' = J0 - J1/x, which tends to 1/2 at x = 0
+      G4double dj1 = i == 0 ? 0.5 : j0 - j1/x;
+      data[4*i + 0] = j0;
+      data[4*i + 1] = -j1 * h;
+      data[4*i + 2] = j1;
+      data[4*i + 3] = dj1 * h;
+    }
+}
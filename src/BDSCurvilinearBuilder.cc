@@ -113,6 +113,33 @@ BDSBeamline* BDSCurvilinearBuilder::BuildCurvilinearBeamLine1To1(BDSBeamline con
   return result;
 }
 
+std::map<const BDSBeamlineElement*, const BDSBeamlineElement*>
+BDSCurvilinearBuilder::MatchElements1To1(const BDSBeamline* beamline,
+					 const BDSBeamline* curvilinearBeamline)
+{
+  std::map<const BDSBeamlineElement*, const BDSBeamlineElement*> result;
+  if (!beamline || !curvilinearBeamline)
+    {return result;}
+
+  // the S positions are copied so are identical - the tolerance is only for safety
+  const G4double tolerance = 1e-9*CLHEP::mm;
+  auto clIt = curvilinearBeamline->begin();
+  for (const auto element : *beamline)
+    {
+      G4double s = element->GetSPositionMiddle();
+      while (clIt != curvilinearBeamline->end() && (*clIt)->GetSPositionMiddle() < s - tolerance)
+	{++clIt;}
+      if (clIt == curvilinearBeamline->end())
+	{break;}
+      if (std::abs((*clIt)->GetSPositionMiddle() - s) <= tolerance)
+	{
+	  result[element] = *clIt;
+	  ++clIt; // zero length elements may share the same S
+	}
+    }
+  return result;
+}
+
 void BDSCurvilinearBuilder::PreviousAndNext(BDSBeamline::const_iterator it,
     BDSBeamline::const_iterator startIt,
     BDSBeamline::const_iterator endIt,
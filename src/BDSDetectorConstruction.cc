@@ -39,6 +39,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDetectorConstruction.hh"
 #include "BDSException.hh"
 #include "BDSExtent.hh"
+#include "BDSFastVacuumTransportModel.hh"
 #include "BDSFieldBuilder.hh"
 #include "BDSFieldObjects.hh"
 #include "BDSFieldQuery.hh"
@@ -86,14 +87,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 #include "G4AffineTransform.hh"
 #include "G4Box.hh"
+#include "G4AutoLock.hh"
 #include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
 #include "G4Material.hh"
 #include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
 #include "G4PVPlacement.hh"
 #include "G4VPrimitiveScorer.hh"
 #include "G4Region.hh"
+#include "G4RegionStore.hh"
 #include "G4ScoringManager.hh"
+#include "G4SDManager.hh"
 #include "G4String.hh"
+#include "G4Threading.hh"
 #include "G4Transform3D.hh"
 #include "G4Version.hh"
 #include "G4VisAttributes.hh"
@@ -270,6 +277,9 @@ G4VPhysicalVolume* BDSDetectorConstruction::Construct()
 
   // placement procedure - put everything in the world
   ComponentPlacement(worldPV);
+
+  if (BDSGlobalConstants::Instance()->FastVacuumTransport())
+    {BuildFastVacuumTransportRegion();}
   
   if (verbose || debug)
     {G4cout << __METHOD_NAME__ << "detector Construction done" << G4endl;}
@@ -759,6 +769,7 @@ void BDSDetectorConstruction::ComponentPlacement(G4VPhysicalVolume* worldPV)
   BDSBeamlineSet mainBL = BDSAcceleratorModel::Instance()->BeamlineSetMain();
   PlaceBeamlineInWorld(mainBL.massWorld,
                        worldPV, checkOverlaps, true, false, false, false, true); // record pv set to element for output
+  RegisterCurvilinearFrames(mainBL);
   PlaceBeamlineInWorld(mainBL.endPieces,
                        worldPV, checkOverlaps);
   if (BDSGlobalConstants::Instance()->BuildTunnel())
@@ -788,6 +799,35 @@ void BDSDetectorConstruction::ComponentPlacement(G4VPhysicalVolume* worldPV)
     }
 }
 
+void BDSDetectorConstruction::RegisterCurvilinearFrames(const BDSBeamlineSet& beamlineSet) const
+{
+  if (!beamlineSet.massWorld || !beamlineSet.curvilinearWorld)
+    {return;}
+
+  BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  auto clElements = BDSCurvilinearBuilder::MatchElements1To1(beamlineSet.massWorld, beamlineSet.curvilinearWorld);
+  for (auto element : *beamlineSet.massWorld)
+    {
+      const std::set<G4VPhysicalVolume*>* pvs = registry->PVsForBeamlineElement(element);
+      if (!pvs)
+	{continue;} // e.g. gaps aren't placed
+      auto search = clElements.find(element);
+      if (search == clElements.end())
+	{continue;} // no curvilinear volume - navigate as usual
+      // use the index and placement of the matching curvilinear element so the output is
+      // the same as when navigating that world
+      const BDSBeamlineElement* clElement = search->second;
+      BDSPhysicalVolumeInfo* theinfo = new BDSPhysicalVolumeInfo(element->GetName(),
+								 element->GetPlacementName() + "_pv",
+								 element->GetSPositionMiddle(),
+								 clElement->GetIndex(),
+								 beamlineSet.curvilinearWorld);
+      const G4Transform3D* clTransform = clElement->GetPlacementTransformCL();
+      theinfo->SetCurvilinearFrame(clTransform->getRotation(), clTransform->getTranslation());
+      registry->RegisterMassWorldInfo(*pvs, theinfo);
+    }
+}
+
 void BDSDetectorConstruction::PlaceBeamlineInWorld(BDSBeamline*          beamline,
 						   G4VPhysicalVolume*    containerPV,
 						   G4bool                checkOverlaps,
@@ -1304,14 +1344,90 @@ void BDSDetectorConstruction::BuildPhysicsBias()
 #endif
 }
 
+namespace
+{
+  /// Worker threads construct their fields and sensitive detectors at the same time
+  /// but the factories and registries used are shared.
+  G4Mutex constructSDandFieldMutex = G4MUTEX_INITIALIZER;
+}
+
 void BDSDetectorConstruction::ConstructSDandField()
 {
+  G4AutoLock lock(&constructSDandFieldMutex);
+
+  if (G4Threading::IsWorkerThread())
+    {AttachWorkerSensitiveDetectors();}
+  
   auto flds = BDSFieldBuilder::Instance()->CreateAndAttachAll(); // avoid shadowing 'fields'
   acceleratorModel->RegisterFields(flds);
 
+  if (BDSGlobalConstants::Instance()->FastVacuumTransport())
+    {ConstructFastVacuumTransport(flds);}
+
   ConstructScoringMeshes();
 }
 
+void BDSDetectorConstruction::AttachWorkerSensitiveDetectors()
+{
+  // the SD manager is per thread so this constructs this thread's SDs
+  PrepareExtraSamplerSDs();
+  G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+  for (auto lv : *G4LogicalVolumeStore::GetInstance())
+    {
+      G4VSensitiveDetector* masterSD = lv->GetMasterSensitiveDetector();
+      if (!masterSD)
+        {continue;}
+      G4VSensitiveDetector* sd = sdManager->FindSensitiveDetector(masterSD->GetFullPathName(), false);
+      if (!sd)
+        {
+          G4String msg = "sensitive detector \"" + masterSD->GetName() + "\" of volume \"" + lv->GetName();
+          msg += "\" cannot be used with more than one thread.";
+          throw BDSException(__METHOD_NAME__, msg);
+        }
+      lv->SetSensitiveDetector(sd);
+    }
+}
+
+void BDSDetectorConstruction::BuildFastVacuumTransportRegion()
+{
+  G4Region* region = nullptr;
+  G4int nVolumes = 0;
+  std::unordered_map<ACRegistryKey, BDSAcceleratorComponent*> allAcceleratorComponents = BDSAcceleratorComponentRegistry::Instance()->AllComponentsIncludingUnique();
+  for (auto const& item : allAcceleratorComponents)
+    {
+      BDSAcceleratorComponent* accCom = item.second;
+      if (dynamic_cast<BDSLine*>(accCom))
+        {continue;} // each sub-component is in the registry too
+      // a region set by the user is kept for its cuts - it is only attached to the container
+      // here and passed down to the vacuum volumes by Geant4 at run initialisation
+      if (!accCom->GetRegion().empty())
+        {continue;}
+      for (auto lv : accCom->GetAcceleratorVacuumLogicalVolumes())
+        {
+          // daughters would be skipped over
+          if (lv->GetNoDaughters() > 0 || lv->GetRegion())
+            {continue;}
+          if (!region)
+            {
+              region = new G4Region("BDSFastVacuumTransport");
+              region->SetProductionCuts(G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts());
+            }
+          region->AddRootLogicalVolume(lv);
+          nVolumes++;
+        }
+    }
+  G4cout << __METHOD_NAME__ << nVolumes << " vacuum volumes for fast vacuum transport" << G4endl;
+}
+
+void BDSDetectorConstruction::ConstructFastVacuumTransport(const std::vector<BDSFieldObjects*>& fields)
+{
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion("BDSFastVacuumTransport", false);
+  if (!region)
+    {return;} // no suitable vacuum volumes
+  // the model is registered with the fast simulation manager of the region
+  new BDSFastVacuumTransportModel("BDSFastVacuumTransport", region, fields);
+}
+
 G4bool BDSDetectorConstruction::UnsuitableFirstElement(GMAD::FastList<GMAD::Element>::FastListConstIterator element)
 {
   // skip past any line elements in parser to find first non-line element
@@ -22,13 +22,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSEventInfo.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSHitEnergyDeposition.hh"
+#include "BDSHitEnergyDepositionBinned.hh"
 #include "BDSHitEnergyDepositionExtra.hh"
 #include "BDSHitEnergyDepositionGlobal.hh"
 #include "BDSHitSampler.hh"
 #include "BDSHitThinThing.hh"
 #include "BDSOutput.hh"
+#include "BDSOutputEventQueue.hh"
+#include "BDSOutputEventRecord.hh"
 #include "BDSModulator.hh"
 #include "BDSNavigatorPlacements.hh"
+#include "BDSPhysicalVolumeInfo.hh"
+#include "BDSPhysicalVolumeInfoRegistry.hh"
 #include "BDSSamplerRegistry.hh"
 #include "BDSSamplerPlacementRecord.hh"
 #include "BDSSDApertureImpacts.hh"
@@ -59,12 +64,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4PrimaryParticle.hh"
 #include "G4PropagatorInField.hh"
 #include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4SDManager.hh"
 #include "G4StackManager.hh"
-#include "G4THitsMap.hh"
 #include "G4TrajectoryContainer.hh"
 #include "G4TrajectoryPoint.hh"
 #include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VHitsCollection.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
 
 #include <algorithm>
 #include <bitset>
@@ -76,7 +85,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 using namespace std::chrono;
 
-G4bool FireLaserCompton;  // bool to ensure that Laserwire can only occur once in an event
+G4ThreadLocal G4bool FireLaserCompton = false;  // bool to ensure that Laserwire can only occur once in an event
+
+G4int BDSEventAction::eventIndexOffset = 0;
 
 BDSEventAction::BDSEventAction(BDSOutput* outputIn):
   output(outputIn),
@@ -85,6 +96,8 @@ BDSEventAction::BDSEventAction(BDSOutput* outputIn):
   samplerCollID_sphere(-1),
   eCounterID(-1),
   eCounterFullID(-1),
+  eCounterBinnedID(-1),
+  eCounterFullBinnedID(-1),
   eCounterVacuumID(-1),
   eCounterTunnelID(-1),
   eCounterWorldID(-1),
@@ -101,7 +114,9 @@ BDSEventAction::BDSEventAction(BDSOutput* outputIn):
   primaryAbsorbedInCollimator(false),
   currentEventIndex(0),
   eventInfo(nullptr),
-  nTracks(0)
+  nTracks(0),
+  auxNavigator(nullptr),
+  outputQueue(nullptr)
 {
   BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
   verboseEventBDSIM         = globals->VerboseEventBDSIM();
@@ -110,6 +125,8 @@ BDSEventAction::BDSEventAction(BDSOutput* outputIn):
   storeTrajectory           = globals->StoreTrajectory();
   storeTrajectoryAll        = globals->StoreTrajectoryAll();
   storeTrajectorySecondary  = globals->StoreTrajectorySecondaryParticles();
+  storeTrajectoryStepPoints = globals->StoreTrajectoryStepPoints();
+  storeTrajectoryStepPointLast = globals->StoreTrajectoryStepPointLast();
   trajectoryFilterLogicAND  = globals->TrajectoryFilterLogicAND();
   trajectoryEnergyThreshold = globals->StoreTrajectoryEnergyThreshold();
   trajectoryCutZ            = globals->TrajCutGTZ();
@@ -130,7 +147,44 @@ BDSEventAction::BDSEventAction(BDSOutput* outputIn):
 }
 
 BDSEventAction::~BDSEventAction()
-{;}
+{
+  for (auto record : recordsInFlight)
+    {delete record;}
+  for (auto record : recordPool)
+    {delete record;}
+  delete auxNavigator;
+}
+
+BDSOutputEventRecord* BDSEventAction::NextRecord()
+{
+  if (recordPool.empty())
+    {return new BDSOutputEventRecord();}
+  BDSOutputEventRecord* record = recordPool.back();
+  recordPool.pop_back();
+  return record;
+}
+
+void BDSEventAction::ReleaseWrittenRecords(G4bool waitForAll)
+{
+  G4int nTries = 0;
+  while (!recordsInFlight.empty())
+    {
+      for (auto it = recordsInFlight.begin(); it != recordsInFlight.end();)
+        {
+          if ((*it)->written.load(std::memory_order_acquire))
+            {
+              (*it)->Clear(); // releases the event on this thread
+              recordPool.push_back(*it);
+              it = recordsInFlight.erase(it);
+            }
+          else
+            {++it;}
+        }
+      if (!waitForAll)
+        {break;}
+      BDSOutputEventQueue::Backoff(nTries);
+    }
+}
 
 void BDSEventAction::BeginOfEventAction(const G4Event* evt)
 {
@@ -183,7 +237,7 @@ void BDSEventAction::BeginOfEventAction(const G4Event* evt)
   // number feedback
   G4int currentEventID = evt->GetEventID();
   BDSSDTerminator::eventNumber = currentEventID; // update static member of terminator
-  eventInfo->SetIndex(currentEventID);
+  eventInfo->SetIndex(currentEventID + eventIndexOffset);
   if (currentEventID % printModulo == 0)
     {G4cout << "---> Begin of event: " << currentEventID << G4endl;}
   if (verboseEventBDSIM) // always print this out
@@ -207,6 +261,11 @@ void BDSEventAction::BeginOfEventAction(const G4Event* evt)
       collimatorCollID         = g4SDMan->GetCollectionID(bdsSDMan->Collimator()->GetName());
       apertureCollID           = g4SDMan->GetCollectionID(bdsSDMan->ApertureImpacts()->GetName());
       thinThingCollID          = g4SDMan->GetCollectionID(bdsSDMan->ThinThing()->GetName());
+      if (BDSGlobalConstants::Instance()->StoreELossBinned())
+        {
+          eCounterBinnedID     = g4SDMan->GetCollectionID(bdsSDMan->EnergyDeposition()->BinnedCollectionName());
+          eCounterFullBinnedID = g4SDMan->GetCollectionID(bdsSDMan->EnergyDepositionFull()->BinnedCollectionName());
+        }
       const std::vector<G4String>& scorerNames = bdsSDMan->PrimitiveScorerNamesComplete();
       for (const auto& name : scorerNames)
         {scorerCollectionIDs[name] = g4SDMan->GetCollectionID(name);}
@@ -245,11 +304,12 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
   const G4int nChar = 50; // for print out
   if (verboseThisEvent)
     {G4cout << __METHOD_NAME__ << "processing end of event"<<G4endl;}
-  eventInfo->SetIndex(event_number);
+  eventInfo->SetIndex(event_number + eventIndexOffset);
 
   // Record if event was aborted - ie whether it's usable for analyses.
   eventInfo->SetAborted(evt->IsAborted());
   eventInfo->SetNTracks(nTracks);
+  eventInfo->SetEnergyKilled(BDSStackingAction::energyKilled / CLHEP::GeV);
 
   // Calculate the elapsed CPU time for the event.
   auto cpuEndTime = std::clock();
@@ -317,6 +377,11 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
   echc* eCounterVacuumHits = HCE ? dynamic_cast<echc*>(HCE->GetHC(eCounterVacuumID)) : nullptr;
   echc* eCounterTunnelHits = HCE ? dynamic_cast<echc*>(HCE->GetHC(eCounterTunnelID)) : nullptr;
 
+  // binned energy deposition - only registered if requested
+  typedef BDSHitsCollectionEnergyDepositionBinned ecbhc;
+  ecbhc* eCounterBinnedHits     = (HCE && eCounterBinnedID >= 0) ? dynamic_cast<ecbhc*>(HCE->GetHC(eCounterBinnedID)) : nullptr;
+  ecbhc* eCounterFullBinnedHits = (HCE && eCounterFullBinnedID >= 0) ? dynamic_cast<ecbhc*>(HCE->GetHC(eCounterFullBinnedID)) : nullptr;
+
   // world exit hits
   typedef BDSHitsCollectionEnergyDepositionGlobal ecghc;
   ecghc* eCounterWorldHits          = HCE ? dynamic_cast<ecghc*>(HCE->GetHC(eCounterWorldID)) : nullptr;
@@ -331,11 +396,11 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
   typedef BDSHitsCollectionThinThing tthc;
   tthc* thinThingHits = HCE ? dynamic_cast<tthc*>(HCE->GetHC(thinThingCollID)) : nullptr;
   
-  std::map<G4String, G4THitsMap<G4double>*> scorerHits;
+  std::map<G4String, G4VHitsCollection*> scorerHits;
   if (HCE)
     {
       for (const auto& nameIndex : scorerCollectionIDs)
-        {scorerHits[nameIndex.first] = dynamic_cast<G4THitsMap<G4double>*>(HCE->GetHC(nameIndex.second));}
+        {scorerHits[nameIndex.first] = HCE->GetHC(nameIndex.second);}
     }
   // primary hit something? we infer this by seeing if there are any energy
   // deposition hits at all - if there are, the primary must have 'hit' something.
@@ -357,6 +422,11 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
       if (eCounterFullHits->entries() > 0)
         {eventInfo->SetPrimaryHitMachine(true);}
     }
+  for (const auto binnedHits : {eCounterBinnedHits, eCounterFullBinnedHits})
+    {
+      if (binnedHits && binnedHits->entries() > 0)
+        {eventInfo->SetPrimaryHitMachine(true);}
+    }
   if (eCounterTunnelHits)
     {
       if (verboseThisEvent)
@@ -405,36 +475,81 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
                                                                                    eCounterFullHits,
                                                                                    allSamplerHits,
                                                                                    nChar);
-
-  output->FillEvent(eventInfo,
-                    evt->GetPrimaryVertex(),
-                    allSamplerHits,
-                    allSamplerCylinderHits,
-                    allSamplerSphereHits,
-                    nullptr,
-                    eCounterHits,
-                    eCounterFullHits,
-                    eCounterVacuumHits,
-                    eCounterTunnelHits,
-                    eCounterWorldHits,
-                    eCounterWorldContentsHits,
-                    worldExitHits,
-                    primaryHits,
-                    primaryLosses,
-                    interestingTrajectories,
-                    collimatorHits,
-                    apertureImpactHits,
-                    scorerHits,
-                    BDSGlobalConstants::Instance()->TurnsTaken());
-  
-  // if events per ntuples not set (default 0) - only write out at end
-  G4int evntsPerNtuple = BDSGlobalConstants::Instance()->NumberOfEventsPerNtuple();
-  if (evntsPerNtuple>0 && (event_number+1)%evntsPerNtuple == 0)
+  FillTrajectoryModelIndices(interestingTrajectories);
+
+  if (outputQueue)
+    {// multi-threaded - hand the event to the writer thread and carry on
+      ReleaseWrittenRecords();
+      BDSOutputEventRecord* record = NextRecord();
+      record->index                   = event_number;
+      record->event                   = evt;
+      record->info                    = eventInfo;
+      record->vertex                  = evt->GetPrimaryVertex();
+      record->samplerHitsPlane        = allSamplerHits;
+      record->samplerHitsCylinder     = allSamplerCylinderHits;
+      record->samplerHitsSphere       = allSamplerSphereHits;
+      record->energyLoss              = eCounterHits;
+      record->energyLossFull          = eCounterFullHits;
+      record->energyLossBinned        = eCounterBinnedHits;
+      record->energyLossFullBinned    = eCounterFullBinnedHits;
+      record->energyLossVacuum        = eCounterVacuumHits;
+      record->energyLossTunnel        = eCounterTunnelHits;
+      record->energyLossWorld         = eCounterWorldHits;
+      record->energyLossWorldContents = eCounterWorldContentsHits;
+      record->worldExitHits           = worldExitHits;
+      record->primaryHits.swap(primaryHits);
+      record->primaryLosses.swap(primaryLosses);
+      record->trajectories            = interestingTrajectories;
+      record->collimatorHits          = collimatorHits;
+      record->apertureImpactHits      = apertureImpactHits;
+      record->scorerHits.swap(scorerHits);
+      record->turnsTaken              = BDSGlobalConstants::Instance()->TurnsTaken();
+      interestingTrajectories = nullptr; // now owned by the record
+      // keep the event and its hits until the record is written
+      evt->KeepForPostProcessing();
+      if (outputQueue->Publish(record))
+        {recordsInFlight.push_back(record);}
+      else
+        {// run aborted on the master or another worker - stop this worker too
+          record->Clear();
+          recordPool.push_back(record);
+          G4RunManager::GetRunManager()->AbortRun(true);
+        }
+    }
+  else
     {
-      // note the timing information will be wrong here as the run hasn't finished but
-      // the file is bridged. There's no good way around this just now as this class
-      // can't access the timing information stored in BDSRunAction
-      output->CloseAndOpenNewFile();
+      output->FillEvent(eventInfo,
+                        evt->GetPrimaryVertex(),
+                        allSamplerHits,
+                        allSamplerCylinderHits,
+                        allSamplerSphereHits,
+                        nullptr,
+                        eCounterHits,
+                        eCounterFullHits,
+                        eCounterBinnedHits,
+                        eCounterFullBinnedHits,
+                        eCounterVacuumHits,
+                        eCounterTunnelHits,
+                        eCounterWorldHits,
+                        eCounterWorldContentsHits,
+                        worldExitHits,
+                        primaryHits,
+                        primaryLosses,
+                        interestingTrajectories,
+                        collimatorHits,
+                        apertureImpactHits,
+                        scorerHits,
+                        BDSGlobalConstants::Instance()->TurnsTaken());
+      
+      // if events per ntuples not set (default 0) - only write out at end
+      G4int evntsPerNtuple = BDSGlobalConstants::Instance()->NumberOfEventsPerNtuple();
+      if (evntsPerNtuple>0 && (event_number+1)%evntsPerNtuple == 0)
+        {
+          // note the timing information will be wrong here as the run hasn't finished but
+          // the file is bridged. There's no good way around this just now as this class
+          // can't access the timing information stored in BDSRunAction
+          output->CloseAndOpenNewFile();
+        }
     }
 	
   if (verboseThisEvent)
@@ -480,32 +595,23 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
     {
       TrajectoryVector* trajVec = trajCont->GetVector();
       
-      // build trackID map, depth map
+      // build trackID map - the depth in the tree is set by the tracking action
+      // as not every track has a trajectory if it was rejected when it started
       std::map<int, BDSTrajectory*> trackIDMap;
-      std::map<BDSTrajectory*, int> depthMap;
       for (auto iT1 : *trajVec)
         {
           BDSTrajectory* traj = static_cast<BDSTrajectory*>(iT1);
-          
-          // fill track ID map
           trackIDMap[traj->GetTrackID()] = traj;
-          
-          // fill depth map
-          G4int depth = traj->GetParentID() == 0 ? 0 : depthMap.at(trackIDMap.at(traj->GetParentID())) + 1;
-          traj->SetDepth(depth);
-          if (traj->GetParentID() == 0) 
-            {depthMap[traj] = 0;}
-          else
-            {depthMap[traj] = depthMap.at(trackIDMap.at(traj->GetParentID())) + 1;}
         }
       
       // fill parent pointer - this can only be done once the map in the previous loop has been made
       for (auto iT1 : *trajVec) 
         {
           BDSTrajectory* traj = static_cast<BDSTrajectory*>(iT1);
-          // the parent ID may be 0 and therefore it may not be in the map but the [] operator
-          // will default-construct it giving therefore a nullptr
-          traj->SetParent(trackIDMap[iT1->GetParentID()]);
+          // the parent ID may be 0 or the parent may not have a trajectory, therefore it may not be
+          // in the map - don't use the [] operator as that would insert a nullptr into the map
+          auto search = trackIDMap.find(iT1->GetParentID());
+          traj->SetParent(search != trackIDMap.end() ? search->second : nullptr);
         }
       
       // loop over trajectories and determine if it should be stored
@@ -514,41 +620,12 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
       G4int nNo  = 0;
       for (auto iT1 : *trajVec)
         {
-          std::bitset<BDS::NTrajectoryFilters> filters;
-          
           BDSTrajectory* traj = static_cast<BDSTrajectory*>(iT1);
-          G4int parentID = traj->GetParentID();
-          
-          // always store primaries
-          if (parentID == 0)
-            {filters[BDSTrajectoryFilter::primary] = true;}
-          else
-            {
-              if (storeTrajectorySecondary)
-                {filters[BDSTrajectoryFilter::secondary] = true;}
-            }
-          
-          // check on energy (if energy threshold is not negative)
-          if (trajectoryEnergyThreshold >= 0 &&
-              traj->GetInitialKineticEnergy() > trajectoryEnergyThreshold)
-            {filters[BDSTrajectoryFilter::energyThreshold] = true;}
-          
-          // check on particle if not empty string
-          if (!trajParticleNameToStore.empty() || !trajParticleIDToStore.empty())
-            {
-              G4String particleName  = traj->GetParticleName();
-              G4int particleID       = traj->GetPDGEncoding();
-              G4String particleIDStr = G4String(std::to_string(particleID));
-              std::size_t found1     = trajParticleNameToStore.find(particleName);
-              bool        found2     = (std::find(trajParticleIDIntToStore.begin(), trajParticleIDIntToStore.end(), particleID)
-                                    != trajParticleIDIntToStore.end());
-              if ((found1 != std::string::npos) || found2)
-                {filters[BDSTrajectoryFilter::particle] = true;}
-            }
-          
-          // check on trajectory tree depth (trajDepth = 0 means only primaries)
-          if (depthMap[traj] <= trajDepth || storeTrajectoryAll) // all means to infinite trajDepth really
-            {filters[BDSTrajectoryFilter::depth] = true;}
+          std::bitset<BDS::NTrajectoryFilters> filters = TrajectoryStartFilters(traj->GetParentID() == 0,
+                                                                                traj->GetInitialKineticEnergy(),
+                                                                                traj->GetParticleName(),
+                                                                                traj->GetPDGEncoding(),
+                                                                                traj->GetDepth());
           
           // check on coordinates (and TODO momentum)
           // clear out trajectories that don't reach point TrajCutGTZ or greater than TrajCutLTR
@@ -582,7 +659,10 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
                     {           
                       if ( dS >= v.first && dS <= v.second) 
                         {
-                          BDSTrajectory* trajToStore = trackIDMap[hit->GetTrackID()];
+                          auto search = trackIDMap.find(hit->GetTrackID());
+                          if (search == trackIDMap.end())
+                            {break;} // track rejected when it started so no trajectory
+                          BDSTrajectory* trajToStore = search->second;
                           if (!interestingTraj[trajToStore])
                             {// was marked as not storing - update counters
                               nYes++;
@@ -607,7 +687,10 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
                     {           
                       if ( dS >= v.first && dS <= v.second) 
                         {
-                          BDSTrajectory* trajToStore = trackIDMap[hit->GetTrackID()];
+                          auto search = trackIDMap.find(hit->GetTrackID());
+                          if (search == trackIDMap.end())
+                            {break;} // track rejected when it started so no trajectory
+                          BDSTrajectory* trajToStore = search->second;
                           if (!interestingTraj[trajToStore])
                             {// was marked as not storing - update counters
                               nYes++;
@@ -634,7 +717,10 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
                   if (std::find(trajectorySamplerID.begin(), trajectorySamplerID.end(), samplerIndex) !=
                       trajectorySamplerID.end())
                     {
-                      BDSTrajectory* trajToStore = trackIDMap[(*SampHC)[i]->trackID];
+                      auto search = trackIDMap.find((*SampHC)[i]->trackID);
+                      if (search == trackIDMap.end())
+                        {continue;} // track rejected when it started so no trajectory
+                      BDSTrajectory* trajToStore = search->second;
                       if (!interestingTraj[trajToStore])
                         {// was marked as not storing - update counters
                           nYes++;
@@ -684,6 +770,89 @@ BDSTrajectoriesToStore* BDSEventAction::IdentifyTrajectoriesForStorage(const G4E
   return new BDSTrajectoriesToStore(interestingTraj, trajectoryFilters);
 }
 
+void BDSEventAction::FillTrajectoryModelIndices(BDSTrajectoriesToStore* trajectories)
+{
+  if (!trajectories)
+    {return;}
+  if (!auxNavigator)
+    {auxNavigator = new BDSAuxiliaryNavigator();}
+  BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  auto modelIndex = [&](BDSTrajectory* traj, G4int i)
+    {
+      G4ThreeVector pos = traj->GetPoint(i)->GetPosition();
+      G4VPhysicalVolume* vol = auxNavigator->LocateGlobalPointAndSetup(pos, nullptr, true, true, true);
+      BDSPhysicalVolumeInfo* theInfo = registry->GetInfo(vol);
+      return theInfo ? theInfo->GetBeamlineIndex() : -1;
+    };
+  for (const auto& trajFlag : trajectories->trajectories)
+    {
+      if (!trajFlag.second)
+        {continue;}
+      BDSTrajectory* traj = trajFlag.first;
+      G4int nSteps = traj->GetPointEntries();
+      // same selection of points as BDSOutputROOTEventTrajectory::Fill
+      G4int nPoints = storeTrajectoryStepPoints > 0 ? std::min(nSteps, storeTrajectoryStepPoints) : nSteps;
+      std::vector<int>& indices = trajectories->modelIndices[traj];
+      indices.assign((std::size_t)nSteps, -1);
+      for (G4int i = 0; i < nPoints; i++)
+        {indices[i] = modelIndex(traj, i);}
+      if (storeTrajectoryStepPoints > 0 && storeTrajectoryStepPointLast && nPoints < nSteps)
+        {indices[nSteps-1] = modelIndex(traj, nSteps-1);}
+    }
+}
+
+std::bitset<BDS::NTrajectoryFilters> BDSEventAction::TrajectoryStartFilters(G4bool          primary,
+                                                                            G4double        kineticEnergy,
+                                                                            const G4String& particleName,
+                                                                            G4int           pdgID,
+                                                                            G4int           depth) const
+{
+  std::bitset<BDS::NTrajectoryFilters> filters;
+  
+  // always store primaries
+  if (primary)
+    {filters[BDSTrajectoryFilter::primary] = true;}
+  else if (storeTrajectorySecondary)
+    {filters[BDSTrajectoryFilter::secondary] = true;}
+  
+  // check on energy (if energy threshold is not negative)
+  if (trajectoryEnergyThreshold >= 0 && kineticEnergy > trajectoryEnergyThreshold)
+    {filters[BDSTrajectoryFilter::energyThreshold] = true;}
+  
+  // check on particle if not empty string
+  if (!trajParticleNameToStore.empty() || !trajParticleIDToStore.empty())
+    {
+      std::size_t found1 = trajParticleNameToStore.find(particleName);
+      bool        found2 = (std::find(trajParticleIDIntToStore.begin(), trajParticleIDIntToStore.end(), pdgID)
+                            != trajParticleIDIntToStore.end());
+      if ((found1 != std::string::npos) || found2)
+        {filters[BDSTrajectoryFilter::particle] = true;}
+    }
+  
+  // check on trajectory tree depth (trajDepth = 0 means only primaries)
+  if (depth <= trajDepth || storeTrajectoryAll) // all means to infinite trajDepth really
+    {filters[BDSTrajectoryFilter::depth] = true;}
+  
+  return filters;
+}
+
+G4bool BDSEventAction::TrajectoryMayBeStored(const std::bitset<BDS::NTrajectoryFilters>& startFilters) const
+{
+  std::bitset<BDS::NTrajectoryFilters> lateFilters;
+  lateFilters[BDSTrajectoryFilter::sampler]     = true;
+  lateFilters[BDSTrajectoryFilter::elossSRange] = true;
+  lateFilters[BDSTrajectoryFilter::minimumZ]    = true;
+  lateFilters[BDSTrajectoryFilter::maximumR]    = true;
+  
+  if (trajectoryFilterLogicAND)
+    {// every filter set that can be decided now must already be matched
+      auto startFiltersSet = trajFiltersSet & ~lateFilters;
+      return (startFilters & startFiltersSet).count() == startFiltersSet.count();
+    }
+  else
+    {return startFilters.any() || (trajFiltersSet & lateFilters).any();}
+}
+
 void BDSEventAction::ConnectTrajectory(std::map<BDSTrajectory*, bool>& interestingTraj,
                                        BDSTrajectory*                  trajectoryToConnect,
                                        std::map<BDSTrajectory*, std::bitset<BDS::NTrajectoryFilters> >& trajectoryFilters) const
@@ -126,6 +126,8 @@ void BDSExecOptions::Parse(int argc, char **argv)
                                         { "survey", 1, 0, 0 },
                                         { "ngenerate", 1, 0, 0 },
                                         { "nGenerate", 1, 0, 0 },
+                                        { "threads",   1, 0, 0 },
+                                        { "jobs",      1, 0, 0 },
                                         { "nturns",    1, 0, 0 },
                                         { "nTurns",    1, 0, 0 },
                                         { "printFractionEvents", 1, 0, 0},
@@ -355,6 +357,18 @@ void BDSExecOptions::Parse(int argc, char **argv)
                 options.set_value("ngenerate", result);
                 beam.set_value("distrFileMatchLength", false); // ngenerate overrides.
               }
+            else if ( !strcmp(optionName, "threads") )
+              {
+                int result = 1;
+                conversion = BDS::IsInteger(optarg, result);
+                options.set_value("nThreads", result);
+              }
+            else if ( !strcmp(optionName, "jobs") )
+              {
+                int result = 1;
+                conversion = BDS::IsInteger(optarg, result);
+                options.set_value("nJobs", result);
+              }
             else if ( !strcmp(optionName, "nturns") || !strcmp(optionName, "nTurns"))
               {
                 int result = 1;
@@ -454,6 +468,8 @@ void BDSExecOptions::Usage() const
         <<"--geant4PhysicsMacroFileName=<filename> : physics macro file name"                << G4endl
         <<"--generatePrimariesOnly      : generate N primary particle coordinates"           << G4endl
         <<"                               without simulation then quit"                      << G4endl
+        <<"--jobs=N                     : split the events between N forked processes and"   << G4endl
+        <<"                               combine their output at the end"                   << G4endl
         <<"--materials                  : list materials included in bdsim by default"       << G4endl
         <<"--ngenerate=N                : the number of primary events to simulate:"         << G4endl
         <<"                               overrides ngenerate option in the input gmad file" << G4endl
@@ -474,6 +490,7 @@ void BDSExecOptions::Usage() const
         <<"--seedStateFileName=<file>   : use this ASCII file seed state to run an event"    << G4endl
         <<"--startFromEvent=N           : event offset to start from when recreating events" << G4endl
         <<"--survey=<file>              : print survey info to <file>"                       << G4endl
+        <<"--threads=N                  : number of threads to process events with"          << G4endl
         <<"--verbose                    : display general parameters before run"             << G4endl
         <<"--verboseRunLevel=N          : set Geant4 verbosity at run level [0:5]"           << G4endl
         <<"--verboseEventLevel=N        : set Geant4 event manager verbosity level"          << G4endl
@@ -0,0 +1,260 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSFastVacuumTransportModel.hh"
+#include "BDSFieldClassType.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldObjects.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSIntegratorDrift.hh"
+#include "BDSIntegratorG4RK4MinStep.hh"
+#include "BDSIntegratorTeleporter.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh" // geant4 types / globals
+#include "G4AffineTransform.hh"
+#include "G4ChargeState.hh"
+#include "G4ChordFinder.hh"
+#include "G4DynamicParticle.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4FieldManager.hh"
+#include "G4FieldTrack.hh"
+#include "G4LogicalVolume.hh"
+#include "G4MagIntegratorStepper.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Region.hh"
+#include "G4ThreeVector.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4VSolid.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+BDSFastVacuumTransportModel::BDSFastVacuumTransportModel(const G4String& name,
+							 G4Region*       envelope,
+							 const std::vector<BDSFieldObjects*>& fields):
+  G4VFastSimulationModel(name, envelope),
+  globalField(false),
+  minimumStep(1*CLHEP::um),
+  maximumNSteps(1000),
+  pathLength(0),
+  rejectedTrack(nullptr),
+  rejectedTrackID(-1),
+  rejectedVolume(nullptr)
+{
+  for (const auto field : fields)
+    {
+      if (SuitableField(field))
+	{fieldObjects[field->GetFieldManager()] = field;}
+    }
+  const G4FieldManager* globalFieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  globalField   = globalFieldManager ? globalFieldManager->GetDetectorField() != nullptr : false;
+  paraxialLimit = BDSGlobalConstants::Instance()->BackupStepperMomLimit();
+}
+
+G4bool BDSFastVacuumTransportModel::SuitableField(const BDSFieldObjects* field)
+{
+  const BDSFieldInfo* info = field->GetInfo();
+  if (!info || !field->GetChordFinder())
+    {return false;}
+  if (BDS::DetermineFieldClassType(info->FieldType()) != BDSFieldClassType::magnetic)
+    {return false;}
+  if (info->ModulatorInfo()) // time dependent
+    {return false;}
+
+  // only the BDSIM integrators that are maps for the element, not general
+  // purpose Runge-Kutta ones that need many short steps
+  const G4MagIntegratorStepper* stepper = field->GetIntegrator();
+  if (!dynamic_cast<const BDSIntegratorDrift*>(stepper))
+    {return false;}
+  if (dynamic_cast<const BDSIntegratorG4RK4MinStep*>(stepper) || dynamic_cast<const BDSIntegratorTeleporter*>(stepper))
+    {return false;}
+  return true;
+}
+
+G4bool BDSFastVacuumTransportModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return BDS::IsFinite(particle.GetPDGCharge());
+}
+
+G4bool BDSFastVacuumTransportModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  if (track->GetParentID() != 0)
+    {return false;}
+  if (!BDS::IsFinite(track->GetDynamicParticle()->GetCharge())) // could be a fully stripped ion
+    {return false;}
+
+  const G4VPhysicalVolume* volume = fastTrack.GetEnvelopePhysicalVolume();
+  if (track == rejectedTrack && track->GetTrackID() == rejectedTrackID && volume == rejectedVolume)
+    {return false;}
+
+  G4ThreeVector localDirection = fastTrack.GetPrimaryTrackLocalDirection();
+  G4bool paraxial = localDirection.z() > (1.0 - paraxialLimit)
+    && std::abs(localDirection.x()) < paraxialLimit
+    && std::abs(localDirection.y()) < paraxialLimit;
+  if (paraxial && Propagate(fastTrack))
+    {return true;}
+
+  rejectedTrack   = track;
+  rejectedTrackID = track->GetTrackID();
+  rejectedVolume  = volume;
+  return false;
+}
+
+void BDSFastVacuumTransportModel::DoIt(const G4FastTrack& fastTrack,
+				       G4FastStep&        fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const G4DynamicParticle* particle = track->GetDynamicParticle();
+  G4double dt = pathLength / track->GetVelocity();
+  G4double gamma = particle->GetTotalEnergy() / particle->GetMass();
+
+  fastStep.ProposePrimaryTrackFinalPosition(finalPosition, false);
+  fastStep.ProposePrimaryTrackFinalMomentumDirection(finalMomentumDirection, false);
+  fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + dt);
+  fastStep.ProposePrimaryTrackFinalProperTime(track->GetProperTime() + dt / gamma);
+  fastStep.ProposePrimaryTrackPathLength(pathLength);
+}
+
+G4bool BDSFastVacuumTransportModel::Propagate(const G4FastTrack& fastTrack)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const G4VSolid* solid = fastTrack.GetEnvelopeSolid();
+  const G4AffineTransform* globalToLocal = fastTrack.GetAffineTransformation();
+  const G4AffineTransform* localToGlobal = fastTrack.GetInverseAffineTransformation();
+
+  G4ThreeVector localPos = fastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector localDir = fastTrack.GetPrimaryTrackLocalDirection();
+  G4double h = solid->DistanceToOut(localPos, localDir);
+  if (h < minimumStep)
+    {return false;} // already at the end - leave it to Geant4 to cross the boundary
+
+  const BDSFieldObjects* field = nullptr;
+  const G4FieldManager* fieldManager = fastTrack.GetEnvelopeLogicalVolume()->GetFieldManager();
+  if (fieldManager)
+    {
+      auto search = fieldObjects.find(fieldManager);
+      if (search == fieldObjects.end())
+	{return false;}
+      field = search->second;
+    }
+  else if (globalField)
+    {return false;}
+
+  if (!field)
+    {// straight line to the surface
+      G4ThreeVector localExit = localPos + h*localDir;
+      if (!OnEndFace(solid, localExit))
+	{return false;}
+      finalPosition          = localToGlobal->TransformPoint(localExit);
+      finalMomentumDirection = track->GetMomentumDirection();
+      pathLength             = h;
+      return true;
+    }
+
+  G4MagIntegratorStepper* stepper = field->GetIntegrator();
+  const G4DynamicParticle* particle = track->GetDynamicParticle();
+  field->GetEquationOfMotion()->SetChargeMomentumMass(G4ChargeState(particle->GetCharge(), 0, 0, 0),
+						      particle->GetTotalMomentum(),
+						      particle->GetMass());
+  // the same accuracy as Geant4 requires for each step in this field
+  G4double deltaChord = field->GetChordFinder()->GetDeltaChord();
+
+  const G4int nVariables = G4FieldTrack::ncompSVEC;
+  G4double y[nVariables]    = {};
+  G4double dydx[nVariables] = {};
+  G4double yOut[nVariables] = {};
+  G4double yErr[nVariables] = {};
+  G4ThreeVector globalPos = track->GetPosition();
+  G4ThreeVector globalMom = track->GetMomentum();
+  for (G4int i = 0; i < 3; i++)
+    {
+      y[i]   = globalPos[i];
+      y[i+3] = globalMom[i];
+    }
+
+  G4double pathTotal = 0;
+  G4double hMaximum  = std::numeric_limits<G4double>::max();
+  for (G4int i = 0; i < maximumNSteps; i++)
+    {
+      h = std::min(h, hMaximum);
+      stepper->RightHandSide(y, dydx);
+      stepper->Stepper(y, dydx, h, yOut, yErr);
+      G4double sagitta = stepper->DistChord();
+
+      G4ThreeVector localOut = globalToLocal->TransformPoint(G4ThreeVector(yOut[0], yOut[1], yOut[2]));
+      G4ThreeVector chord    = localOut - localPos;
+      G4double chordLength   = chord.mag();
+      if (!BDS::IsFinite(chordLength))
+	{return false;}
+      G4ThreeVector chordDir = chord / chordLength;
+
+      // the chord must represent the path well and not pass too close to the surface
+      G4bool shorten = sagitta > deltaChord;
+      G4double distanceToOut = solid->DistanceToOut(localPos, chordDir);
+      if (!shorten && distanceToOut < chordLength)
+	{// leaves the volume in this step
+	  G4ThreeVector localExit = localPos + distanceToOut*chordDir;
+	  if (!OnEndFace(solid, localExit))
+	    {return false;} // would hit the beam pipe
+	  
+	  // repeat the step up to the exit for the final momentum
+	  G4double hExit = h * distanceToOut / chordLength;
+	  stepper->Stepper(y, dydx, hExit, yOut, yErr);
+	  finalPosition          = localToGlobal->TransformPoint(localExit);
+	  finalMomentumDirection = G4ThreeVector(yOut[3], yOut[4], yOut[5]).unit();
+	  pathLength             = pathTotal + hExit;
+	  return true;
+	}
+      if (!shorten)
+	{shorten = solid->DistanceToOut(localPos + 0.5*chord) < sagitta;}
+      if (shorten)
+	{
+	  hMaximum = 0.5*h;
+	  if (hMaximum < minimumStep)
+	    {return false;}
+	  continue;
+	}
+
+      // accept the step
+      pathTotal += h;
+      std::copy(yOut, yOut + nVariables, y);
+      localPos = localOut;
+      localDir = globalToLocal->TransformAxis(G4ThreeVector(y[3], y[4], y[5]).unit());
+      hMaximum = 2*h;
+      // at least the minimum step so a point just inside the end still leaves
+      h = std::max(solid->DistanceToOut(localPos, localDir), 2*minimumStep);
+    }
+  return false;
+}
+
+G4bool BDSFastVacuumTransportModel::OnEndFace(const G4VSolid* solid, const G4ThreeVector& localPoint)
+{
+  // vacuum volumes are along local z, so the end faces face roughly along z
+  // and the sides have normals that are mostly transverse
+  G4ThreeVector normal = solid->SurfaceNormal(localPoint);
+  return std::abs(normal.z()) > 0.5;
+}
@@ -26,6 +26,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4LogicalVolume.hh"
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 BDSFieldBuilder* BDSFieldBuilder::instance = nullptr;
@@ -113,10 +114,34 @@ std::vector<BDSFieldObjects*> BDSFieldBuilder::CreateAndAttachAll()
 {
   std::vector<BDSFieldObjects*> fields;
   fields.reserve(infos.size());
+  // fields already built by hash of their info - identical magnets (e.g. in a
+  // FODO lattice) share one set of field objects
+  std::unordered_map<std::size_t, std::vector<BDSFieldObjects*> > fieldsByHash;
+  G4int nShared = 0;
   for (G4int i = 0; i < (G4int)infos.size(); i++)
     {
       BDSFieldObjects* field = nullptr;
       const BDSFieldInfo* currentInf = infos[i];
+      G4bool shareable = CanShare(currentInf);
+      std::size_t hash = shareable ? currentInf->Hash() : 0;
+      if (shareable)
+        {
+          auto search = fieldsByHash.find(hash);
+          if (search != fieldsByHash.end())
+            {
+              for (auto existing : search->second)
+                {
+                  if (existing->GetInfo()->IsEquivalent(*currentInf))
+                    {field = existing; break;}
+                }
+            }
+          if (field)
+            {
+              field->AttachToVolume(lvs[i], propagators[i], currentInf);
+              nShared++;
+              continue;
+            }
+        }
       try
       {
         if (currentInf->AutoScale())
@@ -137,7 +162,18 @@ std::vector<BDSFieldObjects*> BDSFieldBuilder::CreateAndAttachAll()
         {
           fields.push_back(field);
           field->AttachToVolume(lvs[i], propagators[i]); // works with vector of LVs*
+          if (shareable)
+            {fieldsByHash[hash].push_back(field);}
         }
     }
+  if (nShared > 0)
+    {G4cout << __METHOD_NAME__ << fields.size() << " fields built - " << nShared << " identical fields share these" << G4endl;}
   return fields;
 }
+
+G4bool BDSFieldBuilder::CanShare(const BDSFieldInfo* info)
+{
+  // autoscaled fields depend on another strength and the teleporter
+  // owns the one turn map and is unique anyway
+  return !info->AutoScale() && info->FieldType() != BDSFieldType::teleporter;
+}
@@ -54,7 +54,7 @@ std::pair<G4ThreeVector,G4ThreeVector> BDSFieldEM::GetFieldTransformed(const G4T
       G4ThreeVector transformedEField = transform * (HepGeom::Vector3D<G4double>)field.second;
       if (modulator)
         {
-          G4double factor = modulator->Factor(position, t);
+          G4double factor = modulator->CachedFactor(position, t);
           transformedBField *= factor;
           transformedEField *= factor;
         }
@@ -65,7 +65,7 @@ std::pair<G4ThreeVector,G4ThreeVector> BDSFieldEM::GetFieldTransformed(const G4T
       auto field = GetField(position, t);
       if (modulator)
         {
-          G4double factor = modulator->Factor(position, t);
+          G4double factor = modulator->CachedFactor(position, t);
           field.first *= factor;
           field.second *= factor;
         }
@@ -16,6 +16,7 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSBesselTable.hh"
 #include "BDSCavityInfo.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
@@ -36,37 +37,47 @@ const G4double BDSFieldEMRFCavity::j0FirstZero = 2.404825557695772768622;
 
 const G4double BDSFieldEMRFCavity::Z0 = CLHEP::mu0 * CLHEP::c_light;
 
-BDSFieldEMRFCavity::BDSFieldEMRFCavity(BDSMagnetStrength const* strength):
+BDSFieldEMRFCavity::BDSFieldEMRFCavity(BDSMagnetStrength const* strength,
+                                       G4bool tabulatedBessel):
   BDSFieldEMRFCavity((*strength)["efield"],
                      (*strength)["frequency"],
                      (*strength)["phase"],
                      (*strength)["equatorradius"],
-                     (*strength)["synchronousT0"])
+                     (*strength)["synchronousT0"],
+                     tabulatedBessel)
 {;}
 
 BDSFieldEMRFCavity::BDSFieldEMRFCavity(G4double eFieldAmplitude,
                                        G4double frequencyIn,
                                        G4double phaseOffset,
                                        G4double cavityRadiusIn,
-                                       G4double synchronousTIn):
+                                       G4double synchronousTIn,
+                                       G4bool   tabulatedBessel):
   eFieldMax(eFieldAmplitude),
   phase(phaseOffset),
   cavityRadius(cavityRadiusIn),
   synchronousT(synchronousTIn),
   normalisedCavityRadius(j0FirstZero/cavityRadius),
-  angularFrequency(CLHEP::twopi * frequencyIn)
+  angularFrequency(CLHEP::twopi * frequencyIn),
+  besselTable(tabulatedBessel ? BesselTable() : nullptr)
 {
   // this would cause NANs to be propagated into tracking which is really bad
   if (!BDS::IsFinite(cavityRadiusIn) || std::isnan(normalisedCavityRadius) || std::isinf(normalisedCavityRadius))
     {throw BDSException(__METHOD_NAME__, "no cavity radius supplied - required for pill box model");}
 }
 
+const BDSBesselTable* BDSFieldEMRFCavity::BesselTable()
+{
+  // built once on first use - thread safe static initialisation
+  static const BDSBesselTable table(j0FirstZero);
+  return &table;
+}
+
 std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4ThreeVector& position,
                                                                      const G4double       t) const
 {
   // Converting from Local Cartesian to Local Cylindrical
-  G4double phi = std::atan2(position.y(),position.x());
-  G4double r   = std::hypot(position.x(),position.y());
+  G4double r = std::hypot(position.x(),position.y());
 
   G4double rNormalised = normalisedCavityRadius * r;
 
@@ -74,8 +85,14 @@ std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4Thr
   if (rNormalised > j0FirstZero)
     {rNormalised = j0FirstZero - 1e-6;}
 
-  G4double J0r = TMath::BesselJ0(rNormalised);
-  G4double J1r = TMath::BesselJ1(rNormalised);
+  G4double J0r, J1r;
+  if (besselTable)
+    {besselTable->J0J1(rNormalised, J0r, J1r);}
+  else
+    {
+      J0r = TMath::BesselJ0(rNormalised);
+      J1r = TMath::BesselJ1(rNormalised);
+    }
 
   // Calculating free-space impedance and scale factor for Bphi:
   G4double hMax = -eFieldMax/Z0;
@@ -86,11 +103,15 @@ std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4Thr
   G4double Ez   = eFieldMax * J0r * std::cos(arg);
   G4double Bphi = Bmax * J1r * std::sin(arg);
 
-  // Converting Bphi into cartesian coordinates:
-  G4TwoVector bxby(0,Bphi); // this is equivalent to a pi/2 rotation of (1,0)
-  bxby.rotate(phi);
-  G4double Bx = bxby.x();
-  G4double By = bxby.y();
+  // Converting Bphi into cartesian coordinates: the unit vector in phi is (-y/r, x/r).
+  // On axis J1(0) = 0 so the field is 0.
+  G4double Bx = 0;
+  G4double By = 0;
+  if (r > 0)
+    {
+      Bx = -Bphi * position.y() / r;
+      By =  Bphi * position.x() / r;
+    }
   
   // Local B and E fields:
   G4ThreeVector LocalB = G4ThreeVector(Bx, By, 0);
@@ -16,7 +16,10 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
+#include "BDSArray2DCoords.hh"
 #include "BDSArrayReflectionType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSBeamPipeInfo.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
@@ -53,6 +56,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldMagMultipoleOuter.hh"
 #include "BDSFieldMagMultipoleOuterDual.hh"
 #include "BDSFieldMagMultipoleOuterDualOld.hh"
+#include "BDSFieldMagMultipoleOuterGridded.hh"
 #include "BDSFieldMagMultipoleOuterOld.hh"
 #include "BDSFieldMagMuonSpoiler.hh"
 #include "BDSFieldMagOctupole.hh"
@@ -92,6 +96,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSModulatorSinT.hh"
 #include "BDSModulatorTopHatT.hh"
 #include "BDSModulatorType.hh"
+#include "BDSOneTurnMapGenerator.hh"
 #include "BDSParser.hh"
 #include "BDSParticleDefinition.hh"
 #include "BDSUtilities.hh"
@@ -145,13 +150,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "CLHEP/Vector/EulerAngles.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <utility>
 #include <vector>
 
 const BDSParticleDefinition* BDSFieldFactory::designParticle = nullptr;
-BDSPrimaryGeneratorAction* BDSFieldFactory::primaryGeneratorAction = nullptr;
+G4ThreadLocal BDSPrimaryGeneratorAction* BDSFieldFactory::primaryGeneratorAction = nullptr;
 
 BDSFieldFactory* BDSFieldFactory::instance = nullptr;
 
@@ -183,6 +193,8 @@ BDSFieldFactory::~BDSFieldFactory()
     {delete info.second;}
   for (auto& info : parserModulatorDefinitions)
     {delete info.second;}
+  for (auto& grid : yokeFieldGrids)
+    {delete grid.second;}
 }
 
 void BDSFieldFactory::PrepareFieldDefinitions(const std::vector<GMAD::Field>& definitions,
@@ -368,6 +380,8 @@ void BDSFieldFactory::PrepareFieldDefinitions(const std::vector<GMAD::Field>& de
           BDSArrayReflectionTypeSet ear = BDS::DetermineArrayReflectionTypeSet(electricReflection);
           info->SetElectricArrayReflectionType(ear);
         }
+      info->SetMagneticArrayStorageType(BDS::DetermineArrayStorageType(G4String(definition.magneticStorage)));
+      info->SetElectricArrayStorageType(BDS::DetermineArrayStorageType(G4String(definition.electricStorage)));
       
       info->SetNameOfParserDefinition(G4String(definition.name));
       if (BDSGlobalConstants::Instance()->Verbose())
@@ -815,6 +829,29 @@ BDSFieldMag* BDSFieldFactory::CreateFieldMagRaw(const BDSFieldInfo&      info,
       }
     }
 
+  // Optionally replace the (2D) yoke field calculation by interpolation of a sampled grid.
+  if (field && BDSGlobalConstants::Instance()->YokeFieldsInterpolated())
+    {
+      switch (info.FieldType().underlying())
+        {
+        case BDSFieldType::multipoleouterdipole:
+        case BDSFieldType::multipoleouterquadrupole:
+        case BDSFieldType::multipoleoutersextupole:
+        case BDSFieldType::multipoleouteroctupole:
+        case BDSFieldType::multipoleouterdecapole:
+        case BDSFieldType::skewmultipoleouterquadrupole:
+        case BDSFieldType::skewmultipoleoutersextupole:
+        case BDSFieldType::skewmultipoleouteroctupole:
+        case BDSFieldType::skewmultipoleouterdecapole:
+        case BDSFieldType::multipoleouterdipolelhc:
+        case BDSFieldType::multipoleouterquadrupolelhc:
+        case BDSFieldType::multipoleoutersextupolelhc:
+          {field = CreateYokeFieldInterpolated(info, field); break;}
+        default:
+          {break;}
+        }
+    }
+
   // Set transform for local geometry offset
   // Do this before wrapping in global converter BDSFieldMagGlobal so that the sub-field
   // has it and not the global wrapper.
@@ -867,7 +904,7 @@ BDSFieldObjects* BDSFieldFactory::CreateFieldEM(const BDSFieldInfo& info)
   switch (info.FieldType().underlying())
     {
     case BDSFieldType::rfpillbox:
-      {field = new BDSFieldEMRFCavity(info.MagnetStrength()); break;}
+      {field = new BDSFieldEMRFCavity(info.MagnetStrength(), BDSGlobalConstants::Instance()->CavityFieldTabulatedBessel()); break;}
     case BDSFieldType::ebmap1d:
     case BDSFieldType::ebmap2d:
     case BDSFieldType::ebmap3d:
@@ -1228,11 +1265,27 @@ BDSFieldObjects* BDSFieldFactory::CreateTeleporter(const BDSFieldInfo& info)
   auto mapfile = BDSGlobalConstants::Instance()->PTCOneTurnMapFileName(); // TBC - this shouldn't come from global constants
   BDSPTCOneTurnMap* otm = nullptr;
 
+  G4bool mapFromModel = BDSGlobalConstants::Instance()->OneTurnMapFromModel();
+  if (!mapfile.empty() && mapFromModel)
+    {throw BDSException(__METHOD_NAME__, "only one of ptcOneTurnMapFileName and oneTurnMapFromModel can be used.");}
   if (!mapfile.empty())
+    {otm = new BDSPTCOneTurnMap(mapfile, designParticle);}
+  else if (mapFromModel)
     {
-      otm = new BDSPTCOneTurnMap(mapfile, designParticle);
-      primaryGeneratorAction->RegisterPTCOneTurnMap(otm);
+      const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+      // the map is fitted in PTC units (m, rad, fractional momentum)
+      G4double maxOffset = globals->OneTurnMapFromModelMaxOffset() / CLHEP::m;
+      G4double maxAngle  = globals->OneTurnMapFromModelMaxAngle() / CLHEP::rad;
+      std::array<G4double, BDSPTCOneTurnMap::nVariables> halfWidths = {maxOffset, maxAngle,
+                                                                      maxOffset, maxAngle,
+                                                                      globals->OneTurnMapFromModelMaxDeltaP()};
+      otm = BDS::GenerateOneTurnMap(BDSAcceleratorModel::Instance()->BeamlineMain(),
+                                    designParticle,
+                                    globals->OneTurnMapFromModelOrder(),
+                                    halfWidths);
     }
+  if (otm)
+    {primaryGeneratorAction->RegisterPTCOneTurnMap(otm);}
 
   integrator = new BDSIntegratorTeleporter(bEqOfMotion, info.TransformComplete(),
                                            (*info.MagnetStrength())["length"],
@@ -1281,6 +1334,47 @@ G4double BDSFieldFactory::GetOuterScaling(const BDSMagnetStrength* st) const
   return result;
 }
 
+BDSFieldMag* BDSFieldFactory::CreateYokeFieldInterpolated(const BDSFieldInfo& info,
+                                                          BDSFieldMag*        field)
+{
+  G4int nPoints = BDSGlobalConstants::Instance()->YokeFieldsInterpolatedNPoints();
+  if (nPoints < 2)
+    {throw BDSException(__METHOD_NAME__, "option yokeFieldsInterpolatedNPoints must be at least 2");}
+
+  // cover the corners of a default size square yoke and the second aperture of the LHC style
+  // magnets, or the whole magnet if it is larger - the analytical field is used beyond this
+  G4double halfWidth = std::sqrt(2.0) * 0.5 * BDSGlobalConstants::Instance()->HorizontalWidth();
+  switch (info.FieldType().underlying())
+    {
+    case BDSFieldType::multipoleouterdipolelhc:
+    case BDSFieldType::multipoleouterquadrupolelhc:
+    case BDSFieldType::multipoleoutersextupolelhc:
+      {halfWidth += BDSMagnetOuterFactoryLHC::beamSeparation; break;}
+    default:
+      {break;}
+    }
+  halfWidth = std::max({halfWidth, 4*info.PoleTipRadius(), info.YokeExtent()});
+
+  // The yoke field depends only on these parameters, so magnets with the same ones
+  // can share the same sampled grid.
+  std::ostringstream keyStream;
+  keyStream << std::setprecision(17) << info.FieldType().ToString() << " " << info.PoleTipRadius()
+            << " " << info.BRho() << " " << info.SecondFieldOnLeft() << " " << halfWidth
+            << " " << *(info.MagnetStrength());
+  G4String key = keyStream.str();
+
+  BDSArray2DCoords* grid = nullptr;
+  auto search = yokeFieldGrids.find(key);
+  if (search != yokeFieldGrids.end())
+    {grid = search->second;}
+  else
+    {
+      grid = BDSFieldMagMultipoleOuterGridded::SampleField(field, halfWidth, nPoints);
+      yokeFieldGrids[key] = grid;
+    }
+  return new BDSFieldMagMultipoleOuterGridded(field, grid);
+}
+
 BDSModulator* BDSFieldFactory::CreateModulator(const BDSModulatorInfo* modulatorRecipe,
                                                const BDSFieldInfo& info) const
 {
@@ -1320,6 +1414,9 @@ BDSModulator* BDSFieldFactory::CreateModulator(const BDSModulatorInfo* modulator
         default:
           {break;}
         }
+      const BDSGlobalConstants* g = BDSGlobalConstants::Instance();
+      if (result && g->ModulatorsTabulated())
+        {result->BuildPeriodicTable(g->ModulatorsTabulatedNPoints());}
     }
   catch (BDSException& e)
     {
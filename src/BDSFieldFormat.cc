@@ -38,7 +38,11 @@ std::map<BDSFieldFormat, std::string>* BDSFieldFormat::dictionary =
       {BDSFieldFormat::bdsim4d,   "bdsim4d"},
       {BDSFieldFormat::poisson2d, "poisson2d"},
       {BDSFieldFormat::poisson2dquad, "poisson2dquad"},
-      {BDSFieldFormat::poisson2ddipole, "poisson2ddipole"}
+      {BDSFieldFormat::poisson2ddipole, "poisson2ddipole"},
+      {BDSFieldFormat::bdsim1dbin, "bdsim1dbin"},
+      {BDSFieldFormat::bdsim2dbin, "bdsim2dbin"},
+      {BDSFieldFormat::bdsim3dbin, "bdsim3dbin"},
+      {BDSFieldFormat::bdsim4dbin, "bdsim4dbin"}
 });	
 
 BDSFieldFormat BDS::DetermineFieldFormat(G4String bFormat)
@@ -52,6 +56,10 @@ BDSFieldFormat BDS::DetermineFieldFormat(G4String bFormat)
   formats["poisson2d"]     = BDSFieldFormat::poisson2d;
   formats["poisson2dquad"] = BDSFieldFormat::poisson2dquad;
   formats["poisson2ddipole"] = BDSFieldFormat::poisson2ddipole;
+  formats["bdsim1dbin"]    = BDSFieldFormat::bdsim1dbin;
+  formats["bdsim2dbin"]    = BDSFieldFormat::bdsim2dbin;
+  formats["bdsim3dbin"]    = BDSFieldFormat::bdsim3dbin;
+  formats["bdsim4dbin"]    = BDSFieldFormat::bdsim4dbin;
 
   bFormat = BDS::LowerCase(bFormat);
 
@@ -79,15 +87,19 @@ G4int BDS::NDimensionsOfFieldFormat(const BDSFieldFormat& ff)
   switch (ff.underlying())
     {
       case BDSFieldFormat::bdsim1d:
+      case BDSFieldFormat::bdsim1dbin:
         {result = 1; break;}
       case BDSFieldFormat::bdsim2d:
+      case BDSFieldFormat::bdsim2dbin:
       case BDSFieldFormat::poisson2d:
       case BDSFieldFormat::poisson2dquad:
       case BDSFieldFormat::poisson2ddipole:
         {result = 2; break;}
       case BDSFieldFormat::bdsim3d:
+      case BDSFieldFormat::bdsim3dbin:
         {result = 3; break;}
       case BDSFieldFormat::bdsim4d:
+      case BDSFieldFormat::bdsim4dbin:
         {result = 4; break;}
       case BDSFieldFormat::none:
       default:
@@ -95,3 +107,17 @@ G4int BDS::NDimensionsOfFieldFormat(const BDSFieldFormat& ff)
     }
   return result;
 }
+
+G4bool BDS::FieldFormatIsBinary(const BDSFieldFormat& ff)
+{
+  switch (ff.underlying())
+    {
+      case BDSFieldFormat::bdsim1dbin:
+      case BDSFieldFormat::bdsim2dbin:
+      case BDSFieldFormat::bdsim3dbin:
+      case BDSFieldFormat::bdsim4dbin:
+        {return true;}
+      default:
+        {return false;}
+    }
+}
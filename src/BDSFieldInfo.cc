@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSArrayReflectionType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSFieldInfo.hh"
 #include "BDSFieldType.hh"
 #include "BDSIntegratorType.hh"
@@ -33,6 +34,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserLimits.hh"
 
 #include <algorithm>
+#include <functional>
 #include <ostream>
 
 G4UserLimits* BDSFieldInfo::defaultUL = nullptr;
@@ -48,10 +50,12 @@ BDSFieldInfo::BDSFieldInfo():
   magneticFieldFormat(BDSFieldFormat::none),
   magneticInterpolatorType(BDSInterpolatorType::nearest3d),
   magneticArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  magneticArrayStorageType(BDSArrayStorageType::standard),
   electricFieldFilePath(""),
   electricFieldFormat(BDSFieldFormat::none),
   electricInterpolatorType(BDSInterpolatorType::nearest3d),
   electricArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  electricArrayStorageType(BDSArrayStorageType::standard),
   cacheTransforms(true),
   eScaling(1.0),
   bScaling(1.0),
@@ -69,6 +73,7 @@ BDSFieldInfo::BDSFieldInfo():
   modulatorInfo(nullptr),
   ignoreUpdateOfMaximumStepSize(false),
   isThin(false),
+  yokeExtent(0),
   transformBeamline(nullptr),
   nameOfParserDefinition("")
 {;}
@@ -106,10 +111,12 @@ BDSFieldInfo::BDSFieldInfo(BDSFieldType             fieldTypeIn,
   magneticFieldFormat(magneticFieldFormatIn),
   magneticInterpolatorType(magneticInterpolatorTypeIn),
   magneticArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  magneticArrayStorageType(BDSArrayStorageType::standard),
   electricFieldFilePath(electricFieldFilePathIn),
   electricFieldFormat(electricFieldFormatIn),
   electricInterpolatorType(electricInterpolatorTypeIn),
   electricArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  electricArrayStorageType(BDSArrayStorageType::standard),
   cacheTransforms(cacheTransformsIn),
   eScaling(eScalingIn),
   bScaling(bScalingIn),
@@ -126,6 +133,7 @@ BDSFieldInfo::BDSFieldInfo(BDSFieldType             fieldTypeIn,
   modulatorInfo(nullptr),
   ignoreUpdateOfMaximumStepSize(false),
   isThin(false),
+  yokeExtent(0),
   transformBeamline(nullptr),
   nameOfParserDefinition("")
 {
@@ -156,10 +164,12 @@ BDSFieldInfo::BDSFieldInfo(const BDSFieldInfo& other):
   magneticFieldFormat(other.magneticFieldFormat),
   magneticInterpolatorType(other.magneticInterpolatorType),
   magneticArrayReflectionTypeSet(other.magneticArrayReflectionTypeSet),
+  magneticArrayStorageType(other.magneticArrayStorageType),
   electricFieldFilePath(other.electricFieldFilePath),
   electricFieldFormat(other.electricFieldFormat),
   electricInterpolatorType(other.electricInterpolatorType),
   electricArrayReflectionTypeSet(other.electricArrayReflectionTypeSet),
+  electricArrayStorageType(other.electricArrayStorageType),
   cacheTransforms(other.cacheTransforms),
   eScaling(other.eScaling),
   bScaling(other.bScaling),
@@ -176,6 +186,7 @@ BDSFieldInfo::BDSFieldInfo(const BDSFieldInfo& other):
   modulatorInfo(other.modulatorInfo),
   ignoreUpdateOfMaximumStepSize(other.ignoreUpdateOfMaximumStepSize),
   isThin(other.isThin),
+  yokeExtent(other.yokeExtent),
   transformBeamline(nullptr),
   nameOfParserDefinition(other.nameOfParserDefinition)
 {
@@ -239,10 +250,12 @@ std::ostream& operator<< (std::ostream& out, BDSFieldInfo const& info)
   out << "B map file format:   " << info.magneticFieldFormat      << G4endl;
   out << "B interpolator       " << info.magneticInterpolatorType << G4endl;
   out << "B array reflection:  " << info.magneticArrayReflectionTypeSet << G4endl;
+  out << "B array storage:     " << info.magneticArrayStorageType << G4endl;
   out << "E map file:          " << info.electricFieldFilePath    << G4endl;
   out << "E map file format:   " << info.electricFieldFormat      << G4endl;
   out << "E interpolator       " << info.electricInterpolatorType << G4endl;
   out << "E array reflection:  " << info.electricArrayReflectionTypeSet << G4endl;
+  out << "E array storage:     " << info.electricArrayStorageType << G4endl;
   out << "Transform caching:   " << info.cacheTransforms          << G4endl;
   out << "E Scaling:           " << info.eScaling                 << G4endl;
   out << "B Scaling:           " << info.bScaling                 << G4endl;
@@ -321,3 +334,106 @@ void BDSFieldInfo::SetFieldAsThin()
 {
   isThin = true;
 }
+
+namespace
+{
+  /// Mix the hash of a value into a running hash (as boost::hash_combine).
+  template <typename T>
+  void HashCombine(std::size_t& seed, const T& value)
+  {seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);}
+
+  G4bool TransformsEqual(const G4Transform3D& a, const G4Transform3D& b)
+  {return a.getRotation() == b.getRotation() && a.getTranslation() == b.getTranslation();}
+}
+
+std::size_t BDSFieldInfo::Hash() const
+{
+  std::size_t seed = 0;
+  HashCombine(seed, (G4int)fieldType.underlying());
+  HashCombine(seed, brho);
+  HashCombine(seed, (G4int)integratorType.underlying());
+  HashCombine(seed, provideGlobalTransform);
+  HashCombine(seed, std::string(magneticFieldFilePath));
+  HashCombine(seed, std::string(electricFieldFilePath));
+  HashCombine(seed, eScaling);
+  HashCombine(seed, bScaling);
+  HashCombine(seed, timeOffset);
+  HashCombine(seed, poleTipRadius);
+  HashCombine(seed, beamPipeRadius);
+  HashCombine(seed, tilt);
+  HashCombine(seed, ignoreUpdateOfMaximumStepSize);
+  HashCombine(seed, isThin);
+  HashCombine(seed, yokeExtent);
+  G4ThreeVector translation = TransformComplete().getTranslation();
+  HashCombine(seed, translation.x());
+  HashCombine(seed, translation.y());
+  HashCombine(seed, translation.z());
+  if (magnetStrength)
+    {
+      const BDSMagnetStrength& st = *magnetStrength;
+      for (const auto& keyValue : st)
+	{
+	  if (keyValue.second == 0)
+	    {continue;} // unset keys are zero
+	  HashCombine(seed, std::string(keyValue.first));
+	  HashCombine(seed, keyValue.second);
+	}
+    }
+  return seed;
+}
+
+G4bool BDSFieldInfo::IsEquivalent(const BDSFieldInfo& other) const
+{
+  G4bool same = fieldType == other.fieldType
+    && brho == other.brho
+    && integratorType == other.integratorType
+    && provideGlobalTransform == other.provideGlobalTransform
+    && magneticFieldFilePath == other.magneticFieldFilePath
+    && magneticFieldFormat == other.magneticFieldFormat
+    && magneticInterpolatorType == other.magneticInterpolatorType
+    && magneticArrayReflectionTypeSet == other.magneticArrayReflectionTypeSet
+    && magneticArrayStorageType == other.magneticArrayStorageType
+    && electricFieldFilePath == other.electricFieldFilePath
+    && electricFieldFormat == other.electricFieldFormat
+    && electricInterpolatorType == other.electricInterpolatorType
+    && electricArrayReflectionTypeSet == other.electricArrayReflectionTypeSet
+    && electricArrayStorageType == other.electricArrayStorageType
+    && cacheTransforms == other.cacheTransforms
+    && eScaling == other.eScaling
+    && bScaling == other.bScaling
+    && timeOffset == other.timeOffset
+    && autoScale == other.autoScale
+    && poleTipRadius == other.poleTipRadius
+    && beamPipeRadius == other.beamPipeRadius
+    && chordStepMinimum == other.chordStepMinimum
+    && tilt == other.tilt
+    && secondFieldOnLeft == other.secondFieldOnLeft
+    && magneticSubFieldName == other.magneticSubFieldName
+    && electricSubFieldName == other.electricSubFieldName
+    && usePlacementWorldTransform == other.usePlacementWorldTransform
+    && modulatorInfo == other.modulatorInfo // only the same instance
+    && ignoreUpdateOfMaximumStepSize == other.ignoreUpdateOfMaximumStepSize
+    && isThin == other.isThin
+    && yokeExtent == other.yokeExtent
+    && TransformsEqual(Transform(), other.Transform())
+    && TransformsEqual(TransformBeamline(), other.TransformBeamline());
+  if (!same)
+    {return false;}
+
+  if (!magnetStrength || !other.magnetStrength)
+    {return magnetStrength == other.magnetStrength;}
+  // compare every key set in either as unset keys are zero - const so nothing is inserted
+  const BDSMagnetStrength& st      = *magnetStrength;
+  const BDSMagnetStrength& otherSt = *other.magnetStrength;
+  for (const auto& keyValue : st)
+    {
+      if (otherSt[keyValue.first] != keyValue.second)
+	{return false;}
+    }
+  for (const auto& keyValue : otherSt)
+    {
+      if (st[keyValue.first] != keyValue.second)
+	{return false;}
+    }
+  return true;
+}
@@ -56,13 +56,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldInfo.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSFieldLoaderBDSIM.hh"
+#include "BDSFieldLoaderBinary.hh"
 #include "BDSFieldLoaderPoisson.hh"
+#include "BDSFieldLoaderSharedMemory.hh"
 #include "BDSFieldMagInterpolated.hh"
 #include "BDSFieldMagInterpolated1D.hh"
 #include "BDSFieldMagInterpolated2D.hh"
 #include "BDSFieldMagInterpolated3D.hh"
 #include "BDSFieldMagInterpolated4D.hh"
 #include "BDSFieldValue.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSInterpolator1D.hh"
 #include "BDSInterpolator1DCubic.hh"
 #include "BDSInterpolator1DLinear.hh"
@@ -75,11 +78,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSInterpolator2DNearest.hh"
 #include "BDSInterpolator3D.hh"
 #include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DCubicTable.hh"
+#include "BDSInterpolator3DDirect.hh"
 #include "BDSInterpolator3DLinear.hh"
 #include "BDSInterpolator3DLinearMag.hh"
 #include "BDSInterpolator3DNearest.hh"
 #include "BDSInterpolator4D.hh"
 #include "BDSInterpolator4DCubic.hh"
+#include "BDSInterpolator4DCubicTable.hh"
+#include "BDSInterpolator4DDirect.hh"
 #include "BDSInterpolator4DLinear.hh"
 #include "BDSInterpolator4DLinearMag.hh"
 #include "BDSInterpolator4DNearest.hh"
@@ -96,6 +103,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <cmath>
 #include <fstream>
 #include <set>
+#include <string>
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
@@ -103,6 +111,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 BDSFieldLoader* BDSFieldLoader::instance = nullptr;
 
+namespace
+{
+  /// Arrays larger than this in bytes (i.e. not easily held in cache) are bricked.
+  const std::size_t brickedLayoutMinimumSize = 1024*1024;
+}
+
 BDSFieldLoader* BDSFieldLoader::Instance()
 {
   if (!instance)
@@ -143,26 +157,32 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      i
   G4double                    bScaling = info.BScaling();
   BDSArrayReflectionTypeSet reflection = info.MagneticArrayReflectionType();
   BDSArrayReflectionTypeSet* reflectionPointer = reflection.empty() ? nullptr : &reflection;
+  BDSArrayStorageType          storage = info.MagneticArrayStorageType();
   
   BDSFieldMagInterpolated* result = nullptr;
   try
   {
+  BinaryFileOK(filePath, format);
   switch (format.underlying())
     {
     case BDSFieldFormat::bdsim1d:
-      {result = LoadBDSIM1DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim1dbin:
+      {result = LoadBDSIM1DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim2d:
-      {result = LoadBDSIM2DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim2dbin:
+      {result = LoadBDSIM2DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim3d:
-      {result = LoadBDSIM3DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim3dbin:
+      {result = LoadBDSIM3DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim4d:
-      {result = LoadBDSIM4DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim4dbin:
+      {result = LoadBDSIM4DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::poisson2d:
-      {result = LoadPoissonSuperFishB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishB(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::poisson2dquad:
-      {result = LoadPoissonSuperFishBQuad(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishBQuad(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::poisson2ddipole:
-      {result = LoadPoissonSuperFishBDipole(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishBDipole(filePath, interpolatorType, transform, bScaling, reflectionPointer, storage); break;}
     default:
       {break;}
     }
@@ -225,20 +245,26 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadEField(const BDSFieldInfo& info)
   G4double                    eScaling = info.EScaling();
   BDSArrayReflectionTypeSet reflection = info.ElectricArrayReflectionType();
   BDSArrayReflectionTypeSet* reflectionPointer = reflection.empty() ? nullptr : &reflection;
+  BDSArrayStorageType          storage = info.ElectricArrayStorageType();
   
   BDSFieldEInterpolated* result = nullptr;
   try
   {
+  BinaryFileOK(filePath, format);
   switch (format.underlying())
     {
     case BDSFieldFormat::bdsim1d:
-      {result = LoadBDSIM1DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim1dbin:
+      {result = LoadBDSIM1DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim2d:
-      {result = LoadBDSIM2DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim2dbin:
+      {result = LoadBDSIM2DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim3d:
-      {result = LoadBDSIM3DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim3dbin:
+      {result = LoadBDSIM3DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, storage); break;}
     case BDSFieldFormat::bdsim4d:
-      {result = LoadBDSIM4DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+    case BDSFieldFormat::bdsim4dbin:
+      {result = LoadBDSIM4DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, storage); break;}
     default:
       {break;}
     }
@@ -268,6 +294,8 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadEMField(const BDSFieldInfo& info)
   BDSArrayReflectionTypeSet* bReflectionPointer = bReflection.empty() ? nullptr : &bReflection;
   BDSArrayReflectionTypeSet eReflection = info.ElectricArrayReflectionType();
   BDSArrayReflectionTypeSet* eReflectionPointer = eReflection.empty() ? nullptr : &eReflection;
+  BDSArrayStorageType eStorage = info.ElectricArrayStorageType();
+  BDSArrayStorageType bStorage = info.MagneticArrayStorageType();
 
   // As the different dimension interpolators don't inherit each other, it's very
   // very hard to make a compact polymorphic construction routine here.  In future,
@@ -279,30 +307,40 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadEMField(const BDSFieldInfo& info)
   BDSFieldEMInterpolated* result = nullptr;
   try
   {
+  BinaryFileOK(eFilePath, eFormat);
+  BinaryFileOK(bFilePath, bFormat);
   switch (eFormat.underlying())
     {
     case BDSFieldFormat::bdsim1d:
+    case BDSFieldFormat::bdsim1dbin:
       {
         result = LoadBDSIM1DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer,
+                               eStorage, bStorage);
         break;
       }
     case BDSFieldFormat::bdsim2d:
+    case BDSFieldFormat::bdsim2dbin:
       {
         result = LoadBDSIM2DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer,
+                               eStorage, bStorage);
         break;
       }
     case BDSFieldFormat::bdsim3d:
+    case BDSFieldFormat::bdsim3dbin:
       {
         result = LoadBDSIM3DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer,
+                               eStorage, bStorage);
         break;
       }
     case BDSFieldFormat::bdsim4d:
+    case BDSFieldFormat::bdsim4dbin:
       {
         result = LoadBDSIM4DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer,
+                               eStorage, bStorage);
         break;
       }
     default:
@@ -337,166 +375,194 @@ void BDSFieldLoader::EFilePathOK(const BDSFieldInfo& info)
     }
 }
 
-BDSArray1DCoords* BDSFieldLoader::Get1DCached(const G4String& filePath)
+void BDSFieldLoader::BinaryFileOK(const G4String&       filePath,
+                                  const BDSFieldFormat& format)
 {
-  auto result = arrays1d.find(filePath);
+  if (BDS::FieldFormatIsBinary(format) && !BDSFieldLoaderBinary::IsBinaryFile(filePath))
+    {throw BDSException(__METHOD_NAME__, "\"" + filePath + "\" is not a BDSIM binary format field map.");}
+}
+
+BDSArray1DCoords* BDSFieldLoader::Get1DCached(const G4String& key)
+{
+  auto result = arrays1d.find(key);
   if (result != arrays1d.end())
     {return result->second;}
   else
     {return nullptr;}
 }
 
-BDSArray2DCoords* BDSFieldLoader::Get2DCached(const G4String& filePath)
+BDSArray2DCoords* BDSFieldLoader::Get2DCached(const G4String& key)
 {
-  auto result = arrays2d.find(filePath);
+  auto result = arrays2d.find(key);
   if (result != arrays2d.end())
     {return result->second;}
   else
     {return nullptr;}
 }
 
-BDSArray3DCoords* BDSFieldLoader::Get3DCached(const G4String& filePath)
+BDSArray3DCoords* BDSFieldLoader::Get3DCached(const G4String& key)
 {
-  auto result = arrays3d.find(filePath);
+  auto result = arrays3d.find(key);
   if (result != arrays3d.end())
     {return result->second;}
   else
     {return nullptr;}
 }
 
-BDSArray4DCoords* BDSFieldLoader::Get4DCached(const G4String& filePath)
+BDSArray4DCoords* BDSFieldLoader::Get4DCached(const G4String& key)
 {
-  auto result = arrays4d.find(filePath);
+  auto result = arrays4d.find(key);
   if (result != arrays4d.end())
     {return result->second;}
   else
     {return nullptr;}
 }
 
-BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
+template <class T>
+BDSArray4DCoords* BDSFieldLoader::LoadArrayFromStream(const G4String& filePath,
+                                                      G4int           nDimensions,
+                                                      G4bool          poisson)
 {
-  BDSArray2DCoords* cached = Get2DCached(filePath);
-  if (cached)
-    {return cached;}
-
-  BDSArray2DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (poisson)
     {
-#ifdef USE_GZSTREAM
-      BDSFieldLoaderPoisson<igzstream> loader;
-      result = loader.LoadMag2D(filePath);
-#else
-      throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
-#endif
+      BDSFieldLoaderPoisson<T> loader;
+      return loader.LoadMag2D(filePath);
     }
-  else
+  BDSFieldLoaderBDSIM<T> loader;
+  switch (nDimensions)
     {
-      BDSFieldLoaderPoisson<std::ifstream> loader;
-      result = loader.LoadMag2D(filePath);
+    case 1:
+      {return loader.Load1D(filePath);}
+    case 2:
+      {return loader.Load2D(filePath);}
+    case 3:
+      {return loader.Load3D(filePath);}
+    default:
+      {return loader.Load4D(filePath);}
     }
-  arrays2d[filePath] = result;
-  return result;  
 }
 
-BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
+BDSArray4DCoords* BDSFieldLoader::LoadArrayFromFile(const G4String& filePath,
+                                                    G4int           nDimensions,
+                                                    G4bool          poisson)
 {
-  BDSArray1DCoords* cached = Get1DCached(filePath);
-  if (cached)
-    {return cached;}
-
   // Don't want to template this class and there's no base class pointer
-  // for BDSFieldLoader so unfortunately, there's a wee bit of repetition.
-  BDSArray1DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  // for the loaders so use a templated function for the stream type.
+  if (BDSFieldLoaderBinary::IsBinaryFile(filePath))
+    {// a poisson map converted to binary format still has reflections applied afterwards
+      BDSFieldLoaderBinary loader;
+      return loader.Load(filePath, nDimensions);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
-      BDSFieldLoaderBDSIM<igzstream> loader;
-      result = loader.Load1D(filePath);
+      return LoadArrayFromStream<igzstream>(filePath, nDimensions, poisson);
 #else
       throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
 #endif
     }
   else
-    {
-      BDSFieldLoaderBDSIM<std::ifstream> loader;
-      result = loader.Load1D(filePath);
-    }
-  arrays1d[filePath] = result;
-  return result;
+    {return LoadArrayFromStream<std::ifstream>(filePath, nDimensions, poisson);}
 }
 
-BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
+BDSArray4DCoords* BDSFieldLoader::LoadArray(const G4String&     filePath,
+                                            G4int               nDimensions,
+                                            BDSArrayStorageType storage,
+                                            G4bool              poisson) const
 {
-  BDSArray2DCoords* cached = Get2DCached(filePath);
-  if (cached)
-    {return cached;}
-  
-  BDSArray2DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  BDSArray4DCoords* result = nullptr;
+  // binary files are already memory-mapped and so shared through the page cache
+  if (BDSGlobalConstants::Instance()->FieldMapSharedMemory() && !BDSFieldLoaderBinary::IsBinaryFile(filePath))
     {
-#ifdef USE_GZSTREAM
-      BDSFieldLoaderBDSIM<igzstream> loader;
-      result = loader.Load2D(filePath);
-#else
-      throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
-#endif
+      auto loadFunction = [&filePath, nDimensions, poisson](){return LoadArrayFromFile(filePath, nDimensions, poisson);};
+      result = BDSFieldLoaderSharedMemory::Load(filePath, nDimensions, loadFunction);
     }
   else
+    {result = LoadArrayFromFile(filePath, nDimensions, poisson);}
+
+  // Large 3D and 4D arrays are rearranged into bricks for fewer cache misses during
+  // interpolation. Not for external memory (e.g. shared memory) as that would make a
+  // private copy, nor if the padding to whole bricks would waste too much memory.
+  G4bool large = result->Size() * sizeof(BDSFieldValue) > brickedLayoutMinimumSize;
+  if (nDimensions >= 3 && large && !result->ExternalData() && result->BrickedPaddingRatio() < 1.25)
+    {result->ConvertToBricked();}
+
+  if (storage != BDSArrayStorageType::standard)
     {
-      BDSFieldLoaderBDSIM<std::ifstream> loader;
-      result = loader.Load2D(filePath);
+      std::size_t memoryBefore = result->Size() * sizeof(BDSFieldValue);
+      result->ConvertStorage(storage);
+      G4cout << "Field map \"" << filePath << "\" stored as " << storage << " - "
+             << result->MemoryUsage() / 1024 << " kB instead of " << memoryBefore / 1024 << " kB" << G4endl;
     }
-  arrays2d[filePath] = result;
   return result;
 }
 
-BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
+G4String BDSFieldLoader::CacheKey(const G4String&     filePath,
+                                  BDSArrayStorageType storage)
+{
+  if (storage == BDSArrayStorageType::standard)
+    {return filePath;}
+  else
+    {return filePath + ":" + storage.ToString();}
+}
+
+BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String&     filePath,
+                                                   BDSArrayStorageType storage)
 {
-  BDSArray3DCoords* cached = Get3DCached(filePath);
+  G4String key = CacheKey(filePath, storage);
+  BDSArray2DCoords* cached = Get2DCached(key);
   if (cached)
     {return cached;}
+  BDSArray2DCoords* result = static_cast<BDSArray2DCoords*>(LoadArray(filePath, 2, storage, true));
+  arrays2d[key] = result;
+  return result;  
+}
 
-  BDSArray3DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos )
-    {
-#ifdef USE_GZSTREAM
-      BDSFieldLoaderBDSIM<igzstream> loader;
-      result = loader.Load3D(filePath);
-#else
-      throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
-#endif
-    }
-  else
-    {
-      BDSFieldLoaderBDSIM<std::ifstream> loader;
-      result = loader.Load3D(filePath);
+BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String&     filePath,
+                                              BDSArrayStorageType storage)
+{
+  G4String key = CacheKey(filePath, storage);
+  BDSArray1DCoords* cached = Get1DCached(key);
+  if (cached)
+    {return cached;}
+  BDSArray1DCoords* result = static_cast<BDSArray1DCoords*>(LoadArray(filePath, 1, storage));
+  arrays1d[key] = result;
+  return result;
 }
-  arrays3d[filePath] = result;
+
+BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String&     filePath,
+                                              BDSArrayStorageType storage)
+{
+  G4String key = CacheKey(filePath, storage);
+  BDSArray2DCoords* cached = Get2DCached(key);
+  if (cached)
+    {return cached;}
+  BDSArray2DCoords* result = static_cast<BDSArray2DCoords*>(LoadArray(filePath, 2, storage));
+  arrays2d[key] = result;
   return result;
 }
 
-BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
+BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String&     filePath,
+                                              BDSArrayStorageType storage)
 {
-  BDSArray4DCoords* cached = Get4DCached(filePath);
+  G4String key = CacheKey(filePath, storage);
+  BDSArray3DCoords* cached = Get3DCached(key);
   if (cached)
     {return cached;}
+  BDSArray3DCoords* result = static_cast<BDSArray3DCoords*>(LoadArray(filePath, 3, storage));
+  arrays3d[key] = result;
+  return result;
+}
 
-  BDSArray4DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
-    {
-#ifdef USE_GZSTREAM
-      BDSFieldLoaderBDSIM<igzstream> loader;
-      result = loader.Load4D(filePath);
-#else
-      throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
-#endif
-    }
-  else
-    {
-      BDSFieldLoaderBDSIM<std::ifstream> loader;
-      result = loader.Load4D(filePath);
-    }
-  arrays4d[filePath] = result;
+BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String&     filePath,
+                                              BDSArrayStorageType storage)
+{
+  G4String key = CacheKey(filePath, storage);
+  BDSArray4DCoords* cached = Get4DCached(key);
+  if (cached)
+    {return cached;}
+  BDSArray4DCoords* result = (LoadArray(filePath, 4, storage));
+  arrays4d[key] = result;
   return result;
 }
 
@@ -544,36 +610,112 @@ BDSInterpolator3D* BDSFieldLoader::CreateInterpolator3D(BDSArray3DCoords*   arra
                                                         BDSInterpolatorType interpolatorType) const
 {
   BDSInterpolator3D* result = nullptr;
+  // plain arrays can be read directly without going through the virtual array interface
+  G4bool direct = BDSInterpolator3DDirect<2>::Suitable(array);
   switch (interpolatorType.underlying())
     {
     case BDSInterpolatorType::nearest3d:
       {result = new BDSInterpolator3DNearest(array); break;}
     case BDSInterpolatorType::linear3d:
-      {result = new BDSInterpolator3DLinear(array); break;}
+      {
+        if (direct)
+          {result = new BDSInterpolator3DDirect<2>(array);}
+        else
+          {result = new BDSInterpolator3DLinear(array);}
+        break;
+      }
     case BDSInterpolatorType::linearmag3d:
       {result = new BDSInterpolator3DLinearMag(array); break;}
     case BDSInterpolatorType::cubic3d:
-      {result = new BDSInterpolator3DCubic(array); break;}
+      {
+        if (direct)
+          {result = new BDSInterpolator3DDirect<4>(array);}
+        else
+          {result = new BDSInterpolator3DCubic(array);}
+        break;
+      }
+    case BDSInterpolatorType::cubictable3d:
+      {
+        if (!BDSInterpolator3DCubicTable::Suitable(array))
+          {
+            BDS::Warning(__METHOD_NAME__, "coefficient tables are not available for reflected field maps - using \"cubic3d\" instead.");
+            result = new BDSInterpolator3DCubic(array);
+          }
+        else if (!CubicTableFits(BDSInterpolator3DCubicTable::MemoryRequired(array)))
+          {
+            if (direct)
+              {result = new BDSInterpolator3DDirect<4>(array);}
+            else
+              {result = new BDSInterpolator3DCubic(array);}
+          }
+        else
+          {result = new BDSInterpolator3DCubicTable(array);}
+        break;
+      }
     default:
       {throw BDSException(__METHOD_NAME__, "Invalid interpolator type for 3D field: " + interpolatorType.ToString()); break;}
     }
   return result;
 }
 
+G4bool BDSFieldLoader::CubicTableFits(std::size_t tableSize) const
+{
+  G4double sizeMB = (G4double)tableSize / (1024*1024);
+  G4double limitMB = BDSGlobalConstants::Instance()->FieldMapCubicTableMaxSize();
+  if (sizeMB <= limitMB)
+    {return true;}
+  BDS::Warning(__METHOD_NAME__, "cubic interpolation coefficient table would be " + std::to_string((G4int)sizeMB) +
+               " MB, more than \"fieldMapCubicTableMaxSize\" (" + std::to_string((G4int)limitMB) +
+               " MB) - using \"cubic\" interpolation instead.");
+  return false;
+}
+
 BDSInterpolator4D* BDSFieldLoader::CreateInterpolator4D(BDSArray4DCoords*   array,
                                                         BDSInterpolatorType interpolatorType) const
 {
   BDSInterpolator4D* result = nullptr;
+  // plain arrays can be read directly without going through the virtual array interface
+  G4bool direct = BDSInterpolator4DDirect<2>::Suitable(array);
   switch (interpolatorType.underlying())
     {
     case BDSInterpolatorType::nearest4d:
       {result = new BDSInterpolator4DNearest(array); break;}
     case BDSInterpolatorType::linear4d:
-      {result = new BDSInterpolator4DLinear(array); break;}
+      {
+        if (direct)
+          {result = new BDSInterpolator4DDirect<2>(array);}
+        else
+          {result = new BDSInterpolator4DLinear(array);}
+        break;
+      }
     case BDSInterpolatorType::linearmag4d:
       {result = new BDSInterpolator4DLinearMag(array); break;}
     case BDSInterpolatorType::cubic4d:
-      {result = new BDSInterpolator4DCubic(array); break;}
+      {
+        if (direct)
+          {result = new BDSInterpolator4DDirect<4>(array);}
+        else
+          {result = new BDSInterpolator4DCubic(array);}
+        break;
+      }
+    case BDSInterpolatorType::cubictable4d:
+      {
+        if (!BDSInterpolator4DCubicTable::Suitable(array))
+          {
+            BDS::Warning(__METHOD_NAME__, "coefficient tables are not available for reflected field maps - using \"cubic4d\" instead.");
+            result = new BDSInterpolator4DCubic(array);
+          }
+        else if (!CubicTableFits(BDSInterpolator4DCubicTable::MemoryRequired(array)))
+          {
+            if (direct)
+              {result = new BDSInterpolator4DDirect<4>(array);}
+            else
+              {result = new BDSInterpolator4DCubic(array);}
+          }
+        else
+          {result = new BDSInterpolator4DCubicTable(array);}
+        break;
+      }
     default:
       {throw BDSException(__METHOD_NAME__, "Invalid interpolator type for 4D field: " + interpolatorType.ToString()); break;}
     }
@@ -805,11 +947,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM1DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSArrayStorageType              storage)
 
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray1DCoords*  array = LoadBDSIM1D(filePath);
+  BDSArray1DCoords*  array = LoadBDSIM1D(filePath, storage);
   BDSArray1DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator1D*    ar = CreateInterpolator1D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated1D(ar, transform, bScalingUnits);
@@ -820,10 +963,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM2DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSArrayStorageType              storage)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray2DCoords*  array = LoadBDSIM2D(filePath);
+  BDSArray2DCoords*  array = LoadBDSIM2D(filePath, storage);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
@@ -834,10 +978,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM3DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSArrayStorageType              storage)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray3DCoords*  array = LoadBDSIM3D(filePath);
+  BDSArray3DCoords*  array = LoadBDSIM3D(filePath, storage);
   BDSArray3DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator3D*    ar = CreateInterpolator3D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated3D(ar, transform, bScalingUnits);
@@ -848,10 +993,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM4DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSArrayStorageType              storage)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray4DCoords*  array = LoadBDSIM4D(filePath);
+  BDSArray4DCoords*  array = LoadBDSIM4D(filePath, storage);
   BDSArray4DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator4D*    ar = CreateInterpolator4D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated4D(ar, transform, bScalingUnits);
@@ -862,10 +1008,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishB(const G4String&
                                                                BDSInterpolatorType  interpolatorType,
                                                                const G4Transform3D& transform,
                                                                G4double             bScaling,
-                                                               const BDSArrayReflectionTypeSet* reflection)
+                                                               const BDSArrayReflectionTypeSet* reflection,
+                                                               BDSArrayStorageType              storage)
 {
   G4double   bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords*  array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords*  array = LoadPoissonMag2D(filePath, storage);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
@@ -876,10 +1023,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBQuad(const G4Strin
                                                                    BDSInterpolatorType  interpolatorType,
                                                                    const G4Transform3D& transform,
                                                                    G4double             bScaling,
-                                                                   const BDSArrayReflectionTypeSet* /*reflection*/)
+                                                                   const BDSArrayReflectionTypeSet* /*reflection*/,
+                                                                   BDSArrayStorageType              storage)
 {
   G4double  bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords* array = LoadPoissonMag2D(filePath, storage);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   if (std::abs(array->XStep() - array->YStep()) > 1e-9)
     {throw BDSException(__METHOD_NAME__, "asymmetric grid spacing for reflected quadrupole will result in a distorted field map - please regenerate the map with even spatial samples.");}
@@ -893,10 +1041,11 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBDipole(const G4Str
                                                                      BDSInterpolatorType  interpolatorType,
                                                                      const G4Transform3D& transform,
                                                                      G4double             bScaling,
-                                                                     const BDSArrayReflectionTypeSet* /*reflection*/)
+                                                                     const BDSArrayReflectionTypeSet* /*reflection*/,
+                                                                     BDSArrayStorageType              storage)
 {
   G4double  bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords* array = LoadPoissonMag2D(filePath, storage);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSArray2DCoordsRDipole* rArray = new BDSArray2DCoordsRDipole(array);
   BDSInterpolator2D*           ar = CreateInterpolator2D(rArray, interpolatorType);
@@ -908,10 +1057,11 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM1DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSArrayStorageType              storage)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray1DCoords*  array = LoadBDSIM1D(filePath);
+  BDSArray1DCoords*  array = LoadBDSIM1D(filePath, storage);
   BDSArray1DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator1D*    ar = CreateInterpolator1D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated1D(ar, transform, eScalingUnits);
@@ -922,10 +1072,11 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM2DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSArrayStorageType              storage)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray2DCoords*  array = LoadBDSIM2D(filePath);
+  BDSArray2DCoords*  array = LoadBDSIM2D(filePath, storage);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated2D(ar, transform, eScalingUnits);
@@ -936,10 +1087,11 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM3DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSArrayStorageType              storage)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray3DCoords*  array = LoadBDSIM3D(filePath);
+  BDSArray3DCoords*  array = LoadBDSIM3D(filePath, storage);
   BDSArray3DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator3D*    ar = CreateInterpolator3D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated3D(ar, transform, eScalingUnits);
@@ -950,10 +1102,11 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM4DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSArrayStorageType              storage)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray4DCoords*  array = LoadBDSIM4D(filePath);
+  BDSArray4DCoords*  array = LoadBDSIM4D(filePath, storage);
   BDSArray4DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator4D*    ar = CreateInterpolator4D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated4D(ar, transform, eScalingUnits);
@@ -968,12 +1121,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM1DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSArrayStorageType              eStorage,
+                                                      BDSArrayStorageType              bStorage)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray1DCoords* eArray  = LoadBDSIM1D(eFilePath);
-  BDSArray1DCoords* bArray  = LoadBDSIM1D(bFilePath);
+  BDSArray1DCoords* eArray  = LoadBDSIM1D(eFilePath, eStorage);
+  BDSArray1DCoords* bArray  = LoadBDSIM1D(bFilePath, bStorage);
   BDSArray1DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray1DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator1D*   eInt = CreateInterpolator1D(eArrayR, eInterpolatorType);
@@ -991,12 +1146,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM2DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSArrayStorageType              eStorage,
+                                                      BDSArrayStorageType              bStorage)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray2DCoords*  eArray = LoadBDSIM2D(eFilePath);
-  BDSArray2DCoords*  bArray = LoadBDSIM2D(bFilePath);
+  BDSArray2DCoords*  eArray = LoadBDSIM2D(eFilePath, eStorage);
+  BDSArray2DCoords*  bArray = LoadBDSIM2D(bFilePath, bStorage);
   BDSArray2DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray2DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator2D*   eInt = CreateInterpolator2D(eArrayR, eInterpolatorType);
@@ -1014,12 +1171,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM3DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSArrayStorageType              eStorage,
+                                                      BDSArrayStorageType              bStorage)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray3DCoords*  eArray = LoadBDSIM3D(eFilePath);
-  BDSArray3DCoords*  bArray = LoadBDSIM3D(bFilePath);
+  BDSArray3DCoords*  eArray = LoadBDSIM3D(eFilePath, eStorage);
+  BDSArray3DCoords*  bArray = LoadBDSIM3D(bFilePath, bStorage);
   BDSArray3DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray3DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator3D*   eInt = CreateInterpolator3D(eArrayR, eInterpolatorType);
@@ -1037,12 +1196,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM4DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSArrayStorageType              eStorage,
+                                                      BDSArrayStorageType              bStorage)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray4DCoords*  eArray = LoadBDSIM4D(eFilePath);
-  BDSArray4DCoords*  bArray = LoadBDSIM4D(bFilePath);
+  BDSArray4DCoords*  eArray = LoadBDSIM4D(eFilePath, eStorage);
+  BDSArray4DCoords*  bArray = LoadBDSIM4D(bFilePath, bStorage);
   BDSArray4DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray4DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator4D*   eInt = CreateInterpolator4D(eArrayR, eInterpolatorType);
@@ -0,0 +1,355 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray1DCoords.hh"
+#include "BDSArray2DCoords.hh"
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSDimensionType.hh"
+#include "BDSException.hh"
+#include "BDSFieldLoaderBinary.hh"
+#include "BDSFieldValue.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const char          binaryIdentifier[8] = {'B','D','S','I','M','F','M','B'};
+  const std::uint32_t binaryVersion       = 1;
+  const std::uint32_t binaryEndianCheck   = 0x01020304;
+  const std::uint64_t binaryDataAlignment = 64;
+}
+
+BDSFieldLoaderBinary::BDSFieldLoaderBinary()
+{;}
+
+BDSFieldLoaderBinary::~BDSFieldLoaderBinary()
+{;}
+
+BDSArray1DCoords* BDSFieldLoaderBinary::Load1D(const G4String& fileName)
+{
+  return static_cast<BDSArray1DCoords*>(Load(fileName, 1));
+}
+
+BDSArray2DCoords* BDSFieldLoaderBinary::Load2D(const G4String& fileName)
+{
+  return static_cast<BDSArray2DCoords*>(Load(fileName, 2));
+}
+
+BDSArray3DCoords* BDSFieldLoaderBinary::Load3D(const G4String& fileName)
+{
+  return static_cast<BDSArray3DCoords*>(Load(fileName, 3));
+}
+
+BDSArray4DCoords* BDSFieldLoaderBinary::Load4D(const G4String& fileName)
+{
+  return Load(fileName, 4);
+}
+
+G4bool BDSFieldLoaderBinary::IsBinaryFile(const G4String& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.is_open())
+    {return false;}
+  char identifier[8] = {0};
+  file.read(identifier, sizeof(identifier));
+  if (file.gcount() != (std::streamsize)sizeof(identifier))
+    {return false;}
+  return std::memcmp(identifier, binaryIdentifier, sizeof(identifier)) == 0;
+}
+
+void BDSFieldLoaderBinary::ReadHeader(int             fileDescriptor,
+                                      const G4String& fileName,
+                                      Header&         header)
+{
+  ssize_t nRead = pread(fileDescriptor, &header, sizeof(Header), 0);
+  if (nRead != (ssize_t)sizeof(Header))
+    {throw BDSException(__METHOD_NAME__, "unable to read header from \"" + fileName + "\"");}
+  if (std::memcmp(header.identifier, binaryIdentifier, sizeof(binaryIdentifier)) != 0)
+    {throw BDSException(__METHOD_NAME__, "\"" + fileName + "\" is not a BDSIM binary field map");}
+  if (header.endianCheck != binaryEndianCheck)
+    {throw BDSException(__METHOD_NAME__, "\"" + fileName + "\" was written on a machine with different endianness");}
+  if (header.version != binaryVersion)
+    {throw BDSException(__METHOD_NAME__, "unsupported binary field map version " + std::to_string(header.version));}
+  if (header.componentSize != sizeof(G4float) && header.componentSize != sizeof(G4double))
+    {throw BDSException(__METHOD_NAME__, "invalid field component size in \"" + fileName + "\"");}
+  std::uint64_t nExpected = 1;
+  for (G4int i = 0; i < 4; i++)
+    {
+      if (header.n[i] < 1)
+        {throw BDSException(__METHOD_NAME__, "number of points in each dimension must be greater than 0 in \"" + fileName + "\"");}
+      nExpected *= (std::uint64_t)header.n[i];
+    }
+  if (nExpected != header.nValues)
+    {throw BDSException(__METHOD_NAME__, "inconsistent number of values in header of \"" + fileName + "\"");}
+}
+
+BDSArray4DCoords* BDSFieldLoaderBinary::Load(const G4String& fileName,
+                                             G4int           nDimensions) const
+{
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+    {throw BDSException(__METHOD_NAME__, "Invalid file name or no such file named \"" + fileName + "\"");}
+  G4cout << "BDSIM Binary Field Format> Loading \"" << fileName << "\"" << G4endl;
+  BDSArray4DCoords* result = nullptr;
+  try
+    {result = LoadFromDescriptor(fd, fileName, nDimensions, false);}
+  catch (BDSException&)
+    {
+      close(fd);
+      throw;
+    }
+  // the mapping remains valid after the file descriptor is closed
+  close(fd);
+  return result;
+}
+
+BDSArray4DCoords* BDSFieldLoaderBinary::LoadFromDescriptor(int             fileDescriptor,
+                                                           const G4String& name,
+                                                           G4int           nDimensions,
+                                                           G4bool          readOnly) const
+{
+  G4String functionName = "BDSIM Binary Field Format> ";
+  Header header;
+  ReadHeader(fileDescriptor, name, header);
+  if ((G4int)header.nDimensions != nDimensions)
+    {
+      G4String msg = "\"" + name + "\" contains a " + std::to_string(header.nDimensions) + "D field map but a ";
+      msg += std::to_string(nDimensions) + "D one was expected";
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+  struct stat fileStat;
+  if (fstat(fileDescriptor, &fileStat) != 0)
+    {throw BDSException(__METHOD_NAME__, "unable to determine size of \"" + name + "\"");}
+  std::uint64_t dataSize = header.nValues * 3 * header.componentSize;
+  if ((std::uint64_t)fileStat.st_size < header.dataOffset + dataSize)
+    {throw BDSException(__METHOD_NAME__, "\"" + name + "\" is truncated");}
+
+  // the data may either be used directly if it's the same precision or copied and converted
+  G4bool samePrecision = header.componentSize == sizeof(FIELDTYPET);
+  std::size_t mapLength = (std::size_t)fileStat.st_size;
+  // nothing writes to the field values, so the mapping is read only and a stray write faults
+  int flags = samePrecision && readOnly ? MAP_SHARED : MAP_PRIVATE;
+  void* base = mmap(nullptr, mapLength, PROT_READ, flags, fileDescriptor, 0);
+  if (base == MAP_FAILED)
+    {throw BDSException(__METHOD_NAME__, "unable to memory map \"" + name + "\": " + std::strerror(errno));}
+  std::shared_ptr<void> owner(base, [mapLength](void* p){munmap(p, mapLength);});
+  const char* rawData = static_cast<const char*>(base) + header.dataOffset;
+
+  BDSFieldValue* externalData = nullptr;
+  std::shared_ptr<void> externalOwner = nullptr;
+  if (samePrecision)
+    {
+      externalData  = reinterpret_cast<BDSFieldValue*>(const_cast<char*>(rawData));
+      externalOwner = owner;
+    }
+
+  const std::int32_t* n = header.n;
+  const double* mn = header.min;
+  const double* mx = header.max;
+  BDSDimensionType d[4];
+  for (G4int i = 0; i < 4; i++)
+    {d[i] = BDSDimensionType(header.dimensions[i]);}
+
+  BDSArray4DCoords* result = nullptr;
+  switch (nDimensions)
+    {
+    case 1:
+      {result = new BDSArray1DCoords(n[0], mn[0], mx[0], d[0], externalData, externalOwner); break;}
+    case 2:
+      {
+        result = new BDSArray2DCoords(n[0], n[1], mn[0], mx[0], mn[1], mx[1],
+                                      d[0], d[1], externalData, externalOwner);
+        break;
+      }
+    case 3:
+      {
+        result = new BDSArray3DCoords(n[0], n[1], n[2], mn[0], mx[0], mn[1], mx[1], mn[2], mx[2],
+                                      d[0], d[1], d[2], externalData, externalOwner);
+        break;
+      }
+    case 4:
+      {
+        result = new BDSArray4DCoords(n[0], n[1], n[2], n[3],
+                                      mn[0], mx[0], mn[1], mx[1], mn[2], mx[2], mn[3], mx[3],
+                                      d[0], d[1], d[2], d[3], externalData, externalOwner);
+        break;
+      }
+    default:
+      {
+        G4String msg = "\"" + name + "\" has an unsupported number of dimensions: ";
+        msg += std::to_string(nDimensions);
+        throw BDSException(__METHOD_NAME__, msg);
+      }
+    }
+
+  if (!samePrecision)
+    {// convert each component to the precision of BDSFieldValue - the mapping is released afterwards
+      G4cout << functionName << "precision of \"" << name << "\" differs from BDSIM build - converting values" << G4endl;
+      std::uint64_t index = 0;
+      for (G4int l = 0; l < n[3]; l++)
+        {
+          for (G4int k = 0; k < n[2]; k++)
+            {
+              for (G4int j = 0; j < n[1]; j++)
+                {
+                  for (G4int i = 0; i < n[0]; i++)
+                    {
+                      FIELDTYPET v[3];
+                      for (G4int c = 0; c < 3; c++)
+                        {
+                          const char* component = rawData + (3*index + c) * header.componentSize;
+                          if (header.componentSize == sizeof(G4float))
+                            {G4float f; std::memcpy(&f, component, sizeof(G4float)); v[c] = (FIELDTYPET)f;}
+                          else
+                            {G4double f; std::memcpy(&f, component, sizeof(G4double)); v[c] = (FIELDTYPET)f;}
+                        }
+                      (*result)(i, j, k, l) = BDSFieldValue(v[0], v[1], v[2]);
+                      index++;
+                    }
+                }
+            }
+        }
+    }
+
+  G4cout << functionName << "Loaded " << header.nValues << " field values"
+         << (samePrecision ? (readOnly ? " (shared memory)" : " (memory mapped)") : "") << G4endl;
+  return result;
+}
+
+BDSFieldLoaderBinary::Header BDSFieldLoaderBinary::MakeHeader(const BDSArray4DCoords* array,
+                                                              G4int                   nDimensions)
+{
+  if (!array)
+    {throw BDSException(__METHOD_NAME__, "no array to write");}
+  if (nDimensions < 1 || nDimensions > 4)
+    {throw BDSException(__METHOD_NAME__, "invalid number of dimensions " + std::to_string(nDimensions));}
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::memcpy(header.identifier, binaryIdentifier, sizeof(binaryIdentifier));
+  header.version       = binaryVersion;
+  header.endianCheck   = binaryEndianCheck;
+  header.nDimensions   = (std::uint32_t)nDimensions;
+  header.componentSize = (std::uint32_t)sizeof(FIELDTYPET);
+  header.n[0] = array->NX();
+  header.n[1] = array->NY();
+  header.n[2] = array->NZ();
+  header.n[3] = array->NT();
+  header.dimensions[0] = array->FirstDimension().underlying();
+  header.dimensions[1] = array->SecondDimension().underlying();
+  header.dimensions[2] = array->ThirdDimension().underlying();
+  header.dimensions[3] = array->FourthDimension().underlying();
+  header.min[0] = array->XMin();
+  header.min[1] = array->YMin();
+  header.min[2] = array->ZMin();
+  header.min[3] = array->TMin();
+  header.max[0] = array->XMax();
+  header.max[1] = array->YMax();
+  header.max[2] = array->ZMax();
+  header.max[3] = array->TMax();
+  header.nValues = (std::uint64_t)array->Size();
+  // align the start of the data
+  header.dataOffset = ((sizeof(Header) + binaryDataAlignment - 1) / binaryDataAlignment) * binaryDataAlignment;
+  return header;
+}
+
+std::size_t BDSFieldLoaderBinary::SizeInBytes(const BDSArray4DCoords* array)
+{
+  Header header = MakeHeader(array, 4);
+  return (std::size_t)(header.dataOffset + header.nValues * 3 * header.componentSize);
+}
+
+void BDSFieldLoaderBinary::Serialise(const BDSArray4DCoords* array,
+                                     G4int                   nDimensions,
+                                     char*                   buffer)
+{
+  Header header = MakeHeader(array, nDimensions);
+  FIELDTYPET* values = reinterpret_cast<FIELDTYPET*>(buffer + header.dataOffset);
+  for (G4int l = 0; l < array->NT(); l++)
+    {
+      for (G4int k = 0; k < array->NZ(); k++)
+        {
+          for (G4int j = 0; j < array->NY(); j++)
+            {
+              for (G4int i = 0; i < array->NX(); i++)
+                {
+                  const BDSFieldValue& v = array->GetConst(i, j, k, l);
+                  *values++ = v.x();
+                  *values++ = v.y();
+                  *values++ = v.z();
+                }
+            }
+        }
+    }
+  // header last so that an incomplete buffer is never valid
+  std::memset(buffer, 0, (std::size_t)header.dataOffset);
+  std::memcpy(buffer, &header, sizeof(Header));
+}
+
+void BDSFieldLoaderBinary::Write(const BDSArray4DCoords* array,
+                                 G4int                   nDimensions,
+                                 const G4String&         fileName)
+{
+  Header header = MakeHeader(array, nDimensions);
+
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "unable to open \"" + fileName + "\" for writing");}
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  std::vector<char> padding(header.dataOffset - sizeof(Header), 0);
+  file.write(padding.data(), (std::streamsize)padding.size());
+
+  // write in the natural order of the array (x fastest) through the accessor so
+  // that it works for any array implementation
+  for (G4int l = 0; l < array->NT(); l++)
+    {
+      for (G4int k = 0; k < array->NZ(); k++)
+        {
+          for (G4int j = 0; j < array->NY(); j++)
+            {
+              for (G4int i = 0; i < array->NX(); i++)
+                {
+                  const BDSFieldValue& v = array->GetConst(i, j, k, l);
+                  FIELDTYPET components[3] = {v.x(), v.y(), v.z()};
+                  file.write(reinterpret_cast<const char*>(components), sizeof(components));
+                }
+            }
+        }
+    }
+  if (!file)
+    {throw BDSException(__METHOD_NAME__, "error writing to \"" + fileName + "\"");}
+  file.close();
+  G4cout << "BDSIM Binary Field Format> Wrote " << header.nValues << " field values to \"" << fileName << "\"" << G4endl;
+}
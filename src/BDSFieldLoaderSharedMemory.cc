@@ -0,0 +1,215 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldLoaderBinary.hh"
+#include "BDSFieldLoaderSharedMemory.hh"
+#include "BDSFieldValue.hh"
+#include "BDSWarning.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const std::uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+  const std::uint64_t fnvPrime       = 1099511628211ULL;
+
+  /// Accumulate bytes into an FNV-1a hash.
+  void HashBytes(std::uint64_t& hash, const char* bytes, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; i++)
+      {
+        hash ^= (std::uint64_t)(unsigned char)bytes[i];
+        hash *= fnvPrime;
+      }
+  }
+}
+
+BDSArray4DCoords* BDSFieldLoaderSharedMemory::Load(const G4String& filePath,
+                                                   G4int           nDimensions,
+                                                   const LoadFunction& loadFunction)
+{
+#ifndef __linux__
+  BDS::Warning(__METHOD_NAME__, "shared memory field maps are only supported on Linux - loading \"" + filePath + "\" normally");
+  return loadFunction();
+#else
+  G4String objectName = ObjectName(filePath, nDimensions);
+  if (objectName.empty())
+    {return loadFunction();} // can't read the file - let the regular loader report the problem
+
+  const G4int maxAttempts = 100;
+  for (G4int attempt = 0; attempt < maxAttempts; attempt++)
+    {
+      int fd = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+      if (fd >= 0)
+        {// this process loads the map - others wait for the exclusive lock to be released
+          flock(fd, LOCK_EX);
+          BDSArray4DCoords* array = nullptr;
+          try
+            {array = loadFunction();}
+          catch (...)
+            {
+              shm_unlink(objectName.c_str());
+              close(fd);
+              throw;
+            }
+          G4bool published = Publish(fd, array, nDimensions);
+          if (!published)
+            {shm_unlink(objectName.c_str());}
+          flock(fd, LOCK_UN);
+          close(fd);
+          if (!published)
+            {
+              BDS::Warning(__METHOD_NAME__, "unable to place \"" + filePath + "\" in shared memory - using private copy");
+              return array;
+            }
+          // swap the private copy for the shared one so the memory is only used once
+          BDSArray4DCoords* shared = Attach(objectName, nDimensions);
+          if (shared)
+            {
+              delete array;
+              return shared;
+            }
+          return array;
+        }
+      else if (errno == EEXIST)
+        {
+          BDSArray4DCoords* shared = Attach(objectName, nDimensions);
+          if (shared)
+            {
+              G4cout << "Field map \"" << filePath << "\" attached from shared memory \"" << objectName << "\"" << G4endl;
+              return shared;
+            }
+        }
+      else
+        {
+          BDS::Warning(__METHOD_NAME__, "unable to create shared memory for \"" + filePath + "\": " + std::strerror(errno));
+          return loadFunction();
+        }
+      // the object exists but isn't ready or has just been removed - try again shortly
+      usleep(10000);
+    }
+  BDS::Warning(__METHOD_NAME__, "shared memory object \"" + objectName + "\" is incomplete - it may be left from an "
+               "aborted job and can be removed - loading \"" + filePath + "\" normally");
+  return loadFunction();
+#endif
+}
+
+G4String BDSFieldLoaderSharedMemory::ObjectName(const G4String& filePath,
+                                                G4int           nDimensions)
+{
+  char canonicalPath[PATH_MAX];
+  if (!realpath(filePath.c_str(), canonicalPath))
+    {return "";}
+  std::ifstream file(canonicalPath, std::ios::binary);
+  if (!file.is_open())
+    {return "";}
+  file.close();
+
+  std::uint64_t hash = fnvOffsetBasis;
+  HashBytes(hash, canonicalPath, std::strlen(canonicalPath));
+  std::uint64_t contentHash = ContentHash(canonicalPath);
+  HashBytes(hash, reinterpret_cast<const char*>(&contentHash), sizeof(contentHash));
+  std::uint32_t layout[2] = {(std::uint32_t)nDimensions, (std::uint32_t)sizeof(FIELDTYPET)};
+  HashBytes(hash, reinterpret_cast<const char*>(layout), sizeof(layout));
+
+  // short enough for all systems (some have a limit of 31 characters)
+  char name[32];
+  std::snprintf(name, sizeof(name), "/bdsimfm-%016llx", (unsigned long long)hash);
+  return G4String(name);
+}
+
+std::uint64_t BDSFieldLoaderSharedMemory::ContentHash(const G4String& filePath)
+{
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "unable to open \"" + filePath + "\"");}
+  std::uint64_t hash = fnvOffsetBasis;
+  std::vector<char> buffer(1 << 20);
+  while (file)
+    {
+      file.read(buffer.data(), (std::streamsize)buffer.size());
+      HashBytes(hash, buffer.data(), (std::size_t)file.gcount());
+    }
+  return hash;
+}
+
+G4bool BDSFieldLoaderSharedMemory::Publish(int                     fileDescriptor,
+                                           const BDSArray4DCoords* array,
+                                           G4int                   nDimensions)
+{
+  std::size_t size = BDSFieldLoaderBinary::SizeInBytes(array);
+#ifdef __linux__
+  // reserve the memory now rather than fail on first write if there isn't enough
+  if (posix_fallocate(fileDescriptor, 0, (off_t)size) != 0)
+    {return false;}
+#else
+  if (ftruncate(fileDescriptor, (off_t)size) != 0)
+    {return false;}
+#endif
+  void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+  if (base == MAP_FAILED)
+    {return false;}
+  BDSFieldLoaderBinary::Serialise(array, nDimensions, static_cast<char*>(base));
+  munmap(base, size);
+  return true;
+}
+
+BDSArray4DCoords* BDSFieldLoaderSharedMemory::Attach(const G4String& objectName,
+                                                     G4int           nDimensions)
+{
+  int fd = shm_open(objectName.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    {return nullptr;}
+  // wait for the creating process to finish writing
+  flock(fd, LOCK_SH);
+  BDSArray4DCoords* result = nullptr;
+  struct stat objectStat;
+  if (fstat(fd, &objectStat) == 0 && (std::size_t)objectStat.st_size >= sizeof(BDSFieldLoaderBinary::Header))
+    {
+      try
+        {
+          BDSFieldLoaderBinary loader;
+          result = loader.LoadFromDescriptor(fd, objectName, nDimensions, true);
+        }
+      catch (BDSException&)
+        {result = nullptr;} // incomplete or invalid
+    }
+  flock(fd, LOCK_UN);
+  close(fd);
+  return result;
+}
@@ -52,7 +52,7 @@ G4ThreeVector BDSFieldMag::GetFieldTransformed(const G4ThreeVector& position,
       G4ThreeVector field = GetField(transformedPosition, t);
       if (modulator)
         {
-          G4double factor = modulator->Factor(transformedPosition, t);
+          G4double factor = modulator->CachedFactor(transformedPosition, t);
           field *= factor;
         }
       G4ThreeVector transformedField = transform * (HepGeom::Vector3D<G4double>)field;
@@ -63,7 +63,7 @@ G4ThreeVector BDSFieldMag::GetFieldTransformed(const G4ThreeVector& position,
       G4ThreeVector field = GetField(position, t);
       if (modulator)
         {
-          G4double factor = modulator->Factor(position, t);
+          G4double factor = modulator->CachedFactor(position, t);
           field *= factor;
         }
       return field;
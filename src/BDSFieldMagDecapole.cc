@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagDecapole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4ThreeVector.hh"
@@ -56,3 +57,11 @@ G4ThreeVector BDSFieldMagDecapole::GetField(const G4ThreeVector &position,
 
   return localField;
 }
+
+G4bool BDSFieldMagDecapole::TransversePolynomial(BDSMultipolePolynomial& polynomial) const
+{
+  // By + iBx = (B''''/4!) (x + iy)^4
+  polynomial = BDSMultipolePolynomial();
+  polynomial.SetCoefficient(4, G4complex(bQPNormed, 0));
+  return true;
+}
@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagMultipole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 #include "BDSUtilities.hh"
 
 #include "globals.hh"
@@ -62,56 +63,45 @@ BDSFieldMagMultipole::BDSFieldMagMultipole(BDSMagnetStrength const* strength,
   // class supports.
   if (std::abs(order) > (G4int)normalComponents.size())
     {order = (G4int)normalComponents.size();}
-}
-
-G4ThreeVector BDSFieldMagMultipole::GetField(const G4ThreeVector &position,
-					     const G4double       /*t*/) const
-{
-  // Translate cartesian to polar coordinates
-  G4double r   = std::hypot(position.x(),position.y());
-  G4double phi = 0;
-  if (BDS::IsFiniteStrength(std::abs(r)))
-    {phi = atan2(position.y(),position.x());}
 
-  // compute B field in cylindrical coordinates first then convert to cartesian
-  // Bx = Br * cos(phi) - Bphi * sin(phi)
-  // By = Br * sin(phi) + Bphi * cos(phi)
-  // where, if n=1 is for dipole:
+  // The field in cylindrical coordinates for order n (n=1 is dipole) is:
   // Br  (n) (normal) = +Bn/(n-1)! * r^(n-1) * sin(n*phi)
   // Bphi(n) (normal) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
   // Br  (n) (skewed) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
   // Bphi(n) (skewed) = -Bn/(n-1)! * r^(n-1) * sin(n*phi)
-  // cumulative variables for calculating the field
-
-  G4double br = 0;
-  G4double bphi = 0;
-  // I want to use the strange convention of dipole coeff. with opposite sign -
-  // then it is the same sign as angle.
+  // with the convention of the dipole coefficient having the opposite sign (same sign
+  // as the angle) - hence the negative factorial. Converted to cartesian and with
+  // z = x + iy, this is By + iBx = sum_n (kn - i*ks) / (-n!) * z^n where n = i+1 for the
+  // i-th component (i=0 is quadrupole). This is evaluated without powers or trigonometry.
   G4double ffact = -1;
   for (G4int i = 0; i < maximumNonZeroOrder; i++)
     {
-      // Here we add to so order represents kn properly
-      G4double o = (G4double)i+2; // the current order
-      br   += normalComponents[i] * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //normal
-      br   -= skewComponents[i]   * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //skewed
-
-      bphi += normalComponents[i] * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //normal
-      bphi += skewComponents[i]   * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //skewed
-
-      // Ignore dipole component for now!
-      //if(o==1) // for the angle convention
-	  //{br *= -1; bphi *=-1; }
-
-      ffact *= o;
+      G4double kn = i < (G4int)normalComponents.size() ? normalComponents[i] : 0;
+      G4double ks = i < (G4int)skewComponents.size()   ? skewComponents[i]   : 0;
+      polynomial.SetCoefficient(i+1, G4complex(kn, -ks) / ffact);
+      ffact *= (G4double)(i+2);
     }
-
-  G4ThreeVector cartesianField;
-  cartesianField[0] = (br * std::cos(phi) - bphi * std::sin(phi)); // B_x
-  cartesianField[1] = (br * std::sin(phi) + bphi * std::cos(phi)); // B_y
-  cartesianField[2] = 0;                                           // B_z
-
-  return cartesianField;
 }
 
+G4ThreeVector BDSFieldMagMultipole::GetField(const G4ThreeVector& position,
+                                             const G4double       /*t*/) const
+{
+  G4double by, bx;
+  polynomial.Evaluate(position.x(), position.y(), by, bx);
+  return G4ThreeVector(bx, by, 0);
+}
 
+void BDSFieldMagMultipole::GetFieldBatch(std::size_t     nPoints,
+                                         const G4double* x,
+                                         const G4double* y,
+                                         G4double*       bx,
+                                         G4double*       by) const
+{
+  polynomial.Evaluate(nPoints, x, y, by, bx);
+}
 
+G4bool BDSFieldMagMultipole::TransversePolynomial(BDSMultipolePolynomial& polynomialOut) const
+{
+  polynomialOut = polynomial;
+  return true;
+}
@@ -0,0 +1,87 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray2DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSFieldMagMultipoleOuterGridded.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator2DLinear.hh"
+
+#include "globals.hh" // geant4 types / globals
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+BDSFieldMagMultipoleOuterGridded::BDSFieldMagMultipoleOuterGridded(BDSFieldMag*      analyticalFieldIn,
+								   BDSArray2DCoords* gridIn):
+  analyticalField(analyticalFieldIn),
+  interpolator(new BDSInterpolator2DLinear(gridIn)),
+  warnedOutside(false),
+  xMin(gridIn->XMin()),
+  xMax(gridIn->XMax()),
+  yMin(gridIn->YMin()),
+  yMax(gridIn->YMax())
+{
+  finiteStrength = analyticalField->FiniteStrength();
+}
+
+BDSFieldMagMultipoleOuterGridded::~BDSFieldMagMultipoleOuterGridded()
+{
+  delete interpolator;
+  delete analyticalField;
+}
+
+G4ThreeVector BDSFieldMagMultipoleOuterGridded::GetField(const G4ThreeVector& position,
+							 const G4double       t) const
+{
+  G4double x = position.x();
+  G4double y = position.y();
+  if (x < xMin || x > xMax || y < yMin || y > yMax)
+    {
+      if (!warnedOutside.exchange(true))
+        {// during tracking so don't use BDS::Warning which pauses
+          G4cout << __METHOD_NAME__ << "WARNING point (" << x/CLHEP::mm << ", " << y/CLHEP::mm
+                 << ") mm is outside the interpolated yoke field grid of +- " << xMax/CLHEP::mm
+                 << " mm - using the analytical yoke field beyond the grid" << G4endl;
+        }
+      return analyticalField->GetField(position, t);
+    }
+  return interpolator->GetInterpolatedValue(x, y);
+}
+
+BDSArray2DCoords* BDSFieldMagMultipoleOuterGridded::SampleField(const BDSFieldMag* field,
+								G4double           halfWidth,
+								G4int              nPoints)
+{
+  BDSArray2DCoords* grid = new BDSArray2DCoords(nPoints, nPoints,
+						-halfWidth, halfWidth,
+						-halfWidth, halfWidth);
+  G4double step = 2*halfWidth / (G4double)(nPoints - 1);
+  for (G4int j = 0; j < nPoints; j++)
+    {
+      G4double y = -halfWidth + j*step;
+      for (G4int i = 0; i < nPoints; i++)
+	{
+	  G4double x = -halfWidth + i*step;
+	  G4ThreeVector b = field->GetField(G4ThreeVector(x, y, 0));
+	  (*grid)(i, j, 0, 0) = BDSFieldValue(b.x(), b.y(), b.z());
+	}
+    }
+  return grid;
+}
@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagOctupole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 #include "BDSUtilities.hh"
 
 #include "G4ThreeVector.hh"
@@ -57,3 +58,11 @@ G4ThreeVector BDSFieldMagOctupole::GetField(const G4ThreeVector &position,
 
   return localField;
 }
+
+G4bool BDSFieldMagOctupole::TransversePolynomial(BDSMultipolePolynomial& polynomial) const
+{
+  // By + iBx = (B'''/3!) (x + iy)^3
+  polynomial = BDSMultipolePolynomial();
+  polynomial.SetCoefficient(3, G4complex(bTPNormed, 0));
+  return true;
+}
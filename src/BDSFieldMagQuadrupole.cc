@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagQuadrupole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 #include "BDSUtilities.hh"
 
 #include "globals.hh" // geant4 types / globals
@@ -47,3 +48,11 @@ G4ThreeVector BDSFieldMagQuadrupole::GetField(const G4ThreeVector &position,
 
   return field;
 }
+
+G4bool BDSFieldMagQuadrupole::TransversePolynomial(BDSMultipolePolynomial& polynomial) const
+{
+  // By + iBx = B' (x + iy)
+  polynomial = BDSMultipolePolynomial();
+  polynomial.SetCoefficient(1, G4complex(bPrime, 0));
+  return true;
+}
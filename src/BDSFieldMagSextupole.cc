@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagSextupole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 #include "BDSUtilities.hh"
 
 #include "globals.hh" // geant4 types / globals
@@ -54,3 +55,11 @@ G4ThreeVector BDSFieldMagSextupole::GetField(const G4ThreeVector& position,
   
   return localField;
 }
+
+G4bool BDSFieldMagSextupole::TransversePolynomial(BDSMultipolePolynomial& polynomial) const
+{
+  // By + iBx = (B''/2!) (x + iy)^2
+  polynomial = BDSMultipolePolynomial();
+  polynomial.SetCoefficient(2, G4complex(halfBDoublePrime, 0));
+  return true;
+}
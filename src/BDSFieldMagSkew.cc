@@ -17,13 +17,15 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSFieldMagSkew.hh"
+#include "BDSMultipolePolynomial.hh"
 
 #include "globals.hh"
 #include "G4RotationMatrix.hh"
 
 BDSFieldMagSkew::BDSFieldMagSkew(BDSFieldMag* fieldIn,
 				 G4double     angle):
-  field(fieldIn)
+  field(fieldIn),
+  usePolynomial(false)
 {
   rotation     = new G4RotationMatrix();
   antiRotation = new G4RotationMatrix();
@@ -31,6 +33,10 @@ BDSFieldMagSkew::BDSFieldMagSkew(BDSFieldMag* fieldIn,
   antiRotation->rotateZ(-angle);
 
   finiteStrength = field->FiniteStrength();
+
+  usePolynomial = field->TransversePolynomial(polynomial);
+  if (usePolynomial)
+    {polynomial.RotateField(angle);}
 }
 
 BDSFieldMagSkew::~BDSFieldMagSkew()
@@ -42,8 +48,21 @@ BDSFieldMagSkew::~BDSFieldMagSkew()
 G4ThreeVector BDSFieldMagSkew::GetField(const G4ThreeVector &position,
 					const G4double       t) const
 {
+  if (usePolynomial)
+    {
+      G4double by, bx;
+      polynomial.Evaluate(position.x(), position.y(), by, bx);
+      return G4ThreeVector(bx, by, 0);
+    }
   G4ThreeVector rotatedPosition(position);
   rotatedPosition           = rotatedPosition.transform(*rotation);
   G4ThreeVector normalField = field->GetField(rotatedPosition, t);
   return (*antiRotation)*normalField;
 }
+
+G4bool BDSFieldMagSkew::TransversePolynomial(BDSMultipolePolynomial& polynomialOut) const
+{
+  if (usePolynomial)
+    {polynomialOut = polynomial;}
+  return usePolynomial;
+}
@@ -134,6 +134,19 @@ void BDSFieldObjects::AttachToVolume(const std::vector<G4LogicalVolume*>& volume
     {AttachToVolume(volume, penetrateToDaughterVolumes);}
 }
 
+void BDSFieldObjects::AttachToVolume(const std::vector<G4LogicalVolume*>& volumes,
+				     G4bool              penetrateToDaughterVolumes,
+				     const BDSFieldInfo* userLimitsInfo) const
+{
+  G4UserLimits* ul = userLimitsInfo ? userLimitsInfo->UserLimits() : nullptr;
+  for (auto volume : volumes)
+    {
+      volume->SetFieldManager(fieldManager, penetrateToDaughterVolumes);
+      if (ul)
+	{AttachUserLimitsToVolume(volume, ul, penetrateToDaughterVolumes);}
+    }
+}
+
 void BDSFieldObjects::AttachUserLimitsToVolume(G4LogicalVolume* volume,
 					       G4UserLimits*    userLimits,
 					       G4bool           penetrateToDaughterVolumes) const
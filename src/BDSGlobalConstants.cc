@@ -56,6 +56,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <utility>
 
 BDSGlobalConstants* BDSGlobalConstants::instance = nullptr;
+G4ThreadLocal G4int BDSGlobalConstants::turnsTaken = 1;
 
 BDSGlobalConstants* BDSGlobalConstants::Instance()
 {
@@ -70,8 +71,7 @@ BDSGlobalConstants* BDSGlobalConstants::Instance()
 }
 
 BDSGlobalConstants::BDSGlobalConstants(const GMAD::Options& opt):
-  options(opt),
-  turnsTaken(0)
+  options(opt)
 {
   ResetTurnNumber();
   outputType = BDS::DetermineOutputType(options.outputFormat);
@@ -150,6 +150,10 @@ BDSGlobalConstants::BDSGlobalConstants(const GMAD::Options& opt):
   trajectoryFiltersSet[BDSTrajectoryFilter::maximumR]        = options.HasBeenSet("trajCutLTR");
   trajectoryFiltersSet[BDSTrajectoryFilter::secondary]       = options.HasBeenSet("storeTrajectorySecondaryParticles");
 
+  // binned energy deposition replaces the energy deposition of each step unless that's asked for too
+  if (options.storeElossBinned && !options.HasBeenSet("storeEloss") && !options.HasBeenSet("storeELoss"))
+    {options.storeEloss = false;}
+
   if (StoreMinimalData())
     {
       G4cout << "\nGlobal option> storing minimal data\n" << G4endl;
@@ -21,7 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 #include "G4Allocator.hh"
 
-G4Allocator<BDSHitApertureImpact> BDSAllocatorApertureImpacts;
+G4ThreadLocal G4Allocator<BDSHitApertureImpact> BDSAllocatorApertureImpacts;
 
 BDSHitApertureImpact::BDSHitApertureImpact():
   totalEnergy(0),
@@ -22,7 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // geant4 types / globals
 #include "G4Allocator.hh"
 
-G4Allocator<BDSHitEnergyDeposition> BDSAllocatorEnergyDeposition;
+G4ThreadLocal G4Allocator<BDSHitEnergyDeposition> BDSAllocatorEnergyDeposition;
 
 BDSHitEnergyDeposition::BDSHitEnergyDeposition(G4double energyIn,
 					       G4double sHitIn,
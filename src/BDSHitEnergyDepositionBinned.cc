@@ -0,0 +1,55 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSHitEnergyDepositionBinned.hh"
+
+#include "globals.hh" // geant4 types / globals
+#include "G4Allocator.hh"
+
+#include <cstdlib>
+
+G4ThreadLocal G4Allocator<BDSHitEnergyDepositionBinned> BDSAllocatorEnergyDepositionBinned;
+
+BDSHitEnergyDepositionBinned::BDSHitEnergyDepositionBinned(G4int sBinIn,
+							   G4int beamlineIndexIn,
+							   G4int turnIn,
+							   G4int particleClassIn):
+  sBin(sBinIn),
+  beamlineIndex(beamlineIndexIn),
+  turn(turnIn),
+  particleClass(particleClassIn),
+  energyWeighted(0)
+{;}
+
+BDSHitEnergyDepositionBinned::~BDSHitEnergyDepositionBinned()
+{;}
+
+G4int BDSHitEnergyDepositionBinned::ParticleClass(G4int pdgID)
+{
+  G4int absID = std::abs(pdgID);
+  if (pdgID == 22)
+    {return 0;}
+  else if (absID == 11)
+    {return 1;}
+  else if (absID == 2112)
+    {return 2;}
+  else if (absID > 100)
+    {return 3;} // mesons, baryons and ions (10 digit codes)
+  else
+    {return 4;}
+}
@@ -21,7 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // geant4 types / globals
 #include "G4Allocator.hh"
 
-G4Allocator<BDSHitEnergyDepositionExtra> BDSAllocatorEnergyDepositionExtra;
+G4ThreadLocal G4Allocator<BDSHitEnergyDepositionExtra> BDSAllocatorEnergyDepositionExtra;
 
 BDSHitEnergyDepositionExtra::BDSHitEnergyDepositionExtra(G4double preStepKineticEnergyIn,
 							 G4double XIn, 
@@ -22,7 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 #include "G4Allocator.hh"
 
-G4Allocator<BDSHitSamplerCylinder> BDSAllocatorSamplerCylinder;
+G4ThreadLocal G4Allocator<BDSHitSamplerCylinder> BDSAllocatorSamplerCylinder;
 
 BDSHitSamplerCylinder::BDSHitSamplerCylinder(G4int samplerIDIn,
 					     const BDSParticleCoordsCylindrical& coordsIn,
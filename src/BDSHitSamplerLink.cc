@@ -21,7 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Allocator.hh"
 #include "G4Types.hh"
 
-G4Allocator<BDSHitSamplerLink> BDSAllocatorSamplerLink;
+G4ThreadLocal G4Allocator<BDSHitSamplerLink> BDSAllocatorSamplerLink;
 
 BDSHitSamplerLink::BDSHitSamplerLink(G4int samplerIDIn,
 				     const BDSParticleCoordsFull& coordsIn,
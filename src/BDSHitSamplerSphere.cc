@@ -22,7 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 #include "G4Allocator.hh"
 
-G4Allocator<BDSHitSamplerSphere> BDSAllocatorSamplerSphere;
+G4ThreadLocal G4Allocator<BDSHitSamplerSphere> BDSAllocatorSamplerSphere;
 
 BDSHitSamplerSphere::BDSHitSamplerSphere(G4int samplerIDIn,
 					 const BDSParticleCoordsSpherical& coordsIn,
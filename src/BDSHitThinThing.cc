@@ -27,7 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <vector>
 
-G4Allocator<BDSHitThinThing> BDSAllocatorThinThing;
+G4ThreadLocal G4Allocator<BDSHitThinThing> BDSAllocatorThinThing;
 
 BDSHitThinThing::BDSHitThinThing(G4int pdgIDIn,
 				 G4int trackIDIn,
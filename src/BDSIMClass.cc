@@ -22,9 +22,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSGlobalConstants.hh" //  global parameters
 
 #include <algorithm>
+#include <cerrno>
 #include <csignal>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "G4EventManager.hh" // Geant4 includes
 #include "G4GenericBiasingPhysics.hh"
@@ -38,13 +46,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Version.hh"
 #include "G4VModularPhysicsList.hh"
 
+#include "CLHEP/Random/Random.h"
 #include "CLHEP/Units/SystemOfUnits.h"
 
 #include "BDSAcceleratorModel.hh"
+#include "BDSActionInitialization.hh"
 #include "BDSAperturePointsLoader.hh"
 #include "BDSBeamPipeFactory.hh"
 #include "BDSBunch.hh"
 #include "BDSBunchFactory.hh"
+#include "BDSBunchType.hh"
 #include "BDSCavityFactory.hh"
 #include "BDSColours.hh"
 #include "BDSComponentFactoryUser.hh"
@@ -59,22 +70,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSGeometryWriter.hh"
 #include "BDSIonDefinition.hh"
 #include "BDSMaterials.hh"
+#include "BDSMTRunManager.hh"
 #include "BDSOutput.hh"
+#include "BDSOutputEventQueue.hh"
 #include "BDSOutputFactory.hh"
+#include "BDSOutputType.hh"
 #include "BDSParallelWorldUtilities.hh"
 #include "BDSParser.hh" // Parser
 #include "BDSParticleDefinition.hh"
 #include "BDSPhysicsUtilities.hh"
-#include "BDSPrimaryGeneratorAction.hh"
 #include "BDSRandom.hh" // for random number generator from CLHEP
-#include "BDSRunAction.hh"
 #include "BDSRunManager.hh"
 #include "BDSSamplerRegistry.hh"
 #include "BDSSDManager.hh"
-#include "BDSSteppingAction.hh"
-#include "BDSStackingAction.hh"
 #include "BDSTemporaryFiles.hh"
-#include "BDSTrackingAction.hh"
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
 #include "BDSWarning.hh"
@@ -90,6 +99,7 @@ BDSIM::BDSIM():
   bdsOutput(nullptr),
   bdsBunch(nullptr),
   runManager(nullptr),
+  outputQueue(nullptr),
   userComponentFactory(nullptr),
   userPhysicsList(nullptr),
   realWorld(nullptr)
@@ -106,6 +116,7 @@ BDSIM::BDSIM(int argc, char** argv, bool usualPrintOutIn):
   bdsOutput(nullptr),
   bdsBunch(nullptr),
   runManager(nullptr),
+  outputQueue(nullptr),
   userComponentFactory(nullptr),
   userPhysicsList(nullptr),
   realWorld(nullptr)
@@ -170,9 +181,33 @@ int BDSIM::Initialise()
       return 1;
     }
 
+  if (globals->NJobs() > 1)
+    {CheckJobsSupported(globals);}
+
   /// Construct mandatory run manager (the G4 kernel) and
   /// register mandatory initialization classes.
+#ifdef G4MULTITHREADED
+  if (globals->NThreads() > 1)
+    {
+      CheckMultiThreadingSupported(globals);
+      auto mtRunManager = new BDSMTRunManager();
+      mtRunManager->SetNumberOfThreads(globals->NThreads());
+      runManager = mtRunManager;
+      // events are written in order by a separate thread - allow a few events per worker in flight
+      // as each worker takes one event at a time (see BDSMTRunManager)
+      outputQueue = new BDSOutputEventQueue(bdsOutput,
+                                            8*globals->NThreads(),
+                                            globals->NumberOfEventsPerNtuple());
+      mtRunManager->SetOutputQueue(outputQueue);
+      G4cout << "Processing events with " << globals->NThreads() << " threads" << G4endl;
+    }
+  else
+    {runManager = new BDSRunManager();}
+#else
+  if (globals->NThreads() > 1)
+    {BDS::Warning("option, nThreads > 1 but Geant4 is not built with multithreading - running sequentially");}
   runManager = new BDSRunManager();
+#endif
 
   /// Register the geometry and parallel world construction methods with run manager.
   realWorld = new BDSDetectorConstruction(userComponentFactory);
@@ -247,6 +282,7 @@ int BDSIM::Initialise()
   
   // Muon splitting - optional - should be done *after* biasing to work with it - TBC it's before...
   BDS::BuildMuonBiasing(physList);
+  BDS::BuildFastVacuumTransport(physList, beamParticle);
   
   BDS::RegisterSamplerPhysics(parallelWorldPhysics, physList);
   auto biasPhysics = BDS::BuildAndAttachBiasWrapper(parser->GetBiasing());
@@ -287,44 +323,13 @@ int BDSIM::Initialise()
       G4cout << __METHOD_NAME__ << std::setw(12) << "Radial: "  << std::setw(7) << theGeometryTolerance->GetRadialTolerance()  << " mm"   << G4endl;
     }
   
-  /// Set user action classes
-  BDSEventAction* eventAction = new BDSEventAction(bdsOutput);
-  runManager->SetUserAction(eventAction);
-  
-  BDSRunAction* runAction = new BDSRunAction(bdsOutput,
-                                             bdsBunch,
-                                             bdsBunch->ParticleDefinition()->IsAnIon(),
-                                             eventAction,
-                                             globals->StoreTrajectorySamplerID());
-  runManager->SetUserAction(runAction);
-  
-  // Only add stepping action if it is actually used, so do check here (for performance reasons)
-  G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
-  G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
-                                                          globals->VerboseSteppingEventContinueFor());
-  if (globals->VerboseSteppingBDSIM())
-    {
-      runManager->SetUserAction(new BDSSteppingAction(true,
-                                                      verboseSteppingEventStart,
-                                                      verboseSteppingEventStop));
-    }
-  
-  runManager->SetUserAction(new BDSTrackingAction(globals->Batch(),
-                                                  globals->StoreTrajectory(),
-                                                  globals->StoreTrajectoryOptions(),
-                                                  eventAction,
-                                                  verboseSteppingEventStart,
-                                                  verboseSteppingEventStop,
-                                                  globals->VerboseSteppingPrimaryOnly(),
-                                                  globals->VerboseSteppingLevel()));
-
-  runManager->SetUserAction(new BDSStackingAction(globals));
-  
-  auto primaryGeneratorAction = new BDSPrimaryGeneratorAction(bdsBunch, parser->GetBeam(), globals->Batch());
-  // possibly updated after the primary generator as loaded a beam file
-  eventAction->SetPrintModulo(BDSGlobalConstants::Instance()->PrintModuloEvents());
-  runManager->SetUserAction(primaryGeneratorAction);
-  BDSFieldFactory::SetPrimaryGeneratorAction(primaryGeneratorAction);
+  /// Set user action classes - built for each thread in a multi-threaded run
+  runManager->SetUserInitialization(new BDSActionInitialization(bdsOutput,
+                                                                bdsBunch,
+                                                                parser->GetBeam(),
+                                                                designParticle,
+                                                                realWorld,
+                                                                outputQueue));
 
   /// Initialize G4 kernel
   runManager->Initialize();
@@ -346,8 +351,11 @@ int BDSIM::Initialise()
   /// in event, tracking and stepping action. These have to be done here due to the order
   /// of construction in Geant4.
   runManager->SetVerboseLevel(std::min(globals->VerboseRunLevel(), globals->PhysicsVerbosity()));
-  G4EventManager::GetEventManager()->SetVerboseLevel(globals->VerboseEventLevel());
-  G4EventManager::GetEventManager()->GetTrackingManager()->SetVerboseLevel(globals->VerboseTrackingLevel());
+  if (G4EventManager::GetEventManager())
+    {// only exists on the master in a sequential run - worker threads set their own
+      G4EventManager::GetEventManager()->SetVerboseLevel(globals->VerboseEventLevel());
+      G4EventManager::GetEventManager()->GetTrackingManager()->SetVerboseLevel(globals->VerboseTrackingLevel());
+    }
   
   /// Close the geometry in preparation for running - everything is now fixed.
   G4bool bCloseGeometry = G4GeometryManager::GetInstance()->CloseGeometry();
@@ -398,10 +406,11 @@ void BDSIM::BeamOn(int nGenerate)
         }
       else
         {// batch mode
-          if (nGenerate < 0)
-            {runManager->BeamOn(BDSGlobalConstants::Instance()->NGenerate());}
+          G4int nToGenerate = nGenerate < 0 ? BDSGlobalConstants::Instance()->NGenerate() : nGenerate;
+          if (BDSGlobalConstants::Instance()->NJobs() > 1)
+            {RunJobs(nToGenerate);}
           else
-            {runManager->BeamOn(nGenerate);}
+            {runManager->BeamOn(nToGenerate);}
         }
     }
   catch (const BDSException& exception)
@@ -420,6 +429,7 @@ BDSIM::~BDSIM()
 #ifdef BDSDEBUG
   G4cout << __METHOD_NAME__ << "deleting..." << G4endl;
 #endif
+  delete outputQueue; // finishes writing before the output is deleted
   delete bdsOutput;
 
   try
@@ -495,3 +505,189 @@ void BDSIM::GeneratePrimariesOnly(const BDSGlobalConstants* globals)
   
   bdsOutput->CloseFile();
 }
+
+void BDSIM::CheckEventsCanBeSplit(const BDSGlobalConstants* globals,
+                                  const G4String&           baseMessage) const
+{
+  G4String distrName = G4String(parser->GetBeam().distrType);
+  if (BDS::StrContains(distrName, ":"))
+    {distrName = BDS::SplitOnColon(distrName).first;}
+  BDSBunchType distrType = BDS::DetermineBunchType(distrName);
+  // file based distributions read sequentially through one file that can't be shared between threads
+  switch (distrType.underlying())
+    {
+    case BDSBunchType::userfile:
+    case BDSBunchType::ptc:
+    case BDSBunchType::eventgeneratorfile:
+    case BDSBunchType::bdsimsampler:
+      {throw BDSException(__METHOD_NAME__, baseMessage + "the file based distribution \"" + distrName + "\"");}
+    default:
+      {break;}
+    }
+  if (globals->Recreate())
+    {throw BDSException(__METHOD_NAME__, baseMessage + "recreate mode");}
+}
+
+void BDSIM::CheckMultiThreadingSupported(const BDSGlobalConstants* globals) const
+{
+  G4String baseMessage = "option, nThreads > 1 is not supported with ";
+  CheckEventsCanBeSplit(globals, baseMessage);
+  if (!parser->GetScorerMesh().empty())
+    {throw BDSException(__METHOD_NAME__, baseMessage + "scoring meshes");}
+  if (!parser->GetBLMs().empty())
+    {throw BDSException(__METHOD_NAME__, baseMessage + "BLMs");}
+  if (globals->UseImportanceSampling())
+    {throw BDSException(__METHOD_NAME__, baseMessage + "importance sampling");}
+  if (globals->ScreenPrimaries())
+    {throw BDSException(__METHOD_NAME__, baseMessage + "screenPrimaries");}
+}
+
+void BDSIM::CheckJobsSupported(const BDSGlobalConstants* globals) const
+{
+  G4String baseMessage = "option, nJobs > 1 is not supported with ";
+  CheckEventsCanBeSplit(globals, baseMessage);
+  if (globals->NThreads() > 1)
+    {throw BDSException(__METHOD_NAME__, baseMessage + "nThreads > 1 - use one or the other");}
+  if (globals->NumberOfEventsPerNtuple() > 0)
+    {throw BDSException(__METHOD_NAME__, baseMessage + "nEventsPerFile");}
+  if (!globals->Batch())
+    {BDS::Warning("option, nJobs is only used in batch mode - running interactively as usual");}
+}
+
+void BDSIM::RunJobs(G4int nToGenerate)
+{
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  G4int nJobs = std::min(globals->NJobs(), std::max(1, nToGenerate));
+  G4bool writeOutput = globals->OutputFormat() == BDSOutputType::rootevent;
+
+  // the combined file follows the usual naming policy and each job's file is named after it
+  G4String combinedFileName = writeOutput ? bdsOutput->GetNextFileName() : G4String("");
+  G4String::size_type extensionPosition = combinedFileName.rfind('.');
+  G4String jobBaseName = combinedFileName.substr(0, extensionPosition) + "_job";
+  G4String extension = extensionPosition != G4String::npos ? combinedFileName.substr(extensionPosition) : G4String("");
+
+  // each job gets a fixed offset from the seed of this process so the run is reproducible
+  long baseSeed = CLHEP::HepRandom::getTheSeed();
+  G4cout << __METHOD_NAME__ << "splitting " << nToGenerate << " events between " << nJobs
+         << " jobs with seeds " << baseSeed << " to " << baseSeed + nJobs - 1 << G4endl;
+  
+  // build the physics tables and close the geometry once here rather than in every job
+  runManager->BeamOn(0);
+  
+  std::vector<pid_t> jobs;
+  std::vector<G4String> jobFileNames;
+  G4int firstEventThisJob = 0;
+  for (G4int i = 0; i < nJobs; i++)
+    {
+      G4int nThisJob = nToGenerate / nJobs + (i < nToGenerate % nJobs ? 1 : 0);
+      G4String jobBase = jobBaseName + std::to_string(i);
+      G4cout.flush();
+      std::fflush(nullptr); // so buffered output isn't repeated by each job
+      pid_t pid = fork();
+      if (pid < 0)
+        {throw BDSException(__METHOD_NAME__, "unable to start job " + std::to_string(i));}
+      else if (pid == 0)
+        {// the job - the initialised geometry and physics are shared with the parent (copy on write)
+          int status = 0;
+          try
+            {
+              CLHEP::HepRandom::setTheSeed(baseSeed + i);
+              // number the events as in one run so they are unique in the combined output
+              BDSEventAction::SetEventIndexOffset(firstEventThisJob);
+              if (writeOutput)
+                {bdsOutput->SetBaseFileNameOverwrite(jobBase);}
+              runManager->BeamOn(nThisJob);
+            }
+          catch (const BDSException& exception)
+            {
+              G4cerr << exception.what() << G4endl;
+              status = 1;
+            }
+          // the output is already closed - leave without the clean up of the parent's objects
+          G4cout.flush();
+          std::fflush(nullptr);
+          _exit(status);
+        }
+      jobs.push_back(pid);
+      jobFileNames.push_back(jobBase + extension);
+      firstEventThisJob += nThisJob;
+    }
+
+  std::vector<G4String> completedFileNames;
+  for (G4int i = 0; i < (G4int)jobs.size(); i++)
+    {
+      if (WaitForProcess(jobs[i]))
+        {completedFileNames.push_back(jobFileNames[i]);}
+      else
+        {BDS::Warning(__METHOD_NAME__, "job " + std::to_string(i) + " failed - its events are not in the output");}
+    }
+  
+  if (writeOutput)
+    {CombineJobOutput(combinedFileName, completedFileNames);}
+}
+
+void BDSIM::CombineJobOutput(const G4String&              combinedFileName,
+                             const std::vector<G4String>& jobFileNames) const
+{
+  if (jobFileNames.empty())
+    {
+      BDS::Warning(__METHOD_NAME__, "no jobs completed - no output written");
+      return;
+    }
+  else if (jobFileNames.size() == 1)
+    {// nothing to combine
+      if (std::rename(jobFileNames[0].c_str(), combinedFileName.c_str()) != 0)
+        {
+          BDS::Warning(__METHOD_NAME__, "unable to rename \"" + jobFileNames[0] + "\" to \""
+                       + combinedFileName + "\": " + std::strerror(errno) + " - the output of the job is kept");
+        }
+      else
+        {G4cout << __METHOD_NAME__ << "output written to: " << combinedFileName << G4endl;}
+      return;
+    }
+
+  // use the bdsimCombine built with this bdsim, otherwise rely on it being in the PATH
+  G4String execPath = BDS::GetBDSIMExecPath();
+  G4String combineExec = "bdsimCombine";
+  for (const auto& candidate : {execPath + "bdsimCombine", execPath + "analysis/bdsimCombine"})
+    {
+      if (BDS::FileExists(candidate))
+        {combineExec = candidate; break;}
+    }
+  
+  std::vector<std::string> arguments = {combineExec, combinedFileName};
+  arguments.insert(arguments.end(), jobFileNames.begin(), jobFileNames.end());
+  std::vector<char*> argv;
+  for (auto& argument : arguments)
+    {argv.push_back(&argument[0]);}
+  argv.push_back(nullptr);
+
+  G4cout << __METHOD_NAME__ << "combining the output of " << jobFileNames.size() << " jobs" << G4endl;
+  G4cout.flush();
+  std::fflush(nullptr);
+  pid_t pid = fork();
+  if (pid == 0)
+    {
+      execvp(argv[0], argv.data());
+      _exit(127); // only reached if the executable couldn't be run
+    }
+  
+  if (pid > 0 && WaitForProcess(pid))
+    {
+      for (const auto& fileName : jobFileNames)
+        {std::remove(fileName.c_str());}
+      G4cout << __METHOD_NAME__ << "combined output written to: " << combinedFileName << G4endl;
+    }
+  else
+    {BDS::Warning(__METHOD_NAME__, "unable to combine the output with \"" + combineExec + "\" - the output of each job is kept");}
+}
+
+G4bool BDSIM::WaitForProcess(pid_t pid)
+{
+  int status = 0;
+  pid_t result = 0;
+  do
+    {result = waitpid(pid, &status, 0);}
+  while (result < 0 && errno == EINTR); // interrupted by a signal e.g. ctrl-c that the jobs also get
+  return result == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSIntegratorMultipoleThin.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipolePolynomial.hh"
 #include "BDSStep.hh"
 #include "BDSUtilities.hh"
 
@@ -25,7 +26,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 
 #include <cmath>
-#include <list>
 #include <vector>
 #include <include/BDSGlobalConstants.hh>
 
@@ -43,20 +43,19 @@ BDSIntegratorMultipoleThin::BDSIntegratorMultipoleThin(BDSMagnetStrength const*
     {l=1*CLHEP::m;}
   std::vector<G4String> normKeys = strength->NormalComponentKeys();
   std::vector<G4String> skewKeys = strength->SkewComponentKeys();
-  std::vector<G4String>::iterator nkey = normKeys.begin();
-  std::vector<G4String>::iterator skey = skewKeys.begin();
-  for (G4double i = 0; i < normKeys.size(); i++, ++nkey, ++skey)
+  // kicks are sum_n (bnl or bsl) * z^n / n! with z = x + iy - prepare the coefficients once
+  G4bool   finiteStrength = false;
+  G4double nFactorial     = 1;
+  for (G4int i = 0; i < (G4int)normKeys.size(); i++)
     {
-      bnl.push_back((*strength)[*nkey] / (l*std::pow(CLHEP::m,i+1)));
-      bsl.push_back((*strength)[*skey] / (l*std::pow(CLHEP::m,i+1)));
-      nfact.push_back(Factorial(i));
+      G4int n = i + 1;
+      nFactorial *= (G4double)n;
+      G4double bnl = (*strength)[normKeys[i]] / (l*std::pow(CLHEP::m,i+1));
+      G4double bsl = (*strength)[skewKeys[i]] / (l*std::pow(CLHEP::m,i+1));
+      normalKick.SetCoefficient(n, G4complex(bnl / nFactorial, 0));
+      skewKick.SetCoefficient(n, G4complex(bsl / nFactorial, 0));
+      finiteStrength = finiteStrength || BDS::IsFiniteStrength(bnl) || BDS::IsFiniteStrength(bsl);
     }
-
-  G4bool finiteStrength = false;
-  for (const auto& nl : bnl)
-    {finiteStrength = finiteStrength || BDS::IsFiniteStrength(nl);}
-  for (const auto& sl : bsl)
-    {finiteStrength = finiteStrength || BDS::IsFiniteStrength(sl);}
   zeroStrength = !finiteStrength;
 }
 
@@ -142,60 +141,19 @@ void BDSIntegratorMultipoleThin::OneStep(const G4ThreeVector& posIn,
   G4double zp1 = zp;
 
   // kicks come from pg 27 of mad-8 physical methods manual
-  G4complex kick(0,0);
-  G4complex position(x0, y0);
-  G4complex result(0,0);
-  // components of complex vector
-  G4double knReal = 0;
-  G4double knImag = 0;
-  G4double momx;
-  G4double momy;
-
   // normalise to momentum and charge
   G4double ratio = eqOfM->FCof() * std::abs(brho) / momIn;
 
-  G4int n = 1;
-  std::list<double>::const_iterator kn = bnl.begin();
-
   // sum higher order components into one kick
-  for (; kn != bnl.end(); n++, ++kn)
-    {
-      momx = 0; //reset to zero
-      momy = 0;
-      knReal = (*kn) * ratio * std::pow(position,n).real() / nfact[n];
-      knImag = (*kn) * ratio * std::pow(position,n).imag() / nfact[n];
-      if (!std::isnan(knReal))
-    {momx = knReal;}
-      if (!std::isnan(knImag))
-    {momy = knImag;}
-      result = {momx,momy};
-      kick += result;
-    }
+  G4double kickReal, kickImag;
+  normalKick.Evaluate(x0, y0, kickReal, kickImag);
+  G4complex kick(std::isnan(kickReal) ? 0 : kickReal * ratio,
+                 std::isnan(kickImag) ? 0 : kickImag * ratio);
 
-  // reset n for skewed kicks.
-  n=1;
-  G4double ksReal = 0;
-  G4double ksImag = 0;
-  G4complex skewkick(0,0);
-
-  std::list<double>::const_iterator ks = bsl.begin();
-  for (; ks != bsl.end(); n++, ++ks)
-    {
-      if (BDS::IsFinite(*ks))
-        {
-          //reset to zero
-          momx = 0;
-          momy = 0;
-          ksReal = (*ks) * ratio * std::pow(position, n).real() / nfact[n];
-          ksImag = (*ks) * ratio * std::pow(position, n).imag() / nfact[n];
-          if (!std::isnan(ksReal))
-            {momx = ksReal;}
-          if (!std::isnan(ksImag))
-            {momy = ksImag;}
-          result = {momx,momy};
-          skewkick += result;
-        }
-    }
+  G4double skewReal, skewImag;
+  skewKick.Evaluate(x0, y0, skewReal, skewImag);
+  G4complex skewkick(std::isnan(skewReal) ? 0 : skewReal * ratio,
+                     std::isnan(skewImag) ? 0 : skewImag * ratio);
 
   // apply normal kick
   xp1 -= kick.real();
@@ -212,11 +170,3 @@ void BDSIntegratorMultipoleThin::OneStep(const G4ThreeVector& posIn,
   posOut = G4ThreeVector(x1, y1, z1);
   momOut = G4ThreeVector(xp1, yp1, zp1);
 }
-
-G4int BDSIntegratorMultipoleThin::Factorial(G4int n)
-{
-  G4int result = 1;
-  for (G4int i = 1; i <= n; i++)
-    {result *= i;}
-  return result;
-}
@@ -0,0 +1,125 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray3DCoords.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3DCubicTable.hh"
+#include "BDSInterpolatorRoutines.hh"
+
+#include "globals.hh"
+#include "G4Types.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <typeinfo>
+
+BDSInterpolator3DCubicTable::BDSInterpolator3DCubicTable(BDSArray3DCoords* arrayIn):
+  BDSInterpolator3D(arrayIn),
+  nX(arrayIn->NX()),
+  nY(arrayIn->NY()),
+  nZ(arrayIn->NZ()),
+  xMin(arrayIn->XMin()),
+  yMin(arrayIn->YMin()),
+  zMin(arrayIn->ZMin()),
+  xStepInv(1.0 / arrayIn->XStep()),
+  yStepInv(1.0 / arrayIn->YStep()),
+  zStepInv(1.0 / arrayIn->ZStep())
+{
+  BuildCoefficients();
+  G4cout << "Cubic interpolation coefficient table: " << MemoryUsage() / (1024*1024) << " MB" << G4endl;
+}
+
+BDSInterpolator3DCubicTable::~BDSInterpolator3DCubicTable()
+{;}
+
+G4bool BDSInterpolator3DCubicTable::Suitable(const BDSArray3DCoords* arrayIn)
+{
+  // derived arrays (e.g. reflections) change the indexing and extent
+  return arrayIn && typeid(*arrayIn) == typeid(BDSArray3DCoords);
+}
+
+std::size_t BDSInterpolator3DCubicTable::MemoryRequired(const BDSArray3DCoords* arrayIn)
+{
+  std::size_t nCells = (std::size_t)arrayIn->NX() * (std::size_t)arrayIn->NY() * (std::size_t)arrayIn->NZ();
+  return nCells * nCoefficients * sizeof(BDSFieldValue);
+}
+
+void BDSInterpolator3DCubicTable::BuildCoefficients()
+{
+  coefficients.resize((std::size_t)nX*nY*nZ*nCoefficients);
+  BDSFieldValue* cellCoefficients = coefficients.data();
+  for (G4int k = 0; k < nZ; k++)
+    {
+      for (G4int j = 0; j < nY; j++)
+        {
+          for (G4int i = 0; i < nX; i++)
+            {
+              // same points as ExtractSection4x4x4 including any outside the array
+              BDSFieldValue* v = cellCoefficients;
+              for (G4int a = 0; a < 4; a++)
+                {
+                  for (G4int b = 0; b < 4; b++)
+                    {
+                      for (G4int c = 0; c < 4; c++)
+                        {*v++ = array->GetConst(i-1+a, j-1+b, k-1+c);}
+                    }
+                }
+              BDS::CubicCoefficients(cellCoefficients, 3);
+              cellCoefficients += nCoefficients;
+            }
+        }
+    }
+}
+
+BDSFieldValue BDSInterpolator3DCubicTable::GetInterpolatedValueT(G4double x,
+                                                                 G4double y,
+                                                                 G4double z) const
+{
+  G4double xArr = (x - xMin) * xStepInv;
+  G4double yArr = (y - yMin) * yStepInv;
+  G4double zArr = (z - zMin) * zStepInv;
+  G4int x1 = (G4int)std::floor(xArr);
+  G4int y1 = (G4int)std::floor(yArr);
+  G4int z1 = (G4int)std::floor(zArr);
+  if (x1 < 0 || y1 < 0 || z1 < 0 || x1 >= nX || y1 >= nY || z1 >= nZ)
+    {// outside the table - use the array as normal
+      BDSFieldValue localData[4][4][4];
+      G4double xFrac, yFrac, zFrac;
+      array->ExtractSection4x4x4(x, y, z, localData, xFrac, yFrac, zFrac);
+      return BDS::Cubic3D(localData, xFrac, yFrac, zFrac);
+    }
+
+  G4double xp[4], yp[4], zp[4];
+  BDS::CubicPowers(xArr - x1, xp);
+  BDS::CubicPowers(yArr - y1, yp);
+  BDS::CubicPowers(zArr - z1, zp);
+
+  std::size_t cell = ((std::size_t)z1*nY + y1)*nX + x1;
+  const BDSFieldValue* c = &coefficients[cell*nCoefficients];
+  BDS::FieldLanes sum = {};
+  for (G4int p = 0; p < 4; p++)
+    {
+      for (G4int q = 0; q < 4; q++)
+        {
+          G4double w = xp[p] * yp[q];
+          for (G4int r = 0; r < 4; r++)
+            {BDS::AccumulateWeighted(sum, zp[r] * w, *c++);}
+        }
+    }
+  return BDSFieldValue((FIELDTYPET)sum[0], (FIELDTYPET)sum[1], (FIELDTYPET)sum[2]);
+}
@@ -0,0 +1,142 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator4DCubicTable.hh"
+#include "BDSInterpolatorRoutines.hh"
+
+#include "globals.hh"
+#include "G4Types.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <typeinfo>
+
+BDSInterpolator4DCubicTable::BDSInterpolator4DCubicTable(BDSArray4DCoords* arrayIn):
+  BDSInterpolator4D(arrayIn),
+  nX(arrayIn->NX()),
+  nY(arrayIn->NY()),
+  nZ(arrayIn->NZ()),
+  nT(arrayIn->NT()),
+  xMin(arrayIn->XMin()),
+  yMin(arrayIn->YMin()),
+  zMin(arrayIn->ZMin()),
+  tMin(arrayIn->TMin()),
+  xStepInv(1.0 / arrayIn->XStep()),
+  yStepInv(1.0 / arrayIn->YStep()),
+  zStepInv(1.0 / arrayIn->ZStep()),
+  tStepInv(1.0 / arrayIn->TStep())
+{
+  BuildCoefficients();
+  G4cout << "Cubic interpolation coefficient table: " << MemoryUsage() / (1024*1024) << " MB" << G4endl;
+}
+
+BDSInterpolator4DCubicTable::~BDSInterpolator4DCubicTable()
+{;}
+
+G4bool BDSInterpolator4DCubicTable::Suitable(const BDSArray4DCoords* arrayIn)
+{
+  // derived arrays (e.g. reflections) change the indexing and extent
+  return arrayIn && typeid(*arrayIn) == typeid(BDSArray4DCoords);
+}
+
+std::size_t BDSInterpolator4DCubicTable::MemoryRequired(const BDSArray4DCoords* arrayIn)
+{
+  std::size_t nCells = (std::size_t)arrayIn->NX() * (std::size_t)arrayIn->NY() * (std::size_t)arrayIn->NZ() * (std::size_t)arrayIn->NT();
+  return nCells * nCoefficients * sizeof(BDSFieldValue);
+}
+
+void BDSInterpolator4DCubicTable::BuildCoefficients()
+{
+  coefficients.resize((std::size_t)nX*nY*nZ*nT*nCoefficients);
+  BDSFieldValue* cellCoefficients = coefficients.data();
+  for (G4int l = 0; l < nT; l++)
+    {
+      for (G4int k = 0; k < nZ; k++)
+        {
+          for (G4int j = 0; j < nY; j++)
+            {
+              for (G4int i = 0; i < nX; i++)
+                {
+                  // same points as ExtractSection4x4x4x4 including any outside the array
+                  BDSFieldValue* v = cellCoefficients;
+                  for (G4int a = 0; a < 4; a++)
+                    {
+                      for (G4int b = 0; b < 4; b++)
+                        {
+                          for (G4int c = 0; c < 4; c++)
+                            {
+                              for (G4int d = 0; d < 4; d++)
+                                {*v++ = array->GetConst(i-1+a, j-1+b, k-1+c, l-1+d);}
+                            }
+                        }
+                    }
+                  BDS::CubicCoefficients(cellCoefficients, 4);
+                  cellCoefficients += nCoefficients;
+                }
+            }
+        }
+    }
+}
+
+BDSFieldValue BDSInterpolator4DCubicTable::GetInterpolatedValueT(G4double x,
+                                                                 G4double y,
+                                                                 G4double z,
+                                                                 G4double t) const
+{
+  G4double xArr = (x - xMin) * xStepInv;
+  G4double yArr = (y - yMin) * yStepInv;
+  G4double zArr = (z - zMin) * zStepInv;
+  G4double tArr = (t - tMin) * tStepInv;
+  G4int x1 = (G4int)std::floor(xArr);
+  G4int y1 = (G4int)std::floor(yArr);
+  G4int z1 = (G4int)std::floor(zArr);
+  G4int t1 = (G4int)std::floor(tArr);
+  if (x1 < 0 || y1 < 0 || z1 < 0 || t1 < 0 || x1 >= nX || y1 >= nY || z1 >= nZ || t1 >= nT)
+    {// outside the table - use the array as normal
+      BDSFieldValue localData[4][4][4][4];
+      G4double xFrac, yFrac, zFrac, tFrac;
+      array->ExtractSection4x4x4x4(x, y, z, t, localData, xFrac, yFrac, zFrac, tFrac);
+      return BDS::Cubic4D(localData, xFrac, yFrac, zFrac, tFrac);
+    }
+
+  G4double xp[4], yp[4], zp[4], tp[4];
+  BDS::CubicPowers(xArr - x1, xp);
+  BDS::CubicPowers(yArr - y1, yp);
+  BDS::CubicPowers(zArr - z1, zp);
+  BDS::CubicPowers(tArr - t1, tp);
+
+  std::size_t cell = (((std::size_t)t1*nZ + z1)*nY + y1)*nX + x1;
+  const BDSFieldValue* c = &coefficients[cell*nCoefficients];
+  BDS::FieldLanes sum = {};
+  for (G4int p = 0; p < 4; p++)
+    {
+      for (G4int q = 0; q < 4; q++)
+        {
+          G4double wpq = xp[p] * yp[q];
+          for (G4int r = 0; r < 4; r++)
+            {
+              G4double w = wpq * zp[r];
+              for (G4int s = 0; s < 4; s++)
+                {BDS::AccumulateWeighted(sum, tp[s] * w, *c++);}
+            }
+        }
+    }
+  return BDSFieldValue((FIELDTYPET)sum[0], (FIELDTYPET)sum[1], (FIELDTYPET)sum[2]);
+}
@@ -0,0 +1,141 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSArrayStorageType.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator4DDirect.hh"
+#include "BDSInterpolatorRoutines.hh"
+
+#include "G4Types.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <typeinfo>
+
+template<G4int N>
+BDSInterpolator4DDirect<N>::BDSInterpolator4DDirect(BDSArray4DCoords* arrayIn):
+  BDSInterpolator4D(arrayIn),
+  data(arrayIn->Data()),
+  nX(arrayIn->NX()),
+  nY(arrayIn->NY()),
+  nZ(arrayIn->NZ()),
+  nT(arrayIn->NT()),
+  xMin(arrayIn->XMin()),
+  yMin(arrayIn->YMin()),
+  zMin(arrayIn->ZMin()),
+  tMin(arrayIn->TMin()),
+  xStepInv(1.0 / arrayIn->XStep()),
+  yStepInv(1.0 / arrayIn->YStep()),
+  zStepInv(1.0 / arrayIn->ZStep()),
+  tStepInv(1.0 / arrayIn->TStep())
+{;}
+
+template<G4int N>
+G4bool BDSInterpolator4DDirect<N>::Suitable(const BDSArray4DCoords* arrayIn)
+{
+  if (!arrayIn)
+    {return false;}
+  // derived arrays (e.g. reflections) change the indexing so must use their interface
+  G4bool plainArray = typeid(*arrayIn) == typeid(BDSArray4DCoords);
+  return plainArray && arrayIn->StorageType() == BDSArrayStorageType::standard && arrayIn->Data();
+}
+
+template<G4int N>
+BDSFieldValue BDSInterpolator4DDirect<N>::GetInterpolatedValueT(G4double x,
+                                                               G4double y,
+                                                               G4double z,
+                                                               G4double t) const
+{
+  // first index of the stencil is one before the point for cubic
+  const G4int before = N/2 - 1;
+  G4double xArr = (x - xMin) * xStepInv;
+  G4double yArr = (y - yMin) * yStepInv;
+  G4double zArr = (z - zMin) * zStepInv;
+  G4double tArr = (t - tMin) * tStepInv;
+  G4int x1 = (G4int)std::floor(xArr);
+  G4int y1 = (G4int)std::floor(yArr);
+  G4int z1 = (G4int)std::floor(zArr);
+  G4int t1 = (G4int)std::floor(tArr);
+  G4int x0 = x1 - before;
+  G4int y0 = y1 - before;
+  G4int z0 = z1 - before;
+  G4int t0 = t1 - before;
+  if (x0 < 0 || y0 < 0 || z0 < 0 || t0 < 0 ||
+      x0 + N > nX || y0 + N > nY || z0 + N > nZ || t0 + N > nT)
+    {return GetInterpolatedValueEdge(x, y, z, t);}
+
+  G4double wx[N], wy[N], wz[N], wt[N];
+  BDS::InterpolationWeights<N>(xArr - x1, wx);
+  BDS::InterpolationWeights<N>(yArr - y1, wy);
+  BDS::InterpolationWeights<N>(zArr - z1, wz);
+  BDS::InterpolationWeights<N>(tArr - t1, wt);
+
+  std::size_t ox[N], oy[N], oz[N], ot[N];
+  for (G4int i = 0; i < N; i++)
+    {
+      ox[i] = array->OffsetX(x0 + i);
+      oy[i] = array->OffsetY(y0 + i);
+      oz[i] = array->OffsetZ(z0 + i);
+      ot[i] = array->OffsetT(t0 + i);
+    }
+
+  BDS::FieldLanes sum = {};
+  for (G4int l = 0; l < N; l++)
+    {
+      for (G4int k = 0; k < N; k++)
+        {
+          G4double wkl = wz[k] * wt[l];
+          for (G4int j = 0; j < N; j++)
+            {
+              G4double wjkl = wy[j] * wkl;
+              const BDSFieldValue* row = data + oy[j] + oz[k] + ot[l];
+              for (G4int i = 0; i < N; i++)
+                {BDS::AccumulateWeighted(sum, wx[i] * wjkl, row[ox[i]]);}
+            }
+        }
+    }
+  return BDSFieldValue((FIELDTYPET)sum[0], (FIELDTYPET)sum[1], (FIELDTYPET)sum[2]);
+}
+
+template<>
+BDSFieldValue BDSInterpolator4DDirect<2>::GetInterpolatedValueEdge(G4double x,
+                                                                  G4double y,
+                                                                  G4double z,
+                                                                  G4double t) const
+{
+  BDSFieldValue localData[2][2][2][2];
+  G4double xFrac, yFrac, zFrac, tFrac;
+  array->ExtractSection2x2x2x2(x, y, z, t, localData, xFrac, yFrac, zFrac, tFrac);
+  return BDS::Linear4D(localData, xFrac, yFrac, zFrac, tFrac);
+}
+
+template<>
+BDSFieldValue BDSInterpolator4DDirect<4>::GetInterpolatedValueEdge(G4double x,
+                                                                  G4double y,
+                                                                  G4double z,
+                                                                  G4double t) const
+{
+  BDSFieldValue localData[4][4][4][4];
+  G4double xFrac, yFrac, zFrac, tFrac;
+  array->ExtractSection4x4x4x4(x, y, z, t, localData, xFrac, yFrac, zFrac, tFrac);
+  return BDS::Cubic4D(localData, xFrac, yFrac, zFrac, tFrac);
+}
+
+template class BDSInterpolator4DDirect<2>;
+template class BDSInterpolator4DDirect<4>;
@@ -51,7 +51,10 @@ std::map<BDSInterpolatorType, std::string>* BDSInterpolatorType::dictionary =
       {BDSInterpolatorType::cubic1d,    "cubic1d"},
       {BDSInterpolatorType::cubic2d,    "cubic2d"},
       {BDSInterpolatorType::cubic3d,    "cubic3d"},
-      {BDSInterpolatorType::cubic4d,    "cubic4d"}
+      {BDSInterpolatorType::cubic4d,    "cubic4d"},
+      {BDSInterpolatorType::cubictableauto, "cubictableauto"},
+      {BDSInterpolatorType::cubictable3d,   "cubictable3d"},
+      {BDSInterpolatorType::cubictable4d,   "cubictable4d"}
     });
 
 BDSInterpolatorType BDS::DetermineInterpolatorType(G4String interpolatorType)
@@ -77,6 +80,9 @@ BDSInterpolatorType BDS::DetermineInterpolatorType(G4String interpolatorType)
   types["cubic2d"]     = BDSInterpolatorType::cubic2d;
   types["cubic3d"]     = BDSInterpolatorType::cubic3d;
   types["cubic4d"]     = BDSInterpolatorType::cubic4d;
+  types["cubictable"]   = BDSInterpolatorType::cubictableauto;
+  types["cubictable3d"] = BDSInterpolatorType::cubictable3d;
+  types["cubictable4d"] = BDSInterpolatorType::cubictable4d;
 
   interpolatorType = BDS::LowerCase(interpolatorType);
 
@@ -115,11 +121,13 @@ G4int BDS::NDimensionsOfInterpolatorType(const BDSInterpolatorType& it)
       case BDSInterpolatorType::linear3d:
       case BDSInterpolatorType::linearmag3d:
       case BDSInterpolatorType::cubic3d:
+      case BDSInterpolatorType::cubictable3d:
 	{result = 3; break;}
       case BDSInterpolatorType::nearest4d:
       case BDSInterpolatorType::linear4d:	
       case BDSInterpolatorType::linearmag4d:
       case BDSInterpolatorType::cubic4d:
+      case BDSInterpolatorType::cubictable4d:
         {result = 4; break;}
       default:
         {result = 0; break;}
@@ -136,6 +144,7 @@ G4bool BDS::InterpolatorTypeIsAuto(BDSInterpolatorType typeIn)
     case BDSInterpolatorType::linearauto:
     case BDSInterpolatorType::linearmagauto:
     case BDSInterpolatorType::cubicauto:
+    case BDSInterpolatorType::cubictableauto:
       {result = true; break;}
     default:
       {break;}
@@ -163,6 +172,11 @@ BDSInterpolatorType BDS::InterpolatorTypeSpecificFromAuto(G4int               nD
     {std::make_pair(2, BDSInterpolatorType::cubicauto),      BDSInterpolatorType::cubic2d},
     {std::make_pair(3, BDSInterpolatorType::cubicauto),      BDSInterpolatorType::cubic3d},
     {std::make_pair(4, BDSInterpolatorType::cubicauto),      BDSInterpolatorType::cubic4d},
+    // coefficient tables are only provided for 3D and 4D where they have a benefit
+    {std::make_pair(1, BDSInterpolatorType::cubictableauto), BDSInterpolatorType::cubic1d},
+    {std::make_pair(2, BDSInterpolatorType::cubictableauto), BDSInterpolatorType::cubic2d},
+    {std::make_pair(3, BDSInterpolatorType::cubictableauto), BDSInterpolatorType::cubictable3d},
+    {std::make_pair(4, BDSInterpolatorType::cubictableauto), BDSInterpolatorType::cubictable4d},
   };
   auto key = std::make_pair(nDimension, autoType);
   auto search = mapping.find(key);
@@ -36,8 +36,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4PropagatorInField.hh"
 #include "G4Run.hh"
 #include "G4SDManager.hh"
-#include "G4THitsMap.hh"
 #include "G4TransportationManager.hh"
+#include "G4VHitsCollection.hh"
 #include "G4VUserEventInformation.hh"
 
 #include <map>
@@ -140,11 +140,13 @@ void BDSLinkEventAction::EndOfEventAction(const G4Event* evt)
                     nullptr,
                     nullptr,
                     nullptr,
+                    nullptr,
+                    nullptr,
                     std::vector<const BDSTrajectoryPointHit*>(),
                     std::vector<const BDSTrajectoryPointHit*>(),
                     nullptr,
                     nullptr,
                     nullptr,
-                    std::map<G4String, G4THitsMap<G4double>*>(),
+                    std::map<G4String, G4VHitsCollection*>(),
                     BDSGlobalConstants::Instance()->TurnsTaken());
 }
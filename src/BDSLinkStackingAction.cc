@@ -29,7 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <set>
 
-G4double BDSLinkStackingAction::kineticEnergyKilled = 0;
+G4ThreadLocal G4double BDSLinkStackingAction::kineticEnergyKilled = 0;
 
 BDSLinkStackingAction::BDSLinkStackingAction(const BDSGlobalConstants* globals,
                                              const std::set<G4int>&    pdgIDsToAllowIn,
@@ -0,0 +1,75 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSMTRunManager.hh"
+
+#ifdef G4MULTITHREADED
+#include "BDSDetectorConstruction.hh"
+#include "BDSExceptionHandler.hh"
+#include "BDSFieldQuery.hh"
+#include "BDSOutputEventQueue.hh"
+#include "BDSWorkerThreadInitialization.hh"
+
+BDSMTRunManager::BDSMTRunManager():
+  outputQueue(nullptr)
+{
+  // Construct an exception handler to catch Geant4 aborts on the master.
+  // This has to be done after G4MTRunManager::G4MTRunManager() which constructs
+  // its own default exception handler which overwrites the one in G4StateManager
+  exceptionHandler = new BDSExceptionHandler();
+
+  // keep the events being processed at once close together in index - see class description
+  SetEventModulo(1);
+}
+
+BDSMTRunManager::~BDSMTRunManager()
+{
+  delete exceptionHandler;
+}
+
+void BDSMTRunManager::Initialize()
+{
+  G4MTRunManager::Initialize();
+
+  if (const auto detectorConstruction = dynamic_cast<BDSDetectorConstruction*>(userDetector))
+    {
+      /// Check for any 3D field queries of the model and carry them out
+      const auto& fieldQueries = detectorConstruction->FieldQueries();
+      if (!fieldQueries.empty())
+        {
+          BDSFieldQuery querier;
+          querier.QueryFields(fieldQueries);
+        }
+    }
+}
+
+void BDSMTRunManager::SetOutputQueue(BDSOutputEventQueue* outputQueueIn)
+{
+  outputQueue = outputQueueIn;
+  SetUserInitialization(new BDSWorkerThreadInitialization(outputQueue));
+}
+
+void BDSMTRunManager::AbortRun(G4bool softAbort)
+{
+  G4cout << "Terminate run - trying to write and close output file" << G4endl;
+  if (outputQueue)
+    {outputQueue->Abandon();}
+  G4MTRunManager::AbortRun(softAbort);
+}
+
+#endif
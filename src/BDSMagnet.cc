@@ -45,6 +45,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
+
 class G4Userlimits;
 
 BDSMagnet::BDSMagnet(BDSMagnetType       typeIn,
@@ -237,6 +239,9 @@ void BDSMagnet::BuildOuterField()
       
       BDSMagnetStrength* scalingStrength = vacuumFieldInfo ? vacuumFieldInfo->MagnetStrength() : nullptr;
       G4LogicalVolume* vol = outer->GetContainerLogicalVolume();
+      // so an interpolated yoke field can cover the whole magnet
+      outerFieldInfo->SetYokeExtent(std::max(outer->GetExtent().MaximumAbsTransverse(),
+                                             GetExtent().MaximumAbsTransverse()));
       BDSFieldBuilder::Instance()->RegisterFieldForConstruction(outerFieldInfo,
                                                                 vol,
                                                                 true,
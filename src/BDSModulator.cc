@@ -16,11 +16,65 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSDebug.hh"
+#include "BDSException.hh"
 #include "BDSModulator.hh"
 
-G4int BDSModulator::eventIndex = 0;
+#include "G4String.hh"
+
+#include <cmath>
+#include <string>
+
+G4ThreadLocal G4int BDSModulator::eventIndex = 0;
 
 void BDSModulator::SetEventIndex(G4int eventIndexIn)
 {
   eventIndex = eventIndexIn;
 }
+
+G4double BDSModulator::CachedFactor(const G4ThreeVector& xyz,
+                                    G4double T) const
+{
+  if (!OnlyVariesWithTime())
+    {return Factor(xyz, T);}
+  if (cacheValid && T == cachedT)
+    {return cachedFactor;}
+  cachedFactor = table.empty() ? Factor(xyz, T) : InterpolateTable(T);
+  cachedT      = T;
+  cacheValid   = true;
+  return cachedFactor;
+}
+
+void BDSModulator::BuildPeriodicTable(G4int nPoints)
+{
+  if (nPoints < 4)
+    {throw BDSException(__METHOD_NAME__, "number of points (" + std::to_string(nPoints) + ") must be >= 4");}
+  G4double period = Period();
+  if (!OnlyVariesWithTime() || period <= 0 || !std::isfinite(period))
+    {return;}
+  tablePeriod = period;
+  tableStep   = period / (G4double)nPoints;
+  table.resize((std::size_t)nPoints);
+  for (G4int i = 0; i < nPoints; i++)
+    {table[(std::size_t)i] = Factor(G4ThreeVector(), (G4double)i * tableStep);}
+  cacheValid = false;
+}
+
+G4double BDSModulator::InterpolateTable(G4double T) const
+{
+  G4double tau = std::fmod(T, tablePeriod);
+  if (tau < 0)
+    {tau += tablePeriod;}
+  G4double x = tau / tableStep;
+  G4int n = (G4int)table.size();
+  G4int i = (G4int)x;
+  G4double f = x - (G4double)i;
+  i = i % n; // tau may round to tablePeriod
+  // table is periodic so wrap the four points around i
+  G4double ym1 = table[(std::size_t)((i - 1 + n) % n)];
+  G4double y0  = table[(std::size_t)i];
+  G4double y1  = table[(std::size_t)((i + 1) % n)];
+  G4double y2  = table[(std::size_t)((i + 2) % n)];
+  return ((-f*(f-1)*(f-2))*ym1 + 3*((f+1)*(f-1)*(f-2))*y0
+          - 3*((f+1)*f*(f-2))*y1 + ((f+1)*f*(f-1))*y2) / 6.0;
+}
@@ -58,3 +58,8 @@ G4double BDSModulatorSinT::RecommendedMaxStepLength() const
       return wavelength / 20;
     }
 }
+
+G4double BDSModulatorSinT::Period() const
+{
+  return angularFrequency == 0 ? 0 : CLHEP::twopi / angularFrequency;
+}
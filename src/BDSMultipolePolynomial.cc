@@ -0,0 +1,115 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSMultipolePolynomial.hh"
+
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+BDSMultipolePolynomial::BDSMultipolePolynomial()
+{;}
+
+BDSMultipolePolynomial::BDSMultipolePolynomial(const std::vector<G4complex>& coefficients)
+{
+  for (const auto& c : coefficients)
+    {
+      real.push_back(c.real());
+      imag.push_back(c.imag());
+    }
+  Trim();
+}
+
+void BDSMultipolePolynomial::SetCoefficient(G4int n, G4complex value)
+{
+  if (n < 1)
+    {return;}
+  if ((G4int)real.size() < n)
+    {
+      real.resize(n, 0);
+      imag.resize(n, 0);
+    }
+  real[n-1] = value.real();
+  imag[n-1] = value.imag();
+  Trim();
+}
+
+void BDSMultipolePolynomial::RotateField(G4double angle)
+{
+  for (G4int i = 0; i < (G4int)real.size(); i++)
+    {
+      G4complex c(real[i], imag[i]);
+      c *= std::polar(1.0, (G4double)(i + 2) * angle); // power n = i+1
+      real[i] = c.real();
+      imag[i] = c.imag();
+    }
+}
+
+void BDSMultipolePolynomial::Evaluate(std::size_t     nPoints,
+                                      const G4double* x,
+                                      const G4double* y,
+                                      G4double*       resultReal,
+                                      G4double*       resultImag) const
+{
+  const G4int nCoefficients = (G4int)real.size();
+  // Work in blocks of points that fit in the L1 cache. Within a block, the loop over the
+  // points is innermost for each coefficient so the compiler can vectorise it.
+  const std::size_t blockSize = 64;
+  G4double pr[blockSize];
+  G4double pi[blockSize];
+  for (std::size_t start = 0; start < nPoints; start += blockSize)
+    {
+      const std::size_t nBlock = std::min(blockSize, nPoints - start);
+      const G4double* xb = x + start;
+      const G4double* yb = y + start;
+      for (std::size_t j = 0; j < nBlock; j++)
+        {
+          pr[j] = 0;
+          pi[j] = 0;
+        }
+      for (G4int n = nCoefficients - 1; n >= 0; n--)
+        {
+          const G4double ar = real[n];
+          const G4double ai = imag[n];
+          for (std::size_t j = 0; j < nBlock; j++)
+            {
+              G4double t = pr[j]*xb[j] - pi[j]*yb[j] + ar;
+              pi[j] = pr[j]*yb[j] + pi[j]*xb[j] + ai;
+              pr[j] = t;
+            }
+        }
+      // lowest power is z^1
+      for (std::size_t j = 0; j < nBlock; j++)
+        {
+          resultReal[start + j] = pr[j]*xb[j] - pi[j]*yb[j];
+          resultImag[start + j] = pr[j]*yb[j] + pi[j]*xb[j];
+        }
+    }
+}
+
+void BDSMultipolePolynomial::Trim()
+{
+  while (!real.empty() && real.back() == 0 && imag.back() == 0)
+    {
+      real.pop_back();
+      imag.pop_back();
+    }
+}
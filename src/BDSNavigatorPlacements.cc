@@ -20,19 +20,29 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSNavigatorPlacements.hh"
 
 #include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
 #include "G4Navigator.hh"
 #include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
 
 #include <utility>
 
-G4Navigator*       BDSNavigatorPlacements::navigator         = new G4Navigator();
-G4int              BDSNavigatorPlacements::numberOfInstances = 0;
-G4VPhysicalVolume* BDSNavigatorPlacements::worldPV           = nullptr;
+G4ThreadLocal G4Navigator*       BDSNavigatorPlacements::navigator         = nullptr;
+G4ThreadLocal G4int              BDSNavigatorPlacements::numberOfInstances = 0;
+G4VPhysicalVolume*               BDSNavigatorPlacements::worldPV           = nullptr;
+G4ThreadLocal G4bool             BDSNavigatorPlacements::cacheValid        = false;
+G4ThreadLocal G4VSolid*          BDSNavigatorPlacements::cachedSolid       = nullptr;
+G4ThreadLocal G4ThreeVector      BDSNavigatorPlacements::cachedExtentMin   = G4ThreeVector();
+G4ThreadLocal G4ThreeVector      BDSNavigatorPlacements::cachedExtentMax   = G4ThreeVector();
+G4ThreadLocal G4AffineTransform  BDSNavigatorPlacements::cachedGlobalToLocal = G4AffineTransform();
+G4ThreadLocal G4AffineTransform  BDSNavigatorPlacements::cachedLocalToGlobal = G4AffineTransform();
 
 BDSNavigatorPlacements::BDSNavigatorPlacements():
   globalToLocal(G4AffineTransform()),
   localToGlobal(G4AffineTransform())
 {
+  InitialiseNavigator();
   numberOfInstances++;
 }
 
@@ -46,14 +56,42 @@ BDSNavigatorPlacements::~BDSNavigatorPlacements()
   numberOfInstances--;
 }
 
+void BDSNavigatorPlacements::InitialiseNavigator()
+{
+  if (!navigator)
+    {
+      navigator = new G4Navigator();
+      if (worldPV)
+        {navigator->SetWorldVolume(worldPV);}
+    }
+}
+
+void BDSNavigatorPlacements::AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
+{
+  worldPV = worldPVIn;
+  InitialiseNavigator();
+  navigator->SetWorldVolume(worldPVIn);
+}
+
 void BDSNavigatorPlacements::ResetNavigatorStates()
 {
+  InitialiseNavigator();
   navigator->ResetStackAndState();
+  cacheValid  = false;
+  cachedSolid = nullptr;
 }
 
 G4ThreeVector BDSNavigatorPlacements::ConvertToLocal(const G4ThreeVector& globalPosition,
 						     G4bool& foundAPlacementVolume) const
 {
+  G4ThreeVector localPosition;
+  if (InsideCachedVolume(globalPosition, localPosition))
+    {
+      globalToLocal = cachedGlobalToLocal;
+      localToGlobal = cachedLocalToGlobal;
+      foundAPlacementVolume = true;
+      return localPosition;
+    }
   foundAPlacementVolume = InitialiseTransform(globalPosition);
   if (!foundAPlacementVolume)
     {return G4ThreeVector();}
@@ -84,5 +122,36 @@ G4bool BDSNavigatorPlacements::InitialiseTransform(const G4ThreeVector& globalPo
     {return false;}
   globalToLocal = navigator->GetGlobalToLocalTransform();
   localToGlobal = navigator->GetLocalToGlobalTransform();
+  CacheVolume(foundPVVolume);
   return true; // found a placement volume ok
 }
+
+void BDSNavigatorPlacements::CacheVolume(G4VPhysicalVolume* volume)
+{
+  cacheValid = false;
+  if (!volume)
+    {return;}
+  // with daughters, the navigator may find a different volume at a point inside this one
+  G4LogicalVolume* lv = volume->GetLogicalVolume();
+  if (lv->GetNoDaughters() > 0)
+    {return;}
+  cachedSolid = lv->GetSolid();
+  cachedSolid->BoundingLimits(cachedExtentMin, cachedExtentMax);
+  cachedGlobalToLocal = navigator->GetGlobalToLocalTransform();
+  cachedLocalToGlobal = navigator->GetLocalToGlobalTransform();
+  cacheValid = true;
+}
+
+G4bool BDSNavigatorPlacements::InsideCachedVolume(const G4ThreeVector& globalPosition,
+                                                  G4ThreeVector&       localPosition)
+{
+  if (!cacheValid)
+    {return false;}
+  localPosition = cachedGlobalToLocal.TransformPoint(globalPosition);
+  if (localPosition.x() < cachedExtentMin.x() || localPosition.x() > cachedExtentMax.x() ||
+      localPosition.y() < cachedExtentMin.y() || localPosition.y() > cachedExtentMax.y() ||
+      localPosition.z() < cachedExtentMin.z() || localPosition.z() > cachedExtentMax.z())
+    {return false;}
+  // points on the surface are left to the navigator to decide
+  return cachedSolid->Inside(localPosition) == kInside;
+}
@@ -0,0 +1,211 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBatchTransport.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSOneTurnMapGenerator.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSPTCOneTurnMap.hh"
+
+#include "globals.hh" // geant4 types / globals
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  const G4int nVar = BDSPTCOneTurnMap::nVariables;
+
+  /// Element of the Halton low discrepancy sequence. Used instead of random numbers
+  /// so the probes are spread evenly and the random number generator isn't touched.
+  G4double Halton(G4int index, G4int base)
+  {
+    G4double result = 0;
+    G4double f = 1;
+    while (index > 0)
+      {
+	f /= base;
+	result += f * (index % base);
+	index /= base;
+      }
+    return result;
+  }
+
+  /// Solve the square system a x = b in place by Gaussian elimination with partial pivoting.
+  /// b holds several right hand sides (one per column) and is replaced by the solution.
+  void Solve(std::vector<std::vector<G4double>>& a,
+	     std::vector<std::vector<G4double>>& b)
+  {
+    std::size_t n = a.size();
+    for (std::size_t col = 0; col < n; col++)
+      {
+	std::size_t pivot = col;
+	for (std::size_t row = col + 1; row < n; row++)
+	  {
+	    if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+	      {pivot = row;}
+	  }
+	if (a[pivot][col] == 0)
+	  {throw BDSException(__METHOD_NAME__, "one turn map fit is singular.");}
+	std::swap(a[col], a[pivot]);
+	std::swap(b[col], b[pivot]);
+	for (std::size_t row = col + 1; row < n; row++)
+	  {
+	    G4double factor = a[row][col] / a[col][col];
+	    for (std::size_t k = col; k < n; k++)
+	      {a[row][k] -= factor * a[col][k];}
+	    for (std::size_t k = 0; k < b[row].size(); k++)
+	      {b[row][k] -= factor * b[col][k];}
+	  }
+      }
+    for (std::size_t col = n; col-- > 0;)
+      {
+	for (std::size_t k = 0; k < b[col].size(); k++)
+	  {
+	    G4double sum = b[col][k];
+	    for (std::size_t j = col + 1; j < n; j++)
+	      {sum -= a[col][j] * b[j][k];}
+	    b[col][k] = sum / a[col][col];
+	  }
+      }
+  }
+}
+
+BDSPTCOneTurnMap* BDS::GenerateOneTurnMap(const BDSBeamline*           beamline,
+					  const BDSParticleDefinition* designParticle,
+					  G4int                        order,
+					  const std::array<G4double, BDSPTCOneTurnMap::nVariables>& halfWidth)
+{
+  if (order < 1)
+    {throw BDSException(__METHOD_NAME__, "oneTurnMapFromModelOrder must be at least 1.");}
+  for (G4int v = 0; v < nVar; v++)
+    {
+      if (!(halfWidth[v] > 0) || halfWidth[v] >= 1)
+	{
+	  throw BDSException(__METHOD_NAME__, "oneTurnMapFromModelMaxOffset, oneTurnMapFromModelMaxAngle and "
+			     "oneTurnMapFromModelMaxDeltaP must be greater than 0 and less than 1.");
+	}
+    }
+
+  BDSBatchTransport transport(beamline, designParticle, 0);
+  if (!transport.FirstOpaqueElementName().empty())
+    {
+      throw BDSException(__METHOD_NAME__, "element \"" + transport.FirstOpaqueElementName()
+			 + "\" can't be included in a one turn map generated from the model.");
+    }
+
+  // all monomials of x, px, y, py, deltaP up to the order
+  std::vector<std::array<G4int, nVar>> powers;
+  for (G4int total = 0; total <= order; total++)
+    {
+      for (G4int a = total; a >= 0; a--)
+	{
+	  for (G4int b = total - a; b >= 0; b--)
+	    {
+	      for (G4int c = total - a - b; c >= 0; c--)
+		{
+		  for (G4int d = total - a - b - c; d >= 0; d--)
+		    {powers.push_back({a, b, c, d, total - a - b - c - d});}
+		}
+	    }
+	}
+    }
+  std::size_t nMonomials = powers.size();
+
+  // the probes fill the box of half widths in PTC units (m, rad, m, rad, fractional)
+  // that should cover the region where the map is applied to primaries
+  const std::array<G4int, nVar> bases = {2, 3, 5, 7, 11};
+  std::size_t nProbes = 10 * nMonomials;
+
+  BDSBatchTransport::Batch batch;
+  batch.Resize(nProbes);
+  std::vector<std::array<G4double, nVar>> probes(nProbes);
+  for (std::size_t i = 0; i < nProbes; i++)
+    {
+      for (G4int v = 0; v < nVar; v++)
+	{probes[i][v] = 2*Halton((G4int)i + 1, bases[v]) - 1;} // -1 to 1
+      G4double onePlusDeltaP = 1 + probes[i][4] * halfWidth[4];
+      batch.x[i]      = probes[i][0] * halfWidth[0] * CLHEP::m;
+      batch.xp[i]     = probes[i][1] * halfWidth[1] / onePlusDeltaP;
+      batch.y[i]      = probes[i][2] * halfWidth[2] * CLHEP::m;
+      batch.yp[i]     = probes[i][3] * halfWidth[3] / onePlusDeltaP;
+      batch.qOverP[i] = 1.0 / onePlusDeltaP;
+    }
+  transport.Transport(batch);
+
+  // least squares fit in the scaled variables to keep the normal equations well conditioned
+  std::vector<std::vector<G4double>> ata(nMonomials, std::vector<G4double>(nMonomials, 0));
+  std::vector<std::vector<G4double>> atb(nMonomials, std::vector<G4double>(4, 0));
+  std::vector<G4double> row(nMonomials);
+  for (std::size_t i = 0; i < nProbes; i++)
+    {
+      for (std::size_t j = 0; j < nMonomials; j++)
+	{
+	  G4double value = 1;
+	  for (G4int v = 0; v < nVar; v++)
+	    {value *= std::pow(probes[i][v], powers[j][v]);}
+	  row[j] = value;
+	}
+      G4double onePlusDeltaP = 1 + probes[i][4] * halfWidth[4];
+      std::array<G4double, 4> out = {batch.x[i] / CLHEP::m,
+				     batch.xp[i] * onePlusDeltaP,
+				     batch.y[i] / CLHEP::m,
+				     batch.yp[i] * onePlusDeltaP};
+      for (std::size_t j = 0; j < nMonomials; j++)
+	{
+	  for (std::size_t k = j; k < nMonomials; k++)
+	    {ata[j][k] += row[j] * row[k];}
+	  for (G4int o = 0; o < 4; o++)
+	    {atb[j][o] += row[j] * out[o];}
+	}
+    }
+  for (std::size_t j = 0; j < nMonomials; j++)
+    {
+      for (std::size_t k = 0; k < j; k++)
+	{ata[j][k] = ata[k][j];}
+    }
+  Solve(ata, atb);
+
+  std::array<std::vector<BDSPTCOneTurnMap::PTCMapTerm>, nVar> terms;
+  for (std::size_t j = 0; j < nMonomials; j++)
+    {
+      G4double scale = 1;
+      for (G4int v = 0; v < nVar; v++)
+	{scale *= std::pow(halfWidth[v], powers[j][v]);}
+      const auto& p = powers[j];
+      for (G4int o = 0; o < 4; o++)
+	{
+	  G4double coefficient = atb[j][o] / scale;
+	  if (coefficient != 0)
+	    {terms[o].push_back({coefficient, p[0], p[1], p[2], p[3], p[4]});}
+	}
+    }
+  terms[4].push_back({1.0, 0, 0, 0, 0, 1}); // momentum is unchanged
+
+  G4cout << __METHOD_NAME__ << "generated order " << order << " one turn map from "
+	 << transport.NElementsTransported() << " elements with " << nProbes << " probe particles" << G4endl;
+  auto result = new BDSPTCOneTurnMap(terms, designParticle);
+  result->SetValidRange(halfWidth);
+  return result;
+}
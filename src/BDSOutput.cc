@@ -28,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSHitApertureImpact.hh"
 #include "BDSHitCollimator.hh"
 #include "BDSHitEnergyDeposition.hh"
+#include "BDSHitEnergyDepositionBinned.hh"
 #include "BDSHitEnergyDepositionGlobal.hh"
 #include "BDSHitSampler.hh"
 #include "BDSHitSamplerCylinder.hh"
@@ -40,6 +41,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventCavityInfo.hh"
 #include "BDSOutputROOTEventCollimatorInfo.hh"
 #include "BDSOutputROOTEventCoords.hh"
+#include "BDSOutputROOTEventLossBinned.hh"
 #include "BDSOutputROOTEventLossWorld.hh"
 #include "BDSOutputROOTEventHeader.hh"
 #include "BDSOutputROOTEventHistograms.hh"
@@ -57,8 +59,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSPrimaryVertexInformation.hh"
 #include "BDSPrimaryVertexInformationV.hh"
 #include "BDSScorerHistogramDef.hh"
+#include "BDSScorerHitsMap.hh"
 #include "BDSSDManager.hh"
-#include "BDSStackingAction.hh"
 #include "BDSTrajectoriesToStore.hh"
 #include "BDSTrajectoryPoint.hh"
 #include "BDSTrajectoryPointHit.hh"
@@ -78,6 +80,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "parser/optionsBase.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <map>
 #include <ostream>
@@ -90,16 +93,41 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 const std::set<G4String> BDSOutput::protectedNames = {
   "Event", "Histos", "Info", "Primary", "PrimaryGlobal",
   "Eloss", "ElossVacuum", "ElossTunnel", "ElossWorld", "ElossWorldExit",
-  "ElossWorldContents",
+  "ElossWorldContents", "ElossBinned",
   "PrimaryFirstHit", "PrimaryLastHit", "Trajectory", "ApertureImpacts"
 };
 
+namespace
+{
+  /// Call function(index, value) for each cell of a scorer hits collection, which is
+  /// either a BDSScorerHitsMap from a BDSIM scorer or a G4THitsMap from a Geant4 one.
+  template <typename F>
+  void ForEachScorerHit(const G4VHitsCollection* hits, F&& function)
+  {
+    if (const auto flatMap = dynamic_cast<const BDSScorerHitsMap*>(hits))
+      {
+        for (auto index : flatMap->Indices())
+          {function(index, flatMap->At(index));}
+      }
+    else if (const auto hitMap = dynamic_cast<const G4THitsMap<G4double>*>(hits))
+      {
+#if G4VERSION < 1039
+        for (const auto& hit : *hitMap->GetMap())
+#else
+        for (const auto& hit : *hitMap)
+#endif
+          {function(hit.first, *hit.second);}
+      }
+  }
+}
+
 BDSOutput::BDSOutput(const G4String& baseFileNameIn,
                      const G4String& fileExtensionIn,
                      G4int           fileNumberOffset):
   BDSOutputStructures(BDSGlobalConstants::Instance()),
   baseFileName(baseFileNameIn),
   fileExtension(fileExtensionIn),
+  overwriteFiles(false),
   outputFileNumber(fileNumberOffset),
   sMinHistograms(0),
   sMaxHistograms(0),
@@ -132,6 +160,7 @@ BDSOutput::BDSOutput(const G4String& baseFileNameIn,
   createCollimatorOutputStructures = storeCollimatorInfo || storeCollimatorHits;
 
   storeELoss                 = g->StoreELoss();
+  storeELossBinned           = g->StoreELossBinned();
   // store histograms if storing general energy deposition as negligible in size
   storeELossHistograms       = g->StoreELossHistograms() || storeELoss;
   storeELossTunnel           = g->StoreELossTunnel();
@@ -303,6 +332,8 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
                           const BDSHitsCollectionSamplerLink*            samplerHitsLink,
                           const BDSHitsCollectionEnergyDeposition*       energyLoss,
                           const BDSHitsCollectionEnergyDeposition*       energyLossFull,
+                          const BDSHitsCollectionEnergyDepositionBinned* energyLossBinned,
+                          const BDSHitsCollectionEnergyDepositionBinned* energyLossFullBinned,
                           const BDSHitsCollectionEnergyDeposition*       energyLossVacuum,
                           const BDSHitsCollectionEnergyDeposition*       energyLossTunnel,
                           const BDSHitsCollectionEnergyDepositionGlobal* energyLossWorld,
@@ -313,7 +344,7 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
                           const BDSTrajectoriesToStore*                  trajectories,
                           const BDSHitsCollectionCollimator*             collimatorHits,
                           const BDSHitsCollectionApertureImpacts*        apertureImpactHits,
-                          const std::map<G4String, G4THitsMap<G4double>*>& scorerHits,
+                          const std::map<G4String, G4VHitsCollection*>& scorerHits,
                           const G4int                                    turnsTaken)
 {
   // Clear integrals in this class -> here instead of BDSOutputStructures as
@@ -340,6 +371,8 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
     {FillEnergyLoss(energyLoss,        BDSOutput::LossType::energy);}
   if (energyLossFull)
     {FillEnergyLoss(energyLossFull,    BDSOutput::LossType::energy);}
+  if (energyLossBinned || energyLossFullBinned)
+    {FillEnergyLossBinned(energyLossBinned, energyLossFullBinned);}
   if (energyLossVacuum)
     {FillEnergyLoss(energyLossVacuum,  BDSOutput::LossType::vacuum);}
   if (energyLossTunnel)
@@ -418,7 +451,7 @@ G4String BDSOutput::GetNextFileName()
   
   // policy: overwrite if output filename specifically set, otherwise increase number
   // always check in interactive mode
-  if (!globalConstants->OutputFileNameSet() || !globalConstants->Batch())
+  if (!overwriteFiles && (!globalConstants->OutputFileNameSet() || !globalConstants->Batch()))
     {// check if file exists
       G4String original = newFileName; // could have nper file number suffix too
       G4int nTimeAppended = 1;
@@ -437,6 +470,12 @@ G4String BDSOutput::GetNextFileName()
   return newFileName;
 }
 
+void BDSOutput::SetBaseFileNameOverwrite(const G4String& baseFileNameIn)
+{
+  baseFileName   = baseFileNameIn;
+  overwriteFiles = true;
+}
+
 void BDSOutput::CalculateHistogramParameters()
 {
   // rounding up so last bin definitely covers smax
@@ -697,8 +736,8 @@ void BDSOutput::FillEventInfo(const BDSEventInfo* info)
   evtInfo->energyWorldExitKinetic       = energyWorldExitKinetic;
   evtInfo->energyImpactingAperture      = energyImpactingAperture;
   evtInfo->energyImpactingApertureKinetic = energyImpactingApertureKinetic;
-  G4double ek = BDSStackingAction::energyKilled / CLHEP::GeV;
-  evtInfo->energyKilled = ek;
+  // set in the event info (in GeV) by the event action of the thread that simulated the event
+  G4double ek = evtInfo->energyKilled;
   evtInfo->energyTotal =  energyDeposited
     + energyDepositedVacuum
     + energyDepositedWorld
@@ -906,11 +945,13 @@ void BDSOutput::FillEnergyLoss(const BDSHitsCollectionEnergyDeposition* hits,
         for (G4int i = 0; i < nHits; i++)
           {
             BDSHitEnergyDeposition* hit = (*hits)[i];
+            if (storeELoss)
+              {eLoss->Fill(hit);}
+            if (storeELossBinned)
+              {continue;} // the integral and histograms are filled from the bins instead
             G4double sHit = hit->GetSHit() / CLHEP::m;
             G4double eW = hit->GetEnergyWeighted() / CLHEP::GeV;
             energyDeposited += eW;
-            if (storeELoss)
-              {eLoss->Fill(hit);}
             if (storeELossHistograms)
               {
                 runHistos->Fill1DHistogram(indELoss, sHit, eW);
@@ -984,7 +1025,50 @@ void BDSOutput::FillEnergyLoss(const BDSHitsCollectionEnergyDeposition* hits,
   if (storeCollimatorInfo &&
       nCollimators > 0 &&
       (lossType == BDSOutput::LossType::energy) &&
-      storeELossHistograms)
+      storeELossHistograms &&
+      !storeELossBinned)
+    {CopyFromHistToHist1D("ElossPE", "CollElossPE", collimatorIndices);}
+}
+
+void BDSOutput::FillEnergyLossBinned(const BDSHitsCollectionEnergyDepositionBinned* loss,
+                                     const BDSHitsCollectionEnergyDepositionBinned* lossFull)
+{
+  // the same bin may be in both collections so merge them first - std::map so the
+  // output is ordered by S bin
+  std::map<std::array<G4int,4>, G4double> bins;
+  for (const auto hits : {loss, lossFull})
+    {
+      if (!hits)
+        {continue;}
+      G4int nHits = (G4int)hits->entries();
+      for (G4int i = 0; i < nHits; i++)
+        {
+          const BDSHitEnergyDepositionBinned* hit = (*hits)[i];
+          bins[{hit->sBin, hit->beamlineIndex, hit->turn, hit->particleClass}] += hit->energyWeighted;
+        }
+    }
+  if (bins.empty())
+    {return;}
+
+  const G4double binWidth = BDSGlobalConstants::Instance()->ELossHistoBinWidth();
+  G4int indELoss   = storeELossHistograms ? histIndices1D["Eloss"] : -1;
+  G4int indELossPE = storeELossHistograms ? histIndices1D["ElossPE"] : -1;
+  for (const auto& bin : bins)
+    {
+      G4double sCentre = (sMinHistograms + (bin.first[0] + 0.5) * binWidth) / CLHEP::m;
+      G4double eW = bin.second / CLHEP::GeV;
+      energyDeposited += eW;
+      eLossBinned->Fill((float)sCentre, bin.first[1], bin.first[2], bin.first[3], (float)eW);
+      if (storeELossHistograms)
+        {
+          runHistos->Fill1DHistogram(indELoss, sCentre, eW);
+          evtHistos->Fill1DHistogram(indELoss, sCentre, eW);
+          runHistos->Fill1DHistogram(indELossPE, sCentre, eW);
+          evtHistos->Fill1DHistogram(indELossPE, sCentre, eW);
+        }
+    }
+
+  if (storeCollimatorInfo && nCollimators > 0 && storeELossHistograms)
     {CopyFromHistToHist1D("ElossPE", "CollElossPE", collimatorIndices);}
 }
 
@@ -1124,15 +1208,11 @@ void BDSOutput::FillApertureImpacts(const BDSHitsCollectionApertureImpacts* hits
     }
 }
 
-void BDSOutput::FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap)
+void BDSOutput::FillScorerHits(const std::map<G4String, G4VHitsCollection*>& scorerHitsMap)
 {
   for (const auto& nameHitsMap : scorerHitsMap)
     {
-#if G4VERSION < 1039
-      if (nameHitsMap.second->GetSize() == 0)
-#else
-      if (nameHitsMap.second->size() == 0)
-#endif
+      if (!nameHitsMap.second || nameHitsMap.second->GetSize() == 0)
 #ifdef BDSDEBUG
         {G4cout << nameHitsMap.first << " empty" << G4endl; continue;}
 #else
@@ -1143,7 +1223,7 @@ void BDSOutput::FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>&
 }
 
 void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
-                                         const G4THitsMap<G4double>* hitMap)
+                                         const G4VHitsCollection* hitMap)
 {
   if (BDS::StrContains(histogramDefName, "blm_"))
     {return FillScorerHitsIndividualBLM(histogramDefName, hitMap);}
@@ -1156,18 +1236,17 @@ void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
       const BDSHistBinMapper& mapper = scorerCoordinateMaps.at(histogramDefName);
       TH3D* hist = evtHistos->Get3DHistogram(histIndex);
       G4int x,y,z,e;
-#if G4VERSION < 1039
-      for (const auto& hit : *hitMap->GetMap())
-#else
-      for (const auto& hit : *hitMap)
-#endif
+      // only the bins hit are visited - the run histogram is accumulated bin by bin
+      // and the event histogram flush only resets these bins
+      ForEachScorerHit(hitMap, [&](G4int index, G4double hitValue)
         {
           // convert from scorer global index to 3d i,j,k index of 3d scorer
-          mapper.IJKLFromGlobal(hit.first, x,y,z,e);
+          mapper.IJKLFromGlobal(index, x,y,z,e);
           G4int rootGlobalIndex = (hist->GetBin(x + 1, y + 1, z + 1)); // convert to root system (add 1 to avoid underflow bin)
-          evtHistos->Set3DHistogramBinContent(histIndex, rootGlobalIndex, *hit.second / unit);
-        }
-      runHistos->AccumulateHistogram3D(histIndex, evtHistos->Get3DHistogram(histIndex));
+          G4double value = hitValue / unit;
+          evtHistos->Set3DHistogramBinContent(histIndex, rootGlobalIndex, value);
+          runHistos->Add3DHistogramBinContent(histIndex, rootGlobalIndex, value);
+        });
     }
   
   if (!(histIndices4D.find(histogramDefName) == histIndices4D.end()))
@@ -1177,37 +1256,31 @@ void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
       // avoid using [] operator for map as we have no default constructor for BDSHistBinMapper3D
       const BDSHistBinMapper& mapper = scorerCoordinateMaps.at(histogramDefName);
       G4int x,y,z,e;
-#if G4VERSION < 1039
-      for (const auto& hit : *hitMap->GetMap())
-#else
-      for (const auto& hit : *hitMap)
-#endif
+      ForEachScorerHit(hitMap, [&](G4int index, G4double hitValue)
         {
           // convert from scorer global index to 4d i,j,k,e index of 4d scorer
-          mapper.IJKLFromGlobal(hit.first, x,y,z,e);
-          evtHistos->Set4DHistogramBinContent(histIndex, x, y, z, e - 1, *hit.second / unit); // - 1 to go back to the Boost Histogram indexing (-1 for the underflow bin)
-        }
-      runHistos->AccumulateHistogram4D(histIndex, evtHistos->Get4DHistogram(histIndex));
+          mapper.IJKLFromGlobal(index, x,y,z,e);
+          G4double value = hitValue / unit;
+          // - 1 to go back to the Boost Histogram indexing (-1 for the underflow bin)
+          evtHistos->Set4DHistogramBinContent(histIndex, x, y, z, e - 1, value);
+          runHistos->Add4DHistogramBinContent(histIndex, x, y, z, e - 1, value);
+        });
     }
 }
 
 void BDSOutput::FillScorerHitsIndividualBLM(const G4String& histogramDefName,
-                                            const G4THitsMap<G4double>* hitMap)
+                                            const G4VHitsCollection* hitMap)
 {
   G4int histIndex = blmCollectionNameToHistogramID[histogramDefName];
-#if G4VERSION < 1039
-  for (const auto& hit : *hitMap->GetMap())
-#else
-  for (const auto& hit : *hitMap)
-#endif
+  G4double unit = BDS::MapGetWithDefault(histIndexToUnits1D, histIndex, 1.0);
+  ForEachScorerHit(hitMap, [&](G4int index, G4double value)
     {
 #ifdef BDSDEBUG
-      G4cout << "Filling hist " << histIndex << ", bin: " << hit.first+1 << " value: " << *hit.second << G4endl;
+      G4cout << "Filling hist " << histIndex << ", bin: " << index+1 << " value: " << value << G4endl;
 #endif
-      G4double unit = BDS::MapGetWithDefault(histIndexToUnits1D, histIndex, 1.0);
-      evtHistos->Fill1DHistogram(histIndex,hit.first, *hit.second / unit);
-      runHistos->Fill1DHistogram(histIndex,hit.first, *hit.second / unit);
-    }
+      evtHistos->Fill1DHistogram(histIndex, index, value / unit);
+      runHistos->Fill1DHistogram(histIndex, index, value / unit);
+    });
 }
 
 void BDSOutput::FillRunInfoAndUpdateHeader(const BDSEventInfo* info,
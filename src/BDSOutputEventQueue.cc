@@ -0,0 +1,185 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSOutput.hh"
+#include "BDSOutputEventQueue.hh"
+#include "BDSOutputEventRecord.hh"
+
+#include <algorithm>
+#include <chrono>
+
+BDSOutputEventQueue::BDSOutputEventQueue(BDSOutput* outputIn,
+                                         G4int      capacityIn,
+                                         G4int      eventsPerFileIn):
+  output(outputIn),
+  capacity(std::max(1, capacityIn)),
+  eventsPerFile(eventsPerFileIn),
+  slots(capacity),
+  nextIndex(0),
+  finishing(false),
+  abandoned(false)
+{
+  for (auto& slot : slots)
+    {slot.store(nullptr);}
+}
+
+BDSOutputEventQueue::~BDSOutputEventQueue()
+{
+  Finish();
+}
+
+void BDSOutputEventQueue::Start()
+{
+  Finish(); // in case a previous run wasn't finished
+  for (auto& slot : slots)
+    {slot.store(nullptr, std::memory_order_relaxed);}
+  nextIndex.store(0, std::memory_order_relaxed);
+  finishing.store(false, std::memory_order_relaxed);
+  abandoned.store(false, std::memory_order_relaxed);
+  writer = std::thread(&BDSOutputEventQueue::WriterLoop, this);
+}
+
+void BDSOutputEventQueue::Finish()
+{
+  if (!writer.joinable())
+    {return;}
+  finishing.store(true, std::memory_order_release);
+  writer.join();
+}
+
+void BDSOutputEventQueue::Abandon()
+{
+  abandoned.store(true, std::memory_order_release);
+}
+
+G4bool BDSOutputEventQueue::Publish(BDSOutputEventRecord* record)
+{
+  G4int index = record->index;
+  G4int nTries = 0;
+  while (index >= nextIndex.load(std::memory_order_acquire) + capacity)
+    {
+      if (abandoned.load(std::memory_order_acquire))
+        {return false;}
+      Backoff(nTries);
+    }
+  if (abandoned.load(std::memory_order_acquire))
+    {return false;}
+  slots[index % capacity].store(record, std::memory_order_release);
+  return true;
+}
+
+void BDSOutputEventQueue::Backoff(G4int& nTries)
+{
+  if (nTries < 100)
+    {
+      nTries++;
+      std::this_thread::yield();
+    }
+  else
+    {std::this_thread::sleep_for(std::chrono::microseconds(100));}
+}
+
+void BDSOutputEventQueue::WriterLoop()
+{
+  G4int nTries = 0;
+  while (true)
+    {
+      G4int index = nextIndex.load(std::memory_order_relaxed);
+      auto& slot = slots[index % capacity];
+      BDSOutputEventRecord* record = slot.load(std::memory_order_acquire);
+      if (record && record->index == index)
+        {
+          Write(record);
+          slot.store(nullptr, std::memory_order_relaxed);
+          record->written.store(true, std::memory_order_release);
+          nextIndex.store(index + 1, std::memory_order_release);
+          nTries = 0;
+          continue;
+        }
+
+      // all events are published before finishing is set, so the next one is missing
+      if (finishing.load(std::memory_order_acquire))
+        {
+          WriteRemaining();
+          break;
+        }
+      // no more events will come so don't wait for the missing ones
+      if (abandoned.load(std::memory_order_acquire) && WriteRemaining())
+        {
+          nTries = 0;
+          continue;
+        }
+      Backoff(nTries);
+    }
+}
+
+G4bool BDSOutputEventQueue::WriteRemaining()
+{
+  std::vector<BDSOutputEventRecord*> remaining;
+  for (auto& slot : slots)
+    {
+      BDSOutputEventRecord* record = slot.exchange(nullptr, std::memory_order_acq_rel);
+      if (record)
+        {remaining.push_back(record);}
+    }
+  if (remaining.empty())
+    {return false;}
+  
+  std::sort(remaining.begin(), remaining.end(),
+            [](const BDSOutputEventRecord* a, const BDSOutputEventRecord* b){return a->index < b->index;});
+  G4cout << __METHOD_NAME__ << "writing " << remaining.size() << " events after missing event "
+         << nextIndex.load(std::memory_order_relaxed) << G4endl;
+  for (auto record : remaining)
+    {
+      Write(record);
+      record->written.store(true, std::memory_order_release);
+    }
+  nextIndex.store(remaining.back()->index + 1, std::memory_order_release);
+  return true;
+}
+
+void BDSOutputEventQueue::Write(BDSOutputEventRecord* record)
+{
+  output->FillEvent(record->info,
+                    record->vertex,
+                    record->samplerHitsPlane,
+                    record->samplerHitsCylinder,
+                    record->samplerHitsSphere,
+                    nullptr,
+                    record->energyLoss,
+                    record->energyLossFull,
+                    record->energyLossBinned,
+                    record->energyLossFullBinned,
+                    record->energyLossVacuum,
+                    record->energyLossTunnel,
+                    record->energyLossWorld,
+                    record->energyLossWorldContents,
+                    record->worldExitHits,
+                    record->primaryHits,
+                    record->primaryLosses,
+                    record->trajectories,
+                    record->collimatorHits,
+                    record->apertureImpactHits,
+                    record->scorerHits,
+                    record->turnsTaken);
+
+  // if events per ntuples not set (default 0) - only write out at end
+  if (eventsPerFile > 0 && (record->index + 1) % eventsPerFile == 0)
+    {output->CloseAndOpenNewFile();}
+}
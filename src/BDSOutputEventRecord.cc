@@ -0,0 +1,85 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSOutputEventRecord.hh"
+#include "BDSTrajectoriesToStore.hh"
+#include "BDSTrajectoryPointHit.hh"
+
+#include "G4Event.hh"
+
+BDSOutputEventRecord::BDSOutputEventRecord():
+  index(-1),
+  event(nullptr),
+  info(nullptr),
+  vertex(nullptr),
+  energyLoss(nullptr),
+  energyLossFull(nullptr),
+  energyLossBinned(nullptr),
+  energyLossFullBinned(nullptr),
+  energyLossVacuum(nullptr),
+  energyLossTunnel(nullptr),
+  energyLossWorld(nullptr),
+  energyLossWorldContents(nullptr),
+  worldExitHits(nullptr),
+  trajectories(nullptr),
+  collimatorHits(nullptr),
+  apertureImpactHits(nullptr),
+  turnsTaken(0),
+  written(false)
+{;}
+
+BDSOutputEventRecord::~BDSOutputEventRecord()
+{
+  event = nullptr; // may already be deleted by the run manager at the end of the program
+  Clear();
+}
+
+void BDSOutputEventRecord::Clear()
+{
+  if (event)
+    {event->PostProcessingFinished();} // the run manager may now delete it
+  event  = nullptr;
+  index  = -1;
+  info   = nullptr;
+  vertex = nullptr;
+  samplerHitsPlane.clear();
+  samplerHitsCylinder.clear();
+  samplerHitsSphere.clear();
+  energyLoss              = nullptr;
+  energyLossFull          = nullptr;
+  energyLossBinned        = nullptr;
+  energyLossFullBinned    = nullptr;
+  energyLossVacuum        = nullptr;
+  energyLossTunnel        = nullptr;
+  energyLossWorld         = nullptr;
+  energyLossWorldContents = nullptr;
+  worldExitHits           = nullptr;
+  for (auto p : primaryHits)
+    {delete p;}
+  primaryHits.clear();
+  for (auto p : primaryLosses)
+    {delete p;}
+  primaryLosses.clear();
+  delete trajectories;
+  trajectories = nullptr;
+  collimatorHits     = nullptr;
+  apertureImpactHits = nullptr;
+  scorerHits.clear();
+  turnsTaken = 0;
+  written.store(false, std::memory_order_relaxed);
+}
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventBeam.hh"
 #include "BDSOutputROOTEventCollimator.hh"
 #include "BDSOutputROOTEventCoords.hh"
+#include "BDSOutputROOTEventLossBinned.hh"
 #include "BDSOutputROOTEventLossWorld.hh"
 #include "BDSOutputROOTEventHeader.hh"
 #include "BDSOutputROOTEventHistograms.hh"
@@ -112,6 +113,8 @@ void BDSOutputROOT::NewFile()
   // Build loss and hit structures
   if (storeELoss)
     {theEventOutputTree->Branch("Eloss.",          "BDSOutputROOTEventLoss",   eLoss,          4000, 1);}
+  if (storeELossBinned)
+    {theEventOutputTree->Branch("ElossBinned.",    "BDSOutputROOTEventLossBinned", eLossBinned, 4000, 1);}
   if (storeELossVacuum)
     {theEventOutputTree->Branch("ElossVacuum.",    "BDSOutputROOTEventLoss",   eLossVacuum,    4000, 1);}
   if (storeELossTunnel)
@@ -30,6 +30,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSException.hh"
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
 ClassImp(BDSOutputROOTEventHistograms)
 
 BDSOutputROOTEventHistograms::BDSOutputROOTEventHistograms()
@@ -67,6 +71,7 @@ void BDSOutputROOTEventHistograms::FillSimple(const BDSOutputROOTEventHistograms
   histograms2D = rhs->histograms2D;
   histograms3D = rhs->histograms3D;
   histograms4D = rhs->histograms4D;
+  ClearBinsSet();
 }
 
 void BDSOutputROOTEventHistograms::Fill(const BDSOutputROOTEventHistograms* rhs)
@@ -85,7 +90,7 @@ void BDSOutputROOTEventHistograms::Fill(const BDSOutputROOTEventHistograms* rhs)
   for (auto h : rhs->histograms4D)
     {histograms4D.push_back(static_cast<BDSBH4DBase*>(h->Clone("")));}
 #endif
-
+  ClearBinsSet();
 }
 
 int BDSOutputROOTEventHistograms::Create1DHistogramSTD(std::string name, std::string title,
@@ -139,6 +144,8 @@ G4int BDSOutputROOTEventHistograms::Create3DHistogram(G4String name, G4String ti
                                   nxbins, xmin, xmax,
                                   nybins, ymin, ymax,
                                   nzbins, zmin, zmax));
+  binsSet3D.resize(histograms3D.size());
+  onlyBinsSet3D.resize(histograms3D.size(), true);
   return (G4int)histograms3D.size() - 1;
 }
 
@@ -151,6 +158,8 @@ G4int BDSOutputROOTEventHistograms::Create3DHistogram(G4String name, G4String ti
                                   (Int_t)xedges.size()-1, xedges.data(),
                                   (Int_t)yedges.size()-1, yedges.data(),
                                   (Int_t)zedges.size()-1, zedges.data()));
+  binsSet3D.resize(histograms3D.size());
+  onlyBinsSet3D.resize(histograms3D.size(), true);
   return (G4int)histograms3D.size() - 1;
 }
 
@@ -192,6 +201,8 @@ G4int BDSOutputROOTEventHistograms::Create4DHistogram(const G4String& name,
                                                                    nzbins, zmin, zmax));
     }
 
+  binsSet4D.resize(histograms4D.size());
+  onlyBinsSet4D.resize(histograms4D.size(), true);
   return (G4int)histograms4D.size() - 1;
 }
 #else
@@ -228,6 +239,7 @@ void BDSOutputROOTEventHistograms::Fill3DHistogram(G4int    histoId,
                                                    G4double weight)
 {
   histograms3D[histoId]->Fill(xValue,yValue,zValue,weight);
+  MarkModified3D(histoId);
 }
 
 #ifdef USE_BOOST
@@ -238,6 +250,7 @@ void BDSOutputROOTEventHistograms::Fill4DHistogram(G4int    histoId,
                                                    G4double eValue)
 {
   histograms4D[histoId]->Fill_BDSBH4D(xValue, yValue, zValue, eValue);
+  MarkModified4D(histoId);
 }
 #else
 void BDSOutputROOTEventHistograms::Fill4DHistogram(G4int,
@@ -255,6 +268,8 @@ void BDSOutputROOTEventHistograms::Set3DHistogramBinContent(G4int histoId,
                                                             G4double value)
 {
   histograms3D[histoId]->SetBinContent(globalBinID, value);
+  if (histoId < (G4int)binsSet3D.size())
+    {binsSet3D[histoId].push_back(globalBinID);}
 }
 
 #ifdef USE_BOOST
@@ -266,6 +281,8 @@ void BDSOutputROOTEventHistograms::Set4DHistogramBinContent(G4int histoId,
                                                             G4double value)
 {
   histograms4D[histoId]->Set_BDSBH4D(x, y, z, e, value);
+  if (histoId < (G4int)binsSet4D.size())
+    {binsSet4D[histoId].push_back({x, y, z, e});}
 }
 #else
 void BDSOutputROOTEventHistograms::Set4DHistogramBinContent(G4int, G4int, G4int, G4int, G4int, G4double)
@@ -274,16 +291,50 @@ void BDSOutputROOTEventHistograms::Set4DHistogramBinContent(G4int, G4int, G4int,
 }
 #endif
 
+void BDSOutputROOTEventHistograms::Add3DHistogramBinContent(G4int    histoId,
+                                                            G4int    globalBinID,
+                                                            G4double value)
+{
+  // the same as TH1::Add() with a histogram with only this bin set
+  TH3D* h = histograms3D[histoId];
+  h->AddBinContent(globalBinID, value);
+  if (h->GetSumw2N() > 0)
+    {h->GetSumw2()->fArray[globalBinID] += std::abs(value);}
+  h->SetEntries(h->GetEntries() + 1);
+  MarkModified3D(histoId);
+}
+
+#ifdef USE_BOOST
+void BDSOutputROOTEventHistograms::Add4DHistogramBinContent(G4int    histoId,
+                                                            G4int    x,
+                                                            G4int    y,
+                                                            G4int    z,
+                                                            G4int    e,
+                                                            G4double value)
+{
+  BDSBH4DBase* h = histograms4D[histoId];
+  h->Set_BDSBH4D(x, y, z, e, h->At(x, y, z, e) + value);
+  MarkModified4D(histoId);
+}
+#else
+void BDSOutputROOTEventHistograms::Add4DHistogramBinContent(G4int, G4int, G4int, G4int, G4int, G4double)
+{
+  throw BDSException(__METHOD_NAME__, "BDSIM compiled without BOOST support -> no 4D histograms.");
+}
+#endif
+
 void BDSOutputROOTEventHistograms::AccumulateHistogram3D(G4int histoId,
                                                          TH3D* otherHistogram)
 {
   histograms3D[histoId]->Add(otherHistogram);
+  MarkModified3D(histoId);
 }
 
 void BDSOutputROOTEventHistograms::AccumulateHistogram4D(G4int histoId,
                                                          BDSBH4DBase* otherHistogram)
 {
   *histograms4D[histoId] += *otherHistogram;
+  MarkModified4D(histoId);
 }
 
 #endif
@@ -294,10 +345,64 @@ void BDSOutputROOTEventHistograms::Flush()
     {h->Reset();}
   for (auto h : histograms2D)
     {h->Reset();}
-  for (auto h : histograms3D)
-    {h->Reset();}
+  for (std::size_t i = 0; i < histograms3D.size(); i++)
+    {
+      TH3D* h = histograms3D[i];
+      if (i < onlyBinsSet3D.size() && onlyBinsSet3D[i])
+        {// for a fine mesh with few bins set, this is much quicker than resetting every bin
+          for (auto bin : binsSet3D[i])
+            {h->SetBinContent(bin, 0);}
+          if (h->GetSumw2N() > 0)
+            {
+              for (auto bin : binsSet3D[i])
+                {h->GetSumw2()->fArray[bin] = 0;}
+            }
+          Double_t stats[TH1::kNstat] = {0};
+          h->PutStats(stats);
+          h->SetEntries(0);
+        }
+      else
+        {h->Reset();}
+    }
 #ifdef USE_BOOST
-  for (auto h : histograms4D)
-    {h->Reset_BDSBH4D();}
+  for (std::size_t i = 0; i < histograms4D.size(); i++)
+    {
+      BDSBH4DBase* h = histograms4D[i];
+      if (i < onlyBinsSet4D.size() && onlyBinsSet4D[i])
+        {
+          for (const auto& bin : binsSet4D[i])
+            {h->Set_BDSBH4D(bin[0], bin[1], bin[2], bin[3], 0);}
+          h->SetEntries_BDSBH4D(0);
+        }
+      else
+        {h->Reset_BDSBH4D();}
+    }
 #endif
+  for (auto& bins : binsSet3D)
+    {bins.clear();}
+  for (auto& bins : binsSet4D)
+    {bins.clear();}
+  std::fill(onlyBinsSet3D.begin(), onlyBinsSet3D.end(), true);
+  std::fill(onlyBinsSet4D.begin(), onlyBinsSet4D.end(), true);
+}
+
+void BDSOutputROOTEventHistograms::MarkModified3D(int histoId)
+{
+  if (histoId < (int)onlyBinsSet3D.size())
+    {onlyBinsSet3D[histoId] = false;}
+}
+
+void BDSOutputROOTEventHistograms::MarkModified4D(int histoId)
+{
+  if (histoId < (int)onlyBinsSet4D.size())
+    {onlyBinsSet4D[histoId] = false;}
+}
+
+void BDSOutputROOTEventHistograms::ClearBinsSet()
+{
+  // without a record of the bins, the histograms must be fully reset on the next flush
+  binsSet3D.clear();
+  binsSet4D.clear();
+  onlyBinsSet3D.clear();
+  onlyBinsSet4D.clear();
 }
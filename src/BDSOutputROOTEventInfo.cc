@@ -45,7 +45,8 @@ BDSOutputROOTEventInfo::BDSOutputROOTEventInfo():
   energyTotal(0),
   nCollimatorsInteracted(0),
   nTracks(0),
-  bunchIndex(0)
+  bunchIndex(0),
+  nPrimariesScreened(0)
 {;}
 
 BDSOutputROOTEventInfo::~BDSOutputROOTEventInfo()
@@ -77,6 +78,7 @@ void BDSOutputROOTEventInfo::Flush()
   nCollimatorsInteracted = 0;
   nTracks                = 0;
   bunchIndex             = 0;
+  nPrimariesScreened     = 0;
 }
 
 void BDSOutputROOTEventInfo::Fill(const BDSOutputROOTEventInfo* other)
@@ -108,4 +110,5 @@ void BDSOutputROOTEventInfo::Fill(const BDSOutputROOTEventInfo* other)
   nCollimatorsInteracted  = other->nCollimatorsInteracted;
   nTracks                 = other->nTracks;
   bunchIndex              = other->bunchIndex;
+  nPrimariesScreened      = other->nPrimariesScreened;
 }
@@ -0,0 +1,68 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSOutputROOTEventLossBinned.hh"
+
+ClassImp(BDSOutputROOTEventLossBinned)
+
+BDSOutputROOTEventLossBinned::BDSOutputROOTEventLossBinned()
+{
+  Flush();
+}
+
+BDSOutputROOTEventLossBinned::~BDSOutputROOTEventLossBinned()
+{;}
+
+void BDSOutputROOTEventLossBinned::Fill(float sIn,
+					int   modelIDIn,
+					int   turnIn,
+					int   partClassIn,
+					float energyIn)
+{
+  n++;
+  S.push_back(sIn);
+  modelID.push_back(modelIDIn);
+  if (turnIn >= 0)
+    {turn.push_back(turnIn);}
+  if (partClassIn >= 0)
+    {partClass.push_back(partClassIn);}
+  energy.push_back(energyIn);
+}
+
+void BDSOutputROOTEventLossBinned::Fill(const BDSOutputROOTEventLossBinned* other)
+{
+  if (!other)
+    {return;}
+
+  n         = other->n;
+  S         = other->S;
+  modelID   = other->modelID;
+  turn      = other->turn;
+  partClass = other->partClass;
+  energy    = other->energy;
+}
+
+void BDSOutputROOTEventLossBinned::Flush()
+{
+  n = 0;
+  S.clear();
+  modelID.clear();
+  turn.clear();
+  partClass.clear();
+  energy.clear();
+}
@@ -24,12 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventTrajectory.hh"
 
 #ifndef __ROOTBUILD__
-#include "G4VPhysicalVolume.hh"
-
 #include "BDSHitEnergyDeposition.hh"
-#include "BDSAuxiliaryNavigator.hh"
-#include "BDSPhysicalVolumeInfoRegistry.hh"
-#include "BDSPhysicalVolumeInfo.hh"
 #include "BDSTrajectory.hh"
 #include "BDSTrajectoryOptions.hh"
 
@@ -39,18 +34,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 ClassImp(BDSOutputROOTEventTrajectory)
 BDSOutputROOTEventTrajectory::BDSOutputROOTEventTrajectory():
-  auxNavigator(nullptr),
   n(0)
 {
   FlushLocal();
 }
 
 BDSOutputROOTEventTrajectory::~BDSOutputROOTEventTrajectory()
-{
-#ifndef __ROOTBUILD__
-  delete auxNavigator;
-#endif
-}
+{;}
 
 #ifndef __ROOTBUILD__
 int findPrimaryStepIndex(BDSTrajectory* traj)
@@ -70,11 +60,6 @@ void BDSOutputROOTEventTrajectory::Fill(const BDSTrajectoriesToStore* trajectori
                                         const BDS::TrajectoryOptions& storageOptions,
                                         const std::map<G4Material*, short int>& materialToID)
 {
-  if (!auxNavigator)
-    {// navigator for converting coordinates to curvilinear coordinate system
-      auxNavigator = new BDSAuxiliaryNavigator();
-    }
-
   G4bool stEK = storageOptions.storeLinks || storageOptions.storeKineticEnergy;
   G4bool stMo = storageOptions.storeMomentumVector;
   G4bool stPr = storageOptions.storeProcesses;
@@ -144,20 +129,22 @@ void BDSOutputROOTEventTrajectory::Fill(const BDSTrajectoriesToStore* trajectori
       // now we convert the geant4 type based BDSTrajectory information into
       // basic C++ and ROOT types for the output
       IndividualTrajectory itj;
+      // the beam line indices are found when the event is processed
+      const std::vector<int>& modelIndices = trajectories->modelIndices.at(traj);
       if (storeStepPointsN > 0)
         {// store specific number of step points along the trajectory
           G4int nSteps = traj->GetPointEntries();
           G4int nPoints = std::min(nSteps, storeStepPointsN);
           for (int i = 0; i < nPoints; ++i)
-            {FillIndividualTrajectory(itj, traj, i, materialToID);}
+            {FillIndividualTrajectory(itj, traj, i, modelIndices, materialToID);}
           // optionally include the last point if required and not already stored
           if (storeStepPointLast && (nPoints < nSteps))
-            {FillIndividualTrajectory(itj, traj, nSteps-1, materialToID);}
+            {FillIndividualTrajectory(itj, traj, nSteps-1, modelIndices, materialToID);}
         }
       else
         {// store all points as usual
           for (int i = 0; i < traj->GetPointEntries(); ++i)
-            {FillIndividualTrajectory(itj, traj, i, materialToID);}
+            {FillIndividualTrajectory(itj, traj, i, modelIndices, materialToID);}
         }
       
       // record the filters that were matched for this trajectory
@@ -262,6 +249,7 @@ void BDSOutputROOTEventTrajectory::Fill(const BDSTrajectoriesToStore* trajectori
 void BDSOutputROOTEventTrajectory::FillIndividualTrajectory(IndividualTrajectory& itj,
                                                             BDSTrajectory*        traj,
                                                             int                   i,
+                                                            const std::vector<int>& modelIndices,
                                                             const std::map<G4Material*, short int>& materialToID) const
 {
   BDSTrajectoryPoint* point = dynamic_cast<BDSTrajectoryPoint*>(traj->GetPoint(i));
@@ -274,12 +262,7 @@ void BDSOutputROOTEventTrajectory::FillIndividualTrajectory(IndividualTrajectory
                                 pos.getY() / CLHEP::m,
                                 pos.getZ() / CLHEP::m));
   
-  G4VPhysicalVolume* vol = auxNavigator->LocateGlobalPointAndSetup(pos,nullptr,true,true,true);
-  BDSPhysicalVolumeInfo* theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(vol);
-  if (theInfo)
-    {itj.modelIndex.push_back(theInfo->GetBeamlineIndex());}
-  else
-    {itj.modelIndex.push_back(-1);}
+  itj.modelIndex.push_back(modelIndices[i]);
   
   // Process types
   itj.preProcessType.push_back(point->GetPreProcessType());
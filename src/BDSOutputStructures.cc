@@ -32,6 +32,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventHistograms.hh"
 #include "BDSOutputROOTEventInfo.hh"
 #include "BDSOutputROOTEventLoss.hh"
+#include "BDSOutputROOTEventLossBinned.hh"
 #include "BDSOutputROOTEventLossWorld.hh"
 #include "BDSOutputROOTEventModel.hh"
 #include "BDSOutputROOTEventOptions.hh"
@@ -95,6 +96,7 @@ BDSOutputStructures::BDSOutputStructures(const BDSGlobalConstants* globals):
   eLossWorld         = new BDSOutputROOTEventLossWorld();
   eLossWorldExit     = new BDSOutputROOTEventLossWorld();
   eLossWorldContents = new BDSOutputROOTEventLossWorld();
+  eLossBinned        = new BDSOutputROOTEventLossBinned();
 
   pFirstHit  = new BDSOutputROOTEventLoss(true, true,  true, true,  true, true,  false, true, true);
   pLastHit   = new BDSOutputROOTEventLoss(true, true,  true, true,  true, true,  false, true, true);
@@ -129,6 +131,7 @@ BDSOutputStructures::~BDSOutputStructures()
   delete eLossWorld;
   delete eLossWorldExit;
   delete eLossWorldContents;
+  delete eLossBinned;
   delete pFirstHit;
   delete pLastHit;
   delete apertureImpacts;
@@ -457,6 +460,7 @@ void BDSOutputStructures::ClearStructuresEventLevel()
   eLossWorld->Flush();
   eLossWorldExit->Flush();
   eLossWorldContents->Flush();
+  eLossBinned->Flush();
   pFirstHit->Flush();
   pLastHit->Flush();
   apertureImpacts->Flush();
@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSPSCellFlux4D.hh"
 #include "BDSHistBinMapper.hh"
+#include "BDSScorerHitsMap.hh"
+#include "BDSUtilities.hh"
 
 #ifdef USE_BOOST
 #include <boost/variant.hpp>
@@ -25,7 +27,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iostream>
 
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
 #include "G4String.hh"
+#include "G4TouchableHistory.hh"
 #include "G4Types.hh"
 
 BDSPSCellFlux4D::BDSPSCellFlux4D(const G4String&         name,
@@ -33,6 +38,9 @@ BDSPSCellFlux4D::BDSPSCellFlux4D(const G4String&         name,
 				 G4int ni,   G4int nj,   G4int nk,
 				 G4int depi, G4int depj, G4int depk):
   G4PSCellFlux3D(name,ni,nj,nk,depi,depj,depk),
+  HCID4D(-1),
+  evtMap4D(nullptr),
+  weighted(true),
   fDepthi(depi),
   fDepthj(depj),
   fDepthk(depk),
@@ -45,12 +53,70 @@ BDSPSCellFlux4D::BDSPSCellFlux4D(const G4String&         name,
 				 G4int ni,   G4int nj,   G4int nk,
 				 G4int depi, G4int depj, G4int depk):
   G4PSCellFlux3D(name, unit, ni, nj, nk, depi, depj, depk),
+  HCID4D(-1),
+  evtMap4D(nullptr),
+  weighted(true),
   fDepthi(depi),
   fDepthj(depj),
   fDepthk(depk),
   mapper(mapperIn)
 {;}
 
+void BDSPSCellFlux4D::Initialize(G4HCofThisEvent* HCE)
+{
+  evtMap4D = new BDSScorerHitsMap(detector->GetName(),
+                                  GetName(),
+                                  BDSScorerHitsMap::FreeBuffer(buffers, mapper->NBinsTotal()));
+  if (HCID4D < 0)
+    {HCID4D = GetCollectionID(0);}
+  HCE->AddHitsCollection(HCID4D, evtMap4D);
+}
+
+void BDSPSCellFlux4D::EndOfEvent(G4HCofThisEvent* /*HCE*/)
+{;}
+
+void BDSPSCellFlux4D::clear()
+{
+  evtMap4D->Clear();
+}
+
+void BDSPSCellFlux4D::Weighted(G4bool flag)
+{
+  weighted = flag;
+  G4PSCellFlux3D::Weighted(flag);
+}
+
+G4bool BDSPSCellFlux4D::ProcessHits(G4Step* aStep, G4TouchableHistory*)
+{
+  // as G4PSCellFlux::ProcessHits
+  G4double stepLength = aStep->GetStepLength();
+  if (!BDS::IsFinite(stepLength))
+    {return false;}
+
+  auto touchable = static_cast<const G4TouchableHistory*>(aStep->GetPreStepPoint()->GetTouchable());
+  G4int idx = touchable->GetReplicaNumber(indexDepth);
+  G4double cubicVolume = ComputeVolume(aStep, idx);
+
+  G4double cellFlux = stepLength / cubicVolume;
+  if (weighted)
+    {cellFlux *= aStep->GetPreStepPoint()->GetWeight();}
+  evtMap4D->Add(GetIndex(aStep), cellFlux);
+  return true;
+}
+
+void BDSPSCellFlux4D::PrintAll()
+{
+  G4cout << " MultiFunctionalDet  " << detector->GetName() << G4endl;
+  G4cout << " PrimitiveScorer " << GetName() << G4endl;
+  G4cout << " Number of entries " << evtMap4D->GetSize() << G4endl;
+  for (auto index : evtMap4D->Indices())
+    {
+      G4cout << "  cell: " << index
+             << "  cell flux: " << evtMap4D->At(index) / GetUnitValue()
+             << " [" << GetUnit() << "]" << G4endl;
+    }
+}
+
 G4int BDSPSCellFlux4D::GetIndex(G4Step* aStep)
 {
   const G4VTouchable* touchable = aStep->GetPreStepPoint()->GetTouchable();
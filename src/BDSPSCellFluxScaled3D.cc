@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSException.hh"
 #include "BDSHistBinMapper.hh"
 #include "BDSScorerConversionLoader.hh"
+#include "BDSScorerHitsMap.hh"
 #include "BDSPSCellFluxScaled3D.hh"
 #include "BDSUtilities.hh"
 
@@ -128,7 +129,7 @@ G4bool BDSPSCellFluxScaled3D::ProcessHits(G4Step* aStep, G4TouchableHistory*)
   radiationQuantity = cellFlux * factor;
   G4int index = GetIndex(aStep);
 
-  evtMap3D->add(index, radiationQuantity);
+  evtMap3D->Add(index, radiationQuantity);
   return true;
 }
 
@@ -140,8 +141,9 @@ G4double BDSPSCellFluxScaled3D::GetConversionFactor(G4int  /*particleID*/,
 
 void BDSPSCellFluxScaled3D::Initialize(G4HCofThisEvent* HCE)
 {
-  evtMap3D = new G4THitsMap<G4double>(detector->GetName(),
-				      GetName());
+  evtMap3D = new BDSScorerHitsMap(detector->GetName(),
+                                  GetName(),
+                                  BDSScorerHitsMap::FreeBuffer(buffers, mapper ? mapper->NBinsTotal() : 0));
   if (HCID3D < 0)
     {HCID3D = GetCollectionID(0);}
   HCE->AddHitsCollection(HCID3D, evtMap3D);
@@ -152,7 +154,20 @@ void BDSPSCellFluxScaled3D::EndOfEvent(G4HCofThisEvent* /*HEC*/)
 
 void BDSPSCellFluxScaled3D::clear()
 {
-  evtMap3D->clear();
+  evtMap3D->Clear();
+}
+
+void BDSPSCellFluxScaled3D::PrintAll()
+{
+  G4cout << " MultiFunctionalDet  " << detector->GetName() << G4endl;
+  G4cout << " PrimitiveScorer " << GetName() << G4endl;
+  G4cout << " Number of entries " << evtMap3D->GetSize() << G4endl;
+  for (auto index : evtMap3D->Indices())
+    {
+      G4cout << "  cell: " << index
+             << "  cell flux: " << evtMap3D->At(index) / GetUnitValue()
+             << " [" << GetUnit() << "]" << G4endl;
+    }
 }
 
 G4int BDSPSCellFluxScaled3D::GetIndex(G4Step* aStep)
@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSException.hh"
 #include "BDSHistBinMapper.hh"
 #include "BDSScorerConversionLoader.hh"
+#include "BDSScorerHitsMap.hh"
 #include "BDSPSPopulationScaled.hh"
 #include "BDSUtilities.hh"
 
@@ -121,7 +122,8 @@ BDSPSPopulationScaled::~BDSPSPopulationScaled()
 
 void BDSPSPopulationScaled::Initialize(G4HCofThisEvent* HCE)
 {
-  EvtMap = new G4THitsMap<G4double>(detector->GetName(), GetName());
+  // the number of cells isn't known so the hits map enlarges as required
+  EvtMap = new BDSScorerHitsMap(detector->GetName(), GetName(), BDSScorerHitsMap::FreeBuffer(buffers));
   if (HCID < 0)
     {HCID = GetCollectionID(0);}
 
@@ -135,7 +137,7 @@ void BDSPSPopulationScaled::EndOfEvent(G4HCofThisEvent* /*HEC*/)
 
 void BDSPSPopulationScaled::clear()
 {
-  EvtMap->clear();
+  EvtMap->Clear();
   fCellTrackLogger.clear();
 }
 
@@ -171,7 +173,7 @@ G4bool BDSPSPopulationScaled::ProcessHits(G4Step* aStep, G4TouchableHistory*)
                                             angle);
       radiationQuantity = weight * factor;
       
-      EvtMap->add(index, radiationQuantity);
+      EvtMap->Add(index, radiationQuantity);
     }
   
   return true;
@@ -300,12 +302,11 @@ void BDSPSPopulationScaled::PrintAll()
 {
   G4cout << " MultiFunctionalDet  " << detector->GetName() << G4endl;
   G4cout << " PrimitiveScorer " << GetName() << G4endl;
-  G4cout << " Number of entries " << EvtMap->entries() << G4endl;
-  auto itr = EvtMap->GetMap()->begin();
-  for (; itr != EvtMap->GetMap()->end(); itr++)
+  G4cout << " Number of entries " << EvtMap->GetSize() << G4endl;
+  for (auto index : EvtMap->Indices())
     {
-      G4cout << "  copy no.: " << itr->first
-	     << "  population: " << *(itr->second) / GetUnitValue()
+      G4cout << "  copy no.: " << index
+	     << "  population: " << EvtMap->At(index) / GetUnitValue()
 	     << " [quantity]"
 	     << G4endl;
     }
@@ -29,8 +29,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <fstream>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
@@ -44,7 +47,13 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
   pxLastTurn(0),
   yLastTurn(0),
   pyLastTurn(0),
-  deltaPLastTurn(0)
+  deltaPLastTurn(0),
+  maxPowers{},
+  powerOffsets{},
+  powerTableSize(0),
+  hasValidRange(false),
+  validHalfWidths{},
+  warnedOutsideValidRange(false)
 {
   referenceMomentum = designParticle->Momentum();
   mass = designParticle->Mass();
@@ -68,6 +77,7 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
   G4int ndeltaP = 0;
   G4int nt = 0;
 
+  std::array<std::vector<PTCMapTerm>, nVariables> terms;
   G4String line = "";
   while (std::getline(infile, line))
     {
@@ -80,30 +90,41 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
 
       PTCMapTerm term{coefficient, nx, npx, ny, npy, ndeltaP};
 
-      switch (nVector)
-	{
-	case 1:
-	  {xTerms.push_back(term); break;}
-	case 2:
-	  {pxTerms.push_back(term); break;}
-	case 3:
-	  {yTerms.push_back(term);  break;}
-	case 4:
-	  {pyTerms.push_back(term); break;}
-	case 5:
-	  {deltaPTerms.push_back(term); break;}
-	default:
-	  {
-	    throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");
-	    break;
-	  }
-	}
+      // nVector is 1 to 5 for x, px, y, py, deltaP
+      if (nVector < 1 || nVector > nVariables)
+	{throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");}
+      if (nx < 0 || npx < 0 || ny < 0 || npy < 0 || ndeltaP < 0)
+	{throw BDSException(__METHOD_NAME__, "Negative PTC term power - maptable file is perhaps malformed.");}
+      terms[nVector - 1].push_back(term);
     }
+  Compile(terms);
 #ifdef BDSDEBUG
       G4cout << __METHOD_NAME__ << "> Loaded Map:" << maptableFile << G4endl;
 #endif
 }
 
+BDSPTCOneTurnMap::BDSPTCOneTurnMap(const std::array<std::vector<PTCMapTerm>, nVariables>& terms,
+				   const BDSParticleDefinition* designParticle):
+  initialPrimaryMomentum(0),
+  beamOffsetS0(false),
+  lastTurnNumber(0),
+  xLastTurn(0),
+  pxLastTurn(0),
+  yLastTurn(0),
+  pyLastTurn(0),
+  deltaPLastTurn(0),
+  maxPowers{},
+  powerOffsets{},
+  powerTableSize(0),
+  hasValidRange(false),
+  validHalfWidths{},
+  warnedOutsideValidRange(false)
+{
+  referenceMomentum = designParticle->Momentum();
+  mass = designParticle->Mass();
+  Compile(terms);
+}
+
 void BDSPTCOneTurnMap::SetInitialPrimaryCoordinates(const BDSParticleCoordsFullGlobal& coords,
 						    G4bool beamOffsetS0In)
 {
@@ -160,26 +181,14 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 
       lastTurnNumber = turnsTaken;
-      xOut = Evaluate(xTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pxOut = Evaluate(pxTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      yOut = Evaluate(yTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pyOut = Evaluate(pyTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      deltaPOut = Evaluate(deltaPTerms,
-			   xLastTurn, pxLastTurn,
-			   yLastTurn, pyLastTurn,
-			   deltaPLastTurn);
+      std::array<G4double, nVariables> coords = {xLastTurn, pxLastTurn, yLastTurn, pyLastTurn, deltaPLastTurn};
+      CheckInValidRange(coords);
+      Evaluate(coords);
+      xOut      = coords[0];
+      pxOut     = coords[1];
+      yOut      = coords[2];
+      pyOut     = coords[3];
+      deltaPOut = coords[4];
       // Cache results for next turn.  Do it here, before we convert to BDSIM coordinates.
       xLastTurn      = xOut;
       pxLastTurn     = pxOut;
@@ -244,24 +253,140 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 }
 
-G4double BDSPTCOneTurnMap::Evaluate(std::vector<PTCMapTerm>& terms,
-				    G4double x,
-                                    G4double px,
-				    G4double y,
-				    G4double py,
-                                    G4double deltaP) const
+void BDSPTCOneTurnMap::Compile(const std::array<std::vector<PTCMapTerm>, nVariables>& terms)
 {
-  G4double result = 0;
-  for (const auto& term : terms)
+  // the same monomial usually appears in several outputs so merge them
+  std::map<std::array<G4int, nVariables>, std::size_t> monomialIndex;
+  for (G4int output = 0; output < nVariables; output++)
     {
-      result += (term.coefficient
-		 * std::pow(x, term.nx)
-		 * std::pow(px, term.npx)
-		 * std::pow(y, term.ny)
-		 * std::pow(py, term.npy)
-		 * std::pow(deltaP, term.ndeltaP));
+      for (const auto& term : terms[output])
+	{
+	  std::array<G4int, nVariables> powers = {term.nx, term.npx, term.ny, term.npy, term.ndeltaP};
+	  auto search = monomialIndex.find(powers);
+	  if (search == monomialIndex.end())
+	    {
+	      monomialIndex[powers] = monomials.size();
+	      monomials.push_back(Monomial{powers, {}});
+	      monomials.back().coefficients[output] = term.coefficient;
+	    }
+	  else
+	    {monomials[search->second].coefficients[output] += term.coefficient;}
+	}
     }
-  return result;
+
+  // lay out the powers of each variable one after another, each from power 0
+  for (G4int v = 0; v < nVariables; v++)
+    {
+      for (const auto& monomial : monomials)
+	{maxPowers[v] = std::max(maxPowers[v], monomial.powers[v]);}
+      powerOffsets[v] = powerTableSize;
+      powerTableSize += maxPowers[v] + 1;
+    }
+  // store the index into the power table rather than the power itself
+  for (auto& monomial : monomials)
+    {
+      for (G4int v = 0; v < nVariables; v++)
+	{monomial.powers[v] += powerOffsets[v];}
+    }
+  powerTable.resize((std::size_t)powerTableSize);
+}
+
+void BDSPTCOneTurnMap::SetValidRange(const std::array<G4double, nVariables>& halfWidthsIn)
+{
+  hasValidRange   = true;
+  validHalfWidths = halfWidthsIn;
+}
+
+void BDSPTCOneTurnMap::CheckInValidRange(const std::array<G4double, nVariables>& coords)
+{
+  if (!hasValidRange || warnedOutsideValidRange)
+    {return;}
+  const std::array<G4String, nVariables> names = {"x", "px", "y", "py", "deltaP"};
+  for (G4int v = 0; v < nVariables; v++)
+    {
+      if (std::abs(coords[v]) > validHalfWidths[v])
+	{
+	  // printed once only as this happens during tracking
+	  G4cout << __METHOD_NAME__ << "WARNING: one turn map applied to " << names[v] << " = " << coords[v]
+		 << " outside the range it was generated for (+-" << validHalfWidths[v]
+		 << " in PTC units). The map is extrapolated and may be inaccurate." << G4endl;
+	  warnedOutsideValidRange = true;
+	  return;
+	}
+    }
+}
+
+void BDSPTCOneTurnMap::Evaluate(std::array<G4double, nVariables>& coords)
+{
+  G4double* table = powerTable.data();
+  for (G4int v = 0; v < nVariables; v++)
+    {
+      G4double* p = table + powerOffsets[v];
+      p[0] = 1.0;
+      for (G4int k = 1; k <= maxPowers[v]; k++)
+	{p[k] = p[k-1] * coords[v];}
+    }
+
+  std::array<G4double, nVariables> result = {};
+  for (const auto& monomial : monomials)
+    {
+      const auto& i = monomial.powers;
+      G4double value = table[i[0]] * table[i[1]] * table[i[2]] * table[i[3]] * table[i[4]];
+      for (G4int output = 0; output < nVariables; output++)
+	{result[output] += monomial.coefficients[output] * value;}
+    }
+  coords = result;
+}
+
+void BDSPTCOneTurnMap::Evaluate(std::size_t n,
+				G4double*   x,
+				G4double*   px,
+				G4double*   y,
+				G4double*   py,
+				G4double*   deltaP) const
+{
+  // table of each power for each particle - particle index is the fastest
+  std::vector<G4double> table((std::size_t)powerTableSize * n);
+  G4double* variables[nVariables] = {x, px, y, py, deltaP};
+  for (G4int v = 0; v < nVariables; v++)
+    {
+      G4double* p0 = table.data() + (std::size_t)powerOffsets[v] * n;
+      std::fill(p0, p0 + n, 1.0);
+      for (G4int k = 1; k <= maxPowers[v]; k++)
+	{
+	  const G4double* previous = p0 + (std::size_t)(k-1) * n;
+	  G4double* current = p0 + (std::size_t)k * n;
+	  const G4double* value = variables[v];
+	  for (std::size_t j = 0; j < n; j++)
+	    {current[j] = previous[j] * value[j];}
+	}
+    }
+
+  std::vector<G4double> result((std::size_t)nVariables * n, 0.0);
+  std::vector<G4double> value(n);
+  for (const auto& monomial : monomials)
+    {
+      const auto& i = monomial.powers;
+      const G4double* p0 = table.data() + (std::size_t)i[0] * n;
+      const G4double* p1 = table.data() + (std::size_t)i[1] * n;
+      const G4double* p2 = table.data() + (std::size_t)i[2] * n;
+      const G4double* p3 = table.data() + (std::size_t)i[3] * n;
+      const G4double* p4 = table.data() + (std::size_t)i[4] * n;
+      for (std::size_t j = 0; j < n; j++)
+	{value[j] = p0[j] * p1[j] * p2[j] * p3[j] * p4[j];}
+      for (G4int output = 0; output < nVariables; output++)
+	{
+	  G4double c = monomial.coefficients[output];
+	  if (c == 0)
+	    {continue;}
+	  G4double* r = result.data() + (std::size_t)output * n;
+	  for (std::size_t j = 0; j < n; j++)
+	    {r[j] += c * value[j];}
+	}
+    }
+
+  for (G4int v = 0; v < nVariables; v++)
+    {std::copy(result.data() + (std::size_t)v * n, result.data() + (std::size_t)(v+1) * n, variables[v]);}
 }
 
 G4bool BDSPTCOneTurnMap::ShouldApplyToPrimary(G4double momentum,
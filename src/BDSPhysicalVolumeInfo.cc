@@ -18,8 +18,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSAcceleratorModel.hh"
 #include "BDSPhysicalVolumeInfo.hh"
+#include "G4RotationMatrix.hh"
 #include "G4Types.hh"
 #include "G4String.hh"
+#include "G4ThreeVector.hh"
 
 #include <ostream>
 
@@ -30,7 +32,8 @@ BDSPhysicalVolumeInfo::BDSPhysicalVolumeInfo(G4double sPosAtMiddleOfElement):
   beamlineIndex(-1),
   beamline(nullptr),
   beamlineMassWorld(nullptr),
-  beamlineMassWorldIndex(-1)
+  beamlineMassWorldIndex(-1),
+  hasCurvilinearFrame(false)
 {;}
 
 BDSPhysicalVolumeInfo::BDSPhysicalVolumeInfo(G4String nameIn,
@@ -44,7 +47,8 @@ BDSPhysicalVolumeInfo::BDSPhysicalVolumeInfo(G4String nameIn,
   beamlineIndex(beamlineIndexIn),
   beamline(beamlineIn),
   beamlineMassWorld(beamlineIn),
-  beamlineMassWorldIndex(beamlineIndexIn)
+  beamlineMassWorldIndex(beamlineIndexIn),
+  hasCurvilinearFrame(false)
 {
   // Variables are initialised with beam line and index. Here, we update them by referece if needs be.
   BDSAcceleratorModel::Instance()->MassWorldBeamlineAndIndex(beamlineMassWorld, beamlineMassWorldIndex);
@@ -53,6 +57,14 @@ BDSPhysicalVolumeInfo::BDSPhysicalVolumeInfo(G4String nameIn,
 BDSPhysicalVolumeInfo::~BDSPhysicalVolumeInfo()
 {;}
 
+void BDSPhysicalVolumeInfo::SetCurvilinearFrame(const G4RotationMatrix& rotation,
+						const G4ThreeVector&    position)
+{
+  hasCurvilinearFrame        = true;
+  curvilinearRotationInverse = rotation.inverse();
+  curvilinearOrigin          = position;
+}
+
 std::ostream &operator<<(std::ostream &out, BDSPhysicalVolumeInfo const &info)
 {
   out << "Name: \"" << info.name << "\" S pos: " << info.spos << " mm Precision: ";
@@ -22,9 +22,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh" // geant4 globals / types
 #include "G4VPhysicalVolume.hh"
+#include "G4VTouchable.hh"
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 BDSPhysicalVolumeInfoRegistry* BDSPhysicalVolumeInfoRegistry::instance = nullptr;
 
@@ -122,6 +124,26 @@ BDSPhysicalVolumeInfo* BDSPhysicalVolumeInfoRegistry::GetInfo(G4VPhysicalVolume*
     }
 }
 
+void BDSPhysicalVolumeInfoRegistry::RegisterMassWorldInfo(const std::set<G4VPhysicalVolume*>& physicalVolumes,
+							  BDSPhysicalVolumeInfo* info)
+{
+  pvInfosForDeletion.insert(info);
+  for (auto pv : physicalVolumes)
+    {massWorldRegister[pv] = info;}
+}
+
+const BDSPhysicalVolumeInfo* BDSPhysicalVolumeInfoRegistry::GetInfo(const G4VTouchable* touchable) const
+{
+  if (!touchable)
+    {return nullptr;}
+  // depth 0 is the current volume and the world is at the history depth
+  G4int depth = touchable->GetHistoryDepth();
+  if (depth < 1)
+    {return nullptr;}
+  auto search = massWorldRegister.find(touchable->GetVolume(depth - 1));
+  return search != massWorldRegister.end() ? search->second : nullptr;
+}
+
 void BDSPhysicalVolumeInfoRegistry::RegisterExcludedPV(G4VPhysicalVolume* physicalVolume)
 {
   excludedVolumes.insert(physicalVolume);
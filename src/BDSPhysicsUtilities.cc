@@ -46,6 +46,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4EmParameters.hh"
 #include "G4EmStandardPhysics_option4.hh"
 #include "G4EmStandardPhysicsSS.hh"
+#if G4VERSION_NUMBER > 1029
+#include "G4FastSimulationPhysics.hh"
+#endif
 #include "G4DynamicParticle.hh"
 #include "G4Gamma.hh"
 #include "G4GenericBiasingPhysics.hh"
@@ -528,6 +531,23 @@ void BDS::BuildMuonBiasing(G4VModularPhysicsList* physicsList)
     }
 }
 
+void BDS::BuildFastVacuumTransport(G4VModularPhysicsList*       physicsList,
+				   const BDSParticleDefinition* beamParticle)
+{
+  if (!BDSGlobalConstants::Instance()->FastVacuumTransport())
+    {return;}
+#if G4VERSION_NUMBER > 1029
+  // ions share the process manager of the generic ion
+  G4String particleName = beamParticle->IsAnIon() ? G4String("GenericIon") : beamParticle->ParticleDefinition()->GetParticleName();
+  G4cout << "Fast vacuum transport for \"" << particleName << "\" primaries" << G4endl;
+  auto fastSimulationPhysics = new G4FastSimulationPhysics();
+  fastSimulationPhysics->ActivateFastSimulation(particleName);
+  physicsList->RegisterPhysics(fastSimulationPhysics);
+#else
+  throw BDSException(__METHOD_NAME__, "fastVacuumTransport is only available with Geant4 10.3 onwards");
+#endif
+}
+
 void BDS::PrintDefinedParticles()
 {
   G4cout << __METHOD_NAME__ << "Defined particles: " << G4endl;
@@ -16,6 +16,8 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
+#include "BDSBatchTransport.hh"
 #include "BDSBunch.hh"
 #include "BDSDebug.hh"
 #include "BDSEventInfo.hh"
@@ -48,6 +50,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ParticleDefinition.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
                                                      const GMAD::Beam& beam,
@@ -59,7 +66,13 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   distrFileMatchLength(beam.distrFileMatchLength),
   ionCached(false),
   oneTurnMap(nullptr),
-  generatorFromFile(nullptr)
+  generatorFromFile(nullptr),
+  screenPrimaries(false),
+  reseedEachEvent(false),
+  screenBatchSize(1),
+  designParticle(nullptr),
+  batchTransport(nullptr),
+  nScreenedSinceLast(0)
 {
   if (!bunchIn)
     {throw BDSException(__METHOD_NAME__, "valid BDSBunch required");}
@@ -83,6 +96,29 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   particleGun->SetParticleTime(0);
   
   generatorFromFile = BDSPrimaryGeneratorFile::ConstructGenerator(beam, bunch, recreate, eventOffset, batchMode);
+
+  // when recreating, each event's seed state is loaded and the primary regenerated so no screening is needed
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  // the event seed is still drawn after the coordinates so the event is the same
+  screenPrimaries = globals->ScreenPrimaries() && !recreate;
+  reseedEachEvent = globals->ScreenPrimaries();
+  if (screenPrimaries)
+    {
+      G4String baseMessage = "option, screenPrimaries cannot be used with ";
+      if (globals->Circular())
+        {throw BDSException(__METHOD_NAME__, baseMessage + "a circular machine.");}
+      if (generatorFromFile)
+        {throw BDSException(__METHOD_NAME__, baseMessage + "events from a file.");}
+      if (bunch->UseCurvilinearTransform())
+        {throw BDSException(__METHOD_NAME__, baseMessage + "a finite S0 in the beam.");}
+      if (bunch->UseBunchTiming())
+        {throw BDSException(__METHOD_NAME__, baseMessage + "bunch timing.");}
+      if (writeASCIISeedState || useASCIISeedState)
+        {throw BDSException(__METHOD_NAME__, baseMessage + "writeSeedState or useASCIISeedState.");}
+      screenBatchSize = globals->ScreenPrimariesBatchSize();
+      if (screenBatchSize < 1)
+        {throw BDSException(__METHOD_NAME__, "screenPrimariesBatchSize must be greater than 0.");}
+    }
 }
 
 BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
@@ -90,6 +126,7 @@ BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
   delete particleGun;
   delete recreateFile;
   delete generatorFromFile;
+  delete batchTransport;
 }
 
 void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
@@ -142,18 +179,43 @@ void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   // coordinates with total energy above the rest mass and may throw an exception if it can't
   BDSParticleCoordsFullGlobal coords;
   
-  // BDSBunch distributions based on files do not (as a principle) have the ability to filter
-  // the particles they load so the number of events to generate can be predicted exactly and
-  // there is no need to check on whether an event has been successfully generated here.
-  try
-    {coords = bunch->GetNextParticleValid();}
-  catch (const BDSException& exception)
-    {// we couldn't safely generate a particle -> abort
-      // could be because of user input file
-      anEvent->SetEventAborted();
-      G4cout << exception.what() << G4endl;
-      G4cout << "Aborting this event (#" << thisEventID << ")" << G4endl;
-      return;
+  if (screenPrimaries)
+    {
+      if (screenedPrimaries.empty() && !FillScreenedPrimaries())
+        {
+          G4cerr << __METHOD_NAME__ << "no primaries found that approach an aperture - ending run." << G4endl;
+          anEvent->SetEventAborted();
+          G4EventManager::GetEventManager()->AbortCurrentEvent();
+          G4RunManager::GetRunManager()->AbortRun();
+          return;
+        }
+      const ScreenedPrimary& next = screenedPrimaries.front();
+      coords = next.coords;
+      // store the seed state from before generation so the event can be recreated. The
+      // random numbers following it generated the next primaries in the batch, so the
+      // event is simulated with its own stream seeded when it was generated instead.
+      eventInfo->SetSeedStateAtStart(next.seedStateBefore);
+      eventInfo->SetNPrimariesScreened(next.nScreenedBefore);
+      CLHEP::HepRandom::setTheSeed(next.eventSeed);
+      screenedPrimaries.pop_front();
+    }
+  else
+    {
+      // BDSBunch distributions based on files do not (as a principle) have the ability to filter
+      // the particles they load so the number of events to generate can be predicted exactly and
+      // there is no need to check on whether an event has been successfully generated here.
+      try
+        {coords = bunch->GetNextParticleValid();}
+      catch (const BDSException& exception)
+        {// we couldn't safely generate a particle -> abort
+          // could be because of user input file
+          anEvent->SetEventAborted();
+          G4cout << exception.what() << G4endl;
+          G4cout << "Aborting this event (#" << thisEventID << ")" << G4endl;
+          return;
+        }
+      if (reseedEachEvent) // recreating an event that was screened
+        {CLHEP::HepRandom::setTheSeed(DrawEventSeed());}
     }
   
   if (oneTurnMap)
@@ -260,3 +322,96 @@ void BDSPrimaryGeneratorAction::GeneratePrimariesFromFile(G4Event* anEvent)
       G4EventManager::GetEventManager()->AbortCurrentEvent();
     }
 }
+
+long BDSPrimaryGeneratorAction::DrawEventSeed()
+{
+  const G4double maxEventSeed = 900000000; // largest seed valid for all the engines
+  return (long)(G4UniformRand() * maxEventSeed);
+}
+
+G4bool BDSPrimaryGeneratorAction::FillScreenedPrimaries()
+{
+  if (!batchTransport)
+    {
+      if (!designParticle)
+        {throw BDSException(__METHOD_NAME__, "no design particle set for screening primaries.");}
+      const BDSBeamline* beamline = BDSAcceleratorModel::Instance()->BeamlineMain();
+      batchTransport = new BDSBatchTransport(beamline,
+                                             designParticle,
+                                             BDSGlobalConstants::Instance()->ScreenPrimariesApertureMargin());
+      G4cout << __METHOD_NAME__ << "screening primaries through the first "
+             << batchTransport->NElementsTransported() << " elements of the beam line" << G4endl;
+      const G4String& opaqueName = batchTransport->FirstOpaqueElementName();
+      if (!opaqueName.empty())
+        {
+          BDS::Warning(__METHOD_NAME__, "element \"" + opaqueName + "\" can't be used for screening - all primaries"
+                       " that reach it will be simulated.");
+        }
+    }
+
+  const BDSParticleDefinition* beamParticle = bunch->ParticleDefinition();
+  G4double mass = beamParticle->Mass();
+  G4double designCharge = designParticle->Charge();
+  G4double chargeRatio = BDS::IsFinite(designCharge) ? beamParticle->Charge() / designCharge : 0;
+  G4double designMomentum = designParticle->Momentum();
+
+  std::vector<G4String> seedStatesBefore(screenBatchSize);
+  std::vector<long>     eventSeeds(screenBatchSize);
+  std::vector<BDSParticleCoordsFullGlobal> allCoords(screenBatchSize);
+  BDSBatchTransport::Batch batch;
+
+  // a beam with no particles near an aperture would otherwise never finish
+  const G4int maxBatchesWithoutCandidate = 1000;
+  for (G4int iBatch = 0; iBatch < maxBatchesWithoutCandidate; iBatch++)
+    {
+      batch.Resize((std::size_t)screenBatchSize);
+      std::size_t n = 0;
+      for (G4int i = 0; i < screenBatchSize; i++)
+        {
+          seedStatesBefore[n] = BDSRandom::GetSeedState();
+          try
+            {allCoords[n] = bunch->GetNextParticleValid();}
+          catch (const BDSException& exception)
+            {
+              G4cout << exception.what() << G4endl;
+              break;
+            }
+          // draw the seed for the event straight after its coordinates so recreating
+          // from the seed state before gives the same seed
+          eventSeeds[n] = DrawEventSeed();
+          const BDSParticleCoordsFull& local = allCoords[n].local;
+          G4double momentum = std::sqrt(std::max(0.0, local.totalEnergy*local.totalEnergy - mass*mass));
+          batch.x[n]  = local.x;
+          batch.xp[n] = local.xp;
+          batch.y[n]  = local.y;
+          batch.yp[n] = local.yp;
+          batch.qOverP[n] = momentum > 0 ? chargeRatio * designMomentum / momentum : 0;
+          n++;
+        }
+      if (n == 0)
+        {return false;} // can't generate any more particles
+      batch.Resize(n);
+      batchTransport->Transport(batch);
+
+      for (std::size_t i = 0; i < n; i++)
+        {
+          const BDSParticleCoordsFull& local = allCoords[i].local;
+          // anything not starting at the beginning of the beam line or going backwards or
+          // a neutral particle isn't screened
+          G4bool simulate = batch.reachedAperture[i] || BDS::IsFinite(local.z)
+            || local.zp <= 0 || !BDS::IsFinite(batch.qOverP[i]);
+          if (simulate)
+            {
+              screenedPrimaries.push_back({seedStatesBefore[i], eventSeeds[i], allCoords[i], nScreenedSinceLast});
+              nScreenedSinceLast = 0;
+            }
+          else
+            {nScreenedSinceLast++;}
+        }
+      if (!screenedPrimaries.empty())
+        {return true;}
+      if (n < (std::size_t)screenBatchSize)
+        {return false;} // generation stopped early
+    }
+  return false;
+}
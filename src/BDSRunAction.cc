@@ -27,6 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSException.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSOutput.hh"
+#include "BDSOutputEventQueue.hh"
 #include "BDSParser.hh"
 #include "BDSRunAction.hh"
 #include "BDSSamplerPlacementRecord.hh"
@@ -70,7 +71,8 @@ BDSRunAction::BDSRunAction(BDSOutput*      outputIn,
   cpuStartTime(std::clock_t()),
   eventAction(eventActionIn),
   trajectorySamplerID(trajectorySamplerIDIn),
-  nEventsRequested(0)
+  nEventsRequested(0),
+  outputQueue(nullptr)
 {;}
 
 BDSRunAction::~BDSRunAction()
@@ -80,16 +82,39 @@ BDSRunAction::~BDSRunAction()
 
 void BDSRunAction::BeginOfRunAction(const G4Run* aRun)
 {
-  if (BDSGlobalConstants::Instance()->PrintPhysicsProcesses())
-    {PrintAllProcessesForAllParticles();}
-
   BDSAuxiliaryNavigator::ResetNavigatorStates();
   
   // Bunch generator beginning of run action (optional mean subtraction).
   bunchGenerator->BeginOfRunAction(aRun->GetNumberOfEventToBeProcessed(), BDSGlobalConstants::Instance()->Batch());
   nEventsRequested = aRun->GetNumberOfEventToBeProcessed();
 
-  SetTrajectorySamplerIDs();
+  if (eventAction) // no event action on the master of a multi-threaded run
+    {SetTrajectorySamplerIDs();}
+
+  // only the master writes the output - in a sequential run this is the only thread
+  if (IsMaster())
+    {
+      BeginOfRunOutput(aRun);
+      if (outputQueue) // workers' events are written by the queue's thread
+        {outputQueue->Start();}
+    }
+
+#if G4VERSION_NUMBER > 1049
+  // this apparently has to be done in the run action and doesn't work if done earlier
+  // the processes are per thread so this is done on every thread
+  BDS::FixGeant105ThreshholdsForBeamParticle(bunchGenerator->ParticleDefinition());
+  BDS::FixGeant105ThreshholdsForParticle(G4Positron::Definition());
+  BDS::FixGeant105ThreshholdsForParticle(G4Electron::Definition());
+#endif
+
+  cpuStartTime = std::clock();
+}
+
+void BDSRunAction::BeginOfRunOutput(const G4Run* aRun)
+{
+  if (BDSGlobalConstants::Instance()->PrintPhysicsProcesses())
+    {PrintAllProcessesForAllParticles();}
+  
   CheckTrajectoryOptions();
   
   info = new BDSEventInfo();
@@ -124,19 +149,21 @@ void BDSRunAction::BeginOfRunAction(const G4Run* aRun)
 
   // Write out geant4 data including particle tables.
   output->FillParticleData(usingIons);
-
-#if G4VERSION_NUMBER > 1049
-  // this apparently has to be done in the run action and doesn't work if done earlier
-  BDS::FixGeant105ThreshholdsForBeamParticle(bunchGenerator->ParticleDefinition());
-  BDS::FixGeant105ThreshholdsForParticle(G4Positron::Definition());
-  BDS::FixGeant105ThreshholdsForParticle(G4Electron::Definition());
-#endif
-
-  cpuStartTime = std::clock();
 }
 
 void BDSRunAction::EndOfRunAction(const G4Run* aRun)
 {
+  if (!IsMaster())
+    {// worker in a multi-threaded run - the master writes the run information
+      if (eventAction)
+        {eventAction->ReleaseWrittenRecords(true);}
+      return;
+    }
+  
+  // all workers have finished so write any remaining events before the run information
+  if (outputQueue)
+    {outputQueue->Finish();}
+  
   // Get the current time
   time_t stoptime = time(nullptr);
   info->SetStopTime(stoptime);
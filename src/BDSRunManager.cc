@@ -105,7 +105,9 @@ void BDSRunManager::ProcessOneEvent(G4int i_event)
     {return;}
   eventManager->ProcessOneEvent(currentEvent);
   AnalyzeEvent(currentEvent);
-  UpdateScoring();
+  // No UpdateScoring() here. BDSIM fills its own histograms from the scoring mesh hits
+  // collections and G4ScoringManager::Accumulate assumes each is a G4THitsMap<G4double>,
+  // which isn't so for the BDSIM primitive scorers.
   if (i_event < n_select_msg)
     {G4UImanager::GetUIpointer()->ApplyCommand(msgText);}
 }
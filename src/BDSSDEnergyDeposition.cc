@@ -40,19 +40,41 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4VTouchable.hh"
 #include "Randomize.hh"
 
+#include <cmath>
+
 
 BDSSDEnergyDeposition::BDSSDEnergyDeposition(const G4String& name,
                                              G4bool          storeExtrasIn,
-                                             G4bool          killedParticleMassAddedToElossIn):
+                                             G4bool          killedParticleMassAddedToElossIn,
+                                             G4bool          storeBinnedIn,
+                                             G4bool          storeStepsIn):
   BDSSensitiveDetector("energy_counter/"+name),
   storeExtras(storeExtrasIn),
   killedParticleMassAddedToEloss(killedParticleMassAddedToElossIn),
   colName(name),
   hits(nullptr),
   HCIDe(-1),
+  storeBinned(storeBinnedIn),
+  storeSteps(storeStepsIn || !storeBinnedIn),
+  binTurn(false),
+  binParticleClass(false),
+  binWidth(1),
+  binOrigin(0),
+  colNameBinned(name + "_binned"),
+  binnedHits(nullptr),
+  HCIDBinned(-1),
   auxNavigator(new BDSAuxiliaryNavigator())
 {
   collectionName.insert(colName);
+  if (storeBinned)
+    {
+      collectionName.insert(colNameBinned);
+      const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+      binTurn          = globals->StoreELossTurn();
+      binParticleClass = globals->StoreELossBinnedParticleClass();
+      binWidth         = globals->ELossHistoBinWidth();
+      binOrigin        = globals->BeamlineS(); // same bins as the energy deposition histograms
+    }
 }
 
 BDSSDEnergyDeposition::~BDSSDEnergyDeposition()
@@ -66,6 +88,15 @@ void BDSSDEnergyDeposition::Initialize(G4HCofThisEvent* HCE)
   if (HCIDe < 0)
     {HCIDe = G4SDManager::GetSDMpointer()->GetCollectionID(hits);}
   HCE->AddHitsCollection(HCIDe,hits);
+
+  if (storeBinned)
+    {
+      binnedHits = new BDSHitsCollectionEnergyDepositionBinned(GetName(), colNameBinned);
+      if (HCIDBinned < 0)
+        {HCIDBinned = G4SDManager::GetSDMpointer()->GetCollectionID(binnedHits);}
+      HCE->AddHitsCollection(HCIDBinned, binnedHits);
+      binnedHitsMap.clear(); // hits owned by the last event's collection
+    }
   
 #ifdef BDSDEBUG
   G4cout << __METHOD_NAME__ << "Hits Collection ID: " << HCIDe << G4endl;
@@ -101,39 +132,19 @@ G4bool BDSSDEnergyDeposition::ProcessHits(G4Step* aStep,
   const G4ThreeVector& posafter  = postStepPoint->GetPosition();
   G4ThreeVector eDepPos   = posbefore + randDist*(posafter - posbefore);
 
-  // calculate local coordinates
-  BDSStep stepLocal = auxNavigator->ConvertToLocal(aStep);
-  const G4ThreeVector& posbeforelocal = stepLocal.PreStepPoint();
-  const G4ThreeVector& posafterlocal  = stepLocal.PostStepPoint();
-  G4ThreeVector eDepPosLocal = posbeforelocal + randDist*(posafterlocal - posbeforelocal);
-  G4double stepLength = (posafterlocal - posbeforelocal).mag();
-  
-  // global
-  G4double X = eDepPos.x();
-  G4double Y = eDepPos.y();
-  G4double Z = eDepPos.z();
-  // local
-  G4double x = eDepPosLocal.x();
-  G4double y = eDepPosLocal.y();
-  G4double z = eDepPosLocal.z();
-
-  // Just as the energy deposition is attributed to a uniformly random
-  // point between the preStep and the postStep positions, attribute the
-  // deposition to random time between preStep and postStep times,
-  // using the same random number as for the position.
-  G4double preGlobalTime  = preStepPoint->GetGlobalTime();
-  G4double postGlobalTime = postStepPoint->GetGlobalTime();
-  G4double globalTime = preGlobalTime + randDist * (postGlobalTime - preGlobalTime);
-
-  // get the s coordinate (central s + local z)
-  // volume is from curvilinear coordinate parallel geometry
-  BDSPhysicalVolumeInfo* theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal.VolumeForTransform());
+  // get the s coordinate (central s + local z) and local coordinates from the precomputed
+  // curvilinear frame of the beam line element the step is in, otherwise from the volume
+  // in the curvilinear coordinate parallel geometry
+  BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  const BDSPhysicalVolumeInfo* theInfo = registry->GetInfo(preStepPoint->GetTouchable());
+  G4ThreeVector posbeforelocal;
+  G4ThreeVector posafterlocal;
   G4int beamlineIndex = -1;
   
   // declare lambda for updating parameters if info found (avoid duplication of code)
   G4double sBefore = -1000;
   G4double sAfter  = -1000;
-  auto UpdateParams = [&](BDSPhysicalVolumeInfo* info)
+  auto UpdateParams = [&](const BDSPhysicalVolumeInfo* info)
     {
       G4double sCentre = info->GetSPos();
       sAfter           = sCentre + posafterlocal.z();
@@ -142,46 +153,84 @@ G4bool BDSSDEnergyDeposition::ProcessHits(G4Step* aStep,
     };
   
   if (theInfo)
-    {UpdateParams(theInfo);}
+    {
+      posbeforelocal = theInfo->GlobalToCurvilinear(posbefore);
+      posafterlocal  = theInfo->GlobalToCurvilinear(posafter);
+      UpdateParams(theInfo);
+    }
   else
     {
-      // Try again but with the pre step point only
-      G4ThreeVector unitDirection = (posafter - posbefore).unit();
-      BDSStep stepLocal2 = auxNavigator->ConvertToLocal(posbefore, unitDirection);
-      theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+      BDSStep stepLocal = auxNavigator->ConvertToLocal(aStep);
+      posbeforelocal = stepLocal.PreStepPoint();
+      posafterlocal  = stepLocal.PostStepPoint();
+      theInfo = registry->GetInfo(stepLocal.VolumeForTransform());
       if (theInfo)
         {UpdateParams(theInfo);}
       else
         {
-          // Try yet again with just a slight shift (100um is bigger than any padding space).
-          G4ThreeVector shiftedPos = posbefore + 0.1*CLHEP::mm*unitDirection;
-          stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, unitDirection);
-          theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+          // Try again but with the pre step point only
+          G4ThreeVector unitDirection = (posafter - posbefore).unit();
+          BDSStep stepLocal2 = auxNavigator->ConvertToLocal(posbefore, unitDirection);
+          theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
           if (theInfo)
             {UpdateParams(theInfo);}
           else
             {
-#ifdef BDSDEBUG
-              G4cerr << "No volume info for ";
-              auto vol = stepLocal.VolumeForTransform();
-              if (vol)
-                {G4cerr << vol->GetName() << G4endl;}
+              // Try yet again with just a slight shift (100um is bigger than any padding space).
+              G4ThreeVector shiftedPos = posbefore + 0.1*CLHEP::mm*unitDirection;
+              stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, unitDirection);
+              theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
+              if (theInfo)
+                {UpdateParams(theInfo);}
               else
-                {G4cerr << "Unknown" << G4endl;}
+                {
+#ifdef BDSDEBUG
+                  G4cerr << "No volume info for ";
+                  auto vol = stepLocal.VolumeForTransform();
+                  if (vol)
+                    {G4cerr << vol->GetName() << G4endl;}
+                  else
+                    {G4cerr << "Unknown" << G4endl;}
 #endif
-              // unphysical default value to allow easy identification in output
-              sAfter        = -1000;
-              sBefore       = -1000;
-              beamlineIndex = -2;
+                  // unphysical default value to allow easy identification in output
+                  sAfter        = -1000;
+                  sBefore       = -1000;
+                  beamlineIndex = -2;
+                }
             }
         }
     }
   
+  G4ThreeVector eDepPosLocal = posbeforelocal + randDist*(posafterlocal - posbeforelocal);
+  G4double stepLength = (posafterlocal - posbeforelocal).mag();
+  
+  // global
+  G4double X = eDepPos.x();
+  G4double Y = eDepPos.y();
+  G4double Z = eDepPos.z();
+  // local
+  G4double x = eDepPosLocal.x();
+  G4double y = eDepPosLocal.y();
+  G4double z = eDepPosLocal.z();
+
+  // Just as the energy deposition is attributed to a uniformly random
+  // point between the preStep and the postStep positions, attribute the
+  // deposition to random time between preStep and postStep times,
+  // using the same random number as for the position.
+  G4double preGlobalTime  = preStepPoint->GetGlobalTime();
+  G4double postGlobalTime = postStepPoint->GetGlobalTime();
+  G4double globalTime = preGlobalTime + randDist * (postGlobalTime - preGlobalTime);
+
   G4double sHit = sBefore + randDist*(sAfter - sBefore);
 
   G4double weight      = track->GetWeight();
   G4int    trackID     = track->GetTrackID();
   G4int    turnsTaken  = BDSGlobalConstants::Instance()->TurnsTaken();
+
+  if (storeBinned)
+    {AddToBin(weight * energy, sHit, beamlineIndex, turnsTaken, ptype);}
+  if (!storeSteps)
+    {return true;}
   
   G4int postStepProcessType    = -1;
   G4int postStepProcessSubType = -1;
@@ -244,24 +293,18 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
   G4double Y = posGlobal.y();
   G4double Z = posGlobal.z();
 
-  // calculate local coordinates
-  const G4ThreeVector& momGlobalUnit = track->GetMomentumDirection();
-  BDSStep stepLocal = auxNavigator->ConvertToLocal(posGlobal, momGlobalUnit, 1*CLHEP::mm, true, 1*CLHEP::mm);
-  G4ThreeVector posLocal = stepLocal.PreStepPoint();
-  // local
-  G4double x = posLocal.x();
-  G4double y = posLocal.y();
-  G4double z = posLocal.z();
-  
-  // get the s coordinate (central s + local z)
-  // volume is from curvilinear coordinate parallel geometry
-  BDSPhysicalVolumeInfo* theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal.VolumeForTransform());
+  // get the s coordinate (central s + local z) and local coordinates from the precomputed
+  // curvilinear frame of the beam line element the track is in, otherwise from the volume
+  // in the curvilinear coordinate parallel geometry
+  BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  const BDSPhysicalVolumeInfo* theInfo = registry->GetInfo(track->GetTouchable());
+  G4ThreeVector posLocal;
   G4int beamlineIndex = -1;
   
   // declare lambda for updating parameters if info found (avoid duplication of code)
   G4double sBefore = -1000;
   G4double sAfter  = -1000;
-  auto UpdateParams = [&](BDSPhysicalVolumeInfo* info)
+  auto UpdateParams = [&](const BDSPhysicalVolumeInfo* info)
     {
       G4double sCentre = info->GetSPos();
       sAfter           = sCentre + posLocal.z();
@@ -270,35 +313,57 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
     };
   
   if (theInfo)
-    {UpdateParams(theInfo);}
+    {
+      posLocal = theInfo->GlobalToCurvilinear(posGlobal);
+      UpdateParams(theInfo);
+    }
   else
     {
-      // Try yet again with just a slight shift (100um is bigger than any padding space).
-      G4ThreeVector shiftedPos = posGlobal + 0.1*CLHEP::mm * momGlobalUnit;
-      BDSStep stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, momGlobalUnit);
-      theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+      const G4ThreeVector& momGlobalUnit = track->GetMomentumDirection();
+      BDSStep stepLocal = auxNavigator->ConvertToLocal(posGlobal, momGlobalUnit, 1*CLHEP::mm, true, 1*CLHEP::mm);
+      posLocal = stepLocal.PreStepPoint();
+      theInfo  = registry->GetInfo(stepLocal.VolumeForTransform());
       if (theInfo)
         {UpdateParams(theInfo);}
       else
         {
-#ifdef BDSDEBUG
-          G4cerr << "No volume info for ";
-          auto vol = stepLocal.VolumeForTransform();
-          if (vol)
-            {G4cerr << vol->GetName() << G4endl;}
+          // Try yet again with just a slight shift (100um is bigger than any padding space).
+          G4ThreeVector shiftedPos = posGlobal + 0.1*CLHEP::mm * momGlobalUnit;
+          BDSStep stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, momGlobalUnit);
+          theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
+          if (theInfo)
+            {UpdateParams(theInfo);}
           else
-            {G4cerr << "Unknown" << G4endl;}
+            {
+#ifdef BDSDEBUG
+              G4cerr << "No volume info for ";
+              auto vol = stepLocal.VolumeForTransform();
+              if (vol)
+                {G4cerr << vol->GetName() << G4endl;}
+              else
+                {G4cerr << "Unknown" << G4endl;}
 #endif
-          // unphysical default value to allow easy identification in output
-          sAfter        = -1000;
-          sBefore       = -1000;
-          beamlineIndex = -2;
+              // unphysical default value to allow easy identification in output
+              sAfter        = -1000;
+              sBefore       = -1000;
+              beamlineIndex = -2;
+            }
         }
     }
   G4double sHit = sBefore; // duplicate
+  
+  // local
+  G4double x = posLocal.x();
+  G4double y = posLocal.y();
+  G4double z = posLocal.z();
 
   G4int turnsTaken = BDSGlobalConstants::Instance()->TurnsTaken();
 
+  if (storeBinned)
+    {AddToBin(weight * energy, sHit, beamlineIndex, turnsTaken, ptype);}
+  if (!storeSteps)
+    {return true;}
+
   G4int postStepProcessType    = -1;
   G4int postStepProcessSubType = -1;
   if (storeExtras)
@@ -340,8 +405,33 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
   return true;
 }
 
+void BDSSDEnergyDeposition::AddToBin(G4double energyWeighted,
+                                     G4double sHit,
+                                     G4int    beamlineIndex,
+                                     G4int    turnsTaken,
+                                     G4int    pdgID)
+{
+  BinKey key = {(G4int)std::floor((sHit - binOrigin) / binWidth),
+                beamlineIndex,
+                binTurn ? turnsTaken : -1,
+                binParticleClass ? BDSHitEnergyDepositionBinned::ParticleClass(pdgID) : -1};
+  auto search = binnedHitsMap.find(key);
+  BDSHitEnergyDepositionBinned* hit = nullptr;
+  if (search == binnedHitsMap.end())
+    {
+      hit = new BDSHitEnergyDepositionBinned(key.sBin, key.beamlineIndex, key.turn, key.particleClass);
+      binnedHits->insert(hit);
+      binnedHitsMap.emplace(key, hit);
+    }
+  else
+    {hit = search->second;}
+  hit->Add(energyWeighted);
+}
+
 G4VHit* BDSSDEnergyDeposition::last() const
 {
+  if (hits->GetVector()->empty())
+    {return nullptr;}
   BDSHitEnergyDeposition* lastHit = hits->GetVector()->back();
   return dynamic_cast<G4VHit*>(lastHit);
 }
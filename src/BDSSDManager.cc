@@ -53,7 +53,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class BDSLinkRegistry;
 
-BDSSDManager* BDSSDManager::instance = nullptr;
+G4ThreadLocal BDSSDManager* BDSSDManager::instance = nullptr;
 
 BDSSDManager* BDSSDManager::Instance()
 {
@@ -83,7 +83,13 @@ BDSSDManager::BDSSDManager()
   storeApertureImpactsAll  = g->StoreApertureImpactsAll();
   storeApertureImpactsIons = g->StoreApertureImpactsIons();
   apertureImpactsMinimumKE = g->ApertureImpactsMinimumKE();
-  generateELossHits        = g->StoreELoss() || g->StoreELossHistograms();
+  generateELossHits        = g->StoreELoss() || g->StoreELossHistograms() || g->StoreELossBinned();
+  generateELossBinnedHits  = g->StoreELossBinned();
+  // with binned energy deposition, a hit per step is only needed for what uses each deposit
+  generateELossStepHits    = !generateELossBinnedHits
+    || g->StoreELoss()
+    || g->UseScoringMap()
+    || !g->StoreTrajectoryELossSRange().empty();
   generateELossVacuumHits  = g->StoreELossVacuum() || g->StoreELossVacuumHistograms();
   generateELossTunnelHits  = g->StoreELossTunnel() || g->StoreELossTunnelHistograms();
 
@@ -153,10 +159,13 @@ BDSSDManager::BDSSDManager()
   terminator = new BDSSDTerminator("terminator");
   SDMan->AddNewDetector(terminator);
 
-  energyDeposition = new BDSSDEnergyDeposition("general", storeELossExtras, killedParticleMassAddedToEloss);
+  energyDeposition = new BDSSDEnergyDeposition("general", storeELossExtras, killedParticleMassAddedToEloss,
+                                               generateELossBinnedHits, generateELossStepHits);
   SDMan->AddNewDetector(energyDeposition);
 
-  energyDepositionFull = new BDSSDEnergyDeposition("general_full", true, killedParticleMassAddedToEloss);
+  // the collimator hits always need a hit for each step from this one
+  energyDepositionFull = new BDSSDEnergyDeposition("general_full", true, killedParticleMassAddedToEloss,
+                                                   generateELossBinnedHits, true);
   SDMan->AddNewDetector(energyDepositionFull);
   
   energyDepositionVacuum = new BDSSDEnergyDeposition("vacuum", storeELossExtras, killedParticleMassAddedToEloss);
@@ -244,6 +253,7 @@ BDSSDManager::BDSSDManager()
   wireCompleteSD = new BDSMultiSensitiveDetectorOrdered("wire_complete");
   wireCompleteSD->AddSD(energyDepositionFull);
   wireCompleteSD->AddSD(thinThingSD);
+  SDMan->AddNewDetector(wireCompleteSD); // so it can be found by name on worker threads
 }
 
 G4VSensitiveDetector* BDSSDManager::SensitiveDetector(const BDSSDType sdType,
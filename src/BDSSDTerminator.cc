@@ -27,7 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iomanip>
 
-G4int BDSSDTerminator::eventNumber = 0;
+G4ThreadLocal G4int BDSSDTerminator::eventNumber = 0;
 
 
 BDSSDTerminator::BDSSDTerminator(G4String name)
@@ -0,0 +1,88 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSScorerHitsMap.hh"
+
+#include "globals.hh" // geant4 types / globals
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4VHitsCollection.hh"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+BDSScorerHitsMap::Buffer::Buffer(G4int sizeIn):
+  values((std::size_t)std::max(sizeIn, 0), 0),
+  touched((std::size_t)std::max(sizeIn, 0), 0),
+  inUse(false)
+{;}
+
+void BDSScorerHitsMap::Buffer::Clear()
+{
+  for (auto index : indices)
+    {
+      values[index]  = 0;
+      touched[index] = 0;
+    }
+  indices.clear();
+}
+
+BDSScorerHitsMap::Buffer* BDSScorerHitsMap::FreeBuffer(std::vector<std::unique_ptr<Buffer> >& buffers,
+                                                       G4int sizeIn)
+{
+  for (auto& buffer : buffers)
+    {
+      if (!buffer->inUse)
+        {
+          buffer->Clear();
+          return buffer.get();
+        }
+    }
+  buffers.emplace_back(new Buffer(sizeIn));
+  return buffers.back().get();
+}
+
+BDSScorerHitsMap::BDSScorerHitsMap(const G4String& detectorName,
+                                   const G4String& collectionName,
+                                   Buffer*         bufferIn):
+  G4VHitsCollection(detectorName, collectionName),
+  buffer(bufferIn)
+{
+  buffer->inUse = true;
+}
+
+BDSScorerHitsMap::~BDSScorerHitsMap()
+{
+  buffer->inUse = false;
+}
+
+void BDSScorerHitsMap::Enlarge(G4int index)
+{
+  std::size_t newSize = std::max((std::size_t)index + 1, 2 * buffer->values.size());
+  buffer->values.resize(newSize, 0);
+  buffer->touched.resize(newSize, 0);
+}
+
+void BDSScorerHitsMap::PrintAllHits()
+{
+  G4cout << "BDSScorerHitsMap " << SDname << " / " << collectionName << " --- "
+         << buffer->indices.size() << " entries" << G4endl;
+  for (auto index : buffer->indices)
+    {G4cout << "  index " << index << " : " << buffer->values[index] << G4endl;}
+}
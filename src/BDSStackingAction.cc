@@ -39,7 +39,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4MultiSensitiveDetector.hh"
 #endif
 
-G4double BDSStackingAction::energyKilled = 0;
+G4ThreadLocal G4double BDSStackingAction::energyKilled = 0;
 
 BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals)
 {
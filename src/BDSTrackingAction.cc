@@ -27,6 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSUtilities.hh"
 
 #include "globals.hh" // geant4 types / globals
+#include "G4ParticleDefinition.hh"
 #include "G4TrackingManager.hh"
 #include "G4Track.hh"
 #include "G4VPhysicalVolume.hh"
@@ -47,6 +48,7 @@ BDSTrackingAction::BDSTrackingAction(G4bool batchMode,
   storeTrajectory(storeTrajectoryIn),
   storeTrajectoryOptions(storeTrajectoryOptionsIn),
   eventAction(eventActionIn),
+  trackDepthsEventIndex(-1),
   verboseSteppingEventStart(verboseSteppingEventStartIn),
   verboseSteppingEventStop(verboseSteppingEventStopIn),
   verboseSteppingPrimaryOnly(verboseSteppingPrimaryOnlyIn),
@@ -66,17 +68,55 @@ void BDSTrackingAction::PreUserTrackingAction(const G4Track* track)
   else if (!primaryParticle && verboseSteppingThisEvent && !verboseSteppingPrimaryOnly)
     {fpTrackingManager->GetSteppingManager()->SetVerboseLevel(verboseSteppingLevel);}
   
+  G4int depth = 0;
+  if (storeTrajectory || interactive)
+    {
+      if (eventIndex != trackDepthsEventIndex)
+	{
+	  trackDepths.clear();
+	  trackDepthsEventIndex = eventIndex;
+	}
+      if (!primaryParticle)
+	{
+	  auto search = trackDepths.find(track->GetParentID());
+	  depth = search != trackDepths.end() ? search->second + 1 : 1;
+	}
+      trackDepths[track->GetTrackID()] = depth;
+    }
+  
   if (!primaryParticle)
     {// ie secondary particle
       // only store if we want to or interactive
-      if (storeTrajectory || interactive)
+      if (interactive)
 	{
 	  auto traj = new BDSTrajectory(track,
 					interactive,
 					storeTrajectoryOptions);
+	  traj->SetDepth(depth);
 	  fpTrackingManager->SetStoreTrajectory(1);
 	  fpTrackingManager->SetTrajectory(traj);
 	}
+      else if (storeTrajectory)
+	{
+	  auto startFilters = eventAction->TrajectoryStartFilters(false,
+								  track->GetKineticEnergy(),
+								  track->GetDefinition()->GetParticleName(),
+								  track->GetDefinition()->GetPDGEncoding(),
+								  depth);
+	  G4bool mayBeStored = eventAction->TrajectoryMayBeStored(startFilters);
+	  if (mayBeStored || eventAction->TrajectoryConnect())
+	    {// a skeleton only keeps the points required to connect its secondaries to it
+	      auto traj = new BDSTrajectory(track,
+					    interactive,
+					    storeTrajectoryOptions,
+					    !mayBeStored);
+	      traj->SetDepth(depth);
+	      fpTrackingManager->SetStoreTrajectory(1);
+	      fpTrackingManager->SetTrajectory(traj);
+	    }
+	  else // it would be discarded at the end of the event
+	    {fpTrackingManager->SetStoreTrajectory(0);}
+	}
       else // mark as don't store
 	{fpTrackingManager->SetStoreTrajectory(0);}
     }
@@ -90,6 +130,7 @@ void BDSTrackingAction::PreUserTrackingAction(const G4Track* track)
 					   interactive,
 					   storeTrajectoryOptions,
 					   storePoints);
+      traj->SetDepth(0);
       eventAction->RegisterPrimaryTrajectory(traj);
       fpTrackingManager->SetStoreTrajectory(1);
       fpTrackingManager->SetTrajectory(traj);
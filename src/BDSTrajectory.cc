@@ -30,11 +30,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <ostream>
 
-G4Allocator<BDSTrajectory> bdsTrajectoryAllocator;
+G4ThreadLocal G4Allocator<BDSTrajectory> bdsTrajectoryAllocator;
 
 BDSTrajectory::BDSTrajectory(const G4Track* aTrack,
                              G4bool         interactiveIn,
-                             const BDS::TrajectoryOptions& storageOptionsIn):
+                             const BDS::TrajectoryOptions& storageOptionsIn,
+                             G4bool         skeletonIn):
   G4Trajectory(aTrack),
   interactive(interactiveIn),
   storageOptions(storageOptionsIn),
@@ -42,7 +43,8 @@ BDSTrajectory::BDSTrajectory(const G4Track* aTrack,
   trajIndex(0),
   parentIndex(0),
   parentStepIndex(0),
-  depth(-1)
+  depth(-1),
+  skeleton(skeletonIn)
 {
   suppressTransportationAndNotInteractive = storageOptionsIn.suppressTransportationSteps && !interactiveIn;
   const G4VProcess* proc = aTrack->GetCreatorProcess();
@@ -120,7 +122,23 @@ void BDSTrajectory::AppendStep(const G4Step* aStep)
   // the material
   if (fpBDSPointsContainer->size() == 1)
     {(*fpBDSPointsContainer)[0]->SetMaterial(aStep->GetTrack()->GetMaterial());}
-  if (suppressTransportationAndNotInteractive)
+  
+  if (skeleton)
+    {
+      // a secondary is connected to the point of this trajectory at which it was created
+      // so only those and the end point are required
+      const auto secondaries = aStep->GetSecondaryInCurrentStep();
+      G4bool createdSecondaries = secondaries && !secondaries->empty();
+      G4bool lastStep = aStep->GetTrack()->GetTrackStatus() != fAlive;
+      if (createdSecondaries || lastStep)
+        {
+          fpBDSPointsContainer->push_back(new BDSTrajectoryPoint(aStep,
+                                                                 storageOptions.storeLocal,
+                                                                 storageOptions.storeLinks,
+                                                                 storageOptions.storeIon));
+        }
+    }
+  else if (suppressTransportationAndNotInteractive)
     {
       // note for a first step of a track, the prestep point process
       // may be nullptr, but if we're appending a step we really care
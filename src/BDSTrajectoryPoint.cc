@@ -46,12 +46,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class G4Material;
 
-G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
+G4ThreadLocal G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
 
 G4double BDSTrajectoryPoint::dEThresholdForScattering = 1e-8;
 
-// Don't use transform caching in the aux navigator as it's used for all over the geometry here.
-BDSAuxiliaryNavigator* BDSTrajectoryPoint::auxNavigator = new BDSAuxiliaryNavigator();
+// Constructed on first use in each thread.
+G4ThreadLocal BDSAuxiliaryNavigator* BDSTrajectoryPoint::auxNavigator = nullptr;
 
 BDSTrajectoryPoint::BDSTrajectoryPoint():
   G4TrajectoryPoint(G4ThreeVector())
@@ -96,6 +96,8 @@ BDSTrajectoryPoint::BDSTrajectoryPoint(const G4Track* track,
   
   // s position for pre and post step point
   // with a track, we're at the start and have no step - use 1nm for step to aid geometrical lookup
+  if (!auxNavigator)
+    {auxNavigator = new BDSAuxiliaryNavigator();}
   BDSStep localPosition = auxNavigator->ConvertToLocal(track->GetPosition(),
 						       track->GetMomentumDirection(),
 						       1*CLHEP::nm,
@@ -162,6 +164,8 @@ BDSTrajectoryPoint::BDSTrajectoryPoint(const G4Step* step,
 #endif
   
   // get local coordinates and volume for transform
+  if (!auxNavigator)
+    {auxNavigator = new BDSAuxiliaryNavigator();}
   BDSStep localPosition = auxNavigator->ConvertToLocal(step);
   prePosLocal = localPosition.PreStepPoint();
   postPosLocal = localPosition.PostStepPoint();
@@ -20,7 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Allocator.hh"
 
-G4Allocator<BDSTrajectoryPointIon> BDSAllocatorTrajectoryPointIon;
+G4ThreadLocal G4Allocator<BDSTrajectoryPointIon> BDSAllocatorTrajectoryPointIon;
 
 BDSTrajectoryPointIon::BDSTrajectoryPointIon(G4bool isIonIn,
 					     G4int  ionAIn,
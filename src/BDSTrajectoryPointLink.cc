@@ -20,7 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Allocator.hh"
 
-G4Allocator<BDSTrajectoryPointLink> BDSAllocatorTrajectoryPointLink;
+G4ThreadLocal G4Allocator<BDSTrajectoryPointLink> BDSAllocatorTrajectoryPointLink;
 
 BDSTrajectoryPointLink::BDSTrajectoryPointLink(G4int    chargeIn,
 					       G4int    turnsTakenIn,
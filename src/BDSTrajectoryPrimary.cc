@@ -30,8 +30,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <ostream>
 #include <set>
 
-G4Allocator<BDSTrajectoryPrimary> bdsTrajectoryPrimaryAllocator;
-G4bool BDSTrajectoryPrimary::hasScatteredThisTurn = false;
+G4ThreadLocal G4Allocator<BDSTrajectoryPrimary> bdsTrajectoryPrimaryAllocator;
+G4ThreadLocal G4bool BDSTrajectoryPrimary::hasScatteredThisTurn = false;
 
 BDSTrajectoryPrimary::BDSTrajectoryPrimary(const G4Track* aTrack,
 					   G4bool         interactiveIn,
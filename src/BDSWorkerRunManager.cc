@@ -0,0 +1,35 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSWorkerRunManager.hh"
+
+#ifdef G4MULTITHREADED
+#include "BDSOutputEventQueue.hh"
+
+BDSWorkerRunManager::BDSWorkerRunManager(BDSOutputEventQueue* outputQueueIn):
+  outputQueue(outputQueueIn)
+{;}
+
+void BDSWorkerRunManager::AbortRun(G4bool softAbort)
+{
+  if (outputQueue)
+    {outputQueue->Abandon();}
+  G4WorkerRunManager::AbortRun(softAbort);
+}
+
+#endif
@@ -29,7 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <limits>
 #include <vector>
 
-G4int BDSWrapperMuonSplitting::nCallsThisEvent = 0;
+G4ThreadLocal G4int BDSWrapperMuonSplitting::nCallsThisEvent = 0;
 
 BDSWrapperMuonSplitting::BDSWrapperMuonSplitting(G4VProcess* originalProcess,
                                                  G4int splittingFactorIn,
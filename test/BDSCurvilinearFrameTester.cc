@@ -0,0 +1,114 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Check the curvilinear element matched to each element of a beam line, whose index and
+ * frame are registered for the energy deposition (BDSDetectorConstruction::RegisterCurvilinearFrames),
+ * is the one built from it for both a circular and a linear beam line of tilted bends and
+ * drifts. For a linear beam line the curvilinear one has extra sections at each end. Returns
+ * 1 if any element isn't matched, is matched to another element's curvilinear volume or
+ * the frame isn't at the middle of the element along its reference trajectory.
+ */
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
+#include "BDSCurvilinearBuilder.hh"
+#include "BDSCurvilinearFactory.hh"
+#include "BDSSimpleComponent.hh"
+#include "BDSTiltOffset.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+  G4int CheckBeamline(G4bool circular)
+  {
+    BDSCurvilinearFactory factory;
+    BDSBeamline massWorld;
+    const G4double radius = 20*CLHEP::cm;
+    const G4double tilts[4] = {0, 0.1, -0.3, CLHEP::halfpi};
+    for (G4int i = 0; i < 4; i++)
+      {
+        G4double angle = CLHEP::halfpi;
+        G4double arcLength = 2*CLHEP::m;
+        G4double chordLength = 2 * (arcLength / angle) * std::sin(0.5*angle);
+        BDSTiltOffset* tiltOffset = new BDSTiltOffset(0, 0, tilts[i]);
+        massWorld.AddComponent(factory.CreateCurvilinearVolume("sb" + std::to_string(i), arcLength,
+                                                               chordLength, radius, angle, tiltOffset),
+                               tiltOffset);
+        massWorld.AddComponent(factory.CreateCurvilinearVolume("d" + std::to_string(i), 1*CLHEP::m, radius));
+      }
+
+    BDSCurvilinearBuilder builder;
+    BDSBeamline* clWorld = builder.BuildCurvilinearBeamLine1To1(&massWorld, circular);
+    auto matches = BDSCurvilinearBuilder::MatchElements1To1(&massWorld, clWorld);
+
+    G4int nFailed = 0;
+    G4int k = 0;
+    for (const auto element : massWorld)
+      {
+        G4String name = element->GetName();
+        auto search = matches.find(element);
+        if (search == matches.end())
+          {
+            std::cerr << name << ": no curvilinear element" << std::endl;
+            nFailed++;
+            k++;
+            continue;
+          }
+        const BDSBeamlineElement* clElement = search->second;
+        G4String expectedName = name + "_cl_" + std::to_string(k);
+        if (clElement->GetName() != expectedName)
+          {
+            std::cerr << name << ": matched to " << clElement->GetName() << " not " << expectedName << std::endl;
+            nFailed++;
+          }
+
+        // the registered frame must be centred on the element and along its reference trajectory
+        const G4Transform3D* transform = clElement->GetPlacementTransformCL();
+        G4ThreeVector origin = transform->getTranslation();
+        G4ThreeVector zAxis = transform->getRotation() * G4ThreeVector(0,0,1);
+        G4ThreeVector expectedZ = (*element->GetReferenceRotationMiddle()) * G4ThreeVector(0,0,1);
+        if ((origin - element->GetReferencePositionMiddle()).mag() > 1e-6*CLHEP::mm
+            || (zAxis - expectedZ).mag() > 1e-9)
+          {
+            std::cerr << name << ": curvilinear frame isn't at the middle of the element" << std::endl;
+            nFailed++;
+          }
+        k++;
+      }
+    delete clWorld;
+    std::cout << (circular ? "circular" : "linear") << ": " << matches.size() << " of "
+              << massWorld.size() << " elements matched, " << nFailed << " failures" << std::endl;
+    return nFailed;
+  }
+}
+
+int main()
+{
+  G4int nFailed = CheckBeamline(true) + CheckBeamline(false);
+  return nFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Validation of the tabulated Bessel functions used optionally for the pill box
+ * cavity field (BDSFieldEMRFCavity). The field with the table is compared against
+ * the field evaluated exactly with TMath across the cavity and outside it at a
+ * range of times. The largest differences relative to the peak fields and the
+ * time per query for each are printed. Returns 1 if the difference is too large.
+ */
+#include "BDSFieldEMRFCavity.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+int main()
+{
+  G4double eField       = 30*CLHEP::megavolt/CLHEP::m;
+  G4double frequency    = 1.3*CLHEP::gigahertz;
+  G4double phase        = 0.3;
+  G4double cavityRadius = 10*CLHEP::cm;
+  BDSFieldEMRFCavity exact(eField, frequency, phase, cavityRadius, 0, false);
+  BDSFieldEMRFCavity tabulated(eField, frequency, phase, cavityRadius, 0, true);
+
+  // points up to beyond the cavity radius where the field is clamped
+  std::mt19937_64 generator(1234);
+  std::uniform_real_distribution<G4double> transverse(-1.2*cavityRadius, 1.2*cavityRadius);
+  std::uniform_real_distribution<G4double> time(0, 10/frequency);
+  const G4int nPoints = 1000000;
+  std::vector<std::pair<G4ThreeVector, G4double> > points;
+  points.reserve(nPoints + 1);
+  points.emplace_back(G4ThreeVector(), 0); // on axis
+  for (G4int i = 0; i < nPoints; i++)
+    {points.emplace_back(G4ThreeVector(transverse(generator), transverse(generator), 0), time(generator));}
+
+  G4double maxB  = 0;
+  G4double maxE  = 0;
+  G4double diffB = 0;
+  G4double diffE = 0;
+  for (const auto& p : points)
+    {
+      auto fe = exact.GetField(p.first, p.second);
+      auto ft = tabulated.GetField(p.first, p.second);
+      maxB  = std::max(maxB,  fe.first.mag());
+      maxE  = std::max(maxE,  fe.second.mag());
+      diffB = std::max(diffB, (fe.first  - ft.first).mag());
+      diffE = std::max(diffE, (fe.second - ft.second).mag());
+    }
+  G4double relB = diffB / maxB;
+  G4double relE = diffE / maxE;
+  std::cout << "Largest difference relative to peak field: B " << relB << ", E " << relE << std::endl;
+
+  for (G4int k = 0; k < 2; k++)
+    {
+      const BDSFieldEMRFCavity& field = k == 0 ? exact : tabulated;
+      G4double sum = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (const auto& p : points)
+        {
+          auto f = field.GetField(p.first, p.second);
+          sum += f.first.x() + f.second.z();
+        }
+      auto stop = std::chrono::steady_clock::now();
+      G4double ns = std::chrono::duration<G4double, std::nano>(stop - start).count() / (G4double)points.size();
+      std::cout << (k == 0 ? "exact     " : "tabulated ") << ns << " ns per query (" << sum << ")" << std::endl;
+    }
+
+  const G4double tolerance = 1e-9;
+  if (relB > tolerance || relE > tolerance)
+    {
+      std::cerr << "Tabulated Bessel field differs by more than " << tolerance << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Comparison of the interpolated yoke field (BDSFieldMagMultipoleOuterGridded) with the
+ * analytical yoke field (BDSFieldMagMultipoleOuter) it is sampled from for a quadrupole.
+ * At the grid points the two must agree to the field precision, between them the mean
+ * difference relative to the analytical field must be small and beyond the grid the
+ * analytical field must be used exactly. Returns 1 if any of these fail.
+ */
+#include "BDSArray2DCoords.hh"
+#include "BDSFieldMagMultipoleOuter.hh"
+#include "BDSFieldMagMultipoleOuterGridded.hh"
+#include "BDSFieldMagQuadrupole.hh"
+#include "BDSMagnetStrength.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+int main()
+{
+  BDSMagnetStrength st;
+  st["k1"] = 0.2;
+  G4double brho          = 10*CLHEP::tesla*CLHEP::m;
+  G4double poleTipRadius = 3*CLHEP::cm;
+  BDSFieldMagQuadrupole inner(&st, brho);
+  auto analytical = new BDSFieldMagMultipoleOuter(2, poleTipRadius, &inner, true, brho);
+
+  G4double halfWidth = 30*CLHEP::cm;
+  G4int    nPoints   = 201;
+  // the grid is not owned by the gridded field and is left to the end of the program
+  BDSArray2DCoords* grid = BDSFieldMagMultipoleOuterGridded::SampleField(analytical, halfWidth, nPoints);
+  BDSFieldMagMultipoleOuterGridded gridded(analytical, grid); // owns analytical
+
+  G4int result = 0;
+
+  // at the grid points
+  G4double step  = 2*halfWidth / (G4double)(nPoints - 1);
+  G4double maxB  = 0;
+  G4double diffB = 0;
+  for (G4int j = 0; j < nPoints; j += 5)
+    {
+      for (G4int i = 0; i < nPoints; i += 5)
+        {
+          G4ThreeVector pos(-halfWidth + i*step, -halfWidth + j*step, 0);
+          G4ThreeVector ba = analytical->GetField(pos);
+          maxB  = std::max(maxB, ba.mag());
+          diffB = std::max(diffB, (ba - gridded.GetField(pos)).mag());
+        }
+    }
+  std::cout << "Largest difference at grid points relative to peak field: " << diffB / maxB << std::endl;
+  if (!(diffB / maxB < 1e-6))
+    {
+      std::cerr << "Interpolated yoke field doesn't match the analytical field at the grid points" << std::endl;
+      result = 1;
+    }
+
+  // between the grid points - away from the pole tip where the analytical field is saturated
+  std::mt19937_64 generator(1357);
+  std::uniform_real_distribution<G4double> transverse(-halfWidth, halfWidth);
+  G4double sumRelative = 0;
+  G4int    nCompared   = 0;
+  while (nCompared < 100000)
+    {
+      G4ThreeVector pos(transverse(generator), transverse(generator), 0);
+      if (pos.perp() < 2*poleTipRadius)
+        {continue;}
+      G4ThreeVector ba = analytical->GetField(pos);
+      if (ba.mag() == 0)
+        {continue;}
+      sumRelative += (ba - gridded.GetField(pos)).mag() / ba.mag();
+      nCompared++;
+    }
+  G4double meanRelative = sumRelative / (G4double)nCompared;
+  std::cout << "Mean difference between grid points relative to the analytical field: " << meanRelative << std::endl;
+  if (!(meanRelative < 1e-2))
+    {
+      std::cerr << "Interpolated yoke field differs too much from the analytical field" << std::endl;
+      result = 1;
+    }
+
+  // beyond the grid
+  G4ThreeVector outside(1.5*halfWidth, 0.3*halfWidth, 0);
+  if (gridded.GetField(outside) != analytical->GetField(outside))
+    {
+      std::cerr << "Analytical yoke field not used beyond the grid" << std::endl;
+      result = 1;
+    }
+  return result;
+}
@@ -0,0 +1,87 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Check of the batch interface of the multipole field (BDSFieldMagMultipole::GetFieldBatch)
+ * against the field at each point from GetField for a multipole with all normal and skew
+ * components to the highest order. Returns 1 if any point differs by more than the tolerance
+ * relative to the largest field.
+ */
+#include "BDSFieldMagMultipole.hh"
+#include "BDSMagnetStrength.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+  std::mt19937_64 generator(4321);
+  std::uniform_real_distribution<G4double> strength(-1, 1);
+  BDSMagnetStrength st;
+  for (const auto& key : BDSMagnetStrength::NormalComponentKeys())
+    {st[key] = strength(generator);}
+  for (const auto& key : BDSMagnetStrength::SkewComponentKeys())
+    {st[key] = strength(generator);}
+  G4double brho = 10*CLHEP::tesla*CLHEP::m;
+  BDSFieldMagMultipole field(&st, brho);
+
+  // include an odd number of points so any remainder after vectorised blocks is tested
+  const std::size_t nPoints = 1001;
+  std::uniform_real_distribution<G4double> transverse(-3*CLHEP::cm, 3*CLHEP::cm);
+  std::vector<G4double> x(nPoints);
+  std::vector<G4double> y(nPoints);
+  for (std::size_t i = 0; i < nPoints; i++)
+    {
+      x[i] = transverse(generator);
+      y[i] = transverse(generator);
+    }
+  x[0] = 0; // on axis
+  y[0] = 0;
+
+  std::vector<G4double> bx(nPoints);
+  std::vector<G4double> by(nPoints);
+  field.GetFieldBatch(nPoints, x.data(), y.data(), bx.data(), by.data());
+
+  G4double maxB = 0;
+  G4double diff = 0;
+  for (std::size_t i = 0; i < nPoints; i++)
+    {
+      G4ThreeVector b = field.GetField(G4ThreeVector(x[i], y[i], 0));
+      maxB = std::max(maxB, b.mag());
+      diff = std::max(diff, (b - G4ThreeVector(bx[i], by[i], 0)).mag());
+    }
+  G4double rel = maxB > 0 ? diff / maxB : diff;
+  std::cout << "Largest difference between batch and single point field relative to peak field: " << rel << std::endl;
+
+  const G4double tolerance = 1e-12;
+  if (!(rel <= tolerance))
+    {
+      std::cerr << "Batch multipole field differs by more than " << tolerance << std::endl;
+      return 1;
+    }
+  return 0;
+}
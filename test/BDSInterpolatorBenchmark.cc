@@ -0,0 +1,255 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Micro-benchmark of 3D cubic field map interpolation comparing the standard
+ * (x fastest) array layout with the bricked layout (see BDSArray4D) and the standard
+ * interpolator with the one reading the array directly (BDSInterpolator3DDirect). A realistic
+ * size field map is generated, then queried at random points and along straight
+ * tracks. The time and, on Linux if permitted, the number of cache misses are printed.
+ *
+ * Usage: BDSInterpolatorBenchmark [nPointsPerDimension]
+ */
+#include "BDSArray3DCoords.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DDirect.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  /// Hardware counter of cache misses. Reports -1 if not available.
+  class CacheMissCounter
+  {
+  public:
+    CacheMissCounter(std::uint32_t type, std::uint64_t config):
+      fd(-1)
+    {
+#ifdef __linux__
+      struct perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size           = sizeof(attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+      (void)type;
+      (void)config;
+#endif
+    }
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+      if (fd >= 0)
+        {close(fd);}
+#endif
+    }
+    void Start()
+    {
+#ifdef __linux__
+      if (fd >= 0)
+        {ioctl(fd, PERF_EVENT_IOC_RESET, 0); ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);}
+#endif
+    }
+    long long Stop()
+    {
+#ifdef __linux__
+      if (fd < 0)
+        {return -1;}
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      long long count = 0;
+      if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+        {return -1;}
+      return count;
+#else
+      return -1;
+#endif
+    }
+  private:
+    int fd;
+  };
+
+  /// A smooth solenoid-like field that varies in all three dimensions.
+  BDSFieldValue ExampleField(G4double x, G4double y, G4double z)
+  {
+    G4double a  = 0.3*CLHEP::m;
+    G4double u  = z / a;
+    G4double bz = 2.0 / std::pow(1 + u*u, 1.5);
+    G4double br = 3.0 * u / (2*a) / std::pow(1 + u*u, 2.5);
+    return BDSFieldValue((FIELDTYPET)(br*x), (FIELDTYPET)(br*y), (FIELDTYPET)(bz*(1 - 0.1*(x*x + y*y)/(a*a))));
+  }
+
+  struct Result
+  {
+    G4double      seconds;
+    long long     l1Misses;
+    long long     llcMisses;
+    G4ThreeVector sum; ///< To check the layouts give the same answer and prevent optimisation.
+  };
+
+  Result Run(const BDSInterpolator3D& interpolator, const std::vector<G4ThreeVector>& points)
+  {
+    CacheMissCounter l1(PERF_TYPE_HW_CACHE,
+                        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    CacheMissCounter llc(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    Result result;
+    l1.Start();
+    llc.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& p : points)
+      {result.sum += interpolator.GetInterpolatedValue(p.x(), p.y(), p.z());}
+    auto stop = std::chrono::steady_clock::now();
+    result.llcMisses = llc.Stop();
+    result.l1Misses  = l1.Stop();
+    result.seconds   = std::chrono::duration<G4double>(stop - start).count();
+    return result;
+  }
+
+  void Print(const std::string& name, const Result& r, std::size_t nPoints)
+  {
+    std::cout << std::setw(36) << std::left << name
+              << std::setw(10) << std::right << std::setprecision(4) << r.seconds * 1e9 / (G4double)nPoints << " ns/query";
+    if (r.l1Misses >= 0)
+      {std::cout << std::setw(12) << std::setprecision(3) << (G4double)r.l1Misses / (G4double)nPoints << " L1D misses/query";}
+    if (r.llcMisses >= 0)
+      {std::cout << std::setw(12) << std::setprecision(3) << (G4double)r.llcMisses / (G4double)nPoints << " LLC misses/query";}
+    if (r.l1Misses < 0 && r.llcMisses < 0)
+      {std::cout << "   (hardware cache counters unavailable)";}
+    std::cout << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  G4int n = argc > 1 ? std::atoi(argv[1]) : 200;
+  if (n < 8)
+    {std::cerr << "number of points per dimension must be at least 8" << std::endl; return 1;}
+  G4double halfWidth  = 0.2*CLHEP::m;
+  G4double halfLength = 1.0*CLHEP::m;
+
+  std::cout << "Preparing " << n << "x" << n << "x" << 2*n << " field map ("
+            << (std::size_t)n*n*2*n*sizeof(BDSFieldValue) / (1024*1024) << " MB)" << std::endl;
+  BDSArray3DCoords linear(n, n, 2*n, -halfWidth, halfWidth, -halfWidth, halfWidth, -halfLength, halfLength);
+  for (G4int k = 0; k < linear.NZ(); k++)
+    {
+      for (G4int j = 0; j < linear.NY(); j++)
+        {
+          for (G4int i = 0; i < linear.NX(); i++)
+            {
+              G4double x = linear.XMin() + i*linear.XStep();
+              G4double y = linear.YMin() + j*linear.YStep();
+              G4double z = linear.ZMin() + k*linear.ZStep();
+              linear(i,j,k) = ExampleField(x, y, z);
+            }
+        }
+    }
+  BDSArray3DCoords bricked(linear);
+  bricked.ConvertToBricked();
+
+  // random points throughout the map - worst case for the cache
+  std::mt19937_64 generator(1234);
+  std::uniform_real_distribution<G4double> transverse(-0.95*halfWidth, 0.95*halfWidth);
+  std::uniform_real_distribution<G4double> longitudinal(-0.95*halfLength, 0.95*halfLength);
+  const std::size_t nRandom = 2000000;
+  std::vector<G4ThreeVector> randomPoints;
+  randomPoints.reserve(nRandom);
+  for (std::size_t i = 0; i < nRandom; i++)
+    {randomPoints.emplace_back(transverse(generator), transverse(generator), longitudinal(generator));}
+
+  // points along straight tracks through the map as during tracking
+  const G4int nTracks = 2000;
+  const G4int nSteps  = 1000;
+  std::vector<G4ThreeVector> trackPoints;
+  trackPoints.reserve((std::size_t)nTracks * nSteps);
+  std::uniform_real_distribution<G4double> angle(-0.05, 0.05);
+  for (G4int i = 0; i < nTracks; i++)
+    {
+      G4ThreeVector position(0.5*transverse(generator), 0.5*transverse(generator), -0.95*halfLength);
+      G4ThreeVector direction = G4ThreeVector(angle(generator), angle(generator), 1).unit();
+      G4double step = 1.9*halfLength / (G4double)nSteps;
+      for (G4int s = 0; s < nSteps; s++)
+        {
+          trackPoints.push_back(position);
+          position += step * direction;
+        }
+    }
+
+  struct Case
+  {
+    std::string               name;
+    const BDSInterpolator3D*  interpolator;
+  };
+  BDSInterpolator3DCubic      standardLinear(&linear);
+  BDSInterpolator3DCubic      standardBricked(&bricked);
+  BDSInterpolator3DDirect<4>  directLinear(&linear);
+  BDSInterpolator3DDirect<4>  directBricked(&bricked);
+  std::vector<Case> cases = {{"standard - linear layout", &standardLinear},
+                             {"standard - bricked layout", &standardBricked},
+                             {"direct - linear layout", &directLinear},
+                             {"direct - bricked layout", &directBricked}};
+
+  // warm up
+  Run(standardLinear, trackPoints);
+
+  std::cout << "3D cubic interpolation" << std::endl;
+  G4bool different = false;
+  Result referenceRandom, referenceTrack;
+  for (const auto& c : cases)
+    {
+      Result random = Run(*c.interpolator, randomPoints);
+      Result track  = Run(*c.interpolator, trackPoints);
+      Print("random - " + c.name, random, randomPoints.size());
+      Print("tracks - " + c.name, track,  trackPoints.size());
+      if (c.interpolator == &standardLinear)
+        {referenceRandom = random; referenceTrack = track; continue;}
+      G4double difference = (random.sum - referenceRandom.sum).mag() + (track.sum - referenceTrack.sum).mag();
+      different = different || difference > 1e-5 * (referenceRandom.sum.mag() + referenceTrack.sum.mag());
+    }
+
+  if (different)
+    {
+      std::cerr << "interpolators or layouts give different results" << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,293 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Point by point check of the interpolators chosen automatically for plain 3D and 4D
+ * arrays (BDSInterpolator3DDirect, BDSInterpolator4DDirect, BDSInterpolator3DCubicTable and
+ * BDSInterpolator4DCubicTable) against the standard linear and cubic interpolators. Points
+ * are taken inside the array, near and on its edges (where the stencil leaves the array
+ * and the standard interface is used) and just outside it. This is repeated with the
+ * bricked layout and the float32 and int16 storage types. Returns 1 if any point differs
+ * by more than the tolerance relative to the largest field value.
+ */
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSArrayStorageType.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3D.hh"
+#include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DCubicTable.hh"
+#include "BDSInterpolator3DDirect.hh"
+#include "BDSInterpolator3DLinear.hh"
+#include "BDSInterpolator4D.hh"
+#include "BDSInterpolator4DCubic.hh"
+#include "BDSInterpolator4DCubicTable.hh"
+#include "BDSInterpolator4DDirect.hh"
+#include "BDSInterpolator4DLinear.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  typedef std::array<G4double, 4> Point;
+
+  /// Differences come only from the order of summation and, for the table, the expansion
+  /// into polynomial coefficients, which in 4D is a few hundred rounding errors.
+  const G4double tolerance = 2000 * std::numeric_limits<FIELDTYPET>::epsilon();
+
+  /// Smooth, not polynomial, field so no interpolator is exact.
+  BDSFieldValue Field(G4double x, G4double y, G4double z, G4double t)
+  {
+    return BDSFieldValue((FIELDTYPET)(std::sin(1.3*x + 0.4*y) * std::cos(0.7*z) + 0.2*t),
+                         (FIELDTYPET)(std::cos(0.5*x - 1.1*z) + 0.3*y*t),
+                         (FIELDTYPET)(std::exp(-0.1*(x*x + y*y)) * std::sin(z + t)));
+  }
+
+  /// Fill every point of the array from Field().
+  void Fill(BDSArray4DCoords* array)
+  {
+    G4double tStep = array->NT() > 1 ? array->TStep() : 0; // not defined for a single time
+    for (G4int l = 0; l < array->NT(); l++)
+      {
+        for (G4int k = 0; k < array->NZ(); k++)
+          {
+            for (G4int j = 0; j < array->NY(); j++)
+              {
+                for (G4int i = 0; i < array->NX(); i++)
+                  {
+                    (*array)(i,j,k,l) = Field(array->XMin() + i*array->XStep(),
+                                              array->YMin() + j*array->YStep(),
+                                              array->ZMin() + k*array->ZStep(),
+                                              array->TMin() + l*tStep);
+                  }
+              }
+          }
+      }
+  }
+
+  /// Random points over the array extended by one step each side so that the cells
+  /// at the edges and points outside are included, plus the corners and the nodes
+  /// either side of the first and last cell in each dimension.
+  std::vector<Point> Points(const BDSArray4DCoords* array, G4int nDimensions)
+  {
+    G4double mins[4]  = {array->XMin(),  array->YMin(),  array->ZMin(),  array->TMin()};
+    G4double maxs[4]  = {array->XMax(),  array->YMax(),  array->ZMax(),  array->TMax()};
+    G4double steps[4] = {array->XStep(), array->YStep(), array->ZStep(), array->TStep()};
+    std::mt19937_64 generator(1234);
+    std::vector<Point> result;
+    for (G4int n = 0; n < 4000; n++)
+      {
+        Point p = {0, 0, 0, 0};
+        for (G4int d = 0; d < nDimensions; d++)
+          {
+            std::uniform_real_distribution<G4double> dist(mins[d] - steps[d], maxs[d] + steps[d]);
+            p[d] = dist(generator);
+          }
+        result.push_back(p);
+      }
+    // each coordinate from a set of positions at and either side of the edges
+    std::vector<std::vector<G4double> > edges(4, std::vector<G4double>(1, 0));
+    for (G4int d = 0; d < nDimensions; d++)
+      {
+        edges[d] = {mins[d], mins[d] + 0.5*steps[d], mins[d] + 1.5*steps[d],
+                    maxs[d] - 1.5*steps[d], maxs[d] - 0.5*steps[d], maxs[d]};
+      }
+    for (G4double x : edges[0])
+      {
+        for (G4double y : edges[1])
+          {
+            for (G4double z : edges[2])
+              {
+                for (G4double t : edges[3])
+                  {result.push_back({x, y, z, t});}
+              }
+          }
+      }
+    return result;
+  }
+
+  /// Largest magnitude of the field at any node, which the differences are relative to.
+  G4double Peak(const BDSArray4DCoords* array)
+  {
+    G4double peak = 0;
+    for (G4int l = 0; l < array->NT(); l++)
+      {
+        for (G4int k = 0; k < array->NZ(); k++)
+          {
+            for (G4int j = 0; j < array->NY(); j++)
+              {
+                for (G4int i = 0; i < array->NX(); i++)
+                  {
+                    const BDSFieldValue& v = array->GetConst(i,j,k,l);
+                    peak = std::max(peak, G4ThreeVector(v.x(), v.y(), v.z()).mag());
+                  }
+              }
+          }
+      }
+    return peak;
+  }
+
+  /// @{ Interpolated value at a point.
+  G4ThreeVector Value(const BDSInterpolator3D& interpolator, const Point& p)
+  {return interpolator.GetInterpolatedValue(p[0], p[1], p[2]);}
+
+  G4ThreeVector Value(const BDSInterpolator4D& interpolator, const Point& p)
+  {return interpolator.GetInterpolatedValue(p[0], p[1], p[2], p[3]);}
+  /// @}
+
+  /// Compare two interpolators at every point and report the largest relative difference.
+  template <class T, class R>
+  G4bool Compare(const std::string& name,
+                 const T& test,
+                 const R& reference,
+                 const std::vector<Point>& points,
+                 G4double peak)
+  {
+    G4double diff = 0;
+    for (const auto& p : points)
+      {
+        G4ThreeVector a = Value(test, p);
+        G4ThreeVector b = Value(reference, p);
+        diff = std::max(diff, (a - b).mag());
+      }
+    G4double rel = diff / peak;
+    G4bool pass = rel <= tolerance;
+    std::cout << (pass ? "pass " : "FAIL ") << name << " - largest relative difference " << rel << std::endl;
+    return pass;
+  }
+
+  /// Make a filled 3D array (not a multiple of the brick size in any dimension).
+  BDSArray3DCoords* Make3D()
+  {
+    auto result = new BDSArray3DCoords(9, 7, 10, -2.0, 2.0, -1.5, 1.5, -3.0, 2.0);
+    Fill(result);
+    return result;
+  }
+
+  /// Make a filled 4D array.
+  BDSArray4DCoords* Make4D()
+  {
+    auto result = new BDSArray4DCoords(7, 6, 9, 5, -2.0, 2.0, -1.5, 1.5, -3.0, 2.0, 0.0, 1.0);
+    Fill(result);
+    return result;
+  }
+
+  G4bool Test3D()
+  {
+    G4bool pass = true;
+    BDSArray3DCoords* plain = Make3D();
+    G4double peak = Peak(plain);
+    std::vector<Point> points = Points(plain, 3);
+    BDSInterpolator3DLinear linear(plain);
+    BDSInterpolator3DCubic  cubic(plain);
+
+    pass &= Compare("3D direct linear", BDSInterpolator3DDirect<2>(plain), linear, points, peak);
+    pass &= Compare("3D direct cubic",  BDSInterpolator3DDirect<4>(plain), cubic,  points, peak);
+    pass &= Compare("3D cubic table",   BDSInterpolator3DCubicTable(plain), cubic, points, peak);
+
+    // bricked layout against the standard interpolators on the standard layout
+    BDSArray3DCoords* bricked = Make3D();
+    bricked->ConvertToBricked();
+    if (!BDSInterpolator3DDirect<2>::Suitable(bricked))
+      {std::cout << "FAIL 3D direct interpolation not used for a bricked array" << std::endl; pass = false;}
+    pass &= Compare("3D direct linear bricked", BDSInterpolator3DDirect<2>(bricked), linear, points, peak);
+    pass &= Compare("3D direct cubic bricked",  BDSInterpolator3DDirect<4>(bricked), cubic,  points, peak);
+    pass &= Compare("3D cubic table bricked",   BDSInterpolator3DCubicTable(bricked), cubic, points, peak);
+
+    // reduced precision - the table is compared with the cubic interpolation of the same values
+    for (BDSArrayStorageType storage : {BDSArrayStorageType::float32, BDSArrayStorageType::int16})
+      {
+        for (G4bool brick : {false, true})
+          {
+            BDSArray3DCoords* reduced = Make3D();
+            if (brick)
+              {reduced->ConvertToBricked();}
+            reduced->ConvertStorage(storage);
+            std::string name = "3D cubic table " + storage.ToString() + (brick ? " bricked" : "");
+            if (BDSInterpolator3DDirect<4>::Suitable(reduced))
+              {std::cout << "FAIL " << name << " - direct interpolation allowed" << std::endl; pass = false;}
+            BDSInterpolator3DCubic reducedCubic(reduced);
+            pass &= Compare(name, BDSInterpolator3DCubicTable(reduced), reducedCubic, points, peak);
+            delete reduced;
+          }
+      }
+    delete plain;
+    delete bricked;
+    return pass;
+  }
+
+  G4bool Test4D()
+  {
+    G4bool pass = true;
+    BDSArray4DCoords* plain = Make4D();
+    G4double peak = Peak(plain);
+    std::vector<Point> points = Points(plain, 4);
+    BDSInterpolator4DLinear linear(plain);
+    BDSInterpolator4DCubic  cubic(plain);
+
+    pass &= Compare("4D direct linear", BDSInterpolator4DDirect<2>(plain), linear, points, peak);
+    pass &= Compare("4D direct cubic",  BDSInterpolator4DDirect<4>(plain), cubic,  points, peak);
+    pass &= Compare("4D cubic table",   BDSInterpolator4DCubicTable(plain), cubic, points, peak);
+
+    BDSArray4DCoords* bricked = Make4D();
+    bricked->ConvertToBricked();
+    if (!BDSInterpolator4DDirect<2>::Suitable(bricked))
+      {std::cout << "FAIL 4D direct interpolation not used for a bricked array" << std::endl; pass = false;}
+    pass &= Compare("4D direct linear bricked", BDSInterpolator4DDirect<2>(bricked), linear, points, peak);
+    pass &= Compare("4D direct cubic bricked",  BDSInterpolator4DDirect<4>(bricked), cubic,  points, peak);
+    pass &= Compare("4D cubic table bricked",   BDSInterpolator4DCubicTable(bricked), cubic, points, peak);
+
+    for (BDSArrayStorageType storage : {BDSArrayStorageType::float32, BDSArrayStorageType::int16})
+      {
+        for (G4bool brick : {false, true})
+          {
+            BDSArray4DCoords* reduced = Make4D();
+            if (brick)
+              {reduced->ConvertToBricked();}
+            reduced->ConvertStorage(storage);
+            std::string name = "4D cubic table " + storage.ToString() + (brick ? " bricked" : "");
+            if (BDSInterpolator4DDirect<4>::Suitable(reduced))
+              {std::cout << "FAIL " << name << " - direct interpolation allowed" << std::endl; pass = false;}
+            BDSInterpolator4DCubic reducedCubic(reduced);
+            pass &= Compare(name, BDSInterpolator4DCubicTable(reduced), reducedCubic, points, peak);
+            delete reduced;
+          }
+      }
+    delete plain;
+    delete bricked;
+    return pass;
+  }
+}
+
+int main()
+{
+  std::cout << "Tolerance relative to the peak field: " << tolerance << std::endl;
+  G4bool pass = Test3D();
+  pass = Test4D() && pass;
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Check the ordered output queue of a multi-threaded run doesn't wait forever when one
+ * worker aborts its run. Several threads take event indices one at a time and publish
+ * empty records as the workers do. One of them stops at an event without publishing it
+ * and abandons the queue, as BDSWorkerRunManager::AbortRun does. Each thread then waits
+ * for its published records to be written as in the worker end of run action, and the
+ * main thread finishes the queue as the master does. Returns 1 if any published record
+ * isn't written. Without the abandon this hangs and the test times out.
+ */
+#include "BDSOutputEventQueue.hh"
+#include "BDSOutputEventRecord.hh"
+#include "BDSOutputNone.hh"
+
+#include "G4Types.hh"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int main()
+{
+  const G4int nThreads   = 4;
+  const G4int nEvents    = 2000;
+  const G4int abortIndex = 300;
+  
+  BDSOutputNone output;
+  BDSOutputEventQueue queue(&output, 8*nThreads, 0);
+  std::vector<std::unique_ptr<BDSOutputEventRecord> > records;
+  for (G4int i = 0; i < nEvents; i++)
+    {records.emplace_back(new BDSOutputEventRecord());}
+  std::vector<std::atomic<G4bool> > published(nEvents);
+  for (auto& p : published)
+    {p.store(false);}
+  
+  std::atomic<G4int> nextEvent(0);
+  auto worker = [&](G4int threadID)
+    {
+      std::vector<G4int> inFlight;
+      while (true)
+        {
+          G4int index = nextEvent.fetch_add(1);
+          if (index >= nEvents)
+            {break;}
+          if (threadID == 0 && index >= abortIndex)
+            {// this event and the rest allocated to this thread are never simulated
+              queue.Abandon();
+              break;
+            }
+          records[index]->index = index;
+          if (!queue.Publish(records[index].get()))
+            {break;} // aborted elsewhere - stop as the event action does
+          published[index].store(true);
+          inFlight.push_back(index);
+        }
+      // end of run on the worker - wait for its events to be written
+      G4int nTries = 0;
+      for (auto index : inFlight)
+        {
+          while (!records[index]->written.load())
+            {BDSOutputEventQueue::Backoff(nTries);}
+        }
+    };
+
+  queue.Start();
+  std::vector<std::thread> threads;
+  for (G4int i = 0; i < nThreads; i++)
+    {threads.emplace_back(worker, i);}
+  for (auto& thread : threads)
+    {thread.join();}
+  queue.Finish();
+
+  G4int nPublished = 0;
+  G4int nNotWritten = 0;
+  for (G4int i = 0; i < nEvents; i++)
+    {
+      if (!published[i].load())
+        {continue;}
+      nPublished++;
+      if (!records[i]->written.load())
+        {nNotWritten++;}
+    }
+  std::cout << nPublished << " events published, " << nNotWritten << " not written" << std::endl;
+  if (nNotWritten > 0 || nPublished < abortIndex/2)
+    {
+      std::cerr << "published events were not written after the abort" << std::endl;
+      return 1;
+    }
+  return 0;
+}
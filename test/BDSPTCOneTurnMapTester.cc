@@ -0,0 +1,126 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Check of the compiled one turn map (BDSPTCOneTurnMap). A map with random terms,
+ * including monomials shared between the outputs and repeated within one output, is
+ * applied to a set of particles at once with the batch Evaluate. The result is compared
+ * to summing each term of each output with std::pow, i.e. the map as written in the
+ * map table, particle by particle. Returns 1 if any coordinate differs by more than the
+ * tolerance relative to its magnitude.
+ */
+#include "BDSParticleDefinition.hh"
+#include "BDSPTCOneTurnMap.hh"
+
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  typedef std::array<std::vector<BDSPTCOneTurnMap::PTCMapTerm>, BDSPTCOneTurnMap::nVariables> MapTerms;
+
+  /// Apply the terms of each output directly to one set of coordinates.
+  std::array<G4double, BDSPTCOneTurnMap::nVariables> ApplyTerms(const MapTerms& terms,
+                                                                const std::array<G4double, BDSPTCOneTurnMap::nVariables>& c)
+  {
+    std::array<G4double, BDSPTCOneTurnMap::nVariables> result = {};
+    for (G4int v = 0; v < BDSPTCOneTurnMap::nVariables; v++)
+      {
+        for (const auto& t : terms[v])
+          {
+            result[v] += t.coefficient * std::pow(c[0], t.nx) * std::pow(c[1], t.npx)
+              * std::pow(c[2], t.ny) * std::pow(c[3], t.npy) * std::pow(c[4], t.ndeltaP);
+          }
+      }
+    return result;
+  }
+}
+
+int main()
+{
+  std::mt19937_64 generator(2468);
+  std::uniform_real_distribution<G4double> coefficient(-1, 1);
+  std::uniform_int_distribution<G4int> power(0, 3);
+
+  MapTerms terms;
+  std::vector<BDSPTCOneTurnMap::PTCMapTerm> shared;
+  for (G4int i = 0; i < 20; i++)
+    {shared.push_back({0, power(generator), power(generator), power(generator), power(generator), power(generator)});}
+  for (G4int v = 0; v < BDSPTCOneTurnMap::nVariables; v++)
+    {
+      // linear term so the map is close to the identity as a real one would be
+      std::array<G4int, BDSPTCOneTurnMap::nVariables> p = {};
+      p[v] = 1;
+      terms[v].push_back({1, p[0], p[1], p[2], p[3], p[4]});
+      for (auto t : shared)
+        {
+          t.coefficient = 0.1*coefficient(generator);
+          terms[v].push_back(t);
+        }
+      terms[v].push_back(terms[v].back()); // repeated term must be summed
+    }
+
+  BDSParticleDefinition proton("proton", 938.272*CLHEP::MeV, 1, 0, 0, 10*CLHEP::GeV, 1);
+  BDSPTCOneTurnMap map(terms, &proton);
+
+  const std::size_t nParticles = 101;
+  std::uniform_real_distribution<G4double> coordinate(-1e-2, 1e-2);
+  std::array<std::vector<G4double>, BDSPTCOneTurnMap::nVariables> coords;
+  for (auto& c : coords)
+    {
+      c.resize(nParticles);
+      for (auto& value : c)
+        {value = coordinate(generator);}
+    }
+  for (auto& c : coords)
+    {c[0] = 0;} // all zero
+
+  std::vector<std::array<G4double, BDSPTCOneTurnMap::nVariables> > expected(nParticles);
+  for (std::size_t i = 0; i < nParticles; i++)
+    {expected[i] = ApplyTerms(terms, {coords[0][i], coords[1][i], coords[2][i], coords[3][i], coords[4][i]});}
+
+  map.Evaluate(nParticles, coords[0].data(), coords[1].data(), coords[2].data(), coords[3].data(), coords[4].data());
+
+  G4double maxDiff = 0;
+  for (std::size_t i = 0; i < nParticles; i++)
+    {
+      for (G4int v = 0; v < BDSPTCOneTurnMap::nVariables; v++)
+        {
+          G4double diff = std::abs(coords[v][i] - expected[i][v]) / std::max(1e-6, std::abs(expected[i][v]));
+          maxDiff = std::max(maxDiff, diff);
+        }
+    }
+  std::cout << "Largest relative difference of batch map evaluation to the map terms: " << maxDiff << std::endl;
+
+  const G4double tolerance = 1e-12;
+  if (!(maxDiff <= tolerance))
+    {
+      std::cerr << "Batch one turn map differs by more than " << tolerance << std::endl;
+      return 1;
+    }
+  return 0;
+}